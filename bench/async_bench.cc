@@ -0,0 +1,290 @@
+// Host-side micro-benchmarks of the solver structures that issue their own
+// memory requests: MemoryAllocator and Watches on top of AsyncBase, and the
+// two order heaps. They are built from the solver sources against the SST
+// shim in bench/sst_shim and run against MockStandardMem, the same way
+// micro_bench.cc runs the SST-free paths against MockMem (that file holds
+// main()). The templated Heap in heap.h and the Heap SubComponent share a
+// name, which is why these live in a translation unit of their own.
+//
+// Every benchmark here reports sim_cycles_per_op. The structures keep state
+// across operations, so the iteration counts are fixed to keep the
+// per-operation averages comparable with bench/baseline.json.
+
+#include <benchmark/benchmark.h>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "mock_mem.h"
+#include "async_base.h"
+#include "async_heap.h"
+#include "async_watches.h"
+#include "memory_allocator.h"
+#include "pipelined_heap.h"
+
+namespace {
+
+using SST::Interfaces::StandardMem;
+
+void simCycles(benchmark::State& state, uint64_t cycles, uint64_t ops) {
+    state.counters["sim_cycles_per_op"] = ops > 0 ? (double)cycles / ops : 0.0;
+    state.SetItemsProcessed(ops);
+}
+
+// Runs code that accesses memory through one AsyncBase inside a coroutine,
+// as a single solver worker, and routes the responses back the way
+// SATSolver::handleGlobalMemEvent does: a read response resumes the worker
+// that issued it, a write ack resumes a worker stalled on the store queue.
+// The body loops forever and calls opDone() after each operation.
+class AsyncRunner {
+public:
+    AsyncRunner(MockStandardMem& mem) : mem(mem), yield(nullptr), owner(nullptr), blocked(false), ops(0) {}
+
+    coro_t::push_type** yieldPtr() { return &yield; }
+
+    void attach(AsyncBase& ds) {
+        owner = &ds;
+        ds.setReorderBuffer(&rb);
+        ds.setPreYieldCallback([this]() { blocked = true; });
+    }
+
+    void start(std::function<void()> body) {
+        coro.reset(new coro_t::pull_type([this, body](coro_t::push_type& sink) {
+            yield = &sink;
+            body();
+        }));
+    }
+
+    void opDone() {
+        ops++;
+        (*yield)();
+    }
+
+    // Advance until n more operations completed. Like a solver clock tick,
+    // each cycle resumes the worker at most once, so an operation takes at
+    // least a cycle and write acks keep draining the store queue.
+    void run(uint64_t n) {
+        uint64_t target = ops + n;
+        do {
+            if (!blocked) (*coro)();
+            mem.tick([this](StandardMem::Request* req) { deliver(req); });
+        } while (ops < target);
+    }
+
+    uint64_t cycle() const { return mem.cycle(); }
+
+private:
+    void deliver(StandardMem::Request* req) {
+        if (dynamic_cast<StandardMem::ReadResp*>(req)) {
+            int worker_id = rb.lookUpWorkerId(req->getID());
+            owner->handleMem(req);
+            if (worker_id >= 0) blocked = false;
+        } else {
+            owner->handleMem(req);
+            waiters.clear();
+            if (owner->takeStoreQueueWaiters(waiters)) blocked = false;
+        }
+    }
+
+    MockStandardMem& mem;
+    ReorderBuffer rb;
+    coro_t::push_type* yield;
+    std::unique_ptr<coro_t::pull_type> coro;
+    AsyncBase* owner;
+    std::vector<int> waiters;
+    bool blocked;
+    uint64_t ops;
+};
+
+// Bytes of a learnt clause: mostly short, one in four up to 64 literals
+uint32_t clauseBytes(std::mt19937_64& rng) {
+    uint32_t lits = (rng() % 4 == 0) ? 3 + rng() % 62 : 3 + rng() % 8;
+    return CLAUSE_MEMBER_SIZE * 2 + lits * sizeof(Lit);
+}
+
+// Learnt clause churn in the clause arena: with `live` blocks allocated, each
+// operation frees a random one and allocates a new one, so free lists,
+// splits and coalescing all see traffic. Args: latency, live blocks
+void BM_MemoryAllocatorChurn(benchmark::State& state) {
+    const size_t live_target = (size_t)state.range(1);
+    MockStandardMem mem((uint64_t)state.range(0));
+    AsyncRunner runner(mem);
+    AsyncBase clauses("CLAUSES-> ", 0, &mem, runner.yieldPtr());
+    runner.attach(clauses);
+    MemoryAllocator alloc(0, 0x60000000, 16 << 20);
+    alloc.initialize(&clauses, 64);  // Cref 0 is ClauseRef_Undef
+
+    std::vector<std::pair<Cref, uint32_t>> live;
+    runner.start([&]() {
+        std::mt19937_64 rng(9);
+        for (;;) {
+            if (live.size() >= live_target) {
+                size_t i = rng() % live.size();
+                alloc.freeBlock(live[i].first, live[i].second);
+                live[i] = live.back();
+                live.pop_back();
+            }
+            uint32_t bytes = clauseBytes(rng);
+            live.emplace_back(alloc.allocateBlock(bytes), bytes);
+            runner.opDone();
+        }
+    });
+    runner.run(live_target);  // fill the arena
+
+    uint64_t start = runner.cycle();
+    for (auto _ : state) runner.run(1);
+    simCycles(state, runner.cycle() - start, state.iterations());
+    state.counters["frag_ratio"] = alloc.fragRatio();
+}
+BENCHMARK(BM_MemoryAllocatorChurn)->Args({20, 1024})->Args({100, 1024})->Iterations(20000);
+
+// Watcher insertion and removal on lists built by initWatches from 4096
+// random 3-literal clauses over 1024 variables. Each operation inserts a
+// watcher for a new clause on a random literal and, once 2048 are live,
+// removes a random one of them. Args: latency, block width (propagators)
+void BM_WatchesInsertRemove(benchmark::State& state) {
+    const int num_vars = 1024;
+    MockStandardMem mem((uint64_t)state.range(0));
+    AsyncRunner runner(mem);
+    Watches watches(0, &mem, 0x30000000, 0x40000000, runner.yieldPtr(), (int)state.range(1), 0);
+    runner.attach(watches);
+
+    std::mt19937_64 rng(10);
+    auto randomLit = [&]() { return mkLit(1 + (Var)(rng() % num_vars), rng() & 1); };
+    ClausePool pool;
+    for (int i = 0; i < 4096; i++) {
+        Lit c[3] = { randomLit(), randomLit(), randomLit() };
+        while (c[1] == c[0] || c[1] == ~c[0]) c[1] = randomLit();
+        pool.add(c, 3);
+    }
+    watches.initWatches(2 * (num_vars + 1), pool);
+
+    std::vector<std::pair<int, Cref>> live;  // list, clause
+    runner.start([&]() {
+        Cref next_clause = 1 << 24;  // past the original clauses
+        for (;;) {
+            int lit_idx = toWatchIndex(randomLit());
+            watches.insertWatcher(lit_idx, next_clause, randomLit());
+            live.emplace_back(lit_idx, next_clause);
+            next_clause += 16;
+            if (live.size() > 2048) {
+                size_t i = rng() % live.size();
+                watches.removeWatcher(live[i].first, live[i].second);
+                live[i] = live.back();
+                live.pop_back();
+            }
+            runner.opDone();
+        }
+    });
+    runner.run(2048);
+
+    uint64_t start = runner.cycle();
+    for (auto _ : state) runner.run(1);
+    simCycles(state, runner.cycle() - start, state.iterations());
+}
+BENCHMARK(BM_WatchesInsertRemove)->Args({20, 1})->Args({20, 4})->Args({100, 4})->Iterations(20000);
+
+// Drives an order heap SubComponent like the solver does: requests go in
+// through handleRequest, responses come back on its "response" port, and
+// every cycle first delivers the memory responses due and then ticks it.
+template<typename HeapT>
+struct HeapHarness {
+    MockStandardMem mem;
+    SST::Link response;
+    uint64_t responses;
+    int result;
+    double var_inc;
+    std::unique_ptr<HeapT> heap;
+    std::mt19937_64 rng;
+
+    HeapHarness(uint64_t latency)
+        : mem(latency), response([this](SST::Event* ev) {
+              result = static_cast<HeapRespEvent*>(ev)->result;
+              responses++;
+              delete ev;
+          }),
+          responses(0), result(0), var_inc(1.0), rng(11) {
+        SST::SubComponent::connectPort("response", &response);
+    }
+
+    void init(int num_vars, int lanes) {
+        heap->setDecisionFlags(std::vector<bool>(num_vars + 1, true));
+        heap->setHeapSize(num_vars);
+        heap->setVarIncPtr(&var_inc);
+        heap->setHeapLanes(lanes);
+        heap->initHeap(0);
+    }
+
+    void cycle() {
+        mem.tick([this](StandardMem::Request* req) { heap->handleMem(req); });
+        heap->tick(mem.cycle());
+    }
+
+    void waitResponses(uint64_t n) {
+        uint64_t target = responses + n;
+        while (responses < target) cycle();
+    }
+
+    // Four distinct variables to bump, other than the one being decided
+    std::vector<Var> bumps(int num_vars, Var decided) {
+        std::vector<Var> vars;
+        while (vars.size() < 4) {
+            Var v = 1 + (Var)(rng() % num_vars);
+            if (v != decided && std::find(vars.begin(), vars.end(), v) == vars.end()) vars.push_back(v);
+        }
+        var_inc *= 1.0 / 0.95;  // VSIDS decay; the heaps rescale past 1e100
+        return vars;
+    }
+};
+
+// Decision loop on the classic memory-resident heap: REMOVE_MAX, then bump
+// four variables and put the decided one back, waiting for every response
+// as the solver does with USE_CLASSIC_HEAP. Args: variables, heap lanes, latency
+void BM_AsyncHeapDecide(benchmark::State& state) {
+    const int num_vars = (int)state.range(0);
+    HeapHarness<Heap> h((uint64_t)state.range(2));
+    SST::Params params;
+    h.heap.reset(new Heap(0, params, &h.mem, 0x10000000, 0x20000000));
+    h.init(num_vars, (int)state.range(1));
+
+    uint64_t start = h.mem.cycle();
+    for (auto _ : state) {
+        h.heap->handleRequest(new HeapReqEvent(HeapReqEvent::REMOVE_MAX));
+        h.waitResponses(1);
+        Var v = h.result;
+        for (Var u : h.bumps(num_vars, v)) h.heap->handleRequest(new HeapReqEvent(HeapReqEvent::BUMP, u));
+        h.heap->handleRequest(new HeapReqEvent(HeapReqEvent::INSERT, v));
+        h.waitResponses(5);
+        while (h.heap->state != Heap::IDLE) h.cycle();
+    }
+    simCycles(state, h.mem.cycle() - start, state.iterations());
+}
+BENCHMARK(BM_AsyncHeapDecide)->Args({1 << 10, 1, 20})->Args({1 << 16, 4, 20})->Iterations(5000);
+
+// The same loop on the pipelined heap. Bumps go as one batch and neither
+// they nor the insert answer, so a decision lasts until the next REMOVE_MAX
+// gets through the pipeline. Args: variables, heap lanes, latency
+void BM_PipelinedHeapDecide(benchmark::State& state) {
+    const int num_vars = (int)state.range(0);
+    HeapHarness<PipelinedHeap> h((uint64_t)state.range(2));
+    SST::Params params;
+    h.heap.reset(new PipelinedHeap(0, params, &h.mem, 0x70000000));
+    h.init(num_vars, (int)state.range(1));
+
+    uint64_t start = h.mem.cycle();
+    for (auto _ : state) {
+        h.heap->handleRequest(new HeapReqEvent(HeapReqEvent::REMOVE_MAX));
+        h.waitResponses(1);
+        Var v = h.result;
+        h.heap->handleRequest(new HeapReqEvent(HeapReqEvent::BUMP, h.bumps(num_vars, v)));
+        h.heap->handleRequest(new HeapReqEvent(HeapReqEvent::INSERT, v));
+    }
+    simCycles(state, h.mem.cycle() - start, state.iterations());
+}
+BENCHMARK(BM_PipelinedHeapDecide)->Args({1 << 10, 1, 20})->Args({1 << 16, 4, 20})->Iterations(20000);
+
+} // namespace
@@ -0,0 +1,275 @@
+// Host-side micro-benchmarks of the solver's SST-free hot paths. The
+// structures that issue their own memory requests are in async_bench.cc.
+//
+// Built and run by `make -C src bench`, which writes Google Benchmark JSON
+// to build/bench.json and compares it with bench/baseline.json through
+// tools/bench_compare.py. Benchmarks that move data through memory run
+// against MockMem and also report sim_cycles_per_op, the simulated cycles
+// per operation at the given fixed latency. Those are deterministic, so
+// any change means the modeled behavior changed, not the host.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "mock_mem.h"
+#include "address_layout.h"
+#include "heap.h"
+#include "host_mirror.h"
+#include "mem_profile.h"
+#include "reorder_buffer.h"
+#include "reuse_sampler.h"
+#include "store_queue.h"
+#include "trace_writer.h"
+
+namespace {
+
+void simCycles(benchmark::State& state, uint64_t cycles, uint64_t ops) {
+    state.counters["sim_cycles_per_op"] = ops > 0 ? (double)cycles / ops : 0.0;
+    state.SetItemsProcessed(ops);
+}
+
+// Read round trip through the reorder buffer: `workers` reads in flight, each
+// completion copied out of the worker's slot and replaced by a new read.
+// An iteration is one cycle with at least one completion. Args: workers, latency
+void BM_ReorderBufferRoundTrip(benchmark::State& state) {
+    const int workers = (int)state.range(0);
+    MockMem mem((uint64_t)state.range(1));
+    ReorderBuffer rb;
+    std::mt19937_64 rng(1);
+    std::vector<uint8_t> line(64, 0xab);
+    uint8_t out[64];
+
+    auto issue = [&](int w) {
+        uint64_t addr = (rng() % (1 << 20)) * 64;
+        rb.registerRequest(mem.send(addr, 64, false), w);
+    };
+    for (int w = 0; w < workers; w++) issue(w);
+
+    uint64_t start = mem.cycle(), reads = 0;
+    for (auto _ : state) {
+        uint64_t before = reads;
+        while (reads == before) {
+            mem.tick([&](const MockMem::Resp& r) {
+                int w = rb.lookUpWorkerId(r.id);
+                rb.storeResponse(r.id, line);
+                memcpy(out, rb.responseData(w), sizeof(out));
+                benchmark::DoNotOptimize(out);
+                issue(w);
+                reads++;
+            });
+        }
+    }
+    simCycles(state, mem.cycle() - start, reads);
+}
+BENCHMARK(BM_ReorderBufferRoundTrip)->Args({1, 20})->Args({8, 20})->Args({32, 100});
+
+// Store queue forwarding lookups (the read fast path when WRITE_BUFFER is
+// on) against a queue of `depth` live 8-byte writes spread over 4*depth
+// lines; about one read in thirty hits. Args: depth
+void BM_StoreQueueForward(benchmark::State& state) {
+    const size_t depth = (size_t)state.range(0);
+    StoreQueue sq;
+    sq.setDepth(depth);
+    std::mt19937_64 rng(2);
+    const uint64_t span = 4 * depth * 64;
+    uint8_t data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    for (size_t i = 0; i < depth; i++) sq.push((rng() % span) & ~7ull, 8, data, i + 1);
+
+    std::vector<uint64_t> reads(4096);
+    for (auto& a : reads) a = (rng() % span) & ~7ull;
+    uint8_t out[8];
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sq.forward(reads[i], 8, out));
+        i = (i + 1) & (reads.size() - 1);
+    }
+    state.counters["hit_rate"] = (double)sq.getForwardHits() / state.iterations();
+}
+BENCHMARK(BM_StoreQueueForward)->Arg(16)->Arg(64)->Arg(256);
+
+// Writes entering a bounded store queue and retiring on the mock memory's
+// acks; a full queue waits for the oldest ack. Args: depth, latency
+void BM_StoreQueuePushRetire(benchmark::State& state) {
+    const size_t depth = (size_t)state.range(0);
+    MockMem mem((uint64_t)state.range(1));
+    StoreQueue sq;
+    sq.setDepth(depth);
+    std::mt19937_64 rng(3);
+    uint8_t data[16] = {0};
+    auto retire = [&](const MockMem::Resp& r) { sq.retire(r.id, r.addr); };
+
+    uint64_t start = mem.cycle();
+    for (auto _ : state) {
+        while (sq.full()) mem.tick(retire);
+        uint64_t addr = (rng() % (1 << 16)) * 16;
+        sq.push(addr, 16, data, mem.send(addr, 16, true));
+        mem.tick(retire);  // one write issued per cycle
+    }
+    simCycles(state, mem.cycle() - start, state.iterations());
+}
+BENCHMARK(BM_StoreQueuePushRetire)->Args({16, 20})->Args({64, 100});
+
+// VSIDS decision loop on the in-memory activity heap: pop the most active
+// variable, bump a few others, put it back. Args: variables
+struct ActLess {
+    const std::vector<double>& act;
+    bool operator()(int a, int b) const { return act[a] > act[b]; }
+};
+
+void BM_HeapDecide(benchmark::State& state) {
+    const int n = (int)state.range(0);
+    std::vector<double> act(n);
+    std::mt19937_64 rng(4);
+    for (auto& a : act) a = (double)(rng() % 1000);
+    Heap<int, ActLess> heap{ActLess{act}};
+    for (int v = 0; v < n; v++) heap.insert(v);
+    double inc = 1.0;
+
+    for (auto _ : state) {
+        int v = heap.removeMin();
+        for (int k = 0; k < 4; k++) {
+            int u = (int)(rng() % n);
+            act[u] += inc;
+            if (heap.inHeap(u)) heap.decrease(u);
+        }
+        inc *= 1.0 / 0.95;
+        if (inc > 1e100) {
+            for (auto& a : act) a *= 1e-100;
+            inc *= 1e-100;
+        }
+        heap.insert(v);
+    }
+}
+BENCHMARK(BM_HeapDecide)->Arg(1 << 10)->Arg(1 << 17);
+
+// TraceWriter fast path, mixing strided and random addresses over the DS
+// regions. Args: codec (0 none, 1 zlib)
+void BM_TraceWriterEmitMem(benchmark::State& state) {
+    char path[] = "/tmp/satsolver_bench_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        state.SkipWithError("mkstemp failed");
+        return;
+    }
+    close(fd);
+
+    TraceWriter tw;
+    if (!tw.open(path, 4 << 20, (TraceWriter::Codec)state.range(0), 1)) {
+        state.SkipWithError("TraceWriter::open failed");
+        unlink(path);
+        return;
+    }
+    TraceWriter::DsMap m;
+    for (int i = 0; i < 8; i++) m.add((uint64_t)i << 28, (TraceWriter::DsId)i);
+    tw.setDsMap(m);
+    tw.writeHeader("bench", 0, 0, 0);
+
+    std::mt19937_64 rng(5);
+    std::vector<uint64_t> addrs(1 << 16);
+    uint64_t stride = 0;
+    for (auto& a : addrs) {
+        uint64_t ds = rng() % 8;
+        a = (ds << 28) | ((rng() & 1) ? (stride += 64) : (rng() % (1 << 24)));
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        tw.emitMem(i & 1, addrs[i], 8);
+        i = (i + 1) & (addrs.size() - 1);
+    }
+    tw.close(0);
+    state.counters["file_bytes_per_op"] = benchmark::Counter((double)tw.fileBytes(), benchmark::Counter::kAvgIterations);
+    state.counters["flush_stalls"] = (double)tw.stalls();
+    unlink(path);
+}
+BENCHMARK(BM_TraceWriterEmitMem)->Arg(0)->Arg(1);
+
+// CacheProfiler's per-access reuse sampling over a working set of `lines`
+// lines with 10% hot lines. Args: lines, sample rate in 1/1000
+void BM_ReuseSamplerAccess(benchmark::State& state) {
+    const uint64_t lines = (uint64_t)state.range(0);
+    ReuseSampler rs(state.range(1) / 1000.0);
+    std::mt19937_64 rng(6);
+    std::vector<uint64_t> stream(1 << 16);
+    for (auto& l : stream) l = (rng() % 10 == 0) ? rng() % (lines / 10 + 1) : rng() % lines;
+    size_t i = 0;
+    for (auto _ : state) {
+        uint64_t l = stream[i];
+        if (rs.sampled(l)) benchmark::DoNotOptimize(rs.access(l));
+        i = (i + 1) & (stream.size() - 1);
+    }
+}
+BENCHMARK(BM_ReuseSamplerAccess)->Args({1 << 16, 10})->Args({1 << 20, 1000});
+
+// profile_mem bookkeeping per read against the mock memory. Args: latency
+void BM_MemProfileRead(benchmark::State& state) {
+    MockMem mem((uint64_t)state.range(0));
+    MemProfile prof([&mem]() { return mem.cycle(); });
+    auto complete = [&](const MockMem::Resp& r) { prof.completeRead(r.id); };
+    uint64_t start = mem.cycle();
+    for (auto _ : state) {
+        prof.issueRead(mem.send(0x1000, 64, false), 64);
+        mem.tick(complete);
+    }
+    simCycles(state, mem.cycle() - start, state.iterations());
+}
+BENCHMARK(BM_MemProfileRead)->Arg(100);
+
+// Functional fast-forward mirror: 8-byte writes and reads over 64 MiB of
+// resident pages.
+void BM_HostMirrorWriteRead(benchmark::State& state) {
+    HostMirror mirror;
+    std::mt19937_64 rng(7);
+    std::vector<uint64_t> addrs(1 << 16);
+    for (auto& a : addrs) a = (rng() % (64 << 20)) & ~7ull;
+    uint64_t v = 0;
+    for (uint64_t a : addrs) mirror.write(a, (const uint8_t*)&v, sizeof(v), false);
+    size_t i = 0;
+    for (auto _ : state) {
+        mirror.write(addrs[i], (const uint8_t*)&v, sizeof(v));
+        mirror.read(addrs[(i * 7) & (addrs.size() - 1)], (uint8_t*)&v, sizeof(v));
+        i = (i + 1) & (addrs.size() - 1);
+    }
+    benchmark::DoNotOptimize(v);
+}
+BENCHMARK(BM_HostMirrorWriteRead);
+
+// Translation of a request address and the per-stripe count under the
+// hash layout, over the default regions with three of them interleaved.
+// Args: stripes (1 = untranslated fast path)
+void BM_AddressLayoutTranslate(benchmark::State& state) {
+    AddressLayout layout;
+    const char* names[] = { "heap", "indices", "variables", "watches",
+                            "watch_nodes", "clauses_cmd", "clauses", "var_activity" };
+    for (int i = 0; i < 8; i++) layout.addRegion(names[i], (uint64_t)i << 28, i);
+    layout.setPolicy(AddressLayout::HASH);
+    layout.setStripes(6, __builtin_ctz((unsigned)state.range(0)));
+    layout.setInterleave("variables", 64);
+    layout.setInterleave("watch_nodes", 256);
+    layout.setInterleave("clauses", 128);
+    if (!layout.finalize(64).empty()) {
+        state.SkipWithError("AddressLayout::finalize failed");
+        return;
+    }
+    std::mt19937_64 rng(8);
+    std::vector<uint64_t> addrs(1 << 16);
+    for (auto& a : addrs) a = ((rng() % 8) << 28) | ((rng() % (1 << 22)) & ~7ull);
+    size_t i = 0;
+    for (auto _ : state) {
+        uint64_t phys = layout.toPhysical(addrs[i]);
+        layout.countRequest(phys, false);
+        benchmark::DoNotOptimize(phys);
+        i = (i + 1) & (addrs.size() - 1);
+    }
+}
+BENCHMARK(BM_AddressLayoutTranslate)->Arg(1)->Arg(16);
+
+} // namespace
+
+BENCHMARK_MAIN();
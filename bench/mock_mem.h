@@ -0,0 +1,145 @@
+#ifndef MOCK_MEM_H
+#define MOCK_MEM_H
+
+#include <algorithm>
+#include <deque>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+#include <sst/core/interfaces/stdMem.h>
+
+// Fixed-latency, in-process stand-in for the memory behind a StandardMem
+// interface. Every request completes `latency` cycles after it was sent, so
+// responses come back in issue order. Request IDs count up from 1 like
+// StandardMem::Request IDs. The benchmark owns the clock: tick() advances
+// one cycle and hands out the responses due in it.
+class MockMem {
+public:
+    struct Resp {
+        uint64_t id;
+        uint64_t addr;
+        uint32_t size;
+        bool is_write;
+    };
+
+    explicit MockMem(uint64_t latency) : latency(latency), now(0), next_id(1) {}
+
+    uint64_t send(uint64_t addr, uint32_t size, bool is_write) {
+        uint64_t id = next_id++;
+        pending.push_back({now + latency, {id, addr, size, is_write}});
+        return id;
+    }
+
+    // Advance one cycle; fn(const Resp&) for each request due in it
+    template<typename Fn>
+    void tick(Fn&& fn) {
+        now++;
+        while (!pending.empty() && pending.front().due <= now) {
+            Resp r = pending.front().resp;
+            pending.pop_front();
+            fn(r);
+        }
+    }
+
+    uint64_t cycle() const { return now; }
+    size_t inFlight() const { return pending.size(); }
+
+private:
+    struct Pending {
+        uint64_t due;
+        Resp resp;
+    };
+
+    uint64_t latency;
+    uint64_t now;
+    uint64_t next_id;
+    std::deque<Pending> pending;
+};
+
+// StandardMem subclass in front of a sparse backing store, for the solver
+// structures that issue their own requests (AsyncBase, MemoryAllocator,
+// Watches and both heaps). A read returns the bytes at the time it was sent
+// and a write lands when sent; responses follow `latency` cycles later, in
+// issue order. Posted and untimed writes get no response.
+class MockStandardMem : public SST::Interfaces::StandardMem {
+public:
+    explicit MockStandardMem(uint64_t latency) : latency(latency), now(0), num_reads(0), num_writes(0) {}
+    ~MockStandardMem() override {
+        for (auto& p : pending) delete p.resp;
+    }
+
+    void send(Request* req) override {
+        if (auto* rd = dynamic_cast<Read*>(req)) {
+            auto* resp = new ReadResp(rd->getID(), rd->pAddr, rd->size, std::vector<uint8_t>(rd->size));
+            load(rd->pAddr, resp->data.data(), rd->size);
+            pending.push_back({now + latency, resp});
+            num_reads++;
+        } else if (auto* wr = dynamic_cast<Write*>(req)) {
+            store(wr->pAddr, wr->data.data(), wr->size);
+            if (wr->needsResponse()) pending.push_back({now + latency, wr->makeResponse()});
+            num_writes++;
+        }
+        delete req;
+    }
+
+    void sendUntimedData(Request* req) override {
+        if (auto* wr = dynamic_cast<Write*>(req)) store(wr->pAddr, wr->data.data(), wr->size);
+        delete req;
+    }
+
+    // Advance one cycle; fn(Request*) for each response due in it. The
+    // response is deleted after fn returns, as the solver does.
+    template<typename Fn>
+    void tick(Fn&& fn) {
+        now++;
+        while (!pending.empty() && pending.front().due <= now) {
+            Request* resp = pending.front().resp;
+            pending.pop_front();
+            fn(resp);
+            delete resp;
+        }
+    }
+
+    uint64_t cycle() const { return now; }
+    size_t inFlight() const { return pending.size(); }
+    uint64_t reads() const { return num_reads; }
+    uint64_t writes() const { return num_writes; }
+
+private:
+    static const uint64_t PAGE = 4096;
+
+    uint8_t* page(uint64_t addr) {
+        std::vector<uint8_t>& p = pages[addr / PAGE];
+        if (p.empty()) p.resize(PAGE, 0);
+        return p.data();
+    }
+    void load(uint64_t addr, uint8_t* dst, size_t size) {
+        while (size > 0) {
+            size_t n = std::min<uint64_t>(size, PAGE - addr % PAGE);
+            memcpy(dst, page(addr) + addr % PAGE, n);
+            addr += n, dst += n, size -= n;
+        }
+    }
+    void store(uint64_t addr, const uint8_t* src, size_t size) {
+        while (size > 0) {
+            size_t n = std::min<uint64_t>(size, PAGE - addr % PAGE);
+            memcpy(page(addr) + addr % PAGE, src, n);
+            addr += n, src += n, size -= n;
+        }
+    }
+
+    struct Pending {
+        uint64_t due;
+        Request* resp;
+    };
+
+    uint64_t latency;
+    uint64_t now;
+    uint64_t num_reads;
+    uint64_t num_writes;
+    std::deque<Pending> pending;
+    std::unordered_map<uint64_t, std::vector<uint8_t>> pages;
+};
+
+#endif // MOCK_MEM_H
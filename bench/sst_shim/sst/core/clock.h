@@ -0,0 +1,31 @@
+#ifndef SST_SHIM_CLOCK_H
+#define SST_SHIM_CLOCK_H
+
+#include <sst/core/event.h>
+
+namespace SST {
+
+class TimeConverter {};
+
+namespace Clock {
+
+class HandlerBase {
+public:
+    virtual ~HandlerBase() {}
+    virtual bool operator()(Cycle_t cycle) = 0;
+};
+
+template <typename classT, auto funcT>
+class Handler2 : public HandlerBase {
+public:
+    explicit Handler2(classT* obj) : obj(obj) {}
+    bool operator()(Cycle_t cycle) override { return (obj->*funcT)(cycle); }
+
+private:
+    classT* obj;
+};
+
+} // namespace Clock
+} // namespace SST
+
+#endif // SST_SHIM_CLOCK_H
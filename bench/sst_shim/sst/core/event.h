@@ -0,0 +1,30 @@
+#ifndef SST_SHIM_EVENT_H
+#define SST_SHIM_EVENT_H
+
+#include <cstdint>
+
+namespace SST {
+
+typedef uint64_t Cycle_t;
+typedef uint64_t SimTime_t;
+typedef uint64_t ComponentId_t;
+
+namespace Core {
+namespace Serialization {
+class serializer {};
+} // namespace Serialization
+} // namespace Core
+
+// Events never leave the process, so serialization is a no-op
+class Event {
+public:
+    virtual ~Event() {}
+    virtual void serialize_order(Core::Serialization::serializer& /*ser*/) {}
+};
+
+} // namespace SST
+
+#define ImplementSerializable(obj)
+#define SST_SER(obj) ((void)ser, (void)(obj))
+
+#endif // SST_SHIM_EVENT_H
@@ -0,0 +1,106 @@
+#ifndef SST_SHIM_STDMEM_H
+#define SST_SHIM_STDMEM_H
+
+#include <cstdint>
+#include <vector>
+#include <sst/core/event.h>
+
+namespace SST {
+namespace Interfaces {
+
+// The part of StandardMem the solver uses: Read/Write requests, their
+// responses, and the send paths. Responses carry the ID of their request.
+class StandardMem {
+public:
+    typedef uint64_t Addr;
+    typedef uint64_t id_t;
+    typedef uint32_t flags_t;
+
+    class Request {
+    public:
+        explicit Request(flags_t flags = 0) : id(nextId()), flags(flags) {}
+        Request(id_t rid, flags_t flags) : id(rid), flags(flags) {}
+        virtual ~Request() {}
+
+        id_t getID() { return id; }
+        bool getFail() { return false; }
+        virtual Request* makeResponse() = 0;
+        virtual bool needsResponse() = 0;
+
+    protected:
+        id_t id;
+        flags_t flags;
+
+    private:
+        static id_t nextId() {
+            static id_t next = 0;
+            return next++;
+        }
+    };
+
+    class Read;
+    class Write;
+
+    class ReadResp : public Request {
+    public:
+        ReadResp(id_t rid, Addr pAddr, uint64_t size, std::vector<uint8_t> data, flags_t flags = 0)
+            : Request(rid, flags), pAddr(pAddr), vAddr(0), size(size), data(std::move(data)) {}
+        Request* makeResponse() override { return nullptr; }
+        bool needsResponse() override { return false; }
+
+        Addr pAddr;
+        Addr vAddr;
+        uint64_t size;
+        std::vector<uint8_t> data;
+    };
+
+    class Read : public Request {
+    public:
+        Read(Addr pAddr, uint64_t size, flags_t flags = 0, Addr vAddr = 0)
+            : Request(flags), pAddr(pAddr), vAddr(vAddr), size(size) {}
+        Request* makeResponse() override {
+            return new ReadResp(id, pAddr, size, std::vector<uint8_t>(size, 0), flags);
+        }
+        bool needsResponse() override { return true; }
+
+        Addr pAddr;
+        Addr vAddr;
+        uint64_t size;
+    };
+
+    class WriteResp : public Request {
+    public:
+        WriteResp(id_t rid, Addr pAddr, uint64_t size, flags_t flags = 0)
+            : Request(rid, flags), pAddr(pAddr), vAddr(0), size(size) {}
+        Request* makeResponse() override { return nullptr; }
+        bool needsResponse() override { return false; }
+
+        Addr pAddr;
+        Addr vAddr;
+        uint64_t size;
+    };
+
+    class Write : public Request {
+    public:
+        Write(Addr pAddr, uint64_t size, std::vector<uint8_t> data, bool posted = false,
+              flags_t flags = 0, Addr vAddr = 0)
+            : Request(flags), pAddr(pAddr), vAddr(vAddr), size(size), data(std::move(data)), posted(posted) {}
+        Request* makeResponse() override { return new WriteResp(id, pAddr, size, flags); }
+        bool needsResponse() override { return !posted; }
+
+        Addr pAddr;
+        Addr vAddr;
+        uint64_t size;
+        std::vector<uint8_t> data;
+        bool posted;
+    };
+
+    virtual ~StandardMem() {}
+    virtual void send(Request* req) = 0;
+    virtual void sendUntimedData(Request* req) = 0;
+};
+
+} // namespace Interfaces
+} // namespace SST
+
+#endif // SST_SHIM_STDMEM_H
@@ -0,0 +1,81 @@
+#ifndef SST_SHIM_OUTPUT_H
+#define SST_SHIM_OUTPUT_H
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// SST::Output as the solver uses it: verbose() below the level is a no-op,
+// output() prints, fatal() exits.
+#define CALL_INFO __LINE__, __FILE__, __FUNCTION__
+
+// The rest of the arguments are fatal()'s, CALL_INFO first
+#define sst_assert(condition, ...)                                        \
+    do {                                                                  \
+        if (!(condition)) SST::Output::getDefaultObject().fatal(__VA_ARGS__); \
+    } while (0)
+
+namespace SST {
+
+class Output {
+public:
+    enum output_location_t { NONE, STDOUT, STDERR, FILE };
+
+    Output() : verbose_level(0), location(STDOUT) {}
+
+    void init(const std::string& prefix_, uint32_t verbose_level_, uint32_t /*verbose_mask*/,
+              output_location_t location_, const std::string& /*file*/ = "") {
+        prefix = prefix_;
+        verbose_level = verbose_level_;
+        location = location_;
+    }
+
+    void verbose(uint32_t /*line*/, const char* /*file*/, const char* /*func*/, uint32_t output_level,
+                 uint32_t /*output_bits*/, const char* format, ...) const {
+        if (output_level > verbose_level || location == NONE) return;
+        va_list args;
+        va_start(args, format);
+        print(format, args);
+        va_end(args);
+    }
+
+    void output(const char* format, ...) const {
+        if (location == NONE) return;
+        va_list args;
+        va_start(args, format);
+        vfprintf(stream(), format, args);
+        va_end(args);
+    }
+
+    [[noreturn]] void fatal(uint32_t line, const char* file, const char* func, int exit_code,
+                            const char* format, ...) const {
+        fprintf(stderr, "FATAL: %s%s:%u (%s): ", prefix.c_str(), file, line, func);
+        va_list args;
+        va_start(args, format);
+        vfprintf(stderr, format, args);
+        va_end(args);
+        exit(exit_code);
+    }
+
+    static Output& getDefaultObject() {
+        static Output out;
+        return out;
+    }
+
+private:
+    std::FILE* stream() const { return location == STDERR ? stderr : stdout; }
+    void print(const char* format, va_list args) const {
+        fputs(prefix.c_str(), stream());
+        vfprintf(stream(), format, args);
+    }
+
+    std::string prefix;
+    uint32_t verbose_level;
+    output_location_t location;
+};
+
+} // namespace SST
+
+#endif // SST_SHIM_OUTPUT_H
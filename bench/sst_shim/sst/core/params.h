@@ -0,0 +1,38 @@
+#ifndef SST_SHIM_PARAMS_H
+#define SST_SHIM_PARAMS_H
+
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+
+namespace SST {
+
+// String key/value parameters; find() parses the value or returns the default
+class Params {
+public:
+    void insert(const std::string& key, const std::string& value) { values[key] = value; }
+
+    template <typename T>
+    T find(const std::string& key, T default_value) const {
+        auto it = values.find(key);
+        if (it == values.end()) return default_value;
+        T value;
+        std::istringstream in(it->second);
+        in >> std::setbase(0) >> value;  // accepts 0x prefixes like SST
+        return in.fail() ? default_value : value;
+    }
+
+private:
+    std::map<std::string, std::string> values;
+};
+
+template <>
+inline std::string Params::find<std::string>(const std::string& key, std::string default_value) const {
+    auto it = values.find(key);
+    return it == values.end() ? default_value : it->second;
+}
+
+} // namespace SST
+
+#endif // SST_SHIM_PARAMS_H
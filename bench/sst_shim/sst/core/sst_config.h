@@ -0,0 +1,2 @@
+// Host-side stand-in for the SST core headers, used only to build the
+// micro-benchmarks (make bench). Nothing to configure here.
@@ -0,0 +1,59 @@
+#ifndef SST_SHIM_SUBCOMPONENT_H
+#define SST_SHIM_SUBCOMPONENT_H
+
+#include <map>
+#include <string>
+#include <sst/core/clock.h>
+#include <sst/core/event.h>
+#include <sst/core/link.h>
+#include <sst/core/output.h>
+#include <sst/core/params.h>
+
+// ELI registration only matters to the SST core
+#define SST_ELI_REGISTER_SUBCOMPONENT_API(...)
+#define SST_ELI_REGISTER_SUBCOMPONENT(...)
+#define SST_ELI_ELEMENT_VERSION(...)
+#define SST_ELI_DOCUMENT_PARAMS(...)
+#define SST_ELI_DOCUMENT_PORTS(...)
+#define SST_ELI_DOCUMENT_STATISTICS(...)
+#define SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(...)
+
+namespace SST {
+
+// The owner of a subcomponent drives its clock handler itself, so clock
+// registration is bookkeeping only. Ports are connected before construction
+// with connectPort(), as an SST config script would.
+class SubComponent {
+public:
+    explicit SubComponent(ComponentId_t id) : id(id) {}
+    virtual ~SubComponent() {}
+
+    ComponentId_t getId() const { return id; }
+
+    static void connectPort(const std::string& port, Link* link) { ports()[port] = link; }
+
+protected:
+    TimeConverter* registerClock(const std::string& /*freq*/, Clock::HandlerBase* /*handler*/) {
+        static TimeConverter tc;
+        return &tc;
+    }
+    Cycle_t reregisterClock(TimeConverter* /*tc*/, Clock::HandlerBase* /*handler*/) { return 0; }
+    void unregisterClock(TimeConverter* /*tc*/, Clock::HandlerBase* /*handler*/) {}
+
+    Link* configureLink(const std::string& port) {
+        auto it = ports().find(port);
+        return it == ports().end() ? nullptr : it->second;
+    }
+
+private:
+    static std::map<std::string, Link*>& ports() {
+        static std::map<std::string, Link*> connected;
+        return connected;
+    }
+
+    ComponentId_t id;
+};
+
+} // namespace SST
+
+#endif // SST_SHIM_SUBCOMPONENT_H
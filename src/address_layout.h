@@ -0,0 +1,182 @@
+#ifndef ADDRESS_LAYOUT_H
+#define ADDRESS_LAYOUT_H
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+
+// Region table of the solver's data structures and the mapping from their
+// logical addresses, where each structure is one array at its base, to the
+// physical addresses sent to memory. An address belongs to the region with
+// the highest base at or below it.
+//
+// The memory's address mapping picks a channel/bank stripe from stripe_bits
+// address bits starting at stripe_shift. A region interleaved at G bytes
+// moves the address bits just above G into that field, so consecutive
+// G-byte chunks of the region go to consecutive stripes; hashing further
+// XORs the field with a fold of the bits above it. Both only permute chunks
+// within aligned spans that never cross a region boundary, so a translated
+// address stays in its region and keeps its offset within the chunk, and
+// toLogical() undoes toPhysical(). Regions without a granularity, and every
+// region under the linear policy, are not translated.
+class AddressLayout {
+public:
+    enum Policy { LINEAR, INTERLEAVE, HASH };
+
+    struct Region {
+        std::string name;
+        uint64_t base;
+        uint64_t end;       // base of the next region, ~0 for the last
+        int id;             // owner's tag, e.g. a TraceWriter::DsId
+        int chunk_bits;     // log2 of the interleave granularity, 0 = not translated
+    };
+
+    AddressLayout() : policy(LINEAR), stripe_shift(6), stripe_bits(0), active(false) {}
+
+    void setPolicy(Policy p) { policy = p; }
+    Policy getPolicy() const { return policy; }
+    void setStripes(int shift, int bits) { stripe_shift = shift; stripe_bits = bits; }
+    int numStripes() const { return 1 << stripe_bits; }
+
+    void addRegion(const std::string& name, uint64_t base, int id) {
+        Region r{name, base, ~0ull, id, 0};
+        regions.insert(std::upper_bound(regions.begin(), regions.end(), base,
+            [](uint64_t b, const Region& x) { return b < x.base; }), r);
+    }
+
+    // Interleave granularity of the named region in bytes; false if there
+    // is no such region or bytes is not a power of two
+    bool setInterleave(const std::string& name, uint64_t bytes) {
+        if (bytes == 0 || (bytes & (bytes - 1))) return false;
+        for (Region& r : regions) {
+            if (r.name != name) continue;
+            r.chunk_bits = __builtin_ctzll(bytes);
+            return true;
+        }
+        return false;
+    }
+
+    // Sets the region ends and checks that every translated region is made
+    // of whole spans and moves whole lines. Returns an error message, empty
+    // if the layout is usable.
+    std::string finalize(uint64_t line_size) {
+        int line_bits = __builtin_ctzll(line_size);
+        active = false;
+        for (size_t i = 0; i < regions.size(); i++) {
+            Region& r = regions[i];
+            r.end = i + 1 < regions.size() ? regions[i + 1].base : ~0ull;
+            if (r.end == r.base) return "regions " + regions[i + 1].name + " and " + r.name + " share a base address";
+            if (policy == LINEAR || stripe_bits == 0 || r.chunk_bits == 0) continue;
+            if (r.chunk_bits < line_bits || stripe_shift < line_bits)
+                return r.name + ": interleave granularity and stripe field must not split a cache line";
+            uint64_t span = 1ull << spanHi(r);
+            if (r.base % span || (r.end != ~0ull && r.end % span))
+                return r.name + ": region must be aligned to its " + std::to_string(span) + "-byte interleave span";
+            active = true;
+        }
+        return "";
+    }
+
+    // false when no request is translated, the common fast path
+    bool translates() const { return active; }
+
+    const std::vector<Region>& regionTable() const { return regions; }
+    const Region* find(uint64_t addr) const {
+        auto it = std::upper_bound(regions.begin(), regions.end(), addr,
+            [](uint64_t a, const Region& x) { return a < x.base; });
+        return it == regions.begin() ? nullptr : &*std::prev(it);
+    }
+    // Region id of addr, or fallback outside every region
+    int classify(uint64_t addr, int fallback = -1) const {
+        const Region* r = find(addr);
+        return r ? r->id : fallback;
+    }
+
+    uint64_t toPhysical(uint64_t addr) const {
+        if (!active) return addr;
+        const Region* r = find(addr);
+        if (!translated(r)) return addr;
+        addr = rotate(addr, *r, true);
+        return policy == HASH ? addr ^ (fold(addr >> spanHi(*r)) << stripe_shift) : addr;
+    }
+    uint64_t toLogical(uint64_t addr) const {
+        if (!active) return addr;
+        const Region* r = find(addr);
+        if (!translated(r)) return addr;
+        if (policy == HASH) addr ^= fold(addr >> spanHi(*r)) << stripe_shift;
+        return rotate(addr, *r, false);
+    }
+
+    // Bytes from addr up to the next logical address that is not physically
+    // adjacent to its predecessor; requests must not cross it
+    uint64_t contiguousBytes(uint64_t addr) const {
+        if (!active) return ~0ull;
+        const Region* r = find(addr);
+        if (!translated(r)) return r && r->end != ~0ull ? r->end - addr : ~0ull;
+        uint64_t chunk = 1ull << std::min(r->chunk_bits, stripe_shift);
+        return chunk - (addr & (chunk - 1));
+    }
+    bool contiguous(uint64_t addr, uint64_t size) const {
+        return !active || contiguousBytes(addr) >= size;
+    }
+    // Size of the aligned span around addr that maps onto itself, 0 if addr
+    // is not translated
+    uint64_t spanBytes(uint64_t addr) const {
+        if (!active) return 0;
+        const Region* r = find(addr);
+        return translated(r) ? 1ull << spanHi(*r) : 0;
+    }
+
+    // Stripe a physical address falls in, and of a logical address once mapped
+    int stripeOf(uint64_t phys) const { return (int)((phys >> stripe_shift) & (numStripes() - 1)); }
+    int stripeOfLogical(uint64_t addr) const { return stripeOf(toPhysical(addr)); }
+
+    // Requests sent to memory, by stripe
+    void countRequest(uint64_t phys, bool is_write) {
+        if (stripe_reads.empty()) {
+            stripe_reads.assign(numStripes(), 0);
+            stripe_writes.assign(numStripes(), 0);
+        }
+        (is_write ? stripe_writes : stripe_reads)[stripeOf(phys)]++;
+    }
+    uint64_t stripeReads(int s) const { return s < (int)stripe_reads.size() ? stripe_reads[s] : 0; }
+    uint64_t stripeWrites(int s) const { return s < (int)stripe_writes.size() ? stripe_writes[s] : 0; }
+
+private:
+    bool translated(const Region* r) const { return r && r->chunk_bits > 0 && policy != LINEAR; }
+
+    // The bits [lo, hi) below are the span rotated to move the chunk index
+    // into the stripe field; bits at and above hi are left alone
+    int spanLo(const Region& r) const { return std::min(r.chunk_bits, stripe_shift); }
+    int spanHi(const Region& r) const { return std::max(r.chunk_bits, stripe_shift) + stripe_bits; }
+
+    uint64_t rotate(uint64_t addr, const Region& r, bool forward) const {
+        int lo = spanLo(r), n = spanHi(r) - lo, b = stripe_bits;
+        if (r.chunk_bits == stripe_shift) return addr;
+        uint64_t mask = (1ull << n) - 1;
+        uint64_t w = (addr >> lo) & mask;
+        // chunk below the stripe field: its low bits rotate up into it
+        bool up = (r.chunk_bits < stripe_shift) == forward;
+        w = up ? (w >> b) | ((w << (n - b)) & mask)
+               : ((w << b) & mask) | (w >> (n - b));
+        return (addr & ~(mask << lo)) | (w << lo);
+    }
+
+    // XOR of the stripe_bits wide groups of x
+    uint64_t fold(uint64_t x) const {
+        uint64_t f = 0, mask = (1ull << stripe_bits) - 1;
+        for (; x; x >>= stripe_bits) f ^= x & mask;
+        return f;
+    }
+
+    Policy policy;
+    int stripe_shift;
+    int stripe_bits;
+    bool active;
+    std::vector<Region> regions;   // ascending base
+    std::vector<uint64_t> stripe_reads;
+    std::vector<uint64_t> stripe_writes;
+};
+
+#endif // ADDRESS_LAYOUT_H
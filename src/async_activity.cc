@@ -3,10 +3,8 @@
 
 double Activity::readAct(size_t idx, int worker_id) {
     output.verbose(CALL_INFO, 7, 0, "Read activity at index %zu\n", idx);
-    read(calcAddr(idx), sizeof(double), worker_id);
-
     double value;
-    memcpy(&value, reorder_buffer->getResponse(worker_id).data(), sizeof(double));
+    readInto(calcAddr(idx), &value, 1, worker_id);
     return value;
 }
 
@@ -16,17 +14,13 @@ std::vector<double> Activity::readBurstAct(size_t start, size_t count, int worke
                         start, count, size_);
     }
     std::vector<double> result(count);
-    readBurst(calcAddr(start), count * sizeof(double), worker_id);
-
-    memcpy(result.data(), reorder_buffer->getResponse(worker_id).data(), count * sizeof(double));
+    readBurstInto(calcAddr(start), result.data(), count, worker_id);
     return result;
 }
 
 void Activity::push(double value) {
     output.verbose(CALL_INFO, 7, 0, "Push new value %f at index %zu\n", value, size_);
-    std::vector<uint8_t> buffer(sizeof(double));
-    memcpy(buffer.data(), &value, sizeof(double));
-    write(calcAddr(size_), sizeof(double), buffer);
+    writeFrom(calcAddr(size_), &value);
     
     size_++;
 }
@@ -39,9 +33,7 @@ void Activity::rescaleAll(double factor, int worker_id) {
     }
     
     // Write back
-    std::vector<uint8_t> buffer(size_ * sizeof(double));
-    memcpy(buffer.data(), values.data(), buffer.size());
-    writeBurst(calcAddr(0), buffer);
+    writeBurstFrom(calcAddr(0), values.data(), size_);
 }
 
 void Activity::reduceDB(const std::vector<double>& activities, const std::vector<bool>& to_remove) {
@@ -52,9 +44,7 @@ void Activity::reduceDB(const std::vector<double>& activities, const std::vector
     }
     
     // Bulk write compacted activities back
-    std::vector<uint8_t> buffer(compacted.size() * sizeof(double));
-    memcpy(buffer.data(), compacted.data(), buffer.size());
-    writeBurst(calcAddr(0), buffer);
+    writeBurstFrom(calcAddr(0), compacted.data(), compacted.size());
 
     size_ = compacted.size();
     output.verbose(CALL_INFO, 7, 0, "ACTIVITY: Reduced from %zu to %zu\n", activities.size(), size_);
@@ -15,9 +15,7 @@ public:
 
         // Assignment operator for writing
         ActivityProxy& operator=(double value) {
-            std::vector<uint8_t> buffer(sizeof(double));
-            memcpy(buffer.data(), &value, sizeof(double));
-            parent->write(parent->calcAddr(idx), sizeof(double), buffer);
+            parent->writeFrom(parent->calcAddr(idx), &value);
             return *this;
         }
     };
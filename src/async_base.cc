@@ -1,11 +1,6 @@
 #include <sst/core/sst_config.h>
 #include "async_base.h"
 
-// Forward declaration of internal helper defined later in this file.
-static bool sq_try_forward(const std::vector<StoreQueueEntry>& sq,
-                            uint64_t addr, size_t size,
-                            std::vector<uint8_t>& out_data);
-
 AsyncBase::AsyncBase(const std::string& prefix, int verbose, SST::Interfaces::StandardMem* mem,
                      coro_t::push_type** yield_ptr)
     : memory(mem), yield_ptr(yield_ptr), pre_yield_callback(nullptr), line_size(64), size_(0) {
@@ -13,98 +8,120 @@ AsyncBase::AsyncBase(const std::string& prefix, int verbose, SST::Interfaces::St
 }
 
 void AsyncBase::read(uint64_t addr, size_t size, uint64_t worker_id) {
+    if (functional_) {
+        mirror_->read(addr, reorder_buffer->prepare(worker_id, size), size);
+        return;
+    }
+    if (layout_ && !layout_->contiguous(addr, size)) {
+        // the parts land apart in memory, so read it line by line
+        readBurst(addr, size, worker_id);
+        return;
+    }
     if (tracer_) tracer_->emitMem(false, addr, (uint32_t)size);
     if (WRITE_BUFFER) {
-        std::vector<uint8_t> forwarded_data;
-        if (sq_try_forward(store_queue, addr, size, forwarded_data)) {
-            reorder_buffer->storeDataByWorkerId(worker_id, forwarded_data);
+        // forward straight into the worker's response slot
+        if (store_queue.forward(addr, size, reorder_buffer->reserve(worker_id, size))) {
+            reorder_buffer->markValid(worker_id);
             return;
         }
+        waitStoreQueue(worker_id);
     }
 
     // Not found in store queue, create memory request
     auto req = new SST::Interfaces::StandardMem::Read(addr, size);
-    reorder_buffer->registerRequest(req->getID(), worker_id);
-    memory->send(req);
+    uint64_t req_id = req->getID();
+    reorder_buffer->registerRequest(req_id, worker_id);
+    sendRead(req);
     output.verbose(CALL_INFO, 8, 0, "Read at 0x%lx, size %zu, worker %lu, req %lu\n", 
-                   addr, size, worker_id, req->getID());
+                   addr, size, worker_id, req_id);
     doYield();
 }
 
 void AsyncBase::write(uint64_t addr, size_t size, const std::vector<uint8_t>& data) {
+    assert(data.size() >= size);
+    writeBytes(addr, data.data(), size);
+}
+
+void AsyncBase::writeBytes(uint64_t addr, const uint8_t* data, size_t size) {
+    if (functional_) {
+        mirror_->write(addr, data, size);
+        return;
+    }
+    if (layout_ && !layout_->contiguous(addr, size)) {
+        writeBurstBytes(addr, data, size);
+        return;
+    }
     output.verbose(CALL_INFO, 8, 0, "Write at 0x%lx, size %zu\n", addr, size);
+    if (mirror_) mirror_->write(addr, data, size, false);  // stays current for the next fast-forward
     if (tracer_) tracer_->emitMem(true, addr, (uint32_t)size);
 
+    // StandardMem::Write owns its payload vector; this is the only copy made
+    auto req = new SST::Interfaces::StandardMem::Write(
+        addr, size, std::vector<uint8_t>(data, data + size));
     if (WRITE_BUFFER) {
         // Always add a new entry to the store queue
-        StoreQueueEntry entry(addr, size, data);
-        store_queue.push_back(entry);
+        store_queue.push(addr, size, data, req->getID());
         output.verbose(CALL_INFO, 7, 0, 
             "SQ[%zu]: [0x%lx-0x%lx], size %zu\n",
-            store_queue.size() - 1, addr, addr + size - 1, size);
+            store_queue.occupancy() - 1, addr, addr + size - 1, size);
     }
 
     // Send to memory
-    memory->send(new SST::Interfaces::StandardMem::Write(addr, size, data));
+    if (mem_profile_) mem_profile_->issueWrite(size);
+    sendWrite(req);
     // doYield();
 }
 
 void AsyncBase::writeUntimed(uint64_t addr, size_t size, const std::vector<uint8_t>& data) {
     output.verbose(CALL_INFO, 8, 0, "Untimed write at 0x%lx, size %zu\n", addr, size);
-    memory->sendUntimedData(new SST::Interfaces::StandardMem::Write(
-        addr, size, data, true, 0x1)); // posted, not cacheable
-}
-
-// Helper: try to forward [addr, addr+size) from the store queue.
-// Conservative: forwards iff some single SQ entry fully covers the read
-// (same set as the OLD code). When a covering entry exists, also checks for
-// any newer overlapping entries; if found, merges their bytes on top so the
-// returned data is never stale. This preserves the OLD forwarding rate and
-// data exactly when no newer partial overlap exists, avoiding unintended
-// timing shifts on well-behaved tests.
-static bool sq_try_forward(const std::vector<StoreQueueEntry>& sq,
-                            uint64_t addr, size_t size,
-                            std::vector<uint8_t>& out_data) {
-    uint64_t read_end = addr + size;
-
-    // Newest→oldest: find the first covering entry, while remembering whether
-    // any newer entry partially overlapped our read range.
-    bool saw_overlap = false;
-    int cov = -1;
-    for (int i = sq.size() - 1; i >= 0; i--) {
-        uint64_t sq_start = sq[i].addr;
-        uint64_t sq_end   = sq_start + sq[i].size;
-        if (addr >= sq_start && read_end <= sq_end) { cov = i; break; }
-        if (std::max(addr, sq_start) < std::min(read_end, sq_end)) {
-            saw_overlap = true;
-        }
+    if (mirror_) mirror_->write(addr, data.data(), size, false);
+    if (!layout_ || layout_->contiguous(addr, size)) {
+        sendUntimed(layout_ ? layout_->toPhysical(addr) : addr, data.data(), size);
+        return;
     }
-    if (cov < 0) return false;  // no covering entry → not forwardable (same as OLD)
-
-    // Base: bytes from the covering entry (the OLD result).
-    out_data.assign(size, 0);
-    memcpy(out_data.data(), sq[cov].data.data() + (addr - sq[cov].addr), size);
-
-    // Fast path: no newer overlap → return as-is, identical to OLD.
-    if (!saw_overlap) return true;
-
-    // Slow path: overlay newer overlapping entries on top, newest-wins.
-    std::vector<bool> written(size, false);
-    for (int j = sq.size() - 1; j > cov; j--) {
-        uint64_t js = sq[j].addr;
-        uint64_t je = js + sq[j].size;
-        uint64_t os = std::max(addr, js);
-        uint64_t oe = std::min(read_end, je);
-        if (os >= oe) continue;
-        for (uint64_t b = os; b < oe; b++) {
-            size_t dst = b - addr;
-            if (!written[dst]) {
-                out_data[dst] = sq[j].data[b - js];
-                written[dst] = true;
+
+    // Whole interleave spans map onto themselves and go out permuted in one
+    // write; the partial ones at either end go chunk by chunk
+    size_t done = 0;
+    while (done < size) {
+        uint64_t at = addr + done;
+        uint64_t span = layout_->spanBytes(at);
+        if (span > 0 && at % span == 0 && size - done >= span) {
+            span_buf_.resize(span);
+            for (uint64_t off = 0; off < span; ) {
+                uint64_t n = layout_->contiguousBytes(at + off);
+                memcpy(span_buf_.data() + (layout_->toPhysical(at + off) - at), &data[done + off], n);
+                off += n;
             }
+            sendUntimed(at, span_buf_.data(), span);
+            done += span;
+        } else {
+            size_t n = std::min<uint64_t>(layout_->contiguousBytes(at), size - done);
+            sendUntimed(layout_->toPhysical(at), &data[done], n);
+            done += n;
         }
     }
-    return true;
+}
+
+void AsyncBase::sendUntimed(uint64_t phys, const uint8_t* data, size_t size) {
+    if (preloader_) {
+        preloader_->write(memory, phys, data, size);
+        return;
+    }
+    memory->sendUntimedData(new SST::Interfaces::StandardMem::Write(
+        phys, size, std::vector<uint8_t>(data, data + size), true, 0x1)); // posted, not cacheable
+}
+
+void AsyncBase::waitStoreQueue(uint64_t worker_id) {
+    if (!store_queue.full()) return;
+    store_queue.countStall();
+    output.verbose(CALL_INFO, 7, 0, "SQ full (%zu entries), worker %lu stalls\n",
+                   store_queue.occupancy(), worker_id);
+    // woken through takeStoreQueueWaiters() once a write retires
+    while (store_queue.full()) {
+        sq_waiters.push_back((int)worker_id);
+        doYield();
+    }
 }
 
 std::vector<AsyncBase::CacheChunk> AsyncBase::calculateCacheChunks(uint64_t start_addr, size_t total_size) {
@@ -126,6 +143,12 @@ std::vector<AsyncBase::CacheChunk> AsyncBase::calculateCacheChunks(uint64_t star
 }
 
 void AsyncBase::readBurst(uint64_t start_addr, size_t total_size, uint64_t worker_id) {
+    if (functional_) {
+        reorder_buffer->startBurst(worker_id, total_size);
+        mirror_->read(start_addr, reorder_buffer->burstBuffer(worker_id), total_size);
+        return;
+    }
+
     auto chunks = calculateCacheChunks(start_addr, total_size);
     
     // Create/update burst state for this worker
@@ -136,6 +159,7 @@ void AsyncBase::readBurst(uint64_t start_addr, size_t total_size, uint64_t worke
     
     // Initialize buffer for the complete burst read
     reorder_buffer->startBurst(worker_id, total_size);
+    if (WRITE_BUFFER) waitStoreQueue(worker_id);
 
     for (const auto& chunk : chunks) {
         output.verbose(CALL_INFO, 8, 0,
@@ -145,9 +169,8 @@ void AsyncBase::readBurst(uint64_t start_addr, size_t total_size, uint64_t worke
         if (tracer_) tracer_->emitMem(false, chunk.addr, (uint32_t)chunk.size);
 
         if (WRITE_BUFFER) {
-            std::vector<uint8_t> forwarded_data;
-            if (sq_try_forward(store_queue, chunk.addr, chunk.size, forwarded_data)) {
-                reorder_buffer->storeDataByWorkerId(worker_id, forwarded_data, true, chunk.offset_in_data);
+            uint8_t* dst = reorder_buffer->burstBuffer(worker_id) + chunk.offset_in_data;
+            if (store_queue.forward(chunk.addr, chunk.size, dst)) {
                 if (--worker_state.pending_read_count == 0) worker_state.completed = true;
                 continue;
             }
@@ -157,7 +180,7 @@ void AsyncBase::readBurst(uint64_t start_addr, size_t total_size, uint64_t worke
         auto req = new SST::Interfaces::StandardMem::Read(chunk.addr, chunk.size);
         uint64_t req_id = req->getID();
         reorder_buffer->registerRequest(req_id, worker_id);
-        memory->send(req);
+        sendRead(req);
     }
     
     // Wait for this worker's burst read to complete
@@ -173,25 +196,43 @@ void AsyncBase::readBurst(uint64_t start_addr, size_t total_size, uint64_t worke
 }
 
 void AsyncBase::writeBurst(uint64_t start_addr, const std::vector<uint8_t>& data) {
-    auto chunks = calculateCacheChunks(start_addr, data.size());
+    writeBurstBytes(start_addr, data.data(), data.size());
+}
+
+void AsyncBase::writeBurstBytes(uint64_t start_addr, const uint8_t* data, size_t size) {
+    auto chunks = calculateCacheChunks(start_addr, size);
     
     for (const auto& chunk : chunks) {
         output.verbose(CALL_INFO, 8, 0, 
             "WriteBurst chunk: addr=0x%lx, size=%zu, offset=%zu\n", 
             chunk.addr, chunk.size, chunk.offset_in_data);
         
-        std::vector<uint8_t> chunk_data(chunk.size);
-        memcpy(chunk_data.data(), data.data() + chunk.offset_in_data, chunk.size);
-        
-        write(chunk.addr, chunk.size, chunk_data);
+        writeBytes(chunk.addr, data + chunk.offset_in_data, chunk.size);
     }
 }
 
+// End of fast-forward: stream the lines written while functional into
+// memory, line by line like any other writer. Returns the bytes written.
+uint64_t AsyncBase::materialize() {
+    assert(functional_);
+    functional_ = false;
+    uint64_t bytes = mirror_->dirtyBytes();
+    mirror_->takeDirty([this](uint64_t addr, const uint8_t* data, size_t size) {
+        for (const auto& chunk : calculateCacheChunks(addr, size)) {
+            if (WRITE_BUFFER) waitStoreQueue(0);
+            writeBytes(chunk.addr, data + chunk.offset_in_data, chunk.size);
+        }
+    });
+    output.verbose(CALL_INFO, 1, 0, "Materialized %lu bytes\n", bytes);
+    return bytes;
+}
+
 void AsyncBase::handleMem(SST::Interfaces::StandardMem::Request* req) {
     if (auto* resp = dynamic_cast<SST::Interfaces::StandardMem::ReadResp*>(req)) {
         uint64_t addr = resp->pAddr;
         uint64_t req_id = resp->getID();
         int worker_id = reorder_buffer->lookUpWorkerId(req_id);
+        if (mem_profile_) mem_profile_->completeRead(req_id);
         
         output.verbose(CALL_INFO, 8, 0, "handleMem response for 0x%lx, req_id %lu, worker %d\n", 
                       addr, req_id, worker_id);
@@ -213,14 +254,8 @@ void AsyncBase::handleMem(SST::Interfaces::StandardMem::Request* req) {
         if (!WRITE_BUFFER) return;
 
         uint64_t addr = write_resp->pAddr;
-        
-        // Find and remove the oldest matching store queue entry by address (front of queue)
-        for (auto it = store_queue.begin(); it != store_queue.end(); ++it) {
-            if (it->addr == addr) {
-                output.verbose(CALL_INFO, 7, 0, "SQ removing 0x%lx\n", it->addr);
-                store_queue.erase(it);
-                break;
-            }
+        if (store_queue.retire(write_resp->getID(), addr)) {
+            output.verbose(CALL_INFO, 7, 0, "SQ removing 0x%lx\n", addr);
         }
     }
     // req will be deleted by the caller in SATSolver::handleGlobalMemEvent
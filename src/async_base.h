@@ -8,9 +8,15 @@
 #include <cstring>
 #include <functional>
 #include <unordered_map>
+#include <memory>
 #include "structs.h"
 #include "reorder_buffer.h"
+#include "store_queue.h"
 #include "trace_writer.h"
+#include "untimed_preloader.h"
+#include "host_mirror.h"
+#include "mem_profile.h"
+#include "address_layout.h"
 
 
 class AsyncBase {
@@ -21,29 +27,102 @@ public:
     AsyncBase(const std::string& prefix, int verbose, SST::Interfaces::StandardMem* mem, 
               coro_t::push_type** yield_ptr = nullptr);
     virtual ~AsyncBase() = default;
+    AsyncBase(AsyncBase&&) = default;
+    AsyncBase& operator=(AsyncBase&&) = default;
 
     // Core memory operations
     void read(uint64_t addr, size_t size, uint64_t worker_id = 0);
     void write(uint64_t addr, size_t size, const std::vector<uint8_t>& data);
+    void writeBytes(uint64_t addr, const uint8_t* data, size_t size);
     void writeUntimed(uint64_t addr, size_t size, const std::vector<uint8_t>& data);
     
     // Cache-aware burst operations
     void readBurst(uint64_t start_addr, size_t total_size, uint64_t worker_id = 0);
     void writeBurst(uint64_t start_addr, const std::vector<uint8_t>& data);
+    void writeBurstBytes(uint64_t start_addr, const uint8_t* data, size_t size);
+
+    // Typed helpers: read count elements of T into out / write them from src.
+    // The response is copied straight out of the worker's reorder buffer slot,
+    // so no intermediate vectors are created on the read path.
+    template<typename T>
+    void readInto(uint64_t addr, T* out, size_t count = 1, uint64_t worker_id = 0) {
+        read(addr, sizeof(T) * count, worker_id);
+        memcpy(out, reorder_buffer->responseData(worker_id), sizeof(T) * count);
+    }
+    template<typename T>
+    void readBurstInto(uint64_t addr, T* out, size_t count, uint64_t worker_id = 0) {
+        readBurst(addr, sizeof(T) * count, worker_id);
+        memcpy(out, reorder_buffer->responseData(worker_id), sizeof(T) * count);
+    }
+    template<typename T>
+    void writeFrom(uint64_t addr, const T* src, size_t count = 1) {
+        writeBytes(addr, reinterpret_cast<const uint8_t*>(src), sizeof(T) * count);
+    }
+    template<typename T>
+    void writeBurstFrom(uint64_t addr, const T* src, size_t count) {
+        writeBurstBytes(addr, reinterpret_cast<const uint8_t*>(src), sizeof(T) * count);
+    }
     
     // Memory response handling
     virtual void handleMem(SST::Interfaces::StandardMem::Request* req);
     
     // Configuration
-    void setLineSize(size_t size) { line_size = size; }
+    void setLineSize(size_t size) { line_size = size; store_queue.setLineSize(size); }
+    void setStoreQueueDepth(size_t depth) { store_queue.setDepth(depth); }
+    const StoreQueue& storeQueue() const { return store_queue; }
+    // Workers that stalled on a full store queue and may retry now
+    bool takeStoreQueueWaiters(std::vector<int>& out) {
+        if (sq_waiters.empty() || store_queue.full()) return false;
+        out.swap(sq_waiters);
+        sq_waiters.clear();
+        return true;
+    }
     void setPreYieldCallback(PreYieldCallback cb) { pre_yield_callback = cb; }
     virtual void setReorderBuffer(ReorderBuffer* rb) { reorder_buffer = rb; }
     void setTracer(TraceWriter* t, uint8_t ds_id) { tracer_ = t; ds_id_ = ds_id; }
+    void setPreloader(UntimedPreloader* p) { preloader_ = p; }
+    // Logical to physical translation of the requests sent (shared, not
+    // owned); responses are handed back with logical addresses
+    void setLayout(AddressLayout* l) { layout_ = l; }
+
+    // Memory latency / MLP / bandwidth instrumentation, off unless enabled;
+    // clock returns the owner's current cycle
+    void enableMemProfile(MemProfile::Clock clock) { mem_profile_.reset(new MemProfile(clock)); }
+    const MemProfile* memProfile() const { return mem_profile_.get(); }
+
+    // Functional fast-forward. enableMirror() must come before the untimed
+    // initialization so the mirror starts out equal to memory. While
+    // functional, reads are served from the mirror without yielding and
+    // writes only update it; materialize() then writes the lines dirtied
+    // since into memory as timed writes (from a coroutine, it may stall on
+    // the store queue) and timed operation resumes.
+    void enableMirror() { mirror_.reset(new HostMirror()); }
+    void setFunctional(bool on) { assert(!on || mirror_); functional_ = on; }
+    bool functional() const { return functional_; }
+    uint64_t materialize();
     size_t size() const { return size_; }
     bool empty() const { return size_ == 0; }
     void reset() { burst_states.clear(); }
 
 protected:
+    // Every timed request leaves through these; a data structure with a
+    // local store in front of memory overrides them and passes the rest on
+    virtual void sendRead(SST::Interfaces::StandardMem::Read* req) {
+        if (mem_profile_) mem_profile_->issueRead(req->getID(), req->size);  // past any local store
+        req->pAddr = toMemory(req->pAddr, false);
+        memory->send(req);
+    }
+    virtual void sendWrite(SST::Interfaces::StandardMem::Write* req) {
+        req->pAddr = toMemory(req->pAddr, true);
+        memory->send(req);
+    }
+    uint64_t toMemory(uint64_t addr, bool is_write) {
+        if (!layout_) return addr;
+        uint64_t phys = layout_->toPhysical(addr);
+        layout_->countRequest(phys, is_write);
+        return phys;
+    }
+
     // Helper method to perform the yield operation
     void doYield() {
         if (pre_yield_callback) pre_yield_callback();
@@ -57,6 +136,15 @@ protected:
         size_t size;
     };
     std::vector<CacheChunk> calculateCacheChunks(uint64_t start_addr, size_t total_size);
+
+    // Untimed write of physically contiguous bytes
+    void sendUntimed(uint64_t phys, const uint8_t* data, size_t size);
+
+    // Upper bound on the staging buffer of a streamed untimed initialization
+    static const size_t INIT_BATCH_BYTES = 4 << 20;
+
+    // Block the calling worker until the store queue has a free slot
+    void waitStoreQueue(uint64_t worker_id);
     
     // Per-worker burst read state tracking
     struct BurstReadState {
@@ -83,11 +171,24 @@ protected:
     ReorderBuffer* reorder_buffer;
 
     // Store queue for Write->Read ordering
-    std::vector<StoreQueueEntry> store_queue;
+    StoreQueue store_queue;
+    std::vector<int> sq_waiters;  // workers stalled on a full store queue
 
     // Trace writer (shared, not owned). ds_id_ is set via setTracer.
     TraceWriter* tracer_ = nullptr;
     uint8_t ds_id_ = TraceWriter::DS_UNKNOWN;
+
+    // Coalescing sink for untimed writes (shared, not owned). Null sends directly.
+    UntimedPreloader* preloader_ = nullptr;
+
+    AddressLayout* layout_ = nullptr;
+    std::vector<uint8_t> span_buf_;  // one interleave span, for untimed writes
+
+    // Host copy of this structure's memory, only with fast-forward
+    std::unique_ptr<HostMirror> mirror_;
+    bool functional_ = false;
+
+    std::unique_ptr<MemProfile> mem_profile_;
 };
 
 #endif // ASYNC_BASE_H
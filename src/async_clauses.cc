@@ -8,7 +8,9 @@ Clauses::Clauses(int verbose, SST::Interfaces::StandardMem* mem,
       clauses_cmd_base_addr(clauses_cmd_base_addr),
       clauses_base_addr(clauses_base_addr),
       num_orig_clauses(0), learnt_offset(0),
-      allocator(verbose, clauses_base_addr, 0x0FFFFFFF) {
+      allocator(verbose, clauses_base_addr, 0x0FFFFFFF), verbose(verbose),
+      core_bytes(0), mid_bytes(0), core_end(0), mid_end(0), region_spills(0),
+      scratchpad(nullptr), placement(PLACE_PACKED) {
     
     output.verbose(CALL_INFO, 1, 0, "base addresses: "
         "cmd=0x%lx, data=0x%lx\n", clauses_cmd_base_addr, clauses_base_addr);
@@ -19,98 +21,248 @@ void Clauses::writeAddr(uint32_t idx, const Cref& addr) {
     if (idx >= size_ + 1) { // Allow writing at size_ for adding new clauses
         output.fatal(CALL_INFO, -1, "Invalid clause index for metadata write: %d\n", idx);
     }
-    std::vector<uint8_t> buffer(sizeof(Cref));
-    memcpy(buffer.data(), &addr, sizeof(Cref));
-    write(cmdAddr(idx), sizeof(Cref), buffer);
+    writeFrom(cmdAddr(idx), &addr);
 }
 
 // get the number of literals in a clause from clause address
 uint32_t Clauses::getClauseSize(Cref addr, int worker_id) {
-    read(clauseAddr(addr) + offsetof(Clause, num_lits), sizeof(uint32_t), worker_id);
+    return headerLits(readHeader(addr, worker_id));
+}
+
+// size word with the learnt metadata (see clauseHeader)
+uint32_t Clauses::readHeader(Cref addr, int worker_id) {
+    uint32_t header;
+    readInto(clauseAddr(addr) + offsetof(Clause, num_lits), &header, 1, worker_id);
+    return header;
+}
+
+void Clauses::writeHeader(Cref addr, uint32_t header) {
+    writeFrom(clauseAddr(addr) + offsetof(Clause, num_lits), &header);
+}
 
-    uint32_t size;
-    memcpy(&size, reorder_buffer->getResponse(worker_id).data(), sizeof(uint32_t));
-    return size;
+// size, activity and watched literals of a clause in a single read
+void Clauses::readSummary(Cref addr, ClauseSummary& out, int worker_id) {
+    readInto(clauseAddr(addr), &out, 1, worker_id);
 }
 
 // read the clause literals from clause address
 Clause Clauses::readClause(Cref addr, int worker_id) {
-    uint32_t num_lits = getClauseSize(addr, worker_id);
+    Clause c;
+    readClause(addr, c, worker_id);
+    return c;
+}
+
+// read into an existing clause, reusing its literal storage
+void Clauses::readClause(Cref addr, Clause& c, int worker_id) {
+    uint32_t header = readHeader(addr, worker_id);
+    uint32_t num_lits = headerLits(header);
     assert(num_lits >= 2);
     
     // Read the rest of clause data (activity + literals)
     readBurst(clauseAddr(addr + offsetof(Clause, activity)), CLAUSE_MEMBER_SIZE * (num_lits + 1), worker_id);
 
-    const uint8_t* data = reorder_buffer->getResponse(worker_id).data();
+    const uint8_t* data = reorder_buffer->responseData(worker_id);
     
-    Clause c(num_lits);
+    c.setHeader(header);
+    c.literals.resize(num_lits);
     memcpy(&c.activity, data, sizeof(float));  // Read activity first
     memcpy(c.literals.data(), data + sizeof(float), num_lits * sizeof(Lit));
-    return c;
+
+    LineStats& ls = lineStatsOf(num_lits);
+    uint64_t begin = clauseAddr(addr), bytes = c.size();
+    ls.reads++;
+    ls.lines += linesOf(begin, begin + bytes);
+    ls.min_lines += (bytes + line_size - 1) / line_size;
 }
 
-void Clauses::writeClause(Cref addr, const Clause& c) {
-    std::vector<uint8_t> buffer(c.size());
-    memcpy(buffer.data(), &c, CLAUSE_MEMBER_SIZE * 2); // num_lits and activity
-    memcpy(buffer.data() + CLAUSE_MEMBER_SIZE * 2, c.literals.data(), 
+void Clauses::readClauseHead(Cref addr, Clause& c, int worker_id) {
+    ClauseSummary head;
+    readSummary(addr, head, worker_id);
+    uint32_t num_lits = head.litSize();
+    assert(num_lits >= 2);
+
+    c.setHeader(head.header);
+    c.activity = head.activity;
+    c.literals.resize(num_lits);
+    c.literals[0] = head.watched[0];
+    c.literals[1] = head.watched[1];
+
+    LineStats& ls = lineStatsOf(num_lits);
+    uint64_t begin = clauseAddr(addr), bytes = c.size();
+    ls.reads++;
+    ls.lines += linesOf(begin, begin + CLAUSE_HEAD_BYTES);
+    ls.min_lines += (bytes + line_size - 1) / line_size;
+}
+
+// after readClauseHead on the same clause
+void Clauses::readClauseTail(Cref addr, Clause& c, int worker_id) {
+    uint32_t num_lits = c.litSize();
+    if (num_lits <= 2) return;
+    uint64_t begin = clauseAddr(addr), head_end = begin + CLAUSE_HEAD_BYTES, end = begin + c.size();
+    readBurstInto(head_end, c.literals.data() + 2, num_lits - 2, worker_id);
+
+    // lines past the ones the head read brought in
+    LineStats& ls = lineStatsOf(num_lits);
+    ls.lines += linesOf(head_end, end) - ((head_end - 1) / line_size == head_end / line_size ? 1 : 0);
+}
+
+Clauses::LineStats& Clauses::lineStatsOf(uint32_t num_lits) {
+    return line_stats[MemoryAllocator::getSizeClass(
+        MemoryAllocator::blockSize(CLAUSE_MEMBER_SIZE * 2 + num_lits * sizeof(Lit)))];
+}
+
+// memory image of a clause: size word, activity, literals
+const std::vector<uint8_t>& Clauses::clauseBytes(const Clause& c) {
+    clause_buf.resize(c.size());
+    uint32_t header = c.header();
+    memcpy(clause_buf.data(), &header, CLAUSE_MEMBER_SIZE);
+    memcpy(clause_buf.data() + CLAUSE_MEMBER_SIZE, &c.activity, CLAUSE_MEMBER_SIZE);
+    memcpy(clause_buf.data() + CLAUSE_MEMBER_SIZE * 2, c.literals.data(), 
            c.litSize() * sizeof(Lit)); // literals
-    writeBurst(clauseAddr(addr), buffer);
+    return clause_buf;
+}
+
+void Clauses::writeClause(Cref addr, const Clause& c) {
+    const std::vector<uint8_t>& bytes = clauseBytes(c);
+    writeBurstBytes(clauseAddr(addr), bytes.data(), bytes.size());
+}
+
+void Clauses::offerClause(Cref addr, const Clause& c, ClauseScratchpad::Offer why) {
+    if (!scratchpad || !scratchpad->admits(why, c.litSize(), c.lbd)) return;
+    const std::vector<uint8_t>& bytes = clauseBytes(c);
+    scratchpad->pin(clauseAddr(addr), bytes.data(), bytes.size());
+}
+
+// clause data reads try the scratchpad first; the command region never hits
+void Clauses::sendRead(SST::Interfaces::StandardMem::Read* req) {
+    if (scratchpad && req->pAddr >= clauses_base_addr && scratchpad->serve(req)) return;
+    AsyncBase::sendRead(req);
+}
+
+// write-through, so pinned copies never need to be written back
+void Clauses::sendWrite(SST::Interfaces::StandardMem::Write* req) {
+    if (scratchpad) scratchpad->update(req->pAddr, req->data.data(), req->size);
+    AsyncBase::sendWrite(req);
 }
 
 void Clauses::writeLiteral(Cref addr, const Lit& lit, int idx) {
-    std::vector<uint8_t> buffer(sizeof(Lit));
-    memcpy(buffer.data(), &lit, sizeof(Lit));
-    write(clauseAddr(addr + offsetof(Clause, literals) + idx * sizeof(Lit)), sizeof(Lit), buffer);
+    writeFrom(clauseAddr(addr + offsetof(Clause, literals) + idx * sizeof(Lit)), &lit);
 }
 
-void Clauses::initialize(const std::vector<Clause>& clauses) {
+void Clauses::initialize(const ClausePool& clauses) {
     num_orig_clauses = clauses.size();
     size_ = clauses.size();
     output.verbose(CALL_INFO, 1, 0, "Size: %zu clause pointers, %ld bytes\n",
                    size_, size_ * sizeof(Cref));
     
-    // Calculate total size needed for original clauses
+    // Calculate total size needed for original clauses, padding included
+    auto pad = [this](uint64_t offset, uint32_t bytes) {
+        return placementPad(clauses_base_addr + offset, bytes, placement, line_size);
+    };
     size_t total_memory = line_size;  // addr 0 is ClauseRef_Undef
-    std::vector<Cref> addr_array(clauses.size());
-    
     for (size_t i = 0; i < clauses.size(); i++) {
-        addr_array[i] = total_memory;
-        total_memory += clauses[i].size();
+        total_memory += pad(total_memory, clauses.bytes(i)) + clauses.bytes(i);
     }
 
-    // Initialize allocator with the reserved area for original clauses
-    allocator.initialize(this, total_memory);
-    
     // Set learnt offset to start after original clauses
     learnt_offset = total_memory;
-    
-    // Write all clause pointers in one operation
-    std::vector<uint8_t> addr_buffer(clauses.size() * sizeof(Cref));
-    memcpy(addr_buffer.data(), addr_array.data(), addr_buffer.size());
-    writeUntimed(clauses_cmd_base_addr, addr_buffer.size(), addr_buffer);
-    
-    // Prepare buffer for all clause data - no headers/footers needed for original clauses
-    std::vector<uint8_t> literals_buffer(total_memory);
-    size_t offset = line_size;  // Start after ClauseRef_Undef
-    
-    for (const auto& clause : clauses) {
-        // num_lits and activity
-        memcpy(literals_buffer.data() + offset, &clause, CLAUSE_MEMBER_SIZE * 2);
-        // literals
-        memcpy(literals_buffer.data() + offset + CLAUSE_MEMBER_SIZE * 2,
-               clause.literals.data(), clause.litSize() * sizeof(Lit));
-        offset += clause.size();
+
+    // Initialize allocator with the reserved area for original clauses,
+    // and the tier regions below the local one
+    // region boundaries fall on cache lines
+    auto line_up = [this](Cref a) { return (Cref)((a + line_size - 1) / line_size * line_size); };
+    core_end = core_bytes > 0 ? line_up(learnt_offset + core_bytes) : learnt_offset;
+    mid_end = mid_bytes > 0 ? line_up(core_end + mid_bytes) : core_end;
+    if (core_bytes > 0) {
+        core_alloc.reset(new MemoryAllocator(verbose, clauses_base_addr, core_end));
+        core_alloc->setReorderBuffer(reorder_buffer);
+        core_alloc->setPlacement(placement, line_size);
+        core_alloc->initialize(this, learnt_offset);
     }
+    if (mid_bytes > 0) {
+        mid_alloc.reset(new MemoryAllocator(verbose, clauses_base_addr, mid_end));
+        mid_alloc->setReorderBuffer(reorder_buffer);
+        mid_alloc->setPlacement(placement, line_size);
+        mid_alloc->initialize(this, core_end);
+    }
+    sst_assert(mid_end + MIN_BLOCK_SIZE <= allocator.regionEnd(), CALL_INFO, -1,
+        "Tier regions of %u + %u bytes leave no room for local learnts\n", core_bytes, mid_bytes);
+    allocator.setPlacement(placement, line_size);
+    allocator.initialize(this, mid_end);
+    if (tierRegions()) {
+        output.verbose(CALL_INFO, 1, 0, "Tier regions: core [0x%x, 0x%x), mid [0x%x, 0x%x), local from 0x%x\n",
+                       learnt_offset, core_end, core_end, mid_end, mid_end);
+    }
+
+    // Stream clause pointers and clause data (no headers/footers for
+    // original clauses) into memory in bounded batches
+    std::vector<uint8_t> addr_batch, data_batch;
+    uint64_t addr_batch_addr = clauses_cmd_base_addr;
+    uint64_t data_batch_addr = clauses_base_addr;
+    auto flush = [this](std::vector<uint8_t>& batch, uint64_t& batch_addr) {
+        if (batch.empty()) return;
+        writeUntimed(batch_addr, batch.size(), batch);
+        batch_addr += batch.size();
+        batch.clear();
+    };
+
+    data_batch.assign(line_size, 0);  // ClauseRef_Undef line
+    Cref addr = line_size;
+    for (size_t i = 0; i < clauses.size(); i++) {
+        uint32_t gap = pad(addr, clauses.bytes(i));
+        data_batch.resize(data_batch.size() + gap, 0);
+        addr += gap;
+
+        size_t off = addr_batch.size();
+        addr_batch.resize(off + sizeof(Cref));
+        memcpy(addr_batch.data() + off, &addr, sizeof(Cref));
+        if (addr_batch.size() >= INIT_BATCH_BYTES) flush(addr_batch, addr_batch_addr);
 
-    // Write all clause data to memory in one operation
-    writeUntimed(clauses_base_addr, literals_buffer.size(), literals_buffer);
+        // num_lits and activity, then literals
+        uint32_t num_lits = clauses.litSize(i);
+        float activity = 0.0f;
+        off = data_batch.size();
+        data_batch.resize(off + clauses.bytes(i));
+        memcpy(data_batch.data() + off, &num_lits, CLAUSE_MEMBER_SIZE);
+        memcpy(data_batch.data() + off + CLAUSE_MEMBER_SIZE, &activity, CLAUSE_MEMBER_SIZE);
+        memcpy(data_batch.data() + off + CLAUSE_MEMBER_SIZE * 2,
+               clauses.lits_of(i), num_lits * sizeof(Lit));
+        if (data_batch.size() >= INIT_BATCH_BYTES) flush(data_batch, data_batch_addr);
+
+        addr += clauses.bytes(i);
+    }
+    flush(addr_batch, addr_batch_addr);
+    flush(data_batch, data_batch_addr);
     
     output.verbose(CALL_INFO, 1, 0, "Size: %zu clause structs, %ld bytes\n",
                    size_, total_memory);
 }
 
+void Clauses::setTierRegions(uint32_t core, uint32_t mid) {
+    core_bytes = core;
+    mid_bytes = mid;
+}
+
+MemoryAllocator& Clauses::regionAllocator(int tier) {
+    if (tier == TIER_CORE && core_alloc) return *core_alloc;
+    if (tier == TIER_MID && mid_alloc) return *mid_alloc;
+    return allocator;
+}
+
+void Clauses::printFragStats() const {
+    if (core_alloc) { output.output("  Core region:\n"); core_alloc->printFragStats(); }
+    if (mid_alloc) { output.output("  Mid region:\n"); mid_alloc->printFragStats(); }
+    allocator.printFragStats();
+}
+
 Cref Clauses::addClause(const Clause& clause) {
-    Cref block_addr = allocator.allocateBlock(clause.size());
+    // a full core or mid region spills into the local one
+    MemoryAllocator& region = regionAllocator(clause.tier);
+    Cref block_addr = region.allocateBlock(clause.size(), &region == &allocator);
+    if (block_addr == ClauseRef_Undef) {
+        region_spills++;
+        block_addr = allocator.allocateBlock(clause.size());
+    }
     writeAddr(size_, block_addr);  // Write new ptr at index size_
     
     size_++;
@@ -125,22 +277,18 @@ Cref Clauses::addClause(const Clause& clause) {
 void Clauses::freeClause(Cref addr, uint32_t cls_size) {
     assert(addr >= learnt_offset);
     size_t req_size = CLAUSE_MEMBER_SIZE * 2 + cls_size * sizeof(Lit); // size + activity + literals
-    allocator.freeBlock(addr, req_size);
+    regionAllocator(regionOf(addr)).freeBlock(addr, req_size);
+    if (scratchpad) scratchpad->unpin(clauseAddr(addr));
 }
 
 void Clauses::writeAct(Cref addr, float act) {
-    std::vector<uint8_t> buffer(sizeof(float));
-    memcpy(buffer.data(), &act, sizeof(float));
-    write(clauseAddr(addr + offsetof(Clause, activity)), sizeof(float), buffer);
+    writeFrom(clauseAddr(addr + offsetof(Clause, activity)), &act);
 }
 
 std::vector<Cref> Clauses::readAllAddr(int worker_id) {
     size_t nl = size_ - num_orig_clauses;  // Number of learnt clauses
-    readBurst(cmdAddr(num_orig_clauses), sizeof(Cref) * nl, worker_id);
-    
-    const Cref* addr_ptr = reinterpret_cast<const Cref*>(reorder_buffer->getResponse(worker_id).data());
     std::vector<Cref> result(nl);
-    memcpy(result.data(), addr_ptr, nl * sizeof(Cref));
+    readBurstInto(cmdAddr(num_orig_clauses), result.data(), nl, worker_id);
     return result;
 }
 
@@ -150,8 +298,7 @@ std::vector<float> Clauses::readAllAct(const std::vector<Cref>& addr, int worker
     
     // TODO: parallelize by using non blocking reads with different worker IDs
     for (size_t i = 0; i < addr.size(); i++) {
-        read(clauseAddr(addr[i] + offsetof(Clause, activity)), sizeof(float), worker_id);
-        memcpy(&result[i], reorder_buffer->getResponse(worker_id).data(), sizeof(float));
+        readInto(clauseAddr(addr[i] + offsetof(Clause, activity)), &result[i], 1, worker_id);
     }
     
     return result;
@@ -167,10 +314,121 @@ void Clauses::rescaleAllAct(float factor) {
     }
 }
 
+// Compacting collection of the learnt region.
+// The survivors are packed back to back, apart from placement gaps, from
+// the start of their tier's region (learnt_offset without regions) in the
+// given order; survivors that
+// do not fit their region go to the local one. Each allocator is rebuilt
+// with one free block above its survivors. All survivors are read before
+// anything is written, since the new locations overlap the old ones in any
+// order other than ascending address. The packed regions are streamed out
+// line by line, stalling on a full store queue, so the collector competes
+// for bandwidth like any other writer. Returns the new address of each
+// survivor; contents[i] holds the clause read from survivors[i] so the
+// caller can fix up watchers and reasons.
+std::vector<Cref> Clauses::compactLearnts(const std::vector<Cref>& survivors, std::vector<Clause>& contents) {
+    contents.resize(survivors.size());
+    for (size_t i = 0; i < survivors.size(); i++) {
+        assert(isLearnt(survivors[i]));
+        readClause(survivors[i], contents[i], 0);
+    }
+    // pinned survivors move with their clause
+    std::vector<bool> was_pinned(survivors.size(), false);
+    if (scratchpad) {
+        for (size_t i = 0; i < survivors.size(); i++) was_pinned[i] = scratchpad->pinned(clauseAddr(survivors[i]));
+        scratchpad->clear();
+    }
+
+    const int tiers[3] = {TIER_CORE, TIER_MID, TIER_LOCAL};
+    Cref region_begin[3] = {learnt_offset, core_end, mid_end};
+    Cref live_end[3] = {learnt_offset, core_end, mid_end};
+    uint64_t live_req[3] = {0, 0, 0};
+    std::vector<int> region(survivors.size());
+    std::vector<Cref> relocated(survivors.size());
+    std::vector<uint32_t> block_bytes(survivors.size());
+    // Placement gaps go to the block in front; in front of a region's first
+    // block there is none, so a filler block that is never freed takes it
+    int last[3] = {-1, -1, -1};
+    uint32_t filler[3] = {0, 0, 0};
+    auto gapAt = [&](int r, uint32_t bytes) {
+        uint32_t gap = placementPad(clauses_base_addr + live_end[r] + TAG_SIZE, bytes, placement, line_size);
+        if (gap > 0 && last[r] < 0 && gap < MIN_BLOCK_SIZE) gap += line_size;
+        return gap;
+    };
+    for (size_t i = 0; i < survivors.size(); i++) {
+        uint32_t bytes = MemoryAllocator::blockSize(contents[i].size());
+        int r = 2;
+        if (contents[i].tier == TIER_CORE && core_alloc) r = 0;
+        else if (contents[i].tier == TIER_MID && mid_alloc) r = 1;
+        uint32_t gap = gapAt(r, contents[i].size());
+        if (r < 2 && live_end[r] + gap + bytes + MIN_BLOCK_SIZE > regionAllocator(tiers[r]).regionEnd()) {
+            region_spills++;
+            r = 2;
+            gap = gapAt(r, contents[i].size());
+        }
+        if (gap > 0) {
+            if (last[r] >= 0) block_bytes[last[r]] += gap;
+            else filler[r] = gap;
+            live_end[r] += gap;
+        }
+        region[i] = r;
+        relocated[i] = live_end[r];
+        block_bytes[i] = bytes;
+        live_end[r] += bytes;
+        live_req[r] += contents[i].size();
+        last[r] = i;
+    }
+
+    // block image: header, size word and activity, literals, padding, footer
+    for (int r = 0; r < 3; r++) {
+        if (live_end[r] == region_begin[r]) continue;
+        std::vector<uint8_t> image(live_end[r] - region_begin[r], 0);
+        if (filler[r] > 0) {
+            BlockHeader tag;
+            tag.allocated = 1;
+            tag.block_size = filler[r];
+            memcpy(image.data(), &tag, TAG_SIZE);
+            memcpy(image.data() + filler[r] - TAG_SIZE, &tag, TAG_SIZE);
+        }
+        for (size_t i = 0; i < survivors.size(); i++) {
+            if (region[i] != r) continue;
+            const Clause& c = contents[i];
+            uint8_t* block = image.data() + (relocated[i] - region_begin[r]);
+            BlockHeader tag;
+            tag.allocated = 1;
+            tag.block_size = block_bytes[i];
+            uint32_t header = c.header();
+            memcpy(block, &tag, TAG_SIZE);
+            memcpy(block + TAG_SIZE, &header, CLAUSE_MEMBER_SIZE);
+            memcpy(block + TAG_SIZE + CLAUSE_MEMBER_SIZE, &c.activity, CLAUSE_MEMBER_SIZE);
+            memcpy(block + TAG_SIZE + CLAUSE_MEMBER_SIZE * 2, c.literals.data(), c.litSize() * sizeof(Lit));
+            memcpy(block + tag.block_size - TAG_SIZE, &tag, TAG_SIZE);
+        }
+        for (const auto& chunk : calculateCacheChunks(clauses_base_addr + region_begin[r], image.size())) {
+            if (WRITE_BUFFER) waitStoreQueue(0);
+            writeBytes(chunk.addr, image.data() + chunk.offset_in_data, chunk.size);
+        }
+    }
+
+    for (size_t i = 0; i < survivors.size(); i++) {
+        if (!was_pinned[i]) continue;
+        const std::vector<uint8_t>& bytes = clauseBytes(contents[i]);
+        scratchpad->pin(clauseAddr(relocated[i]), bytes.data(), bytes.size());
+    }
+
+    reduceDB(relocated);
+    if (core_alloc) core_alloc->compact(live_end[0], live_req[0]);
+    if (mid_alloc) mid_alloc->compact(live_end[1], live_req[1]);
+    allocator.compact(live_end[2], live_req[2]);
+
+    output.verbose(CALL_INFO, 4, 0, "Compacted %zu learnt clauses into %u bytes\n",
+                   survivors.size(), (live_end[0] - region_begin[0]) + (live_end[1] - region_begin[1])
+                   + (live_end[2] - region_begin[2]));
+    return relocated;
+}
+
 void Clauses::reduceDB(const std::vector<Cref>& to_keep) {
-    std::vector<uint8_t> addr_buffer(to_keep.size() * sizeof(Cref));
-    memcpy(addr_buffer.data(), to_keep.data(), addr_buffer.size());
-    writeBurst(cmdAddr(num_orig_clauses), addr_buffer);
+    writeBurstFrom(cmdAddr(num_orig_clauses), to_keep.data(), to_keep.size());
 
     size_ = to_keep.size() + num_orig_clauses;  // Update size
 }
@@ -2,8 +2,23 @@
 #define CLAUSES_H
 
 #include <unordered_map>
+#include <memory>
 #include "async_base.h"
 #include "memory_allocator.h"
+#include "clause_scratchpad.h"
+
+// Leading 16 bytes of a clause: everything DB reduction needs, one read
+struct ClauseSummary {
+    uint32_t header;  // size word, see clauseHeader()
+    float activity;
+    Lit watched[2];  // the two watched literals live at positions 0 and 1
+
+    uint32_t litSize() const { return headerLits(header); }
+    int lbd() const { return headerLbd(header); }
+    int tier() const { return headerTier(header); }
+    bool used() const { return headerUsed(header); }
+};
+static_assert(sizeof(ClauseSummary) == CLAUSE_MEMBER_SIZE * 4, "ClauseSummary must match the clause layout");
 
 class Clauses : public AsyncBase {
 public:
@@ -14,15 +29,57 @@ public:
     void setReorderBuffer(ReorderBuffer* rb) override { 
         reorder_buffer = rb;
         allocator.setReorderBuffer(rb);
+        if (core_alloc) core_alloc->setReorderBuffer(rb);
+        if (mid_alloc) mid_alloc->setReorderBuffer(rb);
     }
-    void printFragStats() const { allocator.printFragStats(); }
+    void printFragStats() const;
+
+    // Give core and mid tier learnts their own address regions below the
+    // local one, e.g. to map them onto a scratchpad or a cache partition.
+    // Must be called before initialize; 0 bytes disables a region.
+    void setTierRegions(uint32_t core_bytes, uint32_t mid_bytes);
+    bool tierRegions() const { return core_bytes + mid_bytes > 0; }
+    uint64_t regionSpills() const { return region_spills; }
+
+    // Clause placement policy (see ClausePlacement), for the original
+    // clauses, new learnts and compaction. Must be called before initialize;
+    // placement follows the line size at that point.
+    void setPlacement(ClausePlacement p) { placement = p; }
+    ClausePlacement getPlacement() const { return placement; }
+    // Memory address of the clause at addr
+    uint64_t memAddr(Cref addr) const { return clauseAddr(addr); }
+
+    // Per size class (MemoryAllocator classes of the clause's block size):
+    // clause reads, lines they touched, and the fewest lines the clause
+    // could take
+    struct LineStats {
+        uint64_t reads = 0;
+        uint64_t lines = 0;
+        uint64_t min_lines = 0;
+    };
+    const LineStats& lineStats(int size_class) const { return line_stats[size_class]; }
+
+    // Optional scratchpad in front of the clause data (null disables it).
+    // offerClause pins c if the scratchpad's policy wants it; c must match
+    // what is in memory at addr.
+    void setScratchpad(ClauseScratchpad* sp) { scratchpad = sp; }
+    ClauseScratchpad* getScratchpad() const { return scratchpad; }
+    void offerClause(Cref addr, const Clause& c, ClauseScratchpad::Offer why);
 
     // Core operations
     Clause readClause(Cref addr, int worker_id = 0);
+    void readClause(Cref addr, Clause& out, int worker_id);
+    // Split reads (PLACE_SPLIT): the head fills the size, activity and the
+    // two watched literals of out, the tail the remaining literals
+    void readClauseHead(Cref addr, Clause& out, int worker_id);
+    void readClauseTail(Cref addr, Clause& out, int worker_id);
     void writeClause(Cref addr, const Clause& c);
     void writeLiteral(Cref addr, const Lit& lit, int idx);
     uint32_t getClauseSize(Cref addr, int worker_id = 0);
-    void initialize(const std::vector<Clause>& clauses);
+    uint32_t readHeader(Cref addr, int worker_id = 0);
+    void writeHeader(Cref addr, uint32_t header);
+    void readSummary(Cref addr, ClauseSummary& out, int worker_id = 0);
+    void initialize(const ClausePool& clauses);
     Cref addClause(const Clause& clause);
     bool isLearnt(Cref addr) const { return addr >= learnt_offset; }
     void writeAct(Cref addr, float act);
@@ -31,6 +88,11 @@ public:
     void rescaleAllAct(float factor);
     void reduceDB(const std::vector<Cref>& to_keep);
     void freeClause(Cref addr, uint32_t cls_size);
+    std::vector<Cref> compactLearnts(const std::vector<Cref>& survivors, std::vector<Clause>& contents);
+
+protected:
+    void sendRead(SST::Interfaces::StandardMem::Read* req) override;
+    void sendWrite(SST::Interfaces::StandardMem::Write* req) override;
 
 private:
     uint64_t clauses_cmd_base_addr;
@@ -39,8 +101,34 @@ private:
     size_t num_orig_clauses;
     Cref learnt_offset;
     
-    // Memory allocator
+    // Memory allocator (the local tier's region when regions are enabled)
     MemoryAllocator allocator;
+    int verbose;
+
+    // Tier regions: core [learnt_offset, core_end), mid [core_end, mid_end),
+    // local [mid_end, ...). Without regions core_end == mid_end == learnt_offset.
+    uint32_t core_bytes;
+    uint32_t mid_bytes;
+    Cref core_end;
+    Cref mid_end;
+    std::unique_ptr<MemoryAllocator> core_alloc;
+    std::unique_ptr<MemoryAllocator> mid_alloc;
+    uint64_t region_spills;     // core/mid clauses placed in the local region for lack of space
+    int regionOf(Cref addr) const {
+        return addr < core_end ? TIER_CORE : addr < mid_end ? TIER_MID : TIER_LOCAL;
+    }
+    MemoryAllocator& regionAllocator(int tier);
+
+    ClauseScratchpad* scratchpad;     // not owned
+
+    ClausePlacement placement;
+    LineStats line_stats[NUM_SIZE_CLASSES];
+    // lines of [begin, end) in the clause data region
+    uint64_t linesOf(uint64_t begin, uint64_t end) const { return (end - 1) / line_size - begin / line_size + 1; }
+    LineStats& lineStatsOf(uint32_t num_lits);
+
+    std::vector<uint8_t> clause_buf;  // serialization scratch for writeClause
+    const std::vector<uint8_t>& clauseBytes(const Clause& c);
     
     // Memory operations
     uint64_t cmdAddr(int idx) const {
@@ -8,14 +8,15 @@ Heap::Heap(SST::ComponentId_t id, SST::Params& params,
       outstanding_mem_requests(0), heap_addr(heap_base_addr), indices_addr(indices_base_addr),
       heap_sink_ptr(nullptr), debugging(false), need_rescale(false),
       var_activity(params.find<int>("verbose", 0), mem, 
-                   params.find<uint64_t>("var_act_base_addr", 0x70000000), this) {
+                   params.find<uint64_t>("var_act_base_addr", 0x70000000), this),
+      heaplanes(1), parent_sleeping(false), clock_gated(false), gated_at(0), gated_cycles(0) {
     
     output.init("HEAP-> ", params.find<int>("verbose", 0), 0, SST::Output::STDOUT);
     output.verbose(CALL_INFO, 1, 0, "base addresses: heap=0x%lx, indices=0x%lx\n", 
                    heap_base_addr, indices_base_addr);
 
-    registerClock(params.find<std::string>("clock", "1GHz"),
-        new SST::Clock::Handler2<Heap, &Heap::tick>(this));
+    clock_handler = new SST::Clock::Handler2<Heap, &Heap::tick>(this);
+    clock_tc = registerClock(params.find<std::string>("clock", "1GHz"), clock_handler);
 
     response_port = configureLink("response");
     sst_assert( response_port != nullptr, CALL_INFO, -1, "Error: 'response_port' is not connected to a link\n");
@@ -34,7 +35,7 @@ bool Heap::tick(SST::Cycle_t cycle) {
         case STEP: {
             // printf("=== Cycle %lu ===\n", cycle);
             output.verbose(CALL_INFO, 8, 0, "=== Tick %lu === \n", cycle);
-            assert(heap_active_workers.size() <= HEAPLANES);
+            assert(heap_active_workers.size() <= (size_t)heaplanes);
             for (size_t j = 0; j < heap_active_workers.size(); j++) {
                 if (heap_active_workers[j]) {
                     heap_sink_ptr = heap_sink_ptrs[j];
@@ -88,16 +89,46 @@ bool Heap::tick(SST::Cycle_t cycle) {
     }
 
     // handle pending requests - start new workers if we have available slots
-    if (!pending_requests.empty() && heap_active_workers.size() < HEAPLANES 
+    if (!pending_requests.empty() && heap_active_workers.size() < (size_t)heaplanes 
         && !need_rescale && !debugging) {
         size_t idx = heap_active_workers.size();
         // printf("=== Cycle %lu ===\n", cycle);
         startNewWorker(idx);
     }
 
+    // Workers only advance on memory responses: sleep until one arrives
+    if (parent_sleeping && state != STEP && pending_requests.empty()) {
+        clock_gated = true;
+        gated_at = cycle;
+        return true;
+    }
     return false;
 }
 
+// Re-register after a memory response. SST cycle numbers are absolute, so the
+// ticks that were skipped had nothing to do and the next one runs on the same
+// cycle it would have with the clock left on.
+void Heap::wakeClock() {
+    if (!clock_gated) return;
+    clock_gated = false;
+    SST::Cycle_t next = reregisterClock(clock_tc, clock_handler);
+    if (next > gated_at + 1) gated_cycles += next - gated_at - 1;
+}
+
+// The solver's clock is back. Requests arrive from its tick handler, so the
+// heap must be ticking and must tick after it within a cycle, as it did when
+// both handlers were registered at construction; re-registering puts the
+// heap's handler behind the solver's again.
+void Heap::parentWoke() {
+    parent_sleeping = false;
+    if (clock_gated) {
+        wakeClock();
+    } else {
+        unregisterClock(clock_tc, clock_handler);
+        reregisterClock(clock_tc, clock_handler);
+    }
+}
+
 // Helper method to start a new worker with a request
 void Heap::startNewWorker(size_t idx) {
     HeapReqEvent* req = pending_requests.front();
@@ -194,6 +225,7 @@ void Heap::handleMem(SST::Interfaces::StandardMem::Request* req) {
         }
 
         state = STEP;
+        wakeClock();
     } else if (auto* write_resp = dynamic_cast<SST::Interfaces::StandardMem::WriteResp*>(req)) {
         assert(!write_resp->getFail() && "Write response should not fail");
         if (!WRITE_BUFFER) return;
@@ -557,13 +589,18 @@ void Heap::initHeap(uint64_t random_seed) {
     memcpy(indices_data.data(), pos_map.data(), indices_data.size());
     
     // Send bulk writes
-    memory->sendUntimedData(new SST::Interfaces::StandardMem::Write(
-        heap_addr, heap_data.size(), heap_data,
-        true, 0x1));  // posted, and not cacheable
-    
-    memory->sendUntimedData(new SST::Interfaces::StandardMem::Write(
-        indices_addr, indices_data.size(), indices_data,
-        true, 0x1));  // posted, and not cacheable
+    if (preloader_) {
+        preloader_->write(memory, heap_addr, heap_data.data(), heap_data.size());
+        preloader_->write(memory, indices_addr, indices_data.data(), indices_data.size());
+    } else {
+        memory->sendUntimedData(new SST::Interfaces::StandardMem::Write(
+            heap_addr, heap_data.size(), heap_data,
+            true, 0x1));  // posted, and not cacheable
+
+        memory->sendUntimedData(new SST::Interfaces::StandardMem::Write(
+            indices_addr, indices_data.size(), indices_data,
+            true, 0x1));  // posted, and not cacheable
+    }
 
     locks.resize(heap_size + 1, false);  // Initialize locks for all variables
 
@@ -11,6 +11,7 @@
 #include "async_var_activity.h"
 #include "reorder_buffer.h"
 #include "trace_writer.h"
+#include "untimed_preloader.h"
 
 
 class Heap : public SST::SubComponent {
@@ -49,11 +50,24 @@ public:
     void setDecisionFlags(const std::vector<bool>& dec) { decision = dec; }
     void setHeapSize(size_t size) { heap_size = size; }
     void setVarIncPtr(double* ptr) { var_inc_ptr = ptr; }
+    void setHeapLanes(int lanes) { heaplanes = lanes; }
     void setLineSize(size_t size) { line_size = size; var_activity.setLineSize(size); }
     void setTracer(TraceWriter* t, uint8_t /*ds_id*/) {
         tracer_ = t;
         var_activity.setTracer(t, TraceWriter::DS_VAR_ACT);
     }
+    void setPreloader(UntimedPreloader* p) {
+        preloader_ = p;
+        var_activity.setPreloader(p);
+    }
+    // Memory profile of the VarActivity traffic
+    void enableMemProfile(MemProfile::Clock clock) { var_activity.enableMemProfile(clock); }
+    const MemProfile* memProfile() const { return var_activity.memProfile(); }
+
+    // Driven by the solver's clock gating (see SATSolver::wakeClock)
+    void parentSleeping() { parent_sleeping = true; }
+    void parentWoke();
+    uint64_t gatedCycles() const { return gated_cycles; }
     size_t size() const { return heap_size; }
     bool empty() const { return heap_size == 0; }
     
@@ -79,6 +93,7 @@ private:
     VarActivity var_activity;
     uint64_t var_act_base_addr;  // Base address for variable activity array
     TraceWriter* tracer_ = nullptr;
+    UntimedPreloader* preloader_ = nullptr;
     bool lt(Var x, Var y, int worker_id = 0);  // Comparison method using var_activity directly
 
     std::queue<HeapReqEvent*> pending_requests;
@@ -95,8 +110,19 @@ private:
     std::vector<bool> heap_polling;
     std::vector<bool> locks;  // locks for heap indices
     bool need_rescale;  // need to pause and rescale all variable activities
+    int heaplanes;      // number of heap lanes (parallel heap workers)
     void startNewWorker(size_t idx);
 
+    // Clock gating: the heap only sleeps while the solver's clock is gated
+    // (no requests can arrive) and is woken by its own memory responses.
+    SST::TimeConverter* clock_tc;
+    SST::Clock::HandlerBase* clock_handler;
+    bool parent_sleeping;
+    bool clock_gated;
+    SST::Cycle_t gated_at;
+    uint64_t gated_cycles;
+    void wakeClock();
+
     // Helper methods
     inline int parent(int i) { return (i - 1) >> 1; }
     inline int left(int i) { return (i << 1) + 1; }
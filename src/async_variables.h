@@ -16,18 +16,37 @@ public:
 
         // Assignment for writing a complete Variable
         VariableProxy& operator=(const Variable& var) {
-            parent->writeVar(var_idx, {var});
+            parent->writeVar(var_idx, &var, 1);
             return *this;
         }
     };
 
+    // Memory layout of the assignment:
+    //  SPLIT   16-byte {level, reason} records; values live in the solver
+    //          and are checked for free
+    //  PACKED  one 8-byte record per variable holding value, level and reason
+    //  SOA     a byte per variable for the value, then 8-byte {level, reason}
+    //          records
+    // PACKED and SOA keep the values in memory, so value checks are reads.
+    enum Layout { SPLIT, PACKED, SOA };
+
     Variables(int verbose = 0, SST::Interfaces::StandardMem* mem = nullptr,
-              uint64_t var_base_addr = 0, coro_t::push_type** yield_ptr = nullptr)
-        : AsyncBase("VAR-> ", verbose, mem, yield_ptr), var_base_addr(var_base_addr) {
+              uint64_t var_base_addr = 0, coro_t::push_type** yield_ptr = nullptr,
+              Layout layout = SPLIT)
+        : AsyncBase("VAR-> ", verbose, mem, yield_ptr), var_base_addr(var_base_addr),
+          layout(layout), record_base_addr(var_base_addr) {
         output.verbose(CALL_INFO, 1, 0, "base address: 0x%lx\n", var_base_addr);
     }
 
-    uint64_t varAddr(int var_idx) const { return var_base_addr + var_idx * sizeof(Variable); }
+    Layout getLayout() const { return layout; }
+    bool valuesInMemory() const { return layout != SPLIT; }
+    size_t recordSize() const { return layout == SPLIT ? sizeof(Variable) : sizeof(uint64_t); }
+    uint64_t varAddr(int var_idx) const { return record_base_addr + var_idx * recordSize(); }
+    // the value byte: a separate array for SOA, the low byte of the record
+    // for PACKED
+    uint64_t valueAddr(int var_idx) const {
+        return layout == SOA ? var_base_addr + var_idx : varAddr(var_idx);
+    }
     
     // Array-style access for write
     VariableProxy operator[](int idx) { return VariableProxy(this, idx); }
@@ -35,10 +54,14 @@ public:
     Variable readVar(int var_idx, int worker_id = 0) {
         output.verbose(CALL_INFO, 7, 0, "Read variable %d\n", var_idx);
         assert(var_idx >= 0 && var_idx < size_);
-        read(varAddr(var_idx), sizeof(Variable), worker_id);
-
         Variable var;
-        memcpy(&var, reorder_buffer->getResponse(worker_id).data(), sizeof(Variable));
+        if (layout == SPLIT) {
+            readInto(varAddr(var_idx), &var, 1, worker_id);
+        } else {
+            uint64_t r;
+            readInto(varAddr(var_idx), &r, 1, worker_id);
+            var = unpackVariable(r);
+        }
         return var;
     }
 
@@ -50,25 +73,69 @@ public:
         return readVar(var_idx, worker_id).level;
     }
 
-    void writeVar(int start_idx, const std::vector<Variable>& var_data) {
-        assert(start_idx >= 0 && start_idx + var_data.size() <= size_);
-        int count = var_data.size();
-        std::vector<uint8_t> data(count * sizeof(Variable));
-        memcpy(data.data(), &var_data[0], count * sizeof(Variable));
-        
+    // Timed read of a variable's value (PACKED and SOA only)
+    VarValue readValue(int var_idx, int worker_id = 0) {
+        assert(valuesInMemory() && var_idx >= 0 && var_idx < size_);
+        output.verbose(CALL_INFO, 7, 0, "Read value %d\n", var_idx);
+        uint8_t b;
+        readInto(valueAddr(var_idx), &b, 1, worker_id);
+        return (VarValue)(b & 3);
+    }
+
+    // PACKED writes the value along with level and reason, SOA writes the
+    // value and the record, SPLIT only the record
+    void writeVar(int start_idx, const Variable* vars, int count) {
+        assert(start_idx >= 0 && start_idx + count <= size_);
         output.verbose(CALL_INFO, 7, 0, "Write variables[%d], count %d\n", start_idx, count);
-        write(varAddr(start_idx), count * sizeof(Variable), data);
+        if (layout == SPLIT) {
+            writeFrom(varAddr(start_idx), vars, count);
+            return;
+        }
+        for (int i = 0; i < count; i++) {  // one request per variable
+            Variable v = vars[i];
+            uint8_t value = v.value;
+            if (layout == SOA) v.value = VAL_UNDEF;
+            uint64_t r = packVariable(v);
+            writeFrom(varAddr(start_idx + i), &r, 1);
+            if (layout == SOA) writeFrom(valueAddr(start_idx + i), &value, 1);
+        }
+    }
+
+    void writeVar(int start_idx, const std::vector<Variable>& var_data) {
+        writeVar(start_idx, var_data.data(), var_data.size());
+    }
+
+    // Clear the value in memory on backtracking. Under PACKED the whole
+    // record is cleared, the level and reason of an unassigned variable are
+    // dead. No traffic under SPLIT.
+    void clearValue(int var_idx) {
+        assert(var_idx >= 0 && var_idx < size_);
+        if (layout == PACKED) {
+            uint64_t r = 0;
+            writeFrom(varAddr(var_idx), &r, 1);
+        } else if (layout == SOA) {
+            uint8_t b = VAL_UNDEF;
+            writeFrom(valueAddr(var_idx), &b, 1);
+        }
     }
 
     void init(int num_vars) {
         size_ = num_vars + 1;
-        int total_bytes = (num_vars + 1) * sizeof(Variable);
-        output.verbose(CALL_INFO, 1, 0, "Size: %d variables, %d bytes\n", num_vars, total_bytes);
+        uint64_t value_bytes = 0;
+        if (layout == SOA) {
+            value_bytes = (size_ + line_size - 1) / line_size * line_size;  // records start on a new line
+        }
+        record_base_addr = var_base_addr + value_bytes;
+        uint64_t total_bytes = value_bytes + (uint64_t)size_ * recordSize();
+        output.verbose(CALL_INFO, 1, 0, "Size: %d variables, %lu bytes (%s layout)\n", num_vars, total_bytes,
+                       layout == SPLIT ? "split" : layout == PACKED ? "packed" : "soa");
         // unnecessary to initialize all variables to zero
     }
     
 private:
     uint64_t var_base_addr;
+    Layout layout;
+    uint64_t record_base_addr;  // after the value array under SOA
 };
 
 #endif // ASYNC_VARIABLES_H
@@ -1,10 +1,42 @@
 #include <sst/core/sst_config.h>
 #include "async_watches.h"
 
-uint32_t Watches::allocateBlock() {
+void Watches::setColocation(std::function<int(Cref)> stripe_of) {
+    assert(layout_);
+    if (layout_->contiguousBytes(nodes_base_addr) < block_size)
+        output.fatal(CALL_INFO, -1, "watch_nodes interleave granularity is below the %zu-byte block size\n",
+                     block_size);
+    clause_stripe = std::move(stripe_of);
+    stripe_next.assign(layout_->numStripes(), next_free_block);
+    stripe_free.assign(layout_->numStripes(), std::queue<uint32_t>());
+    nodes_end = next_free_block;
+}
+
+void Watches::freeBlock(uint32_t addr) {
+    if (colocating()) stripe_free[layout_->stripeOfLogical(addr)].push(addr);
+    else free_blocks.push(addr);
+}
+
+uint32_t Watches::allocateBlock(Cref clause_addr) {
     uint32_t addr;
-    // First check if we have recycled blocks available
-    if (!free_blocks.empty()) {
+    if (colocating()) {
+        // The stripe's own bump pointer skips the blocks of other stripes
+        // and those straddling two chunks
+        int s = clause_stripe(clause_addr);
+        num_colocated++;
+        if (!stripe_free[s].empty()) {
+            addr = stripe_free[s].front();
+            stripe_free[s].pop();
+        } else {
+            uint32_t& next = stripe_next[s];
+            while (layout_->stripeOfLogical(next) != s || !layout_->contiguous(next, block_size))
+                next += block_size;
+            addr = next;
+            next += block_size;
+            nodes_end = std::max(nodes_end, next);
+        }
+    } else if (!free_blocks.empty()) {
+        // First check if we have recycled blocks available
         addr = free_blocks.front();
         free_blocks.pop();
     } else {
@@ -19,10 +51,10 @@ uint32_t Watches::allocateBlock() {
 
 WatchMetaData Watches::readMetaData(int lit_idx, int worker_id) {
     output.verbose(CALL_INFO, 7, 0, "Read metadata for var %d\n", lit_idx/2);
-    read(watchesAddr(lit_idx), sizeof(WatchMetaData), worker_id);
+    read(watchesAddr(lit_idx), meta_size, worker_id);
     
     WatchMetaData wmd;
-    memcpy(&wmd, reorder_buffer->getResponse(worker_id).data(), sizeof(WatchMetaData));
+    wmd.fromBytes(reorder_buffer->responseData(worker_id), pre_watchers);
     return wmd;
 }
 
@@ -30,71 +62,59 @@ void Watches::writeMetaData(int lit_idx, const WatchMetaData& metadata) {
     output.verbose(CALL_INFO, 7, 0, "Write metadata: lit %d, head: %u, free_head: %u\n",
         lit_idx, metadata.head_ptr, metadata.free_head);
 
-    std::vector<uint8_t> bytes(sizeof(WatchMetaData));
-    memcpy(bytes.data(), &metadata, sizeof(WatchMetaData));
-    write(watchesAddr(lit_idx), bytes.size(), bytes);
+    uint8_t bytes[WatchMetaData::bytes(MAX_PRE_WATCHERS)];
+    metadata.toBytes(bytes, pre_watchers);
+    writeBytes(watchesAddr(lit_idx), bytes, meta_size);
 }
 
 void Watches::writeHeadPointer(int lit_idx, const uint32_t headptr) {
-    std::vector<uint8_t> bytes(sizeof(uint32_t));
-    memcpy(bytes.data(), &headptr, sizeof(uint32_t));
-    write(watchesAddr(lit_idx), bytes.size(), bytes);
+    writeFrom(watchesAddr(lit_idx), &headptr);
 }
 
 void Watches::writeFreeHead(int lit_idx, const uint32_t freehead) {
-    std::vector<uint8_t> bytes(sizeof(uint32_t));
-    memcpy(bytes.data(), &freehead, sizeof(uint32_t));
-    write(watchesAddr(lit_idx) + sizeof(uint32_t), bytes.size(), bytes);
+    writeFrom(watchesAddr(lit_idx) + sizeof(uint32_t), &freehead);
 }
 
 void Watches::writePreWatcher(int lit_idx, const WatcherNode node, const int index) {
-    std::vector<uint8_t> bytes(sizeof(WatcherNode));
-    memcpy(bytes.data(), &node, sizeof(WatcherNode));
-    write(watchesAddr(lit_idx) + offsetof(WatchMetaData, pre_watchers) + index * sizeof(WatcherNode), bytes.size(), bytes);
+    writeFrom(watchesAddr(lit_idx) + WatchMetaData::preWatcherOffset(index), &node);
 }
 
-void Watches::writePreWatchers(int lit_idx, const WatcherNode pre_watchers[PRE_WATCHERS]) {
-    std::vector<uint8_t> bytes(sizeof(WatcherNode) * PRE_WATCHERS);
-    memcpy(bytes.data(), pre_watchers, sizeof(WatcherNode) * PRE_WATCHERS);
-    write(watchesAddr(lit_idx) + offsetof(WatchMetaData, pre_watchers), bytes.size(), bytes);
+void Watches::writePreWatchers(int lit_idx, const WatcherNode* nodes) {
+    writeFrom(watchesAddr(lit_idx) + WatchMetaData::preWatcherOffset(0), nodes, pre_watchers);
 }
 
 WatcherBlock Watches::readBlock(uint32_t addr, int worker_id) {
     readBurst(addr, block_size, worker_id);
 
-    WatcherBlock block;
-    memcpy(&block, reorder_buffer->getResponse(worker_id).data(), sizeof(WatcherBlock));
+    WatcherBlock block(propagators);
+    block.fromBytes(reorder_buffer->responseData(worker_id));
     return block;
 }
 
 void Watches::writeBlock(uint32_t addr, const WatcherBlock& block) {
-    std::vector<uint8_t> data(block_size, 0);
-    memcpy(data.data(), &block, sizeof(WatcherBlock));
-    writeBurst(addr, data);
+    uint8_t data[WatcherBlock::bytes(MAX_PROPAGATORS)] = {};
+    block.toBytes(data);
+    writeBurstBytes(addr, data, block_size);
 }
 
 void Watches::writePrevFree(uint32_t node_ptr, const uint32_t prev_ptr) {
     // Extract block address and node index from the combined pointer
-    uint32_t block_addr = node_ptr & ~(FREE_IDX_BITS - 1);
-    int node_idx = node_ptr & (FREE_IDX_BITS - 1);
-    uint32_t node_addr = block_addr + offsetof(WatcherBlock, nodes) + node_idx * sizeof(WatcherNode);
+    uint32_t block_addr = node_ptr & ~(free_idx_bits - 1);
+    int node_idx = node_ptr & (free_idx_bits - 1);
+    uint32_t node_addr = block_addr + WatcherBlock::nodeOffset(node_idx);
     
     // Write the prev_ptr directly (assuming LSB is already 0 for valid=0)
-    std::vector<uint8_t> bytes(sizeof(uint32_t));
-    memcpy(bytes.data(), &prev_ptr, sizeof(uint32_t));
-    write(node_addr, bytes.size(), bytes);
+    writeFrom(node_addr, &prev_ptr);
 }
 
 void Watches::writeNextFree(uint32_t node_ptr, const uint32_t next_ptr) {
     // Extract block address and node index from the combined pointer
-    uint32_t block_addr = node_ptr & ~(FREE_IDX_BITS - 1);
-    int node_idx = node_ptr & (FREE_IDX_BITS - 1);
-    uint32_t node_addr = block_addr + offsetof(WatcherBlock, nodes) + node_idx * sizeof(WatcherNode);
+    uint32_t block_addr = node_ptr & ~(free_idx_bits - 1);
+    int node_idx = node_ptr & (free_idx_bits - 1);
+    uint32_t node_addr = block_addr + WatcherBlock::nodeOffset(node_idx);
     
     // Write to next_free field
-    std::vector<uint8_t> bytes(sizeof(uint32_t));
-    memcpy(bytes.data(), &next_ptr, sizeof(uint32_t));
-    write(node_addr + offsetof(WatcherNode, next_free), bytes.size(), bytes);
+    writeFrom(node_addr + offsetof(WatcherNode, next_free), &next_ptr);
 }
 
 // Add a node to the free list
@@ -160,130 +180,143 @@ int Watches::removeFromFreeList(int lit_idx, WatchMetaData& metadata, WatcherBlo
     }
 
     // Mark this block as not in free list anymore
-    block.free_index = PROPAGATORS;
+    block.free_index = propagators;
     return block_visits;
 }
 
-void Watches::initWatches(size_t watch_count, std::vector<Clause>& clauses) {
-    // First, allocate and initialize metadata to null
-    std::vector<WatchMetaData> metadata(watch_count);
+void Watches::initWatches(size_t watch_count, const ClausePool& clauses) {
     size_ = watch_count;
-    
-    // Create temporary data structure to build the linked lists
-    std::vector<std::vector<std::pair<Cref, Lit>>> tmp_watches(watch_count);
-    
-    // Add watchers for all clauses
-    Cref addr = line_size;  // addr 0 is ClauseRef_Undef
-    for (int ci = 0; ci < clauses.size(); ci++) {
-        Clause& c = clauses[ci];
-        if (c.litSize() >= 2) {
-            // needs to be distinct for parallel propagation
-            // cannot have two watchers for the same literal
-            assert(c[0] != c[1]);
 
+    // Bucket the two watchers of every clause by literal in one flat array
+    // (counting sort), instead of one vector per literal. After the fill
+    // pass, list_end[i] is the end of literal i's watchers and its start is
+    // list_end[i - 1].
+    std::vector<uint32_t> list_end(watch_count + 1, 0);
+    for (size_t ci = 0; ci < clauses.size(); ci++) {
+        if (clauses.litSize(ci) < 2) continue;
+        const Lit* c = clauses.lits_of(ci);
+        // needs to be distinct for parallel propagation
+        // cannot have two watchers for the same literal
+        assert(c[0] != c[1]);
+        list_end[toWatchIndex(~c[0]) + 1]++;
+        list_end[toWatchIndex(~c[1]) + 1]++;
+    }
+    for (size_t i = 1; i <= watch_count; i++) list_end[i] += list_end[i - 1];
+
+    std::vector<WatcherNode> watchers(list_end[watch_count]);
+    Cref addr = line_size;  // addr 0 is ClauseRef_Undef
+    for (size_t ci = 0; ci < clauses.size(); ci++) {
+        const Lit* c = clauses.lits_of(ci);
+        addr += placementPad(clauses_base_addr + addr, clauses.bytes(ci), placement, line_size);
+        if (clauses.litSize(ci) >= 2) {
             // Watch the first two literals
-            int idx0 = toWatchIndex(~c[0]);
-            int idx1 = toWatchIndex(~c[1]);
-            
-            // Add watchers to the temporary structure
-            tmp_watches[idx0].push_back(std::make_pair(addr, c[1]));
-            tmp_watches[idx1].push_back(std::make_pair(addr, c[0]));
+            bool binary = binary_watchers && clauses.litSize(ci) == 2;
+            watchers[list_end[toWatchIndex(~c[0])]++] = WatcherNode(addr, c[1], binary);
+            watchers[list_end[toWatchIndex(~c[1])]++] = WatcherNode(addr, c[0], binary);
         }
-        addr += c.size();
+        addr += clauses.bytes(ci);
     }
-    
-    // Allocate memory for batched write operations
-    std::vector<uint8_t> all_blocks_data;
-    
-    // Track which blocks we've used
+
+    // Blocks and metadata are streamed out in bounded batches; blocks of
+    // consecutive literals are allocated back to back. Colocated blocks go
+    // wherever their stripe has room, so they are all staged and written
+    // out in address order at the end.
+    std::vector<uint8_t> block_batch, meta_batch;
+    std::vector<std::pair<uint32_t, size_t>> placed;  // block address, offset in block_batch
+    std::vector<uint32_t> list_blocks;
+    uint64_t block_batch_addr = next_free_block;
+    uint64_t meta_batch_addr = watches_base_addr;
+    auto flush = [this](std::vector<uint8_t>& batch, uint64_t& batch_addr) {
+        if (batch.empty()) return;
+        writeUntimed(batch_addr, batch.size(), batch);
+        batch_addr += batch.size();
+        batch.clear();
+    };
+
     size_t block_idx_counter = 0;
-    
     for (size_t lit_idx = 0; lit_idx < watch_count; lit_idx++) {
-        auto& watch_list = tmp_watches[lit_idx];
-        if (watch_list.empty()) continue;
-        
+        size_t list_begin = lit_idx == 0 ? 0 : list_end[lit_idx - 1];
+        size_t list_size = list_end[lit_idx] - list_begin;
+        const WatcherNode* watch_list = watchers.data() + list_begin;
+        WatchMetaData metadata;
+
         // First fill pre-watchers array
         size_t node_in_list = 0;
-        while (node_in_list < watch_list.size() && node_in_list < PRE_WATCHERS) {
-            auto& watcher = watch_list[node_in_list];
-            metadata[lit_idx].pre_watchers[node_in_list] = WatcherNode(watcher.first, watcher.second);
+        while (node_in_list < list_size && node_in_list < (size_t)pre_watchers) {
+            metadata.pre_watchers[node_in_list] = watch_list[node_in_list];
             node_in_list++;
         }
-        int pre_count = std::min(static_cast<size_t>(PRE_WATCHERS), watch_list.size());
-        
+
         // Calculate blocks needed for the remaining watchers
-        size_t remaining_watchers = watch_list.size() - pre_count;
-        if (remaining_watchers == 0) {
-            // All watchers fit in pre-watchers, no blocks needed
-            continue;
+        size_t remaining_watchers = list_size - node_in_list;
+        size_t blocks_needed = (remaining_watchers + propagators - 1) / propagators;  // Ceiling division
+        list_blocks.clear();
+        for (size_t b = 0; b < blocks_needed; b++) {
+            list_blocks.push_back(colocating()
+                ? allocateBlock(watch_list[node_in_list + b * propagators].getClauseAddr())
+                : next_free_block + (block_idx_counter + b) * block_size);
         }
-        
-        size_t blocks_needed = (remaining_watchers + PROPAGATORS - 1) / PROPAGATORS;  // Ceiling division
-        
-        // Set head_ptr in metadata
-        uint32_t first_block_addr = next_free_block + (block_idx_counter * block_size);
-        metadata[lit_idx].head_ptr = first_block_addr;
-        
+        if (blocks_needed > 0) metadata.head_ptr = list_blocks[0];
+
         // Fill the blocks with remaining watchers
         for (size_t block_idx = 0; block_idx < blocks_needed; block_idx++) {
-            // Prepare block
-            WatcherBlock block;
+            WatcherBlock block(propagators);
             size_t nodes_in_this_block = 0;
-            
-            // Add nodes to this block
-            while (node_in_list < watch_list.size() && nodes_in_this_block < PROPAGATORS) {
-                auto& watcher = watch_list[node_in_list];
-                block.nodes[nodes_in_this_block] = WatcherNode(watcher.first, watcher.second);
-                nodes_in_this_block++;
-                node_in_list++;
+
+            while (node_in_list < list_size && nodes_in_this_block < (size_t)propagators) {
+                block.nodes[nodes_in_this_block++] = watch_list[node_in_list++];
             }
-            
+
             // Set next block pointer if there are more blocks
             if (block_idx < blocks_needed - 1) {
-                block.setNextBlock(first_block_addr + ((block_idx + 1) * block_size));
+                block.setNextBlock(list_blocks[block_idx + 1]);
             }
-            
+
             // If this is the last block and it isn't full, add it to the free list
             // but only if free list is enabled
-            if (USE_FREE_LIST && block_idx == blocks_needed - 1 && nodes_in_this_block < PROPAGATORS) {
-                // Calculate the node address for the first free slot
-                uint32_t curr_block_addr = first_block_addr + (block_idx * block_size);
+            if (USE_FREE_LIST && block_idx == blocks_needed - 1 && nodes_in_this_block < (size_t)propagators) {
+                uint32_t curr_block_addr = list_blocks[block_idx];
                 uint32_t free_node_idx = nodes_in_this_block;  // First empty slot
-                
+
                 // Set up the free node, no prev or next free
                 block.nodes[free_node_idx] = WatcherNode(0, 0);
-                
-                // Update free_index in the block
                 block.free_index = free_node_idx;
-                
-                // Update metadata to point to this free node
-                metadata[lit_idx].free_head = curr_block_addr | free_node_idx;
+                metadata.free_head = curr_block_addr | free_node_idx;
             }
-            
-            // Copy block data to the batch buffer
-            std::vector<uint8_t> block_data(block_size, 0);
-            memcpy(block_data.data(), &block, sizeof(WatcherBlock));
-            all_blocks_data.insert(all_blocks_data.end(), block_data.begin(), block_data.end());
+
+            size_t off = block_batch.size();
+            block_batch.resize(off + block_size, 0);
+            block.toBytes(block_batch.data() + off);
+            if (colocating()) placed.emplace_back(list_blocks[block_idx], off);
+            else if (block_batch.size() >= INIT_BATCH_BYTES) flush(block_batch, block_batch_addr);
         }
-        
         block_idx_counter += blocks_needed;
+
+        size_t off = meta_batch.size();
+        meta_batch.resize(off + meta_size);
+        metadata.toBytes(meta_batch.data() + off, pre_watchers);
+        if (meta_batch.size() >= INIT_BATCH_BYTES) flush(meta_batch, meta_batch_addr);
     }
-    
-    // Write all blocks in one operation if any
-    if (all_blocks_data.size() > 0) {
-        writeUntimed(nodes_base_addr, all_blocks_data.size(), all_blocks_data);
+    if (colocating()) {
+        std::sort(placed.begin(), placed.end());
+        std::vector<uint8_t> run;
+        uint64_t run_addr = 0;
+        for (const auto& pb : placed) {
+            if (!run.empty() && (pb.first != run_addr + run.size() || run.size() >= INIT_BATCH_BYTES))
+                flush(run, run_addr);
+            if (run.empty()) run_addr = pb.first;
+            run.insert(run.end(), block_batch.begin() + pb.second, block_batch.begin() + pb.second + block_size);
+        }
+        flush(run, run_addr);
+    } else {
+        flush(block_batch, block_batch_addr);
+        // Update next_free_block to point after our allocated blocks
+        next_free_block = next_free_block + (block_idx_counter * block_size);
     }
-    
-    // Update next_free_block to point after our allocated blocks
-    next_free_block = next_free_block + (block_idx_counter * block_size);
-    
-    // Write all metadata in one operation
-    std::vector<uint8_t> wmd_bytes(watch_count * sizeof(WatchMetaData));
-    memcpy(wmd_bytes.data(), metadata.data(), wmd_bytes.size());
-    writeUntimed(watches_base_addr, wmd_bytes.size(), wmd_bytes);
-    
+    flush(meta_batch, meta_batch_addr);
+
     output.verbose(CALL_INFO, 1, 0, "Size: %zu watches, %ld bytes\n", 
-                   watch_count, watch_count * sizeof(WatchMetaData));
+                   watch_count, watch_count * meta_size);
     output.verbose(CALL_INFO, 1, 0, "Size: %zu watch node blocks, %ld bytes\n", 
                    block_idx_counter, block_idx_counter * block_size);
 }
@@ -307,6 +340,7 @@ void Watches::updateBlock(int lit_idx, uint32_t prev_addr, uint32_t curr_addr,
     } else {
         // Block still has valid nodes, update it
         writeBlock(curr_addr, curr_block);
+        markSparse(lit_idx);
         
         // If the block has free slots and free list is enabled, add it to the free list
         if (USE_FREE_LIST) {
@@ -317,7 +351,7 @@ void Watches::updateBlock(int lit_idx, uint32_t prev_addr, uint32_t curr_addr,
 }
 
 // Insert a new watcher for a literal
-int Watches::insertWatcher(int lit_idx, Cref clause_addr, Lit blocker, int worker_id) {
+int Watches::insertWatcher(int lit_idx, Cref clause_addr, Lit blocker, int worker_id, bool binary) {
     output.verbose(CALL_INFO, 7, 0, "Inserting watcher for var %d, clause 0x%x, blocker %d\n", lit_idx/2, clause_addr, toInt(blocker));
     if (busy.find(lit_idx) != busy.end()) {
         output.fatal(CALL_INFO, -1, "Watches: Already busy with var %d\n", lit_idx/2);
@@ -330,9 +364,9 @@ int Watches::insertWatcher(int lit_idx, Cref clause_addr, Lit blocker, int worke
     WatchMetaData metadata = readMetaData(lit_idx, worker_id);
 
     // Case 1: Check if there's room in pre-watchers
-    for (int i = 0; i < PRE_WATCHERS; i++) {
+    for (int i = 0; i < pre_watchers; i++) {
         if (!metadata.pre_watchers[i].valid) {
-            metadata.pre_watchers[i] = WatcherNode(clause_addr, blocker);
+            metadata.pre_watchers[i] = WatcherNode(clause_addr, blocker, binary);
             writePreWatcher(lit_idx, metadata.pre_watchers[i], i);
 
             busy.erase(lit_idx);
@@ -346,8 +380,8 @@ int Watches::insertWatcher(int lit_idx, Cref clause_addr, Lit blocker, int worke
     // Case 2: Check free list if available and enabled
     if (USE_FREE_LIST && metadata.free_head != 0) {
         uint32_t free_node_ptr = metadata.free_head;
-        uint32_t free_block_addr = free_node_ptr & ~(FREE_IDX_BITS - 1);
-        int node_idx = free_node_ptr & (FREE_IDX_BITS - 1);
+        uint32_t free_block_addr = free_node_ptr & ~(free_idx_bits - 1);
+        int node_idx = free_node_ptr & (free_idx_bits - 1);
 
         // Read the block containing the free node
         WatcherBlock block = readBlock(free_block_addr, worker_id);
@@ -359,7 +393,7 @@ int Watches::insertWatcher(int lit_idx, Cref clause_addr, Lit blocker, int worke
         if (free_slot == node_idx) block_visits += removeFromFreeList(lit_idx, metadata, block);
 
         // Insert the new watcher into the selected free slot
-        block.nodes[free_slot] = WatcherNode(clause_addr, blocker);
+        block.nodes[free_slot] = WatcherNode(clause_addr, blocker, binary);
         writeBlock(free_block_addr, block);
         
         busy.erase(lit_idx);
@@ -380,10 +414,10 @@ int Watches::insertWatcher(int lit_idx, Cref clause_addr, Lit blocker, int worke
             block_visits++;
             
             // Look for any free slot in the block
-            for (int i = 0; i < PROPAGATORS; i++) {
+            for (int i = 0; i < propagators; i++) {
                 if (!block.nodes[i].valid) {
                     // Found a free slot, insert the watcher here
-                    block.nodes[i] = WatcherNode(clause_addr, blocker);
+                    block.nodes[i] = WatcherNode(clause_addr, blocker, binary);
                     writeBlock(curr_addr, block);
                     
                     busy.erase(lit_idx);
@@ -401,14 +435,14 @@ int Watches::insertWatcher(int lit_idx, Cref clause_addr, Lit blocker, int worke
     }
     
     // Case 4: all blocks full or no blocks - add a new block at front
-    uint32_t new_block_addr = allocateBlock();
-    WatcherBlock new_block;
-    new_block.nodes[0] = WatcherNode(clause_addr, blocker);
+    uint32_t new_block_addr = allocateBlock(clause_addr);
+    WatcherBlock new_block(propagators);
+    new_block.nodes[0] = WatcherNode(clause_addr, blocker, binary);
     // Link to current head
     if (metadata.head_ptr != 0) new_block.setNextBlock(metadata.head_ptr);
     
     // Since we now have a free slot, add this block to the free list if enabled
-    if (USE_FREE_LIST && PROPAGATORS > 1)
+    if (USE_FREE_LIST && propagators > 1)
         block_visits += addToFreeList(lit_idx, metadata, new_block, new_block_addr, 1);
     else {
         writeBlock(new_block_addr, new_block);
@@ -433,7 +467,7 @@ void Watches::removeWatcher(int lit_idx, Cref clause_addr) {
     WatchMetaData metadata = readMetaData(lit_idx);
 
     // First check pre-watchers
-    for (int i = 0; i < PRE_WATCHERS; i++) {
+    for (int i = 0; i < pre_watchers; i++) {
         if (metadata.pre_watchers[i].valid && 
             metadata.pre_watchers[i].getClauseAddr() == clause_addr) {
             // Found in pre-watchers, invalidate it
@@ -449,13 +483,13 @@ void Watches::removeWatcher(int lit_idx, Cref clause_addr) {
     
     uint32_t curr_addr = metadata.head_ptr;
     uint32_t prev_addr = 0;
-    WatcherBlock prev_block;
+    WatcherBlock prev_block(propagators);
 
     while (curr_addr != 0) {
         WatcherBlock curr_block = readBlock(curr_addr);
         
         // Search for the clause in this block
-        for (int i = 0; i < PROPAGATORS; i++) {
+        for (int i = 0; i < propagators; i++) {
             if (curr_block.nodes[i].valid && curr_block.nodes[i].getClauseAddr() == clause_addr) {
                 // Found the clause, invalidate this node
                 curr_block.nodes[i].valid = 0;
@@ -478,3 +512,142 @@ void Watches::removeWatcher(int lit_idx, Cref clause_addr) {
 
     output.fatal(CALL_INFO, -1, "Remove failed clause 0x%x, var %d\n", clause_addr, lit_idx/2);
 }
+
+// Remove the watchers of all dead clauses of a list in one pass, instead of
+// one walk per clause. Every clause in dead must be watched here.
+void Watches::removeWatchers(int lit_idx, const std::unordered_set<Cref>& dead) {
+    size_t removed = 0;
+    WatchMetaData metadata = readMetaData(lit_idx);
+    bool meta_modified = false;
+    for (int i = 0; i < pre_watchers; i++) {
+        WatcherNode& node = metadata.pre_watchers[i];
+        if (node.valid && dead.count(node.getClauseAddr())) {
+            node.valid = 0;
+            meta_modified = true;
+            removed++;
+        }
+    }
+    if (meta_modified) writeMetaData(lit_idx, metadata);
+
+    uint32_t curr_addr = metadata.head_ptr;
+    uint32_t prev_addr = 0;
+    WatcherBlock prev_block(propagators);
+    while (curr_addr != 0 && removed < dead.size()) {
+        WatcherBlock curr_block = readBlock(curr_addr);
+        bool modified = false;
+        for (int i = 0; i < propagators; i++) {
+            WatcherNode& node = curr_block.nodes[i];
+            if (node.valid && dead.count(node.getClauseAddr())) {
+                node.valid = 0;
+                modified = true;
+                removed++;
+            }
+        }
+        if (modified) updateBlock(lit_idx, prev_addr, curr_addr, prev_block, curr_block, metadata);
+
+        // a block emptied by updateBlock is unlinked, prev stays put
+        if (curr_block.countValidNodes() != 0) {
+            prev_addr = curr_addr;
+            prev_block = curr_block;
+        }
+        curr_addr = curr_block.getNextBlock();
+    }
+
+    if (removed != dead.size()) {
+        output.fatal(CALL_INFO, -1, "Remove failed for %zu of %zu clauses, var %d\n",
+                     dead.size() - removed, dead.size(), lit_idx/2);
+    }
+    output.verbose(CALL_INFO, 7, 0, "Removed %zu watchers for var %d\n", removed, lit_idx/2);
+}
+
+// Point the watchers of relocated clauses at their new addresses.
+// One pass over the list; only the nodes that changed are written back.
+void Watches::relocateWatchers(int lit_idx, const std::unordered_map<Cref, Cref>& moved) {
+    WatchMetaData metadata = readMetaData(lit_idx);
+    for (int i = 0; i < pre_watchers; i++) {
+        WatcherNode& node = metadata.pre_watchers[i];
+        if (!node.valid) continue;
+        auto it = moved.find(node.getClauseAddr());
+        if (it == moved.end()) continue;
+        node.setClauseAddr(it->second);
+        writePreWatcher(lit_idx, node, i);
+    }
+
+    uint32_t curr_addr = metadata.head_ptr;
+    while (curr_addr != 0) {
+        WatcherBlock curr_block = readBlock(curr_addr);
+        for (int i = 0; i < propagators; i++) {
+            WatcherNode& node = curr_block.nodes[i];
+            if (!node.valid) continue;
+            auto it = moved.find(node.getClauseAddr());
+            if (it == moved.end()) continue;
+            node.setClauseAddr(it->second);
+            writeFrom(curr_addr + WatcherBlock::nodeOffset(i), &node);
+        }
+        curr_addr = curr_block.getNextBlock();
+    }
+    output.verbose(CALL_INFO, 7, 0, "Relocated watchers of var %d\n", lit_idx/2);
+}
+
+// Oldest sparse list candidate, -1 when there is none
+int Watches::nextSparse() {
+    while (!sparse_queue.empty()) {
+        int lit_idx = sparse_queue.front();
+        sparse_queue.pop_front();
+        if (sparse_set.erase(lit_idx)) return lit_idx;
+    }
+    return -1;
+}
+
+// Merge the valid watchers of a list into the fewest blocks at the front of
+// its chain, keeping their order, and free the blocks left over. The head
+// and the pre-watchers stay put. With the free list, the only block with
+// free nodes is the last one, so the free list is rebuilt from it. Nothing
+// is written when no block would be freed. Returns the blocks freed.
+int Watches::compactList(int lit_idx, int worker_id) {
+    if (busy.find(lit_idx) != busy.end()) {
+        output.fatal(CALL_INFO, -1, "Watches: Already busy with var %d\n", lit_idx/2);
+    }
+    busy.insert(lit_idx);
+    clearSparse(lit_idx);
+
+    WatchMetaData metadata = readMetaData(lit_idx, worker_id);
+    std::vector<uint32_t> chain;
+    std::vector<WatcherNode> live;
+    for (uint32_t curr_addr = metadata.head_ptr; curr_addr != 0;) {
+        WatcherBlock block = readBlock(curr_addr, worker_id);
+        chain.push_back(curr_addr);
+        for (uint32_t mask = block.validMask(); mask != 0; mask &= mask - 1)
+            live.push_back(block.nodes[__builtin_ctz(mask)]);
+        curr_addr = block.getNextBlock();
+    }
+
+    size_t keep = (live.size() + propagators - 1) / propagators;
+    if (keep == chain.size()) {
+        busy.erase(lit_idx);
+        return 0;
+    }
+
+    uint32_t free_head = 0;
+    for (size_t b = 0; b < keep; b++) {
+        WatcherBlock block(propagators);
+        size_t first = b * propagators;
+        size_t n = std::min(live.size() - first, (size_t)propagators);
+        std::copy(live.begin() + first, live.begin() + first + n, block.nodes);
+        if (b + 1 < keep) block.setNextBlock(chain[b + 1]);
+        if (USE_FREE_LIST && n < (size_t)propagators) {
+            block.nodes[n] = WatcherNode(0, 0);
+            block.free_index = n;
+            free_head = chain[b] | n;
+        }
+        writeBlock(chain[b], block);
+    }
+    for (size_t b = keep; b < chain.size(); b++) freeBlock(chain[b]);
+    if (keep == 0) writeHeadPointer(lit_idx, 0);
+    if (USE_FREE_LIST && free_head != metadata.free_head) writeFreeHead(lit_idx, free_head);
+
+    busy.erase(lit_idx);
+    output.verbose(CALL_INFO, 7, 0, "Compacted watchers of var %d: %zu watchers, %zu -> %zu blocks\n",
+                   lit_idx/2, live.size(), chain.size(), keep);
+    return (int)(chain.size() - keep);
+}
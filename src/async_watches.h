@@ -5,9 +5,13 @@
 #include <sst/core/interfaces/stdMem.h>
 #include <boost/coroutine2/all.hpp>
 #include <cstring>
+#include <cassert>
 #include <vector>
 #include <queue>
+#include <deque>
+#include <functional>
 #include <unordered_set>
+#include <unordered_map>
 #include "structs.h"
 #include "async_base.h"
 
@@ -26,9 +30,11 @@ struct WatcherNode {
     };
 
     WatcherNode() : valid(0), addr31(0), blocker(lit_Undef) {}
-    // Constructor for watcher nodes
-    WatcherNode(uint32_t ca, Lit b) : valid(1), addr31(ca >> 1), blocker(b) {
-        assert((ca & 1) == 0 && "Clause address LSB must be 0 (bit fields)");
+    // Constructor for watcher nodes. Clause addresses are 4-byte aligned, so
+    // bit 0 of addr31 is free in a valid node; it marks a binary clause, whose
+    // blocker is always the other literal.
+    WatcherNode(uint32_t ca, Lit b, bool binary = false) : valid(1), addr31((ca >> 1) | binary), blocker(b) {
+        assert((ca & 3) == 0 && "Clause address must be 4-byte aligned (bit fields)");
     }
     // Constructor for free list nodes
     WatcherNode(uint32_t p, uint32_t n) : valid(0), addr31(p >> 1), next_free(n) {
@@ -36,93 +42,189 @@ struct WatcherNode {
     }
 
     // left-shift to restore the original address
-    Cref getClauseAddr() const { return addr31 << 1; }
+    Cref getClauseAddr() const { return (addr31 & ~1u) << 1; }
+    bool isBinary() const { return valid && (addr31 & 1); }
     uint32_t getPrevFree() const { return addr31 << 1; }
     // right-shift to fit in 31 bits
     void setPrevFree(uint32_t ptr) { addr31 = ptr >> 1; }
+    void setClauseAddr(Cref ca) { assert((ca & 3) == 0); addr31 = (ca >> 1) | (addr31 & 1); }
 };
 
-// Block of watchers - dynamically sized based on PROPAGATORS
+// Bitmask of valid nodes; W is a compile-time width so the common
+// configurations get a fully unrolled loop
+template <int W>
+inline uint32_t validNodeMask(const WatcherNode* nodes) {
+    uint32_t mask = 0;
+    for (int i = 0; i < W; i++) mask |= (uint32_t)nodes[i].valid << i;
+    return mask;
+}
+
+inline uint32_t validNodeMask(const WatcherNode* nodes, int width) {
+    switch (width) {
+        case 1: return validNodeMask<1>(nodes);
+        case 4: return validNodeMask<4>(nodes);
+        case 7: return validNodeMask<7>(nodes);
+        case 8: return validNodeMask<8>(nodes);
+        default: {
+            uint32_t mask = 0;
+            for (int i = 0; i < width; i++) mask |= (uint32_t)nodes[i].valid << i;
+            return mask;
+        }
+    }
+}
+
+// Block of watchers - sized at runtime by the "propagators" param.
+// On-memory layout: nodes[width], next_block (uint32), free_index (uint32)
 struct WatcherBlock {
-    WatcherNode nodes[PROPAGATORS]; // Array of nodes sized according to PROPAGATORS
-    uint32_t next_block : 29;       // Pointer to next block (0 = nullptr)
-    uint32_t free_index : 3;        // Index of the node used in free list (0-7)
-    uint32_t padding : 32;          // Padding for alignment
+    WatcherNode nodes[MAX_PROPAGATORS]; // only the first `width` nodes are used
+    uint32_t next_block;            // Pointer to next block (0 = nullptr)
+    uint32_t free_index;            // Index of the node used in free list (width = none)
+    int width;                      // Number of nodes, not stored in memory
+
+    explicit WatcherBlock(int w = 1) : next_block(0), free_index(w), width(w) {
+        assert(w >= 1 && w <= MAX_PROPAGATORS);
+    }
+
+    static constexpr size_t bytes(int w) { return w * sizeof(WatcherNode) + 2 * sizeof(uint32_t); }
+
+    void toBytes(uint8_t* dst) const {
+        size_t n = width * sizeof(WatcherNode);
+        memcpy(dst, nodes, n);
+        memcpy(dst + n, &next_block, sizeof(uint32_t));
+        memcpy(dst + n + sizeof(uint32_t), &free_index, sizeof(uint32_t));
+    }
+
+    void fromBytes(const uint8_t* src) {
+        size_t n = width * sizeof(WatcherNode);
+        memcpy(nodes, src, n);
+        memcpy(&next_block, src + n, sizeof(uint32_t));
+        memcpy(&free_index, src + n + sizeof(uint32_t), sizeof(uint32_t));
+    }
+
+    // byte offset of node i inside the on-memory block
+    static size_t nodeOffset(int i) { return i * sizeof(WatcherNode); }
 
-    WatcherBlock() : next_block(0), free_index(PROPAGATORS), padding(0) {}
+    uint32_t validMask() const { return validNodeMask(nodes, width); }
 
     uint32_t countValidNodes() const {
-        uint32_t count = 0;
-        for (int i = 0; i < PROPAGATORS; i++) {
-            count += nodes[i].valid;
-        }
-        return count;
+        return __builtin_popcount(validMask());
     }
     
     // Check if this block is in the free list
     bool isInFreeList() const {
-        return free_index < PROPAGATORS;
+        return (int)free_index < width;
     }
 
     // find next free slot, prioritizing slots not used in free list
     int findNextFreeNode() const {
-        if (free_index == PROPAGATORS) return -1;
-        for (int i = 0; i < PROPAGATORS; i++) {
-            if (!nodes[i].valid && i != free_index) return i;
+        if ((int)free_index == width) return -1;
+        for (int i = 0; i < width; i++) {
+            if (!nodes[i].valid && i != (int)free_index) return i;
         }
         return free_index;
     }
     
-    // Get the actual next block address (without free_index bits)
+    // Get the actual next block address
     uint32_t getNextBlock() const {
-        return next_block << 3;
+        return next_block;
     }
     
-    // Set the next block address while preserving the free_index
+    // Set the next block address (blocks are 8-byte aligned)
     void setNextBlock(uint32_t addr) {
-        next_block = addr >> 3;
+        assert((addr & 0x7) == 0);
+        next_block = addr;
     }
 };
 
 // Metadata for each watch list
+// On-memory layout: head_ptr, free_head, pre_watchers[pre_watchers]
 struct WatchMetaData {
     uint32_t head_ptr;      // Head pointer to the first block
     uint32_t free_head;     // Head ptr of free list (block_addr | node_idx)
-    WatcherNode pre_watchers[PRE_WATCHERS];  // Pre-watchers stored directly in metadata
+    WatcherNode pre_watchers[MAX_PRE_WATCHERS];  // Pre-watchers stored directly in metadata
 
     WatchMetaData() : head_ptr(0), free_head(0) {}
+
+    static constexpr size_t bytes(int pre) { return 2 * sizeof(uint32_t) + pre * sizeof(WatcherNode); }
+    static size_t preWatcherOffset(int i) { return 2 * sizeof(uint32_t) + i * sizeof(WatcherNode); }
+
+    void toBytes(uint8_t* dst, int pre) const {
+        memcpy(dst, &head_ptr, sizeof(uint32_t));
+        memcpy(dst + sizeof(uint32_t), &free_head, sizeof(uint32_t));
+        memcpy(dst + preWatcherOffset(0), pre_watchers, pre * sizeof(WatcherNode));
+    }
+
+    void fromBytes(const uint8_t* src, int pre) {
+        memcpy(&head_ptr, src, sizeof(uint32_t));
+        memcpy(&free_head, src + sizeof(uint32_t), sizeof(uint32_t));
+        memcpy(pre_watchers, src + preWatcherOffset(0), pre * sizeof(WatcherNode));
+    }
 };
 
 class Watches : public AsyncBase {
 public:
     Watches(int verbose = 0, SST::Interfaces::StandardMem* mem = nullptr,
             uint64_t watches_base_addr = 0, uint64_t nodes_base_addr = 0,
-            coro_t::push_type** yield_ptr = nullptr)
+            coro_t::push_type** yield_ptr = nullptr,
+            int propagators = 1, int pre_watchers = 0)
         : AsyncBase("WATCH-> ", verbose, mem, yield_ptr), 
           watches_base_addr(watches_base_addr), 
           nodes_base_addr(nodes_base_addr), 
           next_free_block(nodes_base_addr),
-          block_size(sizeof(WatcherBlock)) {
+          propagators(propagators),
+          pre_watchers(pre_watchers),
+          block_size(WatcherBlock::bytes(propagators)),
+          meta_size(WatchMetaData::bytes(pre_watchers)),
+          binary_watchers(false),
+          placement(PLACE_PACKED),
+          clauses_base_addr(0),
+          nodes_end(nodes_base_addr),
+          num_colocated(0) {
+        free_idx_bits = 1;
+        while (free_idx_bits < propagators) free_idx_bits <<= 1;
         output.verbose(CALL_INFO, 1, 0, 
             "base addresses: watchlist=0x%lx, nodes=0x%lx\n", 
             watches_base_addr, nodes_base_addr);
     }
 
     // Memory address calculations
-    uint64_t watchesAddr(int idx) const { return watches_base_addr + idx * sizeof(WatchMetaData); }
+    uint64_t watchesAddr(int idx) const { return watches_base_addr + idx * meta_size; }
+    int blockWidth() const { return propagators; }
+    int numPreWatchers() const { return pre_watchers; }
+    WatcherBlock newBlock() const { return WatcherBlock(propagators); }
     // only support one worker at a time for now
     bool isBusy(int lit_idx) const { return busy.find(lit_idx) != busy.end(); }
+    // Mark the watchers of binary clauses (see WatcherNode)
+    void setBinaryWatchers(bool on) { binary_watchers = on; }
+    bool binaryWatchers() const { return binary_watchers; }
+    // initWatches lays out the original clause addresses like Clauses does
+    void setClausePlacement(ClausePlacement p, uint64_t base) { placement = p; clauses_base_addr = base; }
+    // Lists that may hold more blocks than their watchers need. updateBlock
+    // marks a list when it leaves a hole in a block; a full propagation walk
+    // knows the exact count and marks or clears it.
+    void markSparse(int lit_idx) { if (sparse_set.insert(lit_idx).second) sparse_queue.push_back(lit_idx); }
+    void clearSparse(int lit_idx) { sparse_set.erase(lit_idx); }
+    size_t numSparse() const { return sparse_set.size(); }
+    int nextSparse();
+    // Place every block in the memory stripe (see AddressLayout) of the
+    // clause of its first watcher, as given by clause_stripe. Needs the
+    // layout, and must come before initWatches.
+    void setColocation(std::function<int(Cref)> clause_stripe);
+    bool colocating() const { return (bool)clause_stripe; }
+    uint64_t colocatedBlocks() const { return num_colocated; }
+    // End of the allocated watcher blocks
+    uint64_t nodesEnd() const { return colocating() ? nodes_end : next_free_block; }
     
     // helper functions
-    void freeBlock(uint32_t addr) { free_blocks.push(addr); }
-    uint32_t allocateBlock();
+    void freeBlock(uint32_t addr);
+    uint32_t allocateBlock(Cref clause_addr);
     WatchMetaData readMetaData(int lit_idx, int worker_id = 0);
     void writeMetaData(int lit_idx, const WatchMetaData& metadata);
     void writeHeadPointer(int lit_idx, const uint32_t headptr);
     void writeFreeHead(int lit_idx, const uint32_t freehead);
     void writeSize(int lit_idx, const uint32_t size);
     void writePreWatcher(int lit_idx, const WatcherNode node, const int index);
-    void writePreWatchers(int lit_idx, const WatcherNode pre_watchers[PRE_WATCHERS]);
+    void writePreWatchers(int lit_idx, const WatcherNode* pre_watchers);
 
     WatcherBlock readBlock(uint32_t addr, int worker_id = 0);
     void writeBlock(uint32_t addr, const WatcherBlock& block);
@@ -134,21 +236,43 @@ public:
         uint32_t block_addr, int node_idx);
     int removeFromFreeList(int lit_idx, WatchMetaData& metadata, WatcherBlock& block);
 
-    void initWatches(size_t watch_count, std::vector<Clause>& clauses);
+    void initWatches(size_t watch_count, const ClausePool& clauses);
     void updateBlock(int lit_idx, uint32_t prev_addr, uint32_t curr_addr, 
                      WatcherBlock& prev_block, WatcherBlock& curr_block, WatchMetaData& metadata);
-    int insertWatcher(int lit_idx, Cref clause_addr, Lit blocker, int worker_id = 0);
+    int insertWatcher(int lit_idx, Cref clause_addr, Lit blocker, int worker_id = 0, bool binary = false);
     void removeWatcher(int lit_idx, Cref clause_addr);
+    void removeWatchers(int lit_idx, const std::unordered_set<Cref>& dead);
+    void relocateWatchers(int lit_idx, const std::unordered_map<Cref, Cref>& moved);
+    int compactList(int lit_idx, int worker_id = 0);
 
     
 private:
     uint64_t watches_base_addr;    // Base address of the watches array (head pointers)
     uint64_t nodes_base_addr;      // Base address for watcher nodes
     uint32_t next_free_block;      // Next free address for block allocation
+    int propagators;               // Nodes per watcher block
+    int pre_watchers;              // Pre-watchers per metadata entry
+    int free_idx_bits;             // next power of 2 of propagators
     size_t block_size;             // Size of a watcher block in bytes
+    size_t meta_size;              // Size of a metadata entry in bytes
+    bool binary_watchers;          // flag binary clauses in their watchers
+    ClausePlacement placement;     // of the original clauses
+    uint64_t clauses_base_addr;
     
     // Free list for recycling blocks
     std::queue<uint32_t> free_blocks;
+
+    // Colocation: a bump pointer and a free list per stripe
+    std::function<int(Cref)> clause_stripe;
+    std::vector<uint32_t> stripe_next;
+    std::vector<std::queue<uint32_t>> stripe_free;
+    uint32_t nodes_end;
+    uint64_t num_colocated;
+
+    // sparse list candidates in marking order; queue entries no longer in
+    // the set were cleared and are skipped
+    std::deque<int> sparse_queue;
+    std::unordered_set<int> sparse_set;
     
     // literal indices that are currently busy
     std::unordered_set<int> busy;
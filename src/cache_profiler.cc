@@ -1,13 +1,46 @@
 #include <sst/core/sst_config.h>
 #include "cache_profiler.h"
 #include <sst/core/statapi/stataccumulator.h>
-#include <unordered_set> // Add this for the unordered_set
+#include <cstring>
 
 using namespace SST;
 using namespace SST::MemHierarchy;
 using namespace SST::SATSolver;
 
-CacheProfiler::CacheProfiler(ComponentId_t id, Params& params) : CacheListener(id, params) {
+namespace {
+
+// Statistic prefixes and table labels, in Region order
+const char* const REGION_STAT[CacheProfiler::NUM_REGIONS] = {
+    "heap", "indices", "variables", "watches", "watch_nodes", "clauses_cmd", "clauses", "var_activity"
+};
+const char* const REGION_LABEL[CacheProfiler::NUM_REGIONS] = {
+    "Heap", "Indices", "Variables", "Watches", "WatchNodes", "ClausesCmd", "Clauses", "VarActivity"
+};
+const char* const REGION_PARAM[CacheProfiler::NUM_REGIONS] = {
+    "heap_base_addr", "indices_base_addr", "variables_base_addr", "watches_base_addr",
+    "watch_nodes_base_addr", "clauses_cmd_base_addr", "clauses_base_addr", "var_act_base_addr"
+};
+const char* const REGION_DEFAULT[CacheProfiler::NUM_REGIONS] = {
+    "0x00000000", "0x10000000", "0x20000000", "0x30000000",
+    "0x40000000", "0x50000000", "0x60000000", "0x70000000"
+};
+
+// SolverState order (satsolver.h)
+const char* const PHASE_NAME[CacheProfiler::NUM_PHASES] = {
+    "idle", "init", "step", "propagate", "decide", "analyze", "minimize",
+    "btlevel", "backtrack", "reduce", "restart", "wait_heap", "done"
+};
+
+int reuseBin(uint64_t d) { return d == 0 ? 0 : 64 - __builtin_clzll(d); }
+
+} // namespace
+
+const char* CacheProfiler::phaseName(int phase) {
+    return (phase >= 0 && phase < NUM_PHASES) ? PHASE_NAME[phase] : "unknown";
+}
+
+CacheProfiler::CacheProfiler(ComponentId_t id, Params& params) : CacheListener(id, params),
+    sampler(params.find<double>("reuse_sample_rate", 0.01)) {
     output.init("CacheProfiler -> ", 
                  params.find<int>("verbose", 0),
                  0,
@@ -20,24 +53,62 @@ CacheProfiler::CacheProfiler(ComponentId_t id, Params& params) : CacheListener(i
     output.verbose(CALL_INFO, 2, 0, "Exclude cold misses: %s\n", 
                    exclude_cold_misses ? "true" : "false");
 
-    // Get base addresses for each data structure from the solver
-    heap_base_addr = std::stoull(params.find<std::string>("heap_base_addr", "0x00000000"), nullptr, 0);
-    variables_base_addr = std::stoull(params.find<std::string>("variables_base_addr", "0x20000000"), nullptr, 0);
-    watches_base_addr = std::stoull(params.find<std::string>("watches_base_addr", "0x30000000"), nullptr, 0);
-    clauses_cmd_base_addr = std::stoull(params.find<std::string>("clauses_cmd_base_addr", "0x50000000"), nullptr, 0);
-    var_act_base_addr = std::stoull(params.find<std::string>("var_act_base_addr", "0x70000000"), nullptr, 0);
-
-    // Register statistics
-    heap_hits = registerStatistic<uint64_t>("heap_hits");
-    heap_misses = registerStatistic<uint64_t>("heap_misses");
-    variables_hits = registerStatistic<uint64_t>("variables_hits");
-    variables_misses = registerStatistic<uint64_t>("variables_misses");
-    watches_hits = registerStatistic<uint64_t>("watches_hits");
-    watches_misses = registerStatistic<uint64_t>("watches_misses");
-    clauses_hits = registerStatistic<uint64_t>("clauses_hits");
-    clauses_misses = registerStatistic<uint64_t>("clauses_misses");
-    var_activity_hits = registerStatistic<uint64_t>("var_activity_hits");
-    var_activity_misses = registerStatistic<uint64_t>("var_activity_misses");
+    line_size = params.find<uint64_t>("line_size", 64);
+    sst_assert(line_size > 0, CALL_INFO, -1, "line_size must be positive\n");
+
+    // Get base addresses for each data structure from the solver; an access
+    // belongs to the region with the highest base at or below its address
+    for (int i = 0; i < NUM_REGIONS; i++) {
+        RegionProfile& r = regions[i];
+        r.base = std::stoull(params.find<std::string>(REGION_PARAM[i], REGION_DEFAULT[i]), nullptr, 0);
+        region_table.addRegion(REGION_PARAM[i], r.base, i);
+        memset(r.reuse_bins, 0, sizeof(r.reuse_bins));
+        memset(r.phase_hits, 0, sizeof(r.phase_hits));
+        memset(r.phase_misses, 0, sizeof(r.phase_misses));
+
+        // Register statistics
+        std::string prefix = REGION_STAT[i];
+        r.hits = registerStatistic<uint64_t>(prefix + "_hits");
+        r.misses = registerStatistic<uint64_t>(prefix + "_misses");
+        r.cold_misses = registerStatistic<uint64_t>(prefix + "_cold_misses");
+        r.reuse = registerStatistic<uint64_t>(prefix + "_reuse");
+    }
+    std::string err = region_table.finalize(line_size);
+    if (!err.empty()) output.fatal(CALL_INFO, -1, "%s\n", err.c_str());
+    output.verbose(CALL_INFO, 2, 0, "Reuse sample rate: %.4f\n", sampler.sampleRate());
+
+    for (int p = 0; p < NUM_PHASES; p++) {
+        phase_hits[p] = registerStatistic<uint64_t>("phase_hits", PHASE_NAME[p]);
+        phase_misses[p] = registerStatistic<uint64_t>("phase_misses", PHASE_NAME[p]);
+    }
+
+    phase = 0;  // IDLE until the solver reports
+    phase_link = configureLink("phase_port",
+        new Event::Handler2<CacheProfiler, &CacheProfiler::handlePhase>(this));
+}
+
+void CacheProfiler::handlePhase(SST::Event* ev) {
+    SolverPhaseEvent* pe = static_cast<SolverPhaseEvent*>(ev);
+    sst_assert(pe->phase < NUM_PHASES, CALL_INFO, -1, "Unknown solver phase %u\n", pe->phase);
+    phase = pe->phase;
+    delete ev;
+}
+
+CacheProfiler::Region CacheProfiler::classify(Addr addr) const {
+    int i = region_table.classify(addr);
+    if (i < 0) output.fatal(CALL_INFO, -1, "Unknown address 0x%lx\n", addr);
+    return (Region)i;
+}
+
+bool CacheProfiler::touch(RegionProfile& r, Addr addr) {
+    uint64_t line = (addr - r.base) / line_size;
+    size_t word = line / 64;
+    if (word >= r.touched.size())
+        r.touched.resize(std::max(word + 1, 2 * r.touched.size()), 0);
+    uint64_t bit = 1ull << (line % 64);
+    bool first = !(r.touched[word] & bit);
+    r.touched[word] |= bit;
+    return first;
 }
 
 void CacheProfiler::notifyAccess(const CacheListenerNotification& notify) {
@@ -45,58 +116,40 @@ void CacheProfiler::notifyAccess(const CacheListenerNotification& notify) {
     const NotifyResultType notifyResType = notify.getResultType();
     Addr addr = notify.getPhysicalAddress();
 
-    // if (notifyType == EVICT && addr < variables_base_addr) {
-    //     printf("Cache eviction at physical 0x%lx, result type %d\n", addr, notifyResType);
-    // }
-
     if (notifyType != READ && notifyType != WRITE) {
         return; // Only handle read and write accesses
     }
-    
-    // Track if this is a cold miss (first access to this address)
-    bool is_cold_miss = false;
-    if (exclude_cold_misses && notifyResType == MISS && accessed_addresses.find(addr) == accessed_addresses.end()) {
-        is_cold_miss = true;
-        accessed_addresses.insert(addr); // Mark as accessed for future reference
-    } else if (exclude_cold_misses) {
-        // If we're excluding cold misses, make sure we mark any address we see
-        accessed_addresses.insert(addr);
+
+    // Identify which data structure this access belongs to
+    Region region = classify(addr);
+    RegionProfile& r = regions[region];
+
+    // A cold miss is a miss on a line never accessed before
+    bool first_touch = touch(r, addr);
+    bool hit = notifyResType == HIT;
+    bool is_cold_miss = !hit && first_touch;
+
+    if (hit) {
+        r.hits->addData(1);
+        r.phase_hits[phase]++;
+        phase_hits[phase]->addData(1);
+    } else {
+        if (is_cold_miss) r.cold_misses->addData(1);
+        if (!exclude_cold_misses || !is_cold_miss) {
+            r.misses->addData(1);
+            r.phase_misses[phase]++;
+            phase_misses[phase]->addData(1);
+        }
     }
 
-    // Identify which data structure this access belongs to and update statistics
-    if (addr >= var_act_base_addr) {
-        // Variable activity
-        if (notifyResType == HIT) 
-            var_activity_hits->addData(1);
-        else if (!exclude_cold_misses || !is_cold_miss)
-            var_activity_misses->addData(1);
-    } else if (addr >= clauses_cmd_base_addr) {
-        // Clauses
-        if (notifyResType == HIT) 
-            clauses_hits->addData(1);
-        else if (!exclude_cold_misses || !is_cold_miss)
-            clauses_misses->addData(1);
-    } else if (addr >= watches_base_addr) {
-        // Watches
-        if (notifyResType == HIT) 
-            watches_hits->addData(1);
-        else if (!exclude_cold_misses || !is_cold_miss)
-            watches_misses->addData(1);
-    } else if (addr >= variables_base_addr) {
-        // Variables
-        if (notifyResType == HIT) 
-            variables_hits->addData(1);
-        else if (!exclude_cold_misses || !is_cold_miss)
-            variables_misses->addData(1);
-    } else if (addr >= heap_base_addr) {
-        // Heap
-        // if (notifyType == WRITE) printf("CACHE write: 0x%lx, physical 0x%lx, notifyResType %d\n", notify.getTargetAddress(), addr, notifyResType);
-        // else printf("CACHE read: 0x%lx, physical 0x%lx, notifyResType %d\n", notify.getTargetAddress(), addr, notifyResType);
-        if (notifyResType == HIT) 
-            heap_hits->addData(1);
-        else if (!exclude_cold_misses || !is_cold_miss)
-            heap_misses->addData(1);
-    } else output.fatal(CALL_INFO, -1, "Unknown address 0x%lx\n", addr);
+    uint64_t line = addr / line_size;
+    if (sampler.enabled() && sampler.sampled(line)) {
+        int64_t dist = sampler.access(line);
+        if (dist != ReuseSampler::COLD) {
+            r.reuse->addData((uint64_t)dist);
+            r.reuse_bins[reuseBin((uint64_t)dist)]++;
+        }
+    }
 }
 
 
@@ -106,6 +159,7 @@ void CacheProfiler::printStats(Output& output) {
     // Calculate statistics for each data structure
     uint64_t total_hits = 0;
     uint64_t total_misses = 0;
+    uint64_t total_cold = 0;
     
     // Helper function to get the count from a statistic
     auto getStatCount = [](Statistic<uint64_t>* stat) -> uint64_t {
@@ -116,31 +170,73 @@ void CacheProfiler::printStats(Output& output) {
         return 0; // Return 0 if the cast fails
     };
     
-    // Helper lambda to print stats for a data structure
-    auto printStats = [&](const std::string& name, Statistic<uint64_t>* hits, Statistic<uint64_t>* misses) {
-        uint64_t h = getStatCount(hits);
-        uint64_t m = getStatCount(misses);
+    // Print stats for each data structure
+    for (int i = 0; i < NUM_REGIONS; i++) {
+        uint64_t h = getStatCount(regions[i].hits);
+        uint64_t m = getStatCount(regions[i].misses);
+        uint64_t c = getStatCount(regions[i].cold_misses);
         uint64_t total = h + m;
         double miss_rate = (total > 0) ? (double)m / total * 100.0 : 0.0;
         
-        output.output("  %-12s: %10lu hits, %10lu misses, %10lu total, %6.2f%% miss rate\n",
-               name.c_str(), h, m, total, miss_rate);
+        output.output("  %-12s: %10lu hits, %10lu misses, %10lu total, %6.2f%% miss rate, %10lu cold misses\n",
+               REGION_LABEL[i], h, m, total, miss_rate, c);
         
         total_hits += h;
         total_misses += m;
-    };
-    
-    // Print stats for each data structure
-    printStats("Heap", heap_hits, heap_misses);
-    printStats("Variables", variables_hits, variables_misses);
-    printStats("Watches", watches_hits, watches_misses);
-    printStats("Clauses", clauses_hits, clauses_misses);
-    printStats("VarActivity", var_activity_hits, var_activity_misses);
+        total_cold += c;
+    }
     
     // Print total stats
     uint64_t total = total_hits + total_misses;
     double overall_miss_rate = (total > 0) ? (double)total_misses / total * 100.0 : 0.0;
-    output.output("  %-12s: %10lu hits, %10lu misses, %10lu total, %6.2f%% miss rate\n",
-           "TOTAL", total_hits, total_misses, total, overall_miss_rate);
+    output.output("  %-12s: %10lu hits, %10lu misses, %10lu total, %6.2f%% miss rate, %10lu cold misses\n",
+           "TOTAL", total_hits, total_misses, total, overall_miss_rate, total_cold);
+
+    // Reuse: the capacity in lines of a fully associative LRU cache that
+    // would turn the given share of each region's sampled reuses into hits.
+    // Bin upper bounds, so the capacities are rounded up to powers of two.
+    if (sampler.enabled() && sampler.sampledAccesses() > 0) {
+        output.output("  Reuse distance (%.2f%% of lines sampled, %zu lines, %lu accesses), "
+                      "capacity for 50%% / 90%% / 99%% of reuses:\n",
+            sampler.sampleRate() * 100.0, sampler.sampledLines(), sampler.sampledAccesses());
+        for (int i = 0; i < NUM_REGIONS; i++) {
+            const RegionProfile& r = regions[i];
+            uint64_t n = 0;
+            for (int b = 0; b < REUSE_BINS; b++) n += r.reuse_bins[b];
+            if (n == 0) continue;
+            uint64_t cap[3] = {0, 0, 0};
+            const double share[3] = {0.5, 0.9, 0.99};
+            for (int q = 0; q < 3; q++) {
+                uint64_t acc = 0;
+                for (int b = 0; b < REUSE_BINS; b++) {
+                    acc += r.reuse_bins[b];
+                    if (acc >= share[q] * n) {
+                        cap[q] = b == 0 ? 1 : (b >= 64 ? UINT64_MAX : (1ull << b));
+                        break;
+                    }
+                }
+            }
+            output.output("  %-12s: %10lu reuses, %10lu / %10lu / %10lu lines\n", REGION_LABEL[i], n,
+                cap[0], cap[1], cap[2]);
+        }
+    }
+
+    // Misses by solver phase and region, for the phases that saw accesses
+    if (phase_link) {
+        output.output("  Misses by solver phase:\n  %-12s", "");
+        for (int i = 0; i < NUM_REGIONS; i++) output.output(" %11s", REGION_LABEL[i]);
+        output.output(" %7s\n", "miss%");
+        for (int p = 0; p < NUM_PHASES; p++) {
+            uint64_t h = 0, m = 0;
+            for (int i = 0; i < NUM_REGIONS; i++) {
+                h += regions[i].phase_hits[p];
+                m += regions[i].phase_misses[p];
+            }
+            if (h + m == 0) continue;
+            output.output("  %-12s", PHASE_NAME[p]);
+            for (int i = 0; i < NUM_REGIONS; i++) output.output(" %11lu", regions[i].phase_misses[p]);
+            output.output(" %6.2f%%\n", (double)m / (h + m) * 100.0);
+        }
+    }
     output.output("==============================================================================\n");
 }
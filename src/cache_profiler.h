@@ -10,7 +10,11 @@
 #include <sst/elements/memHierarchy/memEvent.h>
 #include <sst/elements/memHierarchy/cacheListener.h>
 #include <string>
-#include <unordered_set>
+#include <vector>
+
+#include "structs.h"
+#include "reuse_sampler.h"
+#include "address_layout.h"
 
 using namespace SST;
 using namespace SST::MemHierarchy;
@@ -25,6 +29,8 @@ public:
 
     void notifyAccess(const CacheListenerNotification& notify);
     void printStats(Output& out);
+
+    static const char* phaseName(int phase);
     
     SST_ELI_REGISTER_SUBCOMPONENT(
         CacheProfiler,
@@ -38,55 +44,108 @@ public:
     SST_ELI_DOCUMENT_PARAMS(
         { "cache_level", "Cache level (L1, L2, L3) for reporting", "unknown" },
         { "heap_base_addr", "Base address for heap data", "0x00000000" },
+        { "indices_base_addr", "Base address for heap index data", "0x10000000" },
         { "variables_base_addr", "Base address for variables data", "0x20000000" },
-        { "watches_base_addr", "Base address for watches data", "0x30000000" },
+        { "watches_base_addr", "Base address for watch list metadata", "0x30000000" },
+        { "watch_nodes_base_addr", "Base address for watcher blocks", "0x40000000" },
         { "clauses_cmd_base_addr", "Base address for clauses command data", "0x50000000" },
+        { "clauses_base_addr", "Base address for clause data", "0x60000000" },
         { "var_act_base_addr", "Base address for variable activity data", "0x70000000" },
+        { "line_size", "Cache line size in bytes, the granularity of cold misses and reuse distances", "64" },
+        { "reuse_sample_rate", "Fraction of cache lines sampled for reuse distances (0 disables)", "0.01" },
         { "verbose", "Verbosity level", "0" },
         { "exclude_cold_misses", "Exclude cold misses when counting cache misses", "0" }
     )
 
+    SST_ELI_DOCUMENT_PORTS(
+        {"phase_port", "Solver phase changes, from a SATSolver profile_port (optional)", {"SolverPhaseEvent"}}
+    )
+
     SST_ELI_DOCUMENT_STATISTICS(
         { "heap_hits", "Number of heap hits", "count", 1 },
         { "heap_misses", "Number of heap misses", "count", 1 },
+        { "heap_cold_misses", "Number of heap misses on a line never accessed before", "count", 1 },
+        { "heap_reuse", "Sampled reuse distance of heap accesses, in distinct cache lines", "lines", 2 },
+        { "indices_hits", "Number of heap index hits", "count", 1 },
+        { "indices_misses", "Number of heap index misses", "count", 1 },
+        { "indices_cold_misses", "Number of heap index misses on a line never accessed before", "count", 1 },
+        { "indices_reuse", "Sampled reuse distance of heap index accesses, in distinct cache lines", "lines", 2 },
         { "variables_hits", "Number of variables hits", "count", 1 },
         { "variables_misses", "Number of variables misses", "count", 1 },
-        { "watches_hits", "Number of watches hits", "count", 1 },
-        { "watches_misses", "Number of watches misses", "count", 1 },
-        { "clauses_hits", "Number of clauses hits", "count", 1 },
-        { "clauses_misses", "Number of clauses misses", "count", 1 },
+        { "variables_cold_misses", "Number of variables misses on a line never accessed before", "count", 1 },
+        { "variables_reuse", "Sampled reuse distance of variables accesses, in distinct cache lines", "lines", 2 },
+        { "watches_hits", "Number of watch list metadata hits", "count", 1 },
+        { "watches_misses", "Number of watch list metadata misses", "count", 1 },
+        { "watches_cold_misses", "Number of watch list metadata misses on a line never accessed before", "count", 1 },
+        { "watches_reuse", "Sampled reuse distance of watch list metadata accesses, in distinct cache lines", "lines", 2 },
+        { "watch_nodes_hits", "Number of watcher block hits", "count", 1 },
+        { "watch_nodes_misses", "Number of watcher block misses", "count", 1 },
+        { "watch_nodes_cold_misses", "Number of watcher block misses on a line never accessed before", "count", 1 },
+        { "watch_nodes_reuse", "Sampled reuse distance of watcher block accesses, in distinct cache lines", "lines", 2 },
+        { "clauses_cmd_hits", "Number of clause command hits", "count", 1 },
+        { "clauses_cmd_misses", "Number of clause command misses", "count", 1 },
+        { "clauses_cmd_cold_misses", "Number of clause command misses on a line never accessed before", "count", 1 },
+        { "clauses_cmd_reuse", "Sampled reuse distance of clause command accesses, in distinct cache lines", "lines", 2 },
+        { "clauses_hits", "Number of clause data hits", "count", 1 },
+        { "clauses_misses", "Number of clause data misses", "count", 1 },
+        { "clauses_cold_misses", "Number of clause data misses on a line never accessed before", "count", 1 },
+        { "clauses_reuse", "Sampled reuse distance of clause data accesses, in distinct cache lines", "lines", 2 },
         { "var_activity_hits", "Number of variable activity hits", "count", 1 },
         { "var_activity_misses", "Number of variable activity misses", "count", 1 },
+        { "var_activity_cold_misses", "Number of variable activity misses on a line never accessed before", "count", 1 },
+        { "var_activity_reuse", "Sampled reuse distance of variable activity accesses, in distinct cache lines", "lines", 2 },
+        { "phase_hits", "Number of hits per solver phase (subId: phase name)", "count", 1 },
+        { "phase_misses", "Number of misses per solver phase (subId: phase name)", "count", 1 },
     )
 
+    // Data structures, in the solver's default base address order
+    enum Region { HEAP, INDICES, VARIABLES, WATCHES, WATCH_NODES, CLAUSES_CMD, CLAUSES, VAR_ACTIVITY, NUM_REGIONS };
+    static const int NUM_PHASES = 13;   // SolverState values, IDLE..DONE
+    static const int REUSE_BINS = 65;   // 0, then [2^(b-1), 2^b) for b = 1..64
+
 private:
+    struct RegionProfile {
+        uint64_t base;
+        // One bit per line touched so far, for cold-miss detection. Grown
+        // on demand, so the cost follows the footprint of the region.
+        std::vector<uint64_t> touched;
+        uint64_t reuse_bins[REUSE_BINS];
+        uint64_t phase_hits[NUM_PHASES];
+        uint64_t phase_misses[NUM_PHASES];
+
+        Statistic<uint64_t>* hits;
+        Statistic<uint64_t>* misses;
+        Statistic<uint64_t>* cold_misses;
+        Statistic<uint64_t>* reuse;
+    };
+
     SST::Output output;
     std::string cache_level;
 
-    // Address ranges for different data structures
-    uint64_t heap_base_addr;
-    uint64_t variables_base_addr;
-    uint64_t watches_base_addr; 
-    uint64_t clauses_cmd_base_addr;
-    uint64_t var_act_base_addr;
-    
+    RegionProfile regions[NUM_REGIONS];
+    // Bases in any order. Physical addresses classify like logical ones,
+    // the solver's address_layout never moves data across regions.
+    AddressLayout region_table;
+    uint64_t line_size;
+
     // Flag for excluding cold misses
     bool exclude_cold_misses;
-    
-    // Track accessed addresses to identify cold misses
-    std::unordered_set<Addr> accessed_addresses;
-
-    // Statistics
-    Statistic<uint64_t>* heap_hits;
-    Statistic<uint64_t>* heap_misses;
-    Statistic<uint64_t>* variables_hits;
-    Statistic<uint64_t>* variables_misses;
-    Statistic<uint64_t>* watches_hits;
-    Statistic<uint64_t>* watches_misses;
-    Statistic<uint64_t>* clauses_hits;
-    Statistic<uint64_t>* clauses_misses;
-    Statistic<uint64_t>* var_activity_hits;
-    Statistic<uint64_t>* var_activity_misses;
+
+    // Spatially sampled reuse distances over all regions together, as a
+    // fully associative cache holding every structure would see them
+    ReuseSampler sampler;
+
+    // Current solver phase, as of the last SolverPhaseEvent. Accesses reach
+    // the cache a few cycles after the solver issued them, so accesses right
+    // at a phase change can be attributed to the neighbouring phase.
+    SST::Link* phase_link;
+    uint8_t phase;
+    Statistic<uint64_t>* phase_hits[NUM_PHASES];
+    Statistic<uint64_t>* phase_misses[NUM_PHASES];
+
+    Region classify(Addr addr) const;
+    bool touch(RegionProfile& r, Addr addr);  // true on the first access to the line
+    void handlePhase(SST::Event* ev);
 };
 
 } // namespace SATSolver
@@ -0,0 +1,138 @@
+#include <sst/core/sst_config.h>
+#include "clause_scratchpad.h"
+#include <algorithm>
+#include <cstring>
+
+using SST::Interfaces::StandardMem;
+
+ClauseScratchpad::ClauseScratchpad(SST::ComponentId_t id, SST::Params& params)
+    : SST::SubComponent(id), policy(POLICY_RECENT), used_(0),
+      num_hits(0), num_misses(0), bytes_saved(0), num_evictions(0) {
+    output.init("SCRATCH-> ", params.find<int>("verbose", 0), 0, SST::Output::STDOUT);
+
+    capacity_ = params.find<uint64_t>("size", 16384);
+    lbd_limit = params.find<int>("lbd_limit", 3);
+    policy_name = params.find<std::string>("policy", "recent");
+    if (policy_name == "recent") policy = POLICY_RECENT;
+    else if (policy_name == "lbd") policy = POLICY_LBD;
+    else if (policy_name == "small") policy = POLICY_SMALL;
+    else output.fatal(CALL_INFO, -1, "Unknown scratchpad policy '%s' (recent, lbd or small)\n",
+                      policy_name.c_str());
+
+    resp_link = configureSelfLink("resp", params.find<std::string>("latency", "2ns"),
+        new SST::Event::Handler2<ClauseScratchpad, &ClauseScratchpad::handleResponse>(this));
+
+    stat_hits = registerStatistic<uint64_t>("hits");
+    stat_misses = registerStatistic<uint64_t>("misses");
+    stat_bytes_saved = registerStatistic<uint64_t>("bytes_saved");
+    stat_pins = registerStatistic<uint64_t>("pins");
+    stat_evictions = registerStatistic<uint64_t>("evictions");
+
+    output.verbose(CALL_INFO, 1, 0, "%lu bytes, policy %s\n", capacity_, policy_name.c_str());
+}
+
+bool ClauseScratchpad::admits(Offer why, uint32_t lits, int lbd) const {
+    switch (policy) {
+    case POLICY_RECENT: return true;  // every offer is a recent learn or conflict
+    case POLICY_LBD:    return lbd > 0 && lbd <= lbd_limit;
+    case POLICY_SMALL:  return lits <= 3;
+    }
+    return false;
+}
+
+void ClauseScratchpad::pin(uint64_t addr, const uint8_t* data, size_t size) {
+    if (size == 0 || size > capacity_) return;
+
+    auto it = entries.find(addr);
+    if (it != entries.end() && it->second.data.size() == size) {
+        // already pinned: refresh the copy and its LRU position
+        memcpy(it->second.data.data(), data, size);
+        lru.splice(lru.begin(), lru, it->second.lru_pos);
+        return;
+    }
+
+    // drop copies overlapping the new range (a block reused after a free)
+    it = entries.upper_bound(addr);
+    if (it != entries.begin() && std::prev(it)->first + std::prev(it)->second.data.size() > addr) --it;
+    while (it != entries.end() && it->first < addr + size) {
+        auto next = std::next(it);
+        unpin(it->first);
+        it = next;
+    }
+
+    while (used_ + size > capacity_) {
+        evict(entries.find(lru.back()));
+    }
+
+    Entry& e = entries[addr];
+    e.data.assign(data, data + size);
+    lru.push_front(addr);
+    e.lru_pos = lru.begin();
+    used_ += size;
+    stat_pins->addData(1);
+    output.verbose(CALL_INFO, 7, 0, "Pinned [0x%lx, +%zu), %lu/%lu bytes used\n",
+                   addr, size, used_, capacity_);
+}
+
+void ClauseScratchpad::unpin(uint64_t addr) {
+    auto it = entries.find(addr);
+    if (it == entries.end()) return;
+    used_ -= it->second.data.size();
+    lru.erase(it->second.lru_pos);
+    entries.erase(it);
+}
+
+void ClauseScratchpad::evict(std::map<uint64_t, Entry>::iterator it) {
+    output.verbose(CALL_INFO, 7, 0, "Evicting [0x%lx, +%zu)\n", it->first, it->second.data.size());
+    num_evictions++;
+    stat_evictions->addData(1);
+    unpin(it->first);
+}
+
+void ClauseScratchpad::clear() {
+    entries.clear();
+    lru.clear();
+    used_ = 0;
+}
+
+bool ClauseScratchpad::serve(StandardMem::Read* req) {
+    uint64_t addr = req->pAddr;
+    uint64_t size = req->size;
+    auto it = entries.upper_bound(addr);
+    if (it == entries.begin() || addr + size > std::prev(it)->first + std::prev(it)->second.data.size()) {
+        num_misses++;
+        stat_misses->addData(1);
+        return false;
+    }
+    --it;
+    lru.splice(lru.begin(), lru, it->second.lru_pos);
+
+    const uint8_t* src = it->second.data.data() + (addr - it->first);
+    resp_link->send(new ScratchpadRespEvent(req->getID(), addr, std::vector<uint8_t>(src, src + size)));
+    num_hits++;
+    bytes_saved += size;
+    stat_hits->addData(1);
+    stat_bytes_saved->addDataNTimes(size, 1);
+    output.verbose(CALL_INFO, 8, 0, "Hit at 0x%lx, size %lu, req %lu\n", addr, size, req->getID());
+    delete req;
+    return true;
+}
+
+void ClauseScratchpad::update(uint64_t addr, const uint8_t* data, size_t size) {
+    if (entries.empty()) return;
+    auto it = entries.upper_bound(addr);
+    if (it != entries.begin()) --it;
+    for (; it != entries.end() && it->first < addr + size; ++it) {
+        uint64_t start = std::max(addr, it->first);
+        uint64_t end = std::min(addr + size, it->first + it->second.data.size());
+        if (start >= end) continue;
+        memcpy(it->second.data.data() + (start - it->first), data + (start - addr), end - start);
+    }
+}
+
+void ClauseScratchpad::handleResponse(SST::Event* ev) {
+    auto* sev = static_cast<ScratchpadRespEvent*>(ev);
+    auto* resp = new StandardMem::ReadResp(sev->req_id, sev->addr, sev->data.size(), std::move(sev->data));
+    delete sev;
+    deliver(resp);  // the handler deletes resp
+}
@@ -0,0 +1,140 @@
+#ifndef CLAUSE_SCRATCHPAD_H
+#define CLAUSE_SCRATCHPAD_H
+
+#include <sst/core/event.h>
+#include <sst/core/subcomponent.h>
+#include <sst/core/link.h>
+#include <sst/core/output.h>
+#include <sst/core/interfaces/stdMem.h>
+#include <functional>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Response of a read served by the scratchpad, delayed by the link latency
+class ScratchpadRespEvent : public SST::Event {
+public:
+    uint64_t req_id;
+    uint64_t addr;
+    std::vector<uint8_t> data;
+
+    ScratchpadRespEvent() : req_id(0), addr(0) {}
+    ScratchpadRespEvent(uint64_t req_id, uint64_t addr, std::vector<uint8_t> data)
+        : req_id(req_id), addr(addr), data(std::move(data)) {}
+
+    void serialize_order(SST::Core::Serialization::serializer &ser) override {
+        Event::serialize_order(ser);
+        SST_SER(req_id);
+        SST_SER(addr);
+        SST_SER(data);
+    }
+    ImplementSerializable(ScratchpadRespEvent);
+};
+
+// Software-managed SRAM in front of the clause data region.
+// The solver offers clauses to it (when they are learnt and when they take
+// part in a conflict) and the policy decides which ones are pinned: a copy of
+// the clause bytes is kept here, keyed by memory address, and evicted LRU
+// once the capacity is used up. Clause reads that a pinned copy fully covers
+// never reach the memory hierarchy; the scratchpad answers them with a
+// regular ReadResp after its own latency, so the reorder buffer and worker
+// wake-up paths do not know the difference.
+// Pinned copies are write-through: memory always has the data and the
+// scratchpad only patches its copy, so eviction is free.
+class ClauseScratchpad : public SST::SubComponent {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_API(ClauseScratchpad)
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        ClauseScratchpad, "satsolver", "ClauseScratchpad", SST_ELI_ELEMENT_VERSION(1,0,0),
+        "On-chip scratchpad for hot clauses", ClauseScratchpad
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"size", "Capacity in bytes of pinned clause data", "16384"},
+        {"latency", "Access latency of a hit", "2ns"},
+        {"policy", "Which clauses to pin: recent (learnt or in a recent conflict), lbd (LBD <= lbd_limit), small (binary/ternary)", "recent"},
+        {"lbd_limit", "Largest LBD pinned by the lbd policy", "3"},
+        {"verbose", "Verbosity level", "0"}
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        {"hits", "Clause reads served by the scratchpad", "reads", 1},
+        {"misses", "Clause reads sent to memory", "reads", 1},
+        {"bytes_saved", "Bytes read from the scratchpad instead of memory", "bytes", 1},
+        {"pins", "Clauses pinned", "clauses", 1},
+        {"evictions", "Pinned clauses evicted to make room", "clauses", 1}
+    )
+
+    // Why a clause is offered
+    enum Offer { OFFER_LEARNT, OFFER_CONFLICT };
+
+    ClauseScratchpad(SST::ComponentId_t id, SST::Params& params);
+
+    // Where served responses go (the solver's memory handler)
+    void setResponseHandler(std::function<void(SST::Interfaces::StandardMem::Request*)> h) {
+        deliver = std::move(h);
+    }
+
+    // Policy decision for a clause of lits literals and the given LBD (0 = unknown)
+    bool admits(Offer why, uint32_t lits, int lbd) const;
+
+    // Copy [addr, addr + size) in, making room by LRU eviction.
+    // Clauses larger than the whole scratchpad are not pinned.
+    void pin(uint64_t addr, const uint8_t* data, size_t size);
+    void unpin(uint64_t addr);
+    bool pinned(uint64_t addr) const { return entries.count(addr) != 0; }
+    void clear();
+
+    // Takes ownership of req and answers it if a pinned copy covers it
+    bool serve(SST::Interfaces::StandardMem::Read* req);
+    // Write-through: patch any pinned copies overlapping the write
+    void update(uint64_t addr, const uint8_t* data, size_t size);
+
+    uint64_t capacity() const { return capacity_; }
+    uint64_t used() const { return used_; }
+    uint64_t hits() const { return num_hits; }
+    uint64_t misses() const { return num_misses; }
+    uint64_t bytesSaved() const { return bytes_saved; }
+    uint64_t evictions() const { return num_evictions; }
+    const std::string& policyName() const { return policy_name; }
+
+private:
+    enum Policy { POLICY_RECENT, POLICY_LBD, POLICY_SMALL };
+
+    struct Entry {
+        std::vector<uint8_t> data;
+        std::list<uint64_t>::iterator lru_pos;
+    };
+
+    void handleResponse(SST::Event* ev);
+    void evict(std::map<uint64_t, Entry>::iterator it);
+
+    SST::Output output;
+    SST::Link* resp_link;  // self link carrying the hit latency
+    std::function<void(SST::Interfaces::StandardMem::Request*)> deliver;
+
+    Policy policy;
+    std::string policy_name;
+    int lbd_limit;
+    uint64_t capacity_;
+    uint64_t used_;
+
+    std::map<uint64_t, Entry> entries;  // pinned copies by start address, non-overlapping
+    std::list<uint64_t> lru;            // start addresses, most recently used first
+
+    uint64_t num_hits;
+    uint64_t num_misses;
+    uint64_t bytes_saved;
+    uint64_t num_evictions;
+
+    Statistic<uint64_t>* stat_hits;
+    Statistic<uint64_t>* stat_misses;
+    Statistic<uint64_t>* stat_bytes_saved;
+    Statistic<uint64_t>* stat_pins;
+    Statistic<uint64_t>* stat_evictions;
+};
+
+#endif // CLAUSE_SCRATCHPAD_H
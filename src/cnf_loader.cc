@@ -0,0 +1,403 @@
+#include <sst/core/sst_config.h>
+#include "cnf_loader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const size_t MIN_CHUNK_BYTES = 1 << 20;    // don't split below 1 MiB per thread
+const size_t HASH_BLOCK_BYTES = 16 << 20;  // fixed, so the hash ignores thread count
+const uint32_t CACHE_VERSION = 2;
+const char CACHE_MAGIC[8] = {'S','A','T','C','N','F','C','\0'};
+
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;         // bit 0: sort_clauses
+    uint64_t file_hash;
+    uint64_t file_size;
+    uint32_t num_vars;
+    uint32_t num_clauses;
+    uint32_t unit_clauses;
+    uint32_t num_units;
+    uint64_t num_parsed;
+    uint64_t num_lits;
+    uint64_t payload_hash;  // units, offsets and literals, in file order
+};
+
+inline uint64_t mix64(uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+uint64_t hashBlock(const char* p, size_t n) {
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ n;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t w;
+        memcpy(&w, p + i, 8);
+        h ^= mix64(w);
+        h = ((h << 27) | (h >> 37)) * 0x9e3779b97f4a7c15ULL + 0x52dce729;
+    }
+    uint64_t w = 0;
+    memcpy(&w, p + i, n - i);
+    h ^= mix64(w ^ (n - i));
+    return mix64(h);
+}
+
+// Checksum of everything a cache stores after its header
+uint64_t payloadHash(const ParsedCnf& p) {
+    uint64_t h = mix64(p.clauses.size());
+    h = mix64(h ^ hashBlock(reinterpret_cast<const char*>(p.units.data()), p.units.size() * sizeof(Lit)));
+    h = mix64(h ^ hashBlock(reinterpret_cast<const char*>(p.clauses.offsets.data()),
+                            p.clauses.offsets.size() * sizeof(uint64_t)));
+    h = mix64(h ^ hashBlock(reinterpret_cast<const char*>(p.clauses.lits.data()),
+                            p.clauses.lits.size() * sizeof(Lit)));
+    return h;
+}
+
+// Structural check of a cache payload, so a stale or corrupted file whose
+// checksum happens to match still cannot produce malformed clauses
+bool validPayload(const ParsedCnf& p) {
+    const std::vector<uint64_t>& offsets = p.clauses.offsets;
+    if (offsets.front() != 0 || offsets.back() != p.clauses.lits.size()) return false;
+    for (size_t i = 1; i < offsets.size(); i++) {
+        if (offsets[i] < offsets[i - 1]) return false;
+    }
+    auto is_lit = [](Lit l) { return var(l) >= 1; };  // 0 only terminates clauses
+    return std::all_of(p.clauses.lits.begin(), p.clauses.lits.end(), is_lit)
+        && std::all_of(p.units.begin(), p.units.end(), is_lit);
+}
+
+inline bool isBlank(char c) { return c == ' ' || c == '\t'; }
+
+} // namespace
+
+// Per-chunk parse result. head holds the raw literals before the first
+// terminator (the tail of a clause started in an earlier chunk), tail the raw
+// literals after the last one. Everything in between is complete and already
+// normalized.
+struct CnfLoader::Chunk {
+    std::vector<Lit> head;
+    bool head_closed = false;
+    std::vector<Lit> lits;
+    std::vector<uint64_t> ends;     // end of each complete clause in lits
+    std::vector<Lit> units;         // raw unit clauses, file order
+    std::vector<Lit> tail;
+};
+
+CnfLoader::CnfLoader(int threads, bool sort_clauses)
+    : threads_(threads), sort_clauses_(sort_clauses) {}
+
+int CnfLoader::threadCount(size_t bytes) const {
+    int n = threads_;
+    if (n <= 0) n = std::max(1u, std::thread::hardware_concurrency());
+    size_t by_size = std::max<size_t>(1, bytes / MIN_CHUNK_BYTES);
+    return (int)std::min<size_t>(n, by_size);
+}
+
+uint64_t CnfLoader::hashBuffer(const char* data, size_t size) const {
+    size_t nblocks = (size + HASH_BLOCK_BYTES - 1) / HASH_BLOCK_BYTES;
+    std::vector<uint64_t> block_hash(nblocks);
+    std::atomic<size_t> next(0);
+    auto work = [&]() {
+        for (size_t b; (b = next.fetch_add(1)) < nblocks; ) {
+            size_t off = b * HASH_BLOCK_BYTES;
+            block_hash[b] = hashBlock(data + off, std::min(HASH_BLOCK_BYTES, size - off));
+        }
+    };
+
+    int n = std::min<size_t>(threadCount(size), nblocks);
+    std::vector<std::thread> pool;
+    for (int t = 1; t < n; t++) pool.emplace_back(work);
+    work();
+    for (auto& th : pool) th.join();
+
+    uint64_t h = mix64(size);
+    for (uint64_t bh : block_hash) h = mix64(h ^ bh) + 0x9e3779b97f4a7c15ULL;
+    return h;
+}
+
+bool CnfLoader::load(const std::string& path, const std::string& cache_dir, ParsedCnf& out) {
+    from_cache_ = false;
+    cache_written_ = false;
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error_ = "Failed to open CNF file: " + path;
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        error_ = "Empty or unreadable CNF file: " + path;
+        return false;
+    }
+    size_t size = st.st_size;
+    void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        error_ = "Failed to mmap CNF file: " + path + " (" + strerror(errno) + ")";
+        return false;
+    }
+    madvise(map, size, MADV_SEQUENTIAL);
+    const char* data = static_cast<const char*>(map);
+
+    std::string cache_file;
+    if (!cache_dir.empty()) {
+        hash_ = hashBuffer(data, size);
+        char name[64];
+        snprintf(name, sizeof(name), "%016llx.%s.cnfcache",
+                 (unsigned long long)hash_, sort_clauses_ ? "sorted" : "raw");
+        cache_file = cache_dir + "/" + name;
+        if (readCache(cache_file, size, out)) {
+            from_cache_ = true;
+            munmap(map, size);
+            return true;
+        }
+    }
+
+    bool ok = parseBuffer(data, size, out);
+    munmap(map, size);
+    if (ok && !cache_file.empty()) {
+        mkdir(cache_dir.c_str(), 0755);  // may already exist
+        cache_written_ = writeCache(cache_file, size, out);
+    }
+    return ok;
+}
+
+bool CnfLoader::parseHeader(const char* data, size_t size, size_t& body, ParsedCnf& out) {
+    size_t pos = 0;
+    while (pos < size) {
+        const char* eol = static_cast<const char*>(memchr(data + pos, '\n', size - pos));
+        size_t end = eol ? eol - data : size;
+        size_t f = pos;
+        while (f < end && (isBlank(data[f]) || data[f] == '\r')) f++;
+        if (f < end && data[f] != 'c') {
+            if (data[f] != 'p') break;
+            std::istringstream pline(std::string(data + f, end - f));
+            std::string p, cnf;
+            pline >> p >> cnf;
+            if (cnf != "cnf") {
+                error_ = "Invalid DIMACS format: expected 'cnf' but got '" + cnf + "'";
+                return false;
+            }
+            pline >> out.num_vars >> out.num_clauses;
+            body = end < size ? end + 1 : size;
+            return true;
+        }
+        pos = end + 1;
+    }
+    error_ = "Invalid DIMACS format: missing 'p cnf' problem line";
+    return false;
+}
+
+void CnfLoader::normalize(std::vector<Lit>& lits, size_t from) const {
+    if (sort_clauses_) std::sort(lits.begin() + from, lits.end());
+    lits.erase(std::unique(lits.begin() + from, lits.end()), lits.end());
+}
+
+void CnfLoader::parseChunk(const char* begin, const char* end, Chunk& chunk) const {
+    std::vector<Lit>* acc = &chunk.head;  // literals of the clause being read
+    size_t start = 0;                     // its first literal in *acc
+
+    const char* p = begin;
+    while (p < end) {
+        const char* eol = static_cast<const char*>(memchr(p, '\n', end - p));
+        if (!eol) eol = end;
+        const char* s = p;
+        const char* e = eol;
+        p = eol < end ? eol + 1 : end;
+
+        while (e > s && (e[-1] == '\r' || isBlank(e[-1]))) e--;
+        const char* f = s;
+        while (f < e && isBlank(*f)) f++;
+        if (f == e || *f == 'c' || *f == 'p') continue;
+
+        // only digits, '-' and blanks make a clause line
+        bool valid = true;
+        for (const char* q = s; q < e; q++) {
+            if (!isdigit((unsigned char)*q) && *q != '-' && !isBlank(*q)) { valid = false; break; }
+        }
+        if (!valid) continue;
+
+        for (const char* q = f; q < e; ) {
+            while (q < e && isBlank(*q)) q++;
+            if (q == e) break;
+            bool neg = (*q == '-');
+            if (neg) q++;
+            if (q == e || !isdigit((unsigned char)*q)) break;  // stray '-' ends the line
+            int v = 0;
+            while (q < e && isdigit((unsigned char)*q)) v = v * 10 + (*q++ - '0');
+
+            if (v != 0) {
+                acc->push_back(toLit(neg ? -v : v));
+                continue;
+            }
+
+            // clause terminator
+            if (!chunk.head_closed) {
+                chunk.head_closed = true;
+                acc = &chunk.lits;
+                start = 0;
+                continue;
+            }
+            size_t n = acc->size() - start;
+            if (n == 1) {
+                chunk.units.push_back(acc->back());
+                acc->pop_back();
+            } else if (n > 1) {
+                normalize(*acc, start);
+                chunk.ends.push_back(acc->size());
+                start = acc->size();
+            }
+        }
+    }
+
+    if (chunk.head_closed) {
+        chunk.tail.assign(chunk.lits.begin() + start, chunk.lits.end());
+        chunk.lits.resize(start);
+    }
+}
+
+bool CnfLoader::parseBuffer(const char* data, size_t size, ParsedCnf& out) {
+    out = ParsedCnf();
+    size_t body = 0;
+    if (!parseHeader(data, size, body, out)) return false;
+
+    // Split the body at line starts
+    size_t len = size - body;
+    int n = threadCount(len);
+    threads_used_ = n;
+    std::vector<size_t> bounds(n + 1, size);
+    bounds[0] = body;
+    for (int i = 1; i < n; i++) {
+        size_t pos = std::max(bounds[i - 1], body + len / n * i);
+        const char* eol = pos < size ? static_cast<const char*>(memchr(data + pos, '\n', size - pos)) : nullptr;
+        bounds[i] = eol ? eol - data + 1 : size;
+    }
+
+    std::vector<Chunk> chunks(n);
+    std::vector<std::thread> pool;
+    for (int i = 1; i < n; i++) {
+        pool.emplace_back([&, i]() { parseChunk(data + bounds[i], data + bounds[i + 1], chunks[i]); });
+    }
+    parseChunk(data + bounds[0], data + bounds[1], chunks[0]);
+    for (auto& th : pool) th.join();
+
+    // Stitch chunks together in file order
+    std::unordered_set<int> unit_seen;
+    auto addUnit = [&](Lit l) {
+        out.unit_clauses++;
+        if (unit_seen.insert(l.x).second) out.units.push_back(l);
+    };
+    std::vector<Lit> pending;
+    auto emit = [&]() {
+        if (pending.size() == 1) {
+            addUnit(pending[0]);
+        } else if (pending.size() > 1) {
+            normalize(pending, 0);
+            out.clauses.add(pending.data(), pending.size());
+        }
+        pending.clear();
+    };
+
+    size_t total_lits = 0;
+    for (const auto& c : chunks) total_lits += c.lits.size();
+    out.clauses.lits.reserve(total_lits);
+    out.clauses.offsets.reserve(out.num_clauses + 1);
+
+    for (auto& c : chunks) {
+        pending.insert(pending.end(), c.head.begin(), c.head.end());
+        if (!c.head_closed) continue;
+        emit();
+
+        uint64_t base = out.clauses.lits.size();
+        out.clauses.lits.insert(out.clauses.lits.end(), c.lits.begin(), c.lits.end());
+        for (uint64_t e : c.ends) out.clauses.offsets.push_back(base + e);
+        for (Lit l : c.units) addUnit(l);
+        pending.swap(c.tail);
+        c = Chunk();  // release chunk memory early
+    }
+    emit();  // file ended without a trailing 0
+    return true;
+}
+
+bool CnfLoader::readCache(const std::string& file, size_t file_size, ParsedCnf& out) const {
+    FILE* fp = fopen(file.c_str(), "rb");
+    if (!fp) return false;
+
+    CacheHeader h;
+    bool ok = fread(&h, sizeof(h), 1, fp) == 1
+        && memcmp(h.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0
+        && h.version == CACHE_VERSION
+        && h.flags == (sort_clauses_ ? 1u : 0u)
+        && h.file_hash == hash_
+        && h.file_size == file_size;
+    if (ok) {
+        out = ParsedCnf();
+        out.num_vars = h.num_vars;
+        out.num_clauses = h.num_clauses;
+        out.unit_clauses = h.unit_clauses;
+        std::vector<uint64_t>& offsets = out.clauses.offsets;
+        std::vector<Lit>& lits = out.clauses.lits;
+        out.units.resize(h.num_units);
+        offsets.resize(h.num_parsed + 1);
+        lits.resize(h.num_lits);
+        ok = fread(out.units.data(), sizeof(Lit), out.units.size(), fp) == out.units.size()
+            && fread(offsets.data(), sizeof(uint64_t), offsets.size(), fp) == offsets.size()
+            && fread(lits.data(), sizeof(Lit), lits.size(), fp) == lits.size()
+            && fgetc(fp) == EOF
+            && validPayload(out)
+            && payloadHash(out) == h.payload_hash;
+    }
+    fclose(fp);
+    return ok;
+}
+
+bool CnfLoader::writeCache(const std::string& file, size_t file_size, const ParsedCnf& out) const {
+    // write to a private temp file and rename, so concurrent runs never see a partial cache
+    std::string tmp = file + ".tmp." + std::to_string(getpid());
+    FILE* fp = fopen(tmp.c_str(), "wb");
+    if (!fp) return false;
+
+    CacheHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    h.version = CACHE_VERSION;
+    h.flags = sort_clauses_ ? 1u : 0u;
+    h.file_hash = hash_;
+    h.file_size = file_size;
+    h.num_vars = out.num_vars;
+    h.num_clauses = out.num_clauses;
+    h.unit_clauses = out.unit_clauses;
+    h.num_units = out.units.size();
+    h.num_parsed = out.clauses.size();
+    h.num_lits = out.clauses.lits.size();
+    h.payload_hash = payloadHash(out);
+
+    bool ok = fwrite(&h, sizeof(h), 1, fp) == 1
+        && fwrite(out.units.data(), sizeof(Lit), out.units.size(), fp) == out.units.size()
+        && fwrite(out.clauses.offsets.data(), sizeof(uint64_t), out.clauses.offsets.size(), fp) == out.clauses.offsets.size()
+        && fwrite(out.clauses.lits.data(), sizeof(Lit), out.clauses.lits.size(), fp) == out.clauses.lits.size();
+    ok = (fclose(fp) == 0) && ok;
+    if (ok) ok = rename(tmp.c_str(), file.c_str()) == 0;
+    if (!ok) unlink(tmp.c_str());
+    return ok;
+}
@@ -0,0 +1,69 @@
+#ifndef CNF_LOADER_H
+#define CNF_LOADER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <sst/core/event.h>  // structs.h needs SST::Event
+#include "structs.h"
+
+// Parsed CNF in flat form (see ClausePool). Unit clauses are split out (deduplicated, in file order) into units;
+// unit_clauses counts every unit clause seen, duplicates included.
+struct ParsedCnf {
+    uint32_t num_vars = 0;
+    uint32_t num_clauses = 0;       // as declared in the problem line
+    uint32_t unit_clauses = 0;
+    std::vector<Lit> units;
+    ClausePool clauses;
+};
+
+// DIMACS loader for large instances.
+//
+// The file is mmap'd, split at line boundaries into chunks that are parsed
+// on worker threads, and stitched back together in file order (clauses may
+// span lines and therefore chunks). Results match the line-based parser:
+// comment and malformed lines are skipped, literals are sorted when
+// sort_clauses is set, and adjacent duplicates are removed.
+//
+// With a cache directory, the parsed result is stored as <hash>.cnfcache,
+// keyed by a content hash of the CNF and the sort flag, and reloaded on the
+// next run instead of parsing. The hash is computed over fixed-size blocks so
+// it does not depend on the thread count.
+//
+// Thread model: load() spawns and joins its own threads; the object itself is
+// not shared.
+class CnfLoader {
+public:
+    explicit CnfLoader(int threads = 0, bool sort_clauses = true);
+
+    bool load(const std::string& path, const std::string& cache_dir, ParsedCnf& out);
+    bool parseBuffer(const char* data, size_t size, ParsedCnf& out);
+
+    const std::string& error() const { return error_; }
+    bool fromCache() const { return from_cache_; }
+    bool cacheWritten() const { return cache_written_; }
+    int threadsUsed() const { return threads_used_; }
+    uint64_t fileHash() const { return hash_; }
+
+private:
+    struct Chunk;
+
+    int threadCount(size_t bytes) const;
+    uint64_t hashBuffer(const char* data, size_t size) const;
+    bool parseHeader(const char* data, size_t size, size_t& body, ParsedCnf& out);
+    void parseChunk(const char* begin, const char* end, Chunk& chunk) const;
+    void normalize(std::vector<Lit>& lits, size_t from) const;
+    bool readCache(const std::string& file, size_t file_size, ParsedCnf& out) const;
+    bool writeCache(const std::string& file, size_t file_size, const ParsedCnf& out) const;
+
+    int threads_;
+    bool sort_clauses_;
+    std::string error_;
+    bool from_cache_ = false;
+    bool cache_written_ = false;
+    int threads_used_ = 1;
+    uint64_t hash_ = 0;
+};
+
+#endif // CNF_LOADER_H
@@ -3,6 +3,7 @@
 #include "sst/core/params.h"
 #include "sst/core/statapi/stataccumulator.h"
 #include <stdint.h>
+#include <algorithm>
 #include <vector>
 #include <unordered_set>
 
@@ -12,6 +13,14 @@ DirectedPrefetcher::DirectedPrefetcher(ComponentId_t id, Params& params) : Cache
     requireLibrary("memHierarchy");
 
     blockSize = params.find<uint64_t>("cache_line_size", 64);
+    maxDepth = params.find<uint32_t>("chase_depth", 4);
+    chaseDegree = params.find<uint32_t>("chase_degree", 8);
+    chaseDepth = maxDepth;
+    linkTableSize = std::max<size_t>(1, params.find<size_t>("link_table_size", 65536));
+    throttleWindow = params.find<uint64_t>("throttle_window", 256);
+    throttleLow = params.find<double>("throttle_low", 0.4);
+    throttleHigh = params.find<double>("throttle_high", 0.75);
+    windowUsed = windowUnused = 0;
 
     // Set up link to receive prefetch requests
     cmdLink = configureLink("cmd_port", 
@@ -20,6 +29,11 @@ DirectedPrefetcher::DirectedPrefetcher(ComponentId_t id, Params& params) : Cache
     statPrefetchEventsIssued = registerStatistic<uint64_t>("prefetches_issued");
     statPrefetchUsed = registerStatistic<uint64_t>("prefetches_used");
     statPrefetchUnused = registerStatistic<uint64_t>("prefetches_unused");
+    statChaseRequests = registerStatistic<uint64_t>("chase_requests");
+    statChasedBlocks = registerStatistic<uint64_t>("chased_blocks");
+    statChasedClauses = registerStatistic<uint64_t>("chased_clauses");
+    statLinkMisses = registerStatistic<uint64_t>("link_misses");
+    statChaseDepth = registerStatistic<uint64_t>("chase_depth");
 }
 
 DirectedPrefetcher::~DirectedPrefetcher() {}
@@ -27,27 +41,100 @@ DirectedPrefetcher::~DirectedPrefetcher() {}
 void DirectedPrefetcher::handlePrefetchRequest(SST::Event* ev) {
     PrefetchRequestEvent* prefReq = dynamic_cast<PrefetchRequestEvent*>(ev);
     if (prefReq) {
-        Addr addr = prefReq->addr;
-        Addr lineAddr = addr - (addr % blockSize);
-        
-        // Check if this address is already cached or already in prefetch table
-        if (prefetchTable.find(lineAddr) == prefetchTable.end()) {
-            prefetchTable.insert(lineAddr);
-
-            // Issue prefetch request
-            std::vector<Event::HandlerBase*>::iterator callbackItr;
-            for (callbackItr = registeredCallbacks.begin(); callbackItr != registeredCallbacks.end(); callbackItr++) {
-                MemEvent* newEv = new MemEvent(getName(), lineAddr, lineAddr, Command::GetS);
-                newEv->setSize(blockSize);
-                newEv->setPrefetchFlag(true);
-                (*(*callbackItr))(newEv);
-            }
-            statPrefetchEventsIssued->addData(1);
+        switch (prefReq->type) {
+        case PrefetchRequestEvent::LINE:
+            prefetchLine(prefReq->addr);
+            break;
+        case PrefetchRequestEvent::CHASE:
+            statChaseRequests->addData(1);
+            chase(prefReq->addr);
+            break;
+        case PrefetchRequestEvent::LINK:
+            // the successor of a node that was just read is due next
+            if (!prefReq->targets.empty() && prefReq->targets[0] != 0) prefetchLine(prefReq->targets[0]);
+            learnLink(prefReq->addr, prefReq->targets);
+            break;
         }
     }
     delete ev;
 }
 
+void DirectedPrefetcher::prefetchLine(uint64_t addr) {
+    Addr lineAddr = addr - (addr % blockSize);
+
+    // Check if this address is already cached or already in prefetch table
+    if (prefetchTable.find(lineAddr) == prefetchTable.end()) {
+        prefetchTable.insert(lineAddr);
+
+        // Issue prefetch request
+        std::vector<Event::HandlerBase*>::iterator callbackItr;
+        for (callbackItr = registeredCallbacks.begin(); callbackItr != registeredCallbacks.end(); callbackItr++) {
+            MemEvent* newEv = new MemEvent(getName(), lineAddr, lineAddr, Command::GetS);
+            newEv->setSize(blockSize);
+            newEv->setPrefetchFlag(true);
+            (*(*callbackItr))(newEv);
+        }
+        statPrefetchEventsIssued->addData(1);
+    }
+}
+
+// Walk a watch list from its metadata: prefetch each node and up to
+// chaseDegree of its clauses, following next pointers for chaseDepth blocks.
+// The walk stops at the first node whose links have not been seen yet.
+void DirectedPrefetcher::chase(uint64_t root) {
+    uint64_t node = root;
+    for (uint32_t blocks = 0; node != 0; blocks++) {
+        prefetchLine(node);
+        if (node != root) statChasedBlocks->addData(1);
+
+        auto it = linkTable.find(node);
+        if (it == linkTable.end()) {
+            statLinkMisses->addData(1);
+            return;
+        }
+        const std::vector<uint64_t>& links = it->second;
+        size_t clauses = std::min<size_t>(links.size() - 1, chaseDegree);
+        for (size_t i = 1; i <= clauses; i++) prefetchLine(links[i]);
+        statChasedClauses->addDataNTimes(clauses, 1);
+
+        if (blocks >= chaseDepth) return;
+        node = links[0];
+    }
+}
+
+void DirectedPrefetcher::learnLink(uint64_t addr, std::vector<uint64_t>& targets) {
+    if (targets.empty()) return;
+    auto it = linkTable.find(addr);
+    if (it != linkTable.end()) {
+        it->second.swap(targets);
+        return;
+    }
+    if (linkTable.size() >= linkTableSize) {
+        linkTable.erase(linkOrder.front());
+        linkOrder.pop_front();
+    }
+    linkTable.emplace(addr, std::move(targets));
+    linkOrder.push_back(addr);
+}
+
+// Feedback throttling: every throttleWindow resolved prefetches, step the
+// chase depth down when too few were used before eviction and back up when
+// most of them were.
+void DirectedPrefetcher::resolvePrefetch(bool used) {
+    if (used) statPrefetchUsed->addData(1);
+    else statPrefetchUnused->addData(1);
+    if (throttleWindow == 0) return;
+
+    (used ? windowUsed : windowUnused)++;
+    if (windowUsed + windowUnused < throttleWindow) return;
+
+    double accuracy = (double)windowUsed / (windowUsed + windowUnused);
+    if (accuracy < throttleLow && chaseDepth > 0) chaseDepth--;
+    else if (accuracy > throttleHigh && chaseDepth < maxDepth) chaseDepth++;
+    statChaseDepth->addData(chaseDepth);
+    windowUsed = windowUnused = 0;
+}
+
 void DirectedPrefetcher::notifyAccess(const SST::MemHierarchy::CacheListenerNotification& notify) {
     const NotifyAccessType notifyType = notify.getAccessType();
     const NotifyResultType notifyResType = notify.getResultType();
@@ -59,7 +146,7 @@ void DirectedPrefetcher::notifyAccess(const SST::MemHierarchy::CacheListenerNoti
         if (prefetchTable.find(lineAddr) != prefetchTable.end()) {
             if (notifyResType == HIT) {
                 // printf("addr 0x%lx prefetched\n", addr);
-                statPrefetchUsed->addData(1);
+                resolvePrefetch(true);
             }
             // else printf("addr 0x%lx late\n", addr);
             prefetchTable.erase(lineAddr);
@@ -68,7 +155,7 @@ void DirectedPrefetcher::notifyAccess(const SST::MemHierarchy::CacheListenerNoti
         // Check if the evicted line was a prefetch we issued but was never used
         if (prefetchTable.find(lineAddr) != prefetchTable.end()) {
             // printf("addr 0x%lx evicted unused prefetch\n", addr);
-            statPrefetchUnused->addData(1);
+            resolvePrefetch(false);
             prefetchTable.erase(lineAddr);
         }
     }
@@ -97,6 +184,12 @@ void DirectedPrefetcher::printStats(Output& out) {
         accuracy = static_cast<double>(getCount(statPrefetchUsed)) / getCount(statPrefetchEventsIssued) * 100.0;
     }
     out.output("  Prefetch accuracy: %.2f%%\n", accuracy);
+    if (getCount(statChaseRequests) > 0) {
+        out.output("  Chase requests: %" PRIu64 " (%" PRIu64 " blocks, %" PRIu64 " clauses, %" PRIu64 " link misses)\n",
+            getCount(statChaseRequests), getCount(statChasedBlocks),
+            getCount(statChasedClauses), getCount(statLinkMisses));
+        out.output("  Chase depth: %u of %u\n", chaseDepth, maxDepth);
+    }
 }
 
 void DirectedPrefetcher::serialize_order(SST::Core::Serialization::serializer& ser) {
@@ -106,7 +199,23 @@ void DirectedPrefetcher::serialize_order(SST::Core::Serialization::serializer& s
     SST_SER(blockSize);
     SST_SER(prefetchTable);
     SST_SER(cmdLink);
+    SST_SER(maxDepth);
+    SST_SER(chaseDegree);
+    SST_SER(chaseDepth);
+    SST_SER(linkTableSize);
+    SST_SER(linkTable);
+    SST_SER(linkOrder);
+    SST_SER(throttleWindow);
+    SST_SER(throttleLow);
+    SST_SER(throttleHigh);
+    SST_SER(windowUsed);
+    SST_SER(windowUnused);
     SST_SER(statPrefetchEventsIssued);
     SST_SER(statPrefetchUsed);
     SST_SER(statPrefetchUnused);
+    SST_SER(statChaseRequests);
+    SST_SER(statChasedBlocks);
+    SST_SER(statChasedClauses);
+    SST_SER(statLinkMisses);
+    SST_SER(statChaseDepth);
 }
@@ -2,7 +2,9 @@
 #define _H_SST_DIRECTED_PREFETCH
 
 #include <vector>
+#include <deque>
 #include <unordered_set>
+#include <unordered_map>
 
 #include <sst/core/event.h>
 #include <sst/core/sst_types.h>
@@ -14,16 +16,26 @@
 
 
 // Event class for prefetch requests
+//  LINE:  prefetch the line holding addr
+//  CHASE: addr is the metadata of a watch list; the engine walks the list
+//         from there using the links it has learnt
+//  LINK:  the data of a list node the solver just read (metadata or block):
+//         targets[0] is the next node (0 = end), the rest are clause addresses
 class PrefetchRequestEvent : public SST::Event {
 public:
+    enum Type { LINE, CHASE, LINK };
+    Type type;
     uint64_t addr;  // Address to prefetch
+    std::vector<uint64_t> targets;
 
-    PrefetchRequestEvent() : addr(0) {}
-    PrefetchRequestEvent(uint64_t addr) : addr(addr) {}
+    PrefetchRequestEvent() : type(LINE), addr(0) {}
+    PrefetchRequestEvent(uint64_t addr, Type type = LINE) : type(type), addr(addr) {}
 
     void serialize_order(SST::Core::Serialization::serializer &ser) override {
         Event::serialize_order(ser);
+        SST_SER(type);
         SST_SER(addr);
+        SST_SER(targets);
     }
     ImplementSerializable(PrefetchRequestEvent);
 };
@@ -45,12 +57,18 @@ public:
         "satsolver",
         "DirectedPrefetcher",
         SST_ELI_ELEMENT_VERSION(1,0,0),
-        "Directed Prefetcher that receives explicit prefetch requests",
+        "Directed Prefetcher that receives explicit prefetch requests and chases watch lists",
         SST::MemHierarchy::CacheListener
     )
 
     SST_ELI_DOCUMENT_PARAMS(
-        { "cache_line_size", "Size of the cache line the prefetcher is attached to", "64" }
+        { "cache_line_size", "Size of the cache line the prefetcher is attached to", "64" },
+        { "chase_depth", "Max watcher blocks followed past the metadata per chase request", "4" },
+        { "chase_degree", "Max clauses prefetched per list node", "8" },
+        { "link_table_size", "Number of list nodes whose links the engine remembers", "65536" },
+        { "throttle_window", "Resolved prefetches (used + unused) per accuracy check (0 disables throttling)", "256" },
+        { "throttle_low", "Accuracy below which the chase depth is reduced", "0.4" },
+        { "throttle_high", "Accuracy above which the chase depth is increased", "0.75" }
     )
     
     SST_ELI_DOCUMENT_PORTS(
@@ -61,6 +79,11 @@ public:
         { "prefetches_issued", "Number of prefetch requests issued", "prefetches", 1 },
         { "prefetches_used", "Number of prefetch requests that were used", "prefetches", 1 },
         { "prefetches_unused", "Number of prefetch requests that were evicted unused", "prefetches", 1 },
+        { "chase_requests", "Number of watch lists the engine was asked to chase", "requests", 1 },
+        { "chased_blocks", "Number of watcher blocks reached by chasing", "blocks", 1 },
+        { "chased_clauses", "Number of clause prefetches generated by chasing", "prefetches", 1 },
+        { "link_misses", "Chase steps stopped by a node missing from the link table", "events", 1 },
+        { "chase_depth", "Chase depth after each accuracy check", "blocks", 1 },
     )
 
     // Serialization support
@@ -69,14 +92,39 @@ public:
     ImplementSerializable(DirectedPrefetcher)
 
 private:
+    void prefetchLine(uint64_t addr);
+    void chase(uint64_t root);
+    void learnLink(uint64_t addr, std::vector<uint64_t>& targets);
+    void resolvePrefetch(bool used);
+
     std::vector<Event::HandlerBase*> registeredCallbacks;
     uint64_t blockSize;
     std::unordered_set<uint64_t> prefetchTable;  // Track addresses that were prefetched
     SST::Link* cmdLink;  // Link to receive prefetch requests
 
+    // Pointer-chasing engine. Links are learnt from the nodes the solver
+    // reads, the way a content-directed prefetcher sees the lines filled;
+    // stale links only cost useless prefetches.
+    uint32_t maxDepth;
+    uint32_t chaseDegree;
+    uint32_t chaseDepth;       // current depth, adapted to the accuracy
+    size_t linkTableSize;
+    std::unordered_map<uint64_t, std::vector<uint64_t>> linkTable;  // node -> next, clauses...
+    std::deque<uint64_t> linkOrder;  // insertion order for FIFO replacement
+    uint64_t throttleWindow;
+    double throttleLow;
+    double throttleHigh;
+    uint64_t windowUsed;
+    uint64_t windowUnused;
+
     Statistic<uint64_t>* statPrefetchEventsIssued;
     Statistic<uint64_t>* statPrefetchUsed;
     Statistic<uint64_t>* statPrefetchUnused;
+    Statistic<uint64_t>* statChaseRequests;
+    Statistic<uint64_t>* statChasedBlocks;
+    Statistic<uint64_t>* statChasedClauses;
+    Statistic<uint64_t>* statLinkMisses;
+    Statistic<uint64_t>* statChaseDepth;
 };
 
 #endif
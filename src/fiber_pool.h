@@ -0,0 +1,205 @@
+#ifndef FIBER_POOL_H
+#define FIBER_POOL_H
+
+#include <boost/coroutine2/all.hpp>
+#include <boost/context/stack_context.hpp>
+#include <boost/context/stack_traits.hpp>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <utility>
+#include <cstdlib>
+#include <new>
+#include <cstdint>
+#include <cassert>
+#include "structs.h"
+
+// Execution contexts for the solver's simulated workers.
+// Every literal, watcher, learner and minimizer task runs in its own
+// coroutine; with the default allocator each one mallocs (and for default
+// sized stacks, mmaps) a fresh stack. The pool hands out fixed-size stacks
+// from a free list instead, so after warm-up spawning a task costs no system
+// allocation. Stacks are only returned to the OS when the pool is destroyed,
+// which must outlive every coroutine spawned from it.
+class FiberPool {
+public:
+    explicit FiberPool(size_t stack_size = boost::context::stack_traits::default_size())
+        : stack_size(stack_size), num_spawns(0), in_use(0), peak_in_use(0) {}
+
+    FiberPool(const FiberPool&) = delete;
+    FiberPool& operator=(const FiberPool&) = delete;
+
+    ~FiberPool() {
+        for (void* s : stacks) std::free(s);
+    }
+
+    // Only valid before the first spawn
+    void setStackSize(size_t size) {
+        assert(stacks.empty());
+        stack_size = std::max(size, boost::context::stack_traits::minimum_size());
+    }
+
+    // Preallocate stacks for n concurrent fibers
+    void reserve(size_t n) {
+        while (stacks.size() < n) grow();
+    }
+
+    // Start fn on a pooled stack; runs until its first yield like a plain pull_type
+    template<typename Fn>
+    coro_t::pull_type* spawn(Fn&& fn) {
+        num_spawns++;
+        return new coro_t::pull_type(StackHandle(this), std::forward<Fn>(fn));
+    }
+
+    // Destroy a (possibly suspended) fiber and recycle its stack
+    void release(coro_t::pull_type*& fiber) {
+        delete fiber;
+        fiber = nullptr;
+    }
+
+    size_t stackSize() const { return stack_size; }
+    size_t stacksAllocated() const { return stacks.size(); }
+    uint64_t spawns() const { return num_spawns; }
+    size_t peakInUse() const { return peak_in_use; }
+
+private:
+    // StackAllocator handed to coroutine2, a thin reference to the pool
+    struct StackHandle {
+        FiberPool* pool;
+        explicit StackHandle(FiberPool* pool) : pool(pool) {}
+        boost::context::stack_context allocate() { return pool->allocStack(); }
+        void deallocate(boost::context::stack_context& sctx) { pool->freeStack(sctx); }
+    };
+
+    void grow() {
+        void* s = std::malloc(stack_size);
+        if (s == nullptr) throw std::bad_alloc();
+        stacks.push_back(s);
+        free_stacks.push_back(s);
+    }
+
+    boost::context::stack_context allocStack() {
+        if (free_stacks.empty()) grow();
+        void* s = free_stacks.back();
+        free_stacks.pop_back();
+        in_use++;
+        peak_in_use = std::max(peak_in_use, in_use);
+
+        boost::context::stack_context sctx;
+        sctx.size = stack_size;
+        sctx.sp = static_cast<char*>(s) + stack_size;  // stacks grow down
+        return sctx;
+    }
+
+    void freeStack(boost::context::stack_context& sctx) {
+        assert(sctx.size == stack_size);
+        free_stacks.push_back(static_cast<char*>(sctx.sp) - sctx.size);
+        in_use--;
+    }
+
+    size_t stack_size;
+    std::vector<void*> stacks;       // every stack owned by the pool
+    std::vector<void*> free_stacks;  // stacks not backing a live fiber
+    uint64_t num_spawns;
+    size_t in_use;
+    size_t peak_in_use;
+};
+
+// Wake-up tracking for one phase's worker slots.
+// Memory responses and lock releases activate() the worker they belong to,
+// and the stepping loops visit the ready workers instead of scanning every
+// slot each cycle. A slot stays listed until it is deactivated, and the
+// list is handed out in ascending slot order, the order the per-slot scans
+// used to resume workers in, so timing does not depend on response arrival
+// order within a cycle.
+// With no slots (between phases) activations are ignored.
+class ReadyQueue {
+public:
+    ReadyQueue() : num_active(0) {}
+
+    void reset(size_t slots) {
+        active.assign(slots, 0);
+        stamps.assign(slots, 0);
+        ids.clear();
+        num_active = 0;
+    }
+    void clear() { reset(0); }
+    size_t size() const { return active.size(); }
+
+    void activate(int id) {
+        if (id < 0 || (size_t)id >= active.size()) return;
+        stamps[id]++;
+        if (active[id]) return;
+        active[id] = 1;
+        num_active++;
+        ids.push_back(id);
+    }
+    bool isActive(int id) const { return active[id] != 0; }
+    bool anyActive() const { return num_active > 0; }
+    void deactivate(int id) {
+        if (!active[id]) return;
+        active[id] = 0;
+        num_active--;
+    }
+
+    // Activation count of a slot. deactivate(id, stamp) is a no-op if the
+    // slot was activated again since the stamp was taken, so a wake-up that
+    // lands while the worker's parent is running is not lost.
+    uint32_t stamp(int id) const { return stamps[id]; }
+    void deactivate(int id, uint32_t stamp) {
+        if (stamps[id] == stamp) deactivate(id);
+    }
+
+    // Snapshot of the active workers, ascending. Copied out because resuming
+    // a worker may change the set.
+    void readyWorkers(std::vector<int>& out) {
+        if (ids.size() != num_active || !std::is_sorted(ids.begin(), ids.end())) {
+            size_t j = 0;
+            for (int id : ids) if (active[id]) ids[j++] = id;
+            ids.resize(j);
+            std::sort(ids.begin(), ids.end());
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        }
+        out = ids;
+    }
+
+private:
+    std::vector<uint8_t> active;
+    std::vector<uint32_t> stamps;
+    std::vector<int> ids;   // superset of the active slots, compacted on demand
+    size_t num_active;
+};
+
+// Workers blocked on a busy resource (a watch list or a locked clause).
+// A worker registers the key it needs and sleeps without polling; releasing
+// the key moves every waiter to the ready queue, where it re-checks its
+// condition and waits again if the resource was taken in the meantime.
+class WaitQueue {
+public:
+    WaitQueue() : num_waits(0), num_wakes(0) {}
+
+    void wait(uint64_t key, int worker) {
+        waiters[key].push_back(worker);
+        num_waits++;
+    }
+
+    void wake(uint64_t key, ReadyQueue& rq) {
+        auto it = waiters.find(key);
+        if (it == waiters.end()) return;
+        for (int w : it->second) rq.activate(w);
+        num_wakes += it->second.size();
+        waiters.erase(it);
+    }
+
+    bool empty() const { return waiters.empty(); }
+    void clear() { waiters.clear(); }
+    uint64_t waits() const { return num_waits; }
+    uint64_t wakes() const { return num_wakes; }
+
+private:
+    std::unordered_map<uint64_t, std::vector<int>> waiters;
+    uint64_t num_waits;
+    uint64_t num_wakes;
+};
+
+#endif // FIBER_POOL_H
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <cassert>
+#include <cstddef>
 
 // Generic heap implementation for ordering elements with a given comparator
 template<class K, class Comp>
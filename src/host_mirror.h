@@ -0,0 +1,95 @@
+#ifndef HOST_MIRROR_H
+#define HOST_MIRROR_H
+
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+
+// Host-side copy of a data structure's simulated memory, for functional
+// fast-forward. Bytes never written read as zero like untouched backing
+// store. Pages are allocated on first write; lines written since the last
+// takeDirty() are tracked so only they have to be materialized into the
+// simulated memory when timed simulation resumes.
+class HostMirror {
+public:
+    explicit HostMirror(size_t line_size = 64, size_t lines_per_page = 64)
+        : line_size(line_size), lines_per_page(lines_per_page),
+          page_size(line_size * lines_per_page), dirty_lines(0) {}
+
+    // dirty = false for data that memory already holds (init-time preloads)
+    void write(uint64_t addr, const uint8_t* data, size_t size, bool dirty = true) {
+        while (size > 0) {
+            Page& p = page(addr / page_size);
+            size_t off = addr % page_size;
+            size_t n = std::min(size, page_size - off);
+            memcpy(p.data.data() + off, data, n);
+            if (dirty) {
+                for (size_t l = off / line_size; l <= (off + n - 1) / line_size; l++) {
+                    if (!p.dirty[l]) { p.dirty[l] = 1; dirty_lines++; }
+                }
+            }
+            addr += n;
+            data += n;
+            size -= n;
+        }
+    }
+
+    void read(uint64_t addr, uint8_t* out, size_t size) const {
+        while (size > 0) {
+            auto it = pages.find(addr / page_size);
+            size_t off = addr % page_size;
+            size_t n = std::min(size, page_size - off);
+            if (it == pages.end()) memset(out, 0, n);
+            else memcpy(out, it->second.data.data() + off, n);
+            addr += n;
+            out += n;
+            size -= n;
+        }
+    }
+
+    // Hand out the dirty data as line-aligned runs in ascending address
+    // order, fn(addr, data, size), and mark everything clean
+    template<typename Fn>
+    void takeDirty(Fn&& fn) {
+        for (auto& kv : pages) {
+            Page& p = kv.second;
+            uint64_t base = kv.first * page_size;
+            for (size_t l = 0; l < lines_per_page; ) {
+                if (!p.dirty[l]) { l++; continue; }
+                size_t first = l;
+                while (l < lines_per_page && p.dirty[l]) p.dirty[l++] = 0;
+                fn(base + first * line_size, p.data.data() + first * line_size, (l - first) * line_size);
+            }
+        }
+        dirty_lines = 0;
+    }
+
+    uint64_t dirtyBytes() const { return dirty_lines * line_size; }
+    uint64_t residentBytes() const { return pages.size() * page_size; }
+
+private:
+    struct Page {
+        std::vector<uint8_t> data;
+        std::vector<uint8_t> dirty;  // per line
+    };
+
+    Page& page(uint64_t idx) {
+        auto it = pages.find(idx);
+        if (it != pages.end()) return it->second;
+        Page& p = pages[idx];
+        p.data.assign(page_size, 0);
+        p.dirty.assign(lines_per_page, 0);
+        return p;
+    }
+
+    size_t line_size;
+    size_t lines_per_page;
+    size_t page_size;
+    std::map<uint64_t, Page> pages;  // page index -> page
+    uint64_t dirty_lines;
+};
+
+#endif // HOST_MIRROR_H
@@ -0,0 +1,58 @@
+#ifndef LINE_BUFFER_POOL_H
+#define LINE_BUFFER_POOL_H
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+// Fixed-size byte buffers carved from slabs and recycled through a free list.
+// Buffers up to buf_size come from the pool; larger requests (e.g. multi-line
+// direct writes) fall back to the heap. Not thread-safe, one pool per AsyncBase.
+class LineBufferPool {
+public:
+    explicit LineBufferPool(size_t buf_size = 64, size_t bufs_per_slab = 256)
+        : buf_size(buf_size), bufs_per_slab(bufs_per_slab) {}
+
+    LineBufferPool(const LineBufferPool&) = delete;
+    LineBufferPool& operator=(const LineBufferPool&) = delete;
+    LineBufferPool(LineBufferPool&&) = default;
+    LineBufferPool& operator=(LineBufferPool&&) = default;
+
+    // Only valid while no buffer is handed out
+    void setBufferSize(size_t size) {
+        if (size == buf_size) return;
+        free_list.clear();
+        slabs.clear();
+        buf_size = size;
+    }
+    size_t bufferSize() const { return buf_size; }
+
+    uint8_t* alloc(size_t size) {
+        if (size > buf_size) return new uint8_t[size];
+        if (free_list.empty()) grow();
+        uint8_t* buf = free_list.back();
+        free_list.pop_back();
+        return buf;
+    }
+
+    void release(uint8_t* buf, size_t size) {
+        if (buf == nullptr) return;
+        if (size > buf_size) delete[] buf;
+        else free_list.push_back(buf);
+    }
+
+private:
+    void grow() {
+        slabs.emplace_back(new uint8_t[buf_size * bufs_per_slab]);
+        uint8_t* base = slabs.back().get();
+        for (size_t i = 0; i < bufs_per_slab; i++) free_list.push_back(base + i * buf_size);
+    }
+
+    size_t buf_size;
+    size_t bufs_per_slab;
+    std::vector<std::unique_ptr<uint8_t[]>> slabs;
+    std::vector<uint8_t*> free_list;
+};
+
+#endif // LINE_BUFFER_POOL_H
@@ -0,0 +1,107 @@
+#ifndef MEM_PROFILE_H
+#define MEM_PROFILE_H
+
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <algorithm>
+#include <cstdint>
+
+// Memory-side profile of one data structure: the latency of each read
+// request from issue to response, the reads in flight (the memory-level
+// parallelism the structure achieves), and the bytes it moves. Only
+// requests that leave for memory are seen; store queue forwards, scratchpad
+// hits and functional accesses are not. Cycles come from the owner's clock.
+class MemProfile {
+public:
+    using Clock = std::function<uint64_t()>;
+
+    // Latencies and occupancies at or above the cap share its last bucket
+    static const size_t HIST_CAP = 1 << 16;
+
+    explicit MemProfile(Clock clock)
+        : clock(clock), outstanding(0), peak_outstanding(0), last_change(0),
+          occupancy_area(0), busy_cycles(0), num_reads(0), read_bytes(0),
+          num_writes(0), write_bytes(0), latency_sum(0), max_latency(0) {}
+
+    void issueRead(uint64_t req_id, size_t bytes) {
+        uint64_t now = clock();
+        advance(now);
+        in_flight[req_id] = now;
+        outstanding++;
+        peak_outstanding = std::max(peak_outstanding, outstanding);
+        bump(occupancy_counts, outstanding);
+        num_reads++;
+        read_bytes += bytes;
+    }
+
+    // Responses to requests not seen by issueRead are ignored
+    void completeRead(uint64_t req_id) {
+        auto it = in_flight.find(req_id);
+        if (it == in_flight.end()) return;
+        uint64_t now = clock();
+        advance(now);
+        uint64_t latency = now - it->second;
+        in_flight.erase(it);
+        outstanding--;
+        bump(latency_counts, latency);
+        latency_sum += latency;
+        max_latency = std::max(max_latency, latency);
+    }
+
+    void issueWrite(size_t bytes) {
+        num_writes++;
+        write_bytes += bytes;
+    }
+
+    // Distributions, indexed by cycles / by reads in flight including the
+    // one being issued
+    const std::vector<uint64_t>& latencyCounts() const { return latency_counts; }
+    const std::vector<uint64_t>& occupancyCounts() const { return occupancy_counts; }
+
+    uint64_t reads() const { return num_reads; }
+    uint64_t readBytes() const { return read_bytes; }
+    uint64_t writes() const { return num_writes; }
+    uint64_t writeBytes() const { return write_bytes; }
+    uint64_t maxLatency() const { return max_latency; }
+    uint64_t peakOutstanding() const { return peak_outstanding; }
+    uint64_t busyCycles() const { return busy_cycles; }  // cycles with a read in flight
+    double meanLatency() const {
+        uint64_t done = num_reads - in_flight.size();
+        return done > 0 ? (double)latency_sum / done : 0.0;
+    }
+    // Mean reads in flight over the busy cycles
+    double achievedMlp() const { return busy_cycles > 0 ? (double)occupancy_area / busy_cycles : 0.0; }
+
+private:
+    void advance(uint64_t now) {
+        if (now > last_change) {
+            occupancy_area += outstanding * (now - last_change);
+            if (outstanding > 0) busy_cycles += now - last_change;
+        }
+        last_change = now;
+    }
+    static void bump(std::vector<uint64_t>& hist, uint64_t value) {
+        size_t i = (size_t)std::min<uint64_t>(value, HIST_CAP - 1);
+        if (i >= hist.size()) hist.resize(i + 1, 0);
+        hist[i]++;
+    }
+
+    Clock clock;
+    std::unordered_map<uint64_t, uint64_t> in_flight;  // req id -> issue cycle
+    uint64_t outstanding;
+    uint64_t peak_outstanding;
+    uint64_t last_change;
+    uint64_t occupancy_area;   // sum over cycles of reads in flight
+    uint64_t busy_cycles;
+    uint64_t num_reads;
+    uint64_t read_bytes;
+    uint64_t num_writes;
+    uint64_t write_bytes;
+    uint64_t latency_sum;
+    uint64_t max_latency;
+    std::vector<uint64_t> latency_counts;
+    std::vector<uint64_t> occupancy_counts;
+};
+
+#endif // MEM_PROFILE_H
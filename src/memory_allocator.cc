@@ -4,7 +4,7 @@
 
 MemoryAllocator::MemoryAllocator(int verbose, uint64_t mem_base_addr, uint64_t total_size)
     : mem_base_addr(mem_base_addr), heap_size(total_size), reserved_size(0),
-      req_mem(0), alloc_mem(0), frag_ratio(0.0), peak_frag_ratio(0.0) {
+      placement(PLACE_PACKED), line_size(64), req_mem(0), alloc_mem(0), frag_ratio(0.0), peak_frag_ratio(0.0) {
 
     output.init("ALLOC->", verbose, 0, SST::Output::STDOUT);
     // Initialize free lists
@@ -53,7 +53,7 @@ void MemoryAllocator::initialize(AsyncBase* async_base, Cref res_size) {
         heap_size, reserved_size);
 }
 
-int MemoryAllocator::getSizeClass(uint32_t size) const {
+int MemoryAllocator::getSizeClass(uint32_t size) {
     for (int i = 1; i < NUM_SIZE_CLASSES; i++) {
         // find the first size class where size is less than the threshold
         if (size < SIZE_CLASSES[i]) {
@@ -65,10 +65,8 @@ int MemoryAllocator::getSizeClass(uint32_t size) const {
 }
 
 BlockHeader MemoryAllocator::readBlockTag(Cref addr, int worker_id) {
-    async_base->read(mem_base_addr + addr, TAG_SIZE, worker_id);
-
     BlockHeader header;
-    memcpy(&header, reorder_buffer->getResponse(worker_id).data(), TAG_SIZE);
+    async_base->readInto(mem_base_addr + addr, &header, 1, worker_id);
     return header;
 }
 
@@ -78,40 +76,29 @@ void MemoryAllocator::setTags(Cref addr, uint32_t size, bool allocated) {
     tag.allocated = allocated ? 1 : 0;
     tag.block_size = size;
     
-    std::vector<uint8_t> tag_buffer(TAG_SIZE);
-    memcpy(tag_buffer.data(), &tag, TAG_SIZE);
-    
     // Write header and footer
-    async_base->write(mem_base_addr + addr, TAG_SIZE, tag_buffer);
-    async_base->write(mem_base_addr + addr + size - TAG_SIZE, TAG_SIZE, tag_buffer);
+    async_base->writeFrom(mem_base_addr + addr, &tag);
+    async_base->writeFrom(mem_base_addr + addr + size - TAG_SIZE, &tag);
 }
 
 Cref MemoryAllocator::getNextFreeBlock(Cref addr, int worker_id) {
-    async_base->read(mem_base_addr + addr + TAG_SIZE, sizeof(Cref), worker_id);
-
     Cref next;
-    memcpy(&next, reorder_buffer->getResponse(worker_id).data(), sizeof(Cref));
+    async_base->readInto(mem_base_addr + addr + TAG_SIZE, &next, 1, worker_id);
     return next;
 }
 
 Cref MemoryAllocator::getPrevFreeBlock(Cref addr, int worker_id) {
-    async_base->read(mem_base_addr + addr + TAG_SIZE + sizeof(Cref), sizeof(Cref), worker_id);
-    
     Cref prev;
-    memcpy(&prev, reorder_buffer->getResponse(worker_id).data(), sizeof(Cref));
+    async_base->readInto(mem_base_addr + addr + TAG_SIZE + sizeof(Cref), &prev, 1, worker_id);
     return prev;
 }
 
 void MemoryAllocator::setNextFreeBlock(Cref addr, Cref next) {
-    std::vector<uint8_t> buffer(sizeof(Cref));
-    memcpy(buffer.data(), &next, sizeof(Cref));
-    async_base->write(mem_base_addr + addr + TAG_SIZE, sizeof(Cref), buffer);
+    async_base->writeFrom(mem_base_addr + addr + TAG_SIZE, &next);
 }
 
 void MemoryAllocator::setPrevFreeBlock(Cref addr, Cref prev) {
-    std::vector<uint8_t> buffer(sizeof(Cref));
-    memcpy(buffer.data(), &prev, sizeof(Cref));
-    async_base->write(mem_base_addr + addr + TAG_SIZE + sizeof(Cref), sizeof(Cref), buffer);
+    async_base->writeFrom(mem_base_addr + addr + TAG_SIZE + sizeof(Cref), &prev);
 }
 
 void MemoryAllocator::insertFreeBlock(Cref addr, uint32_t size) {
@@ -153,49 +140,66 @@ void MemoryAllocator::removeFreeBlock(Cref addr, uint32_t block_size) {
     }
 }
 
-Cref MemoryAllocator::allocateBlock(uint32_t size) {
-    // Ensure minimum block size
-    uint32_t required_size = std::max(size + 2 * TAG_SIZE, MIN_BLOCK_SIZE);
-    output.verbose(CALL_INFO, 8, 0, "Need a block of size >= %u bytes\n", required_size);
-
-    // Find suitable size class
-    Cref block = ClauseRef_Undef;
-    uint32_t block_size = 0;
+// Take a free block of at least need bytes off its list
+Cref MemoryAllocator::findFreeBlock(uint32_t need, uint32_t& block_size) {
     for (int i = 0; i < NUM_SIZE_CLASSES; i++) {
         // if the required size is not equal to the size class,
         // we always use the next size up to avoid scanning the smaller free list
-        if (required_size <= SIZE_CLASSES[i] && free_lists[i] != ClauseRef_Undef) {
-            block = free_lists[i];
+        if (need <= SIZE_CLASSES[i] && free_lists[i] != ClauseRef_Undef) {
+            Cref block = free_lists[i];
             block_size = readBlockTag(block).block_size;
             removeFreeBlock(block, block_size);
             output.verbose(CALL_INFO, 8, 0, "Found a block at 0x%x, %u bytes from size class %u bytes\n",
                 block, block_size, SIZE_CLASSES[i]);
-            assert(block_size >= required_size);
-            break;
+            assert(block_size >= need);
+            return block;
         }
     }
     
     // If no suitable block found, scan the largest free list
-    if (block == ClauseRef_Undef) {
-        // Search through the last size class for a block that fits
-        if (free_lists[NUM_SIZE_CLASSES - 1] != ClauseRef_Undef) {
-            Cref current = free_lists[NUM_SIZE_CLASSES - 1];
-            while (current != ClauseRef_Undef) {
-                block_size = readBlockTag(current).block_size;
-                if (block_size >= required_size) {
-                    block = current;
-                    removeFreeBlock(block, block_size);
-                    output.verbose(CALL_INFO, 8, 0, "Found a block at 0x%x, %u bytes from largest size class\n",
-                        block, block_size);
-                    break;
-                }
-                current = getNextFreeBlock(current);
-            }
+    Cref current = free_lists[NUM_SIZE_CLASSES - 1];
+    while (current != ClauseRef_Undef) {
+        block_size = readBlockTag(current).block_size;
+        if (block_size >= need) {
+            removeFreeBlock(current, block_size);
+            output.verbose(CALL_INFO, 8, 0, "Found a block at 0x%x, %u bytes from largest size class\n",
+                current, block_size);
+            return current;
         }
+        current = getNextFreeBlock(current);
+    }
+    return ClauseRef_Undef;
+}
 
-        if (block == ClauseRef_Undef) {
-            output.fatal(CALL_INFO, -1, "Out of memory: failed to allocate %u bytes\n", size);
-            return ClauseRef_Undef;
+Cref MemoryAllocator::allocateBlock(uint32_t size, bool must_fit) {
+    // Ensure minimum block size
+    uint32_t required_size = blockSize(size);
+    output.verbose(CALL_INFO, 8, 0, "Need a block of size >= %u bytes\n", required_size);
+
+    // A placed clause may have to move up to the next line, or the one after
+    // when the gap in front is too small to be a free block
+    uint32_t slack = placementSpan(size, placement, line_size) > 0 ? line_size + MIN_BLOCK_SIZE : 0;
+    uint32_t block_size = 0;
+    Cref block = findFreeBlock(required_size + slack, block_size);
+    if (block == ClauseRef_Undef && slack > 0) {
+        slack = 0;  // best effort when memory is tight
+        block = findFreeBlock(required_size, block_size);
+    }
+    if (block == ClauseRef_Undef) {
+        if (!must_fit) return ClauseRef_Undef;
+        output.fatal(CALL_INFO, -1, "Out of memory: failed to allocate %u bytes\n", size);
+        return ClauseRef_Undef;
+    }
+
+    if (slack > 0) {
+        uint32_t pad = placementPad(mem_base_addr + block + TAG_SIZE, size, placement, line_size);
+        if (pad > 0 && pad < MIN_BLOCK_SIZE) pad += line_size;
+        if (pad > 0) {
+            insertFreeBlock(block, pad);
+            output.verbose(CALL_INFO, 8, 0, "Placed at 0x%x, %u bytes in front left free\n",
+                block + pad, pad);
+            block += pad;
+            block_size -= pad;
         }
     }
 
@@ -254,9 +258,10 @@ void MemoryAllocator::freeBlock(Cref addr, size_t req_size) {
         }
     }
     
-    // Check if the next physical block is free
+    // Check if the next physical block is free (offsets, so compare with
+    // the arena end rather than the absolute end address)
     Cref next_physical = addr + curr_size;
-    if (next_physical < getMemoryEnd()) {
+    if (next_physical < heap_size) {
         BlockHeader next_header = readBlockTag(next_physical);
         if (!next_header.allocated) {
             // Coalesce with next block
@@ -271,6 +276,21 @@ void MemoryAllocator::freeBlock(Cref addr, size_t req_size) {
     insertFreeBlock(final_addr, final_size);
 }
 
+void MemoryAllocator::compact(Cref live_end, uint64_t live_req) {
+    assert(live_end >= reserved_size && live_end + MIN_BLOCK_SIZE <= heap_size);
+    for (int i = 0; i < NUM_SIZE_CLASSES; i++) {
+        free_lists[i] = ClauseRef_Undef;
+    }
+
+    req_mem = reserved_size + live_req;
+    alloc_mem = live_end;
+    updateFragStats();
+
+    insertFreeBlock(live_end, heap_size - live_end);
+    output.verbose(CALL_INFO, 7, 0, "Compacted: live blocks end at 0x%x, %lu bytes free\n",
+                   live_end, heap_size - live_end);
+}
+
 void MemoryAllocator::updateFragStats() {
     assert(alloc_mem > 0);
     frag_ratio = static_cast<double>(alloc_mem - req_mem) / alloc_mem;
@@ -5,6 +5,7 @@
 #include "async_base.h"
 #include <vector>
 #include <cstring>
+#include <algorithm>
 
 // Block header structure with allocated flag and block size
 struct BlockHeader {
@@ -33,18 +34,35 @@ static const uint32_t SIZE_CLASSES[NUM_SIZE_CLASSES] = {
     MIN_BLOCK_SIZE + 62 * sizeof(Lit),  // Class 7: [64 literals, class 8)
 };
 
+// Literal counts of the clauses whose blocks fall in each size class, for
+// reports. A clause block is at least 24 bytes, so the two smallest classes
+// only ever hold free blocks.
+static const char* const CLAUSE_CLASS_NAMES[NUM_SIZE_CLASSES] = {
+    nullptr, nullptr, "lits_2_5", "lits_6_9", "lits_10_17", "lits_18_29", "lits_30_61", "lits_62_up"
+};
+
 class MemoryAllocator {
 public:
     MemoryAllocator(int verbose, uint64_t mem_base_addr, uint64_t total_size);
     
     // Core allocation functions
-    Cref allocateBlock(uint32_t size);
+    // Returns ClauseRef_Undef when nothing fits and must_fit is false
+    Cref allocateBlock(uint32_t size, bool must_fit = true);
     void freeBlock(Cref addr, size_t req_size);
+    // Smallest block (tags included) that holds size bytes
+    static uint32_t blockSize(uint32_t size) { return std::max(size + 2 * TAG_SIZE, MIN_BLOCK_SIZE); }
+    static int getSizeClass(uint32_t size);
+    // Place clause bodies (a block past its header tag) by policy p; blocks
+    // moved up to a line boundary leave a free block in front of them
+    void setPlacement(ClausePlacement p, uint32_t line) { placement = p; line_size = line; }
+    // The live blocks were packed into [reserved, live_end): free the rest as one block
+    void compact(Cref live_end, uint64_t live_req);
     
     // Initialization
     void setReorderBuffer(ReorderBuffer* rb) { reorder_buffer = rb; }
     void initialize(AsyncBase* async_base, Cref reserved_size = 0);
     uint64_t getMemoryEnd() const { return mem_base_addr + heap_size; }
+    Cref regionEnd() const { return heap_size; }
     
     // Fragmentation tracking
     double fragRatio() const { return frag_ratio; }
@@ -61,6 +79,10 @@ private:
     
     // Segregated free lists
     Cref free_lists[NUM_SIZE_CLASSES];
+    Cref findFreeBlock(uint32_t need, uint32_t& block_size);
+
+    ClausePlacement placement;
+    uint32_t line_size;
     
     // Fragmentation tracking
     uint64_t req_mem;        // Total requested memory by client
@@ -69,9 +91,6 @@ private:
     double peak_frag_ratio;  // Peak internal fragmentation ratio
     void updateFragStats();
     
-    // Memory allocator helpers
-    int getSizeClass(uint32_t size) const;
-    
     // Block manipulation helpers
     BlockHeader readBlockTag(Cref addr, int worker_id = 0);
     void setTags(Cref addr, uint32_t size, bool allocated);
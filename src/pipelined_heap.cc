@@ -13,18 +13,27 @@ PipelinedHeap::PipelinedHeap(
     var_ptr_base_addr(var_ptr_base_addr),
     heap_size(0),
     var_inc_ptr(nullptr),
-    bump_active(false),
-    bump_mem_inflight(false),
+    debug_heap_pending(false),
+    debug_heap_errors(0),
     active_inserts(0),
     rescale(false),
     rescale_pending_reads(0),
-    debug_heap_pending(false),
-    debug_heap_errors(0) {
+    lanes(1),
+    active_bumps(0),
+    rescale_epoch(0),
+    peak_bumps(0),
+    lane_hazard_stalls(0),
+    lane_bypass_hits(0),
+    batch_requests(0),
+    parent_sleeping(false),
+    clock_gated(false),
+    gated_at(0),
+    gated_cycles(0) {
 
     output.init("PHEAP-> ", params.find<int>("verbose", 0), 0, SST::Output::STDOUT);
 
-    registerClock(params.find<std::string>("clock", "1GHz"),
-                 new SST::Clock::Handler2<PipelinedHeap, &PipelinedHeap::tick>(this));
+    clock_handler = new SST::Clock::Handler2<PipelinedHeap, &PipelinedHeap::tick>(this);
+    clock_tc = registerClock(params.find<std::string>("clock", "1GHz"), clock_handler);
 
     response_port = configureLink("response");
     sst_assert(response_port != nullptr, CALL_INFO, -1, 
@@ -75,85 +84,185 @@ bool PipelinedHeap::tick(SST::Cycle_t cycle) {
 
     if (!insert_queue.empty() && canStartOperation(HEAP_OP_INSERT) && !rescale) {
         InsReq& op = insert_queue.front();
-        if (!op.bump) active_inserts++;
-        startOperation(HEAP_OP_INSERT, op.arg, op.activity, op.bump, op.dest);
-        insert_queue.pop_front();
+        if (!op.bump || resolveBumpDest(op)) {
+            if (!op.bump) active_inserts++;
+            startOperation(HEAP_OP_INSERT, op.arg, op.activity, op.bump, op.dest);
+            insert_queue.pop_front();
+        }
+    }
+
+    // A bump that has to rescale activities waits until everything else in
+    // flight has drained, so no stale activity survives the rescale
+    if (!parked_bumps.empty() && !rescale && req_to_op.empty() && insert_queue.empty()
+        && active_inserts == 0 && active_bumps == parked_bumps.size() && pipelineEmpty()) {
+        ParkedBump parked = parked_bumps.front();
+        parked_bumps.pop_front();
+        // fetched before an earlier rescale
+        for (uint32_t e = parked.epoch; e < rescale_epoch; e++) parked.data.act *= 1e-100;
+        finishVarMemFetch(parked.req, parked.data, false);
     }
 
-    if (!request_queue.empty()) {
+    // Each lane accepts one INSERT/BUMP per cycle, in order; other requests
+    // only issue alone
+    for (int accepted = 0; accepted < lanes && !request_queue.empty(); accepted++) {
         const PendingRequest& pending = request_queue.front();
-        switch (pending.op) {
-            case HeapReqEvent::READ: {
-                // READ is expensive to support in hardware
-                int lvl = priority_encoder(pending.arg);
-                int idx = pending.arg & ~(1 << lvl);
-                sendResp(getVar(lvl, idx));
-                request_queue.pop_front();
-                break;
-            }
-            case HeapReqEvent::BUMP: {
+        bool lane_op = pending.op == HeapReqEvent::INSERT || pending.op == HeapReqEvent::BUMP;
+        if (accepted > 0 && !lane_op) break;
+        if (!acceptRequest(pending)) break;
+        request_queue.pop_front();
+        if (!lane_op) break;
+    }
+
+    advancePipeline();
+
+    // Nothing queued or in flight in the pipeline, and the solver cannot send
+    // requests: sleep until a memory response
+    if (parent_sleeping && request_queue.empty() && insert_queue.empty() && parked_bumps.empty()
+        && pipelineEmpty()) {
+        clock_gated = true;
+        gated_at = cycle;
+        return true;
+    }
+    return false;
+}
+
+// Issue the request at the head of the queue. Returns false if it has to wait.
+bool PipelinedHeap::acceptRequest(const PendingRequest& pending) {
+    switch (pending.op) {
+        case HeapReqEvent::READ: {
+            // READ is expensive to support in hardware
+            int lvl = priority_encoder(pending.arg);
+            int idx = pending.arg & ~(1 << lvl);
+            sendResp(getVar(lvl, idx));
+            return true;
+        }
+        case HeapReqEvent::BUMP: {
+            if (rescale || !parked_bumps.empty()) return false;
+            if (lanes == 1) {
                 // can only start with an empty pipeline
-                if (!bump_active && !rescale && req_to_op.empty() && isPipelineIdle()) {
-                    bump_active = true;
-                    getVarMem(pending.arg, true);
-                    request_queue.pop_front();
-                }
-                break;
+                if (active_bumps != 0 || !req_to_op.empty() || !isPipelineIdle()) return false;
+            } else {
+                // one operation per var in flight, and no REPLACE moving vars up
+                if (active_bumps >= (uint32_t)lanes || replaceInFlight()
+                    || bumping_vars.count(pending.arg) || in_progress_vars.count(pending.arg))
+                    return false;
             }
-            case HeapReqEvent::INSERT: {
-                // can fetch var mem when not bump or bump has started
-                if (!bump_active && !rescale){
-                    // discards the requests for vars already in progress
-                    if (in_progress_vars.find(pending.arg) == in_progress_vars.end()) {
-                        in_progress_vars.insert(pending.arg);
-                        getVarMem(pending.arg, false);
-                    }
-                    request_queue.pop_front();
-                }
-                break;
+            active_bumps++;
+            peak_bumps = std::max(peak_bumps, (uint64_t)active_bumps);
+            bumping_vars.insert(pending.arg);
+            getVarMem(pending.arg, true);
+            return true;
+        }
+        case HeapReqEvent::INSERT: {
+            // can fetch var mem when not bump or bump has started
+            if (rescale || !parked_bumps.empty()) return false;
+            if (lanes == 1 ? active_bumps != 0 : bumping_vars.count(pending.arg) != 0) return false;
+            // discards the requests for vars already in progress
+            if (in_progress_vars.find(pending.arg) == in_progress_vars.end()) {
+                in_progress_vars.insert(pending.arg);
+                getVarMem(pending.arg, false);
             }
-            case HeapReqEvent::REMOVE_MAX: {
-                // after previous insert/bump have started
-                if (!bump_active && (active_inserts == 0) && req_to_op.empty()
-                    && canStartOperation(HEAP_OP_REPLACE)) {
-                    startOperation(HEAP_OP_REPLACE, 0, 0, 0, 0);
-                    request_queue.pop_front();
-                }
-                break;
+            return true;
+        }
+        case HeapReqEvent::REMOVE_MAX: {
+            // after previous insert/bump have started
+            if (active_bumps == 0 && (active_inserts == 0) && req_to_op.empty()
+                && canStartOperation(HEAP_OP_REPLACE)) {
+                startOperation(HEAP_OP_REPLACE, 0, 0, 0, 0);
+                return true;
             }
-            case HeapReqEvent::DEBUG_HEAP: {
-                // Wait for all previous requests and pipeline to finish
-                if (active_inserts == 0 && !bump_active && req_to_op.empty() && isPipelineIdle() && !rescale) {
-                // if (active_inserts == 0 && !bump_active && req_to_op.empty() && isPipelineIdle() && store_queue.empty() && !rescale) {
-                    // Start debug heap check
-                    debug_heap_pending = true;
-                    debug_heap_errors = 0;
-                    debug_heap_varmem.clear();
-                    debug_heap_varmem.reserve(num_vars + 1);  // Reserve enough space for all variables
-                    
-                    // Use readBurstAll to read all VarMem entries
-                    if (heap_size == 0) {
-                        sendResp(0);
-                        debug_heap_pending = false;
-                    } else {
-                        output.verbose(CALL_INFO, 6, 0, "DEBUG_HEAP: Reading memory for heap verification\n");
-                        readBurstAll(var_ptr_base_addr, (num_vars + 1) * sizeof(VarMem));
-                    }
-                    request_queue.pop_front();
+            return false;
+        }
+        case HeapReqEvent::DEBUG_HEAP: {
+            // Wait for all previous requests and pipeline to finish
+            if (active_inserts == 0 && active_bumps == 0 && req_to_op.empty() && isPipelineIdle() && !rescale) {
+            // if (active_inserts == 0 && active_bumps == 0 && req_to_op.empty() && isPipelineIdle() && store_queue.empty() && !rescale) {
+                // Start debug heap check
+                debug_heap_pending = true;
+                debug_heap_errors = 0;
+                debug_heap_varmem.clear();
+                debug_heap_varmem.reserve(num_vars + 1);  // Reserve enough space for all variables
+                
+                // Use readBurstAll to read all VarMem entries
+                if (heap_size == 0) {
+                    sendResp(0);
+                    debug_heap_pending = false;
+                } else {
+                    output.verbose(CALL_INFO, 6, 0, "DEBUG_HEAP: Reading memory for heap verification\n");
+                    readBurstAll(var_ptr_base_addr, (num_vars + 1) * sizeof(VarMem));
                 }
-                break;
-            }
-            default: {
-                request_queue.pop_front();
-                break;
+                return true;
             }
+            return false;
         }
+        default:
+            return true;
     }
+}
 
-    advancePipeline();
+// A bump re-inserts its var along the path to the var's node. An operation
+// in flight moves every var on its own path one level down, so the bump has
+// to wait while its node is an ancestor of (or is) another destination, and
+// then picks up the position its var was last written to.
+bool PipelinedHeap::resolveBumpDest(InsReq& op) {
+    auto bp = lane_bypass.find(op.arg);
+    if (bp != lane_bypass.end()) op.dest = bp->second.node_idx;
+
+    uint32_t lvl = priority_encoder(op.dest);
+    for (const auto& kv : inflight_ops) {
+        uint32_t other_lvl = priority_encoder(kv.first);
+        if (other_lvl >= lvl && (kv.first >> (other_lvl - lvl)) == op.dest) {
+            lane_hazard_stalls++;
+            return false;
+        }
+    }
+    if (bp != lane_bypass.end()) {
+        lane_bypass_hits++;
+        lane_bypass.erase(bp);
+    }
+    return true;
+}
+
+void PipelinedHeap::finishBump(Var v) {
+    sst_assert(active_bumps > 0, CALL_INFO, -1, "bump of var %d finished with no bump active\n", v);
+    active_bumps--;
+    bumping_vars.erase(v);
+    lane_bypass.erase(v);
+}
+
+bool PipelinedHeap::replaceInFlight() const {
+    for (int level = 0; level < MAX_HEAP_LEVELS; ++level) {
+        for (int stage = 0; stage < PIPELINE_DEPTH; ++stage) {
+            if (stages[level][stage].valid && stages[level][stage].op_type == HEAP_OP_REPLACE) return true;
+        }
+    }
     return false;
 }
 
+// Re-register after a memory response. SST cycle numbers are absolute, so the
+// ticks that were skipped had nothing to do and the next one runs on the same
+// cycle it would have with the clock left on.
+void PipelinedHeap::wakeClock() {
+    if (!clock_gated) return;
+    clock_gated = false;
+    SST::Cycle_t next = reregisterClock(clock_tc, clock_handler);
+    if (next > gated_at + 1) gated_cycles += next - gated_at - 1;
+}
+
+// The solver's clock is back. Requests arrive from its tick handler, so the
+// heap must be ticking and must tick after it within a cycle, as it did when
+// both handlers were registered at construction; re-registering puts the
+// heap's handler behind the solver's again.
+void PipelinedHeap::parentWoke() {
+    parent_sleeping = false;
+    if (clock_gated) {
+        wakeClock();
+    } else {
+        unregisterClock(clock_tc, clock_handler);
+        reregisterClock(clock_tc, clock_handler);
+    }
+}
+
 void PipelinedHeap::advancePipeline() {
     // Process each level in reverse order (bottom-up)
     for (int level = MAX_HEAP_LEVELS - 1; level >= 0; level--) {
@@ -213,6 +322,7 @@ void PipelinedHeap::startOperation(HeapOpType op, Var arg, double activity, bool
             Var v = getVar(target_level, ~(1 << target_level) & dest);
             sst_assert(v == arg, CALL_INFO, -1, "bump var %d is not located at idx %d which has var %d\n", arg, dest, v);
         }
+        inflight_ops[dest] = bump ? arg : var_Undef;
     } else if (op == HEAP_OP_REPLACE) {
         if (heap_size == 0) {
             sendResp(var_Undef);
@@ -399,14 +509,21 @@ void PipelinedHeap::handleStageInsert(int level, int stage) {
 
             if (in_progress_vars.find(curr_stage.var) != in_progress_vars.end())
                 in_progress_vars.erase(curr_stage.var);
+            // a bump still waiting to start must follow its var
+            if (bumping_vars.count(curr_stage.var))
+                lane_bypass[curr_stage.var] = BypassData((1 << level) | node_idx, curr_stage.var, curr_stage.act);
 
             // If this is the root level, we've completed the operation
             if (level == curr_stage.depth) {
-                if (bump_active) bump_active = false;
+                auto it = inflight_ops.find((1 << level) | node_idx);
+                sst_assert(it != inflight_ops.end(), CALL_INFO, -1,
+                    "no operation in flight to node %d at level %d\n", node_idx, level);
+                if (it->second != var_Undef) finishBump(it->second);
                 else {
+                    sst_assert(active_inserts > 0, CALL_INFO, -1, "active_inserts became negative\n");
                     active_inserts--;
-                    sst_assert(active_inserts >= 0, CALL_INFO, -1, "active_inserts became negative\n");
                 }
+                inflight_ops.erase(it);
             }
 
             stages[level][stage].reset();
@@ -581,6 +698,20 @@ void PipelinedHeap::handleRequest(HeapReqEvent* req) {
     output.verbose(CALL_INFO, 6, 0, "Received request: op=%d, arg=%d\n", 
                    req->op, req->arg);
 
+    // A batch is queued as its individual requests, in order
+    if (!req->batch.empty()) {
+        sst_assert(req->op == HeapReqEvent::INSERT || req->op == HeapReqEvent::BUMP, CALL_INFO, -1,
+            "Batched heap request must be INSERT or BUMP, got %d\n", req->op);
+        batch_requests++;
+        for (Var v : req->batch) {
+            sst_assert(v != var_Undef && v <= (Var)num_vars, CALL_INFO, -1,
+                "Batched request for var %d out of range (num_vars %zu)\n", v, num_vars);
+            request_queue.emplace_back(req->op, v);
+        }
+        delete req;
+        return;
+    }
+
     // Assert var is valid
     sst_assert(req->arg != var_Undef || (req->op != HeapReqEvent::INSERT || req->op != HeapReqEvent::BUMP),
         CALL_INFO, -1, "Attempting to insert undefined variable");
@@ -596,6 +727,7 @@ void PipelinedHeap::sendResp(int result) {
 
 void PipelinedHeap::handleMem(SST::Interfaces::StandardMem::Request* req) {
     if (auto* read_resp = dynamic_cast<SST::Interfaces::StandardMem::ReadResp*>(req)) {
+        if (mem_profile_) mem_profile_->completeRead(read_resp->getID());
         auto it = req_to_op.find(read_resp->getID());
         sst_assert(it != req_to_op.end(), CALL_INFO, -1, "Unexpected memory response ID %lu", read_resp->getID());
 
@@ -608,28 +740,7 @@ void PipelinedHeap::handleMem(SST::Interfaces::StandardMem::Request* req) {
                 "Memory response data size too small: %zu\n", read_resp->data.size());
                       
             memcpy(&data, read_resp->data.data(), sizeof(VarMem));
-
-            InsReq op = pending.insert_req;
-            op.dest = data.addr;
-            op.activity = data.act;
-
-            if (bump_active) {
-                if (data.act + *(var_inc_ptr) > 1e100)
-                    rescaleAct(op.arg, data);
-                data.act += *(var_inc_ptr);
-                op.activity = data.act;
-                if (data.addr != 0)  // bump and var in the heap
-                    insert_queue.emplace_back(op);
-                else {
-                    if (!rescale) setVarMem(op.arg, data);  // update the varmem with bumped activity
-                    bump_active = false;
-                }
-            } else {
-                if (data.addr == 0)  // insert if var not in heap
-                    insert_queue.emplace_back(op);
-                else if (in_progress_vars.find(op.arg) != in_progress_vars.end())
-                    in_progress_vars.erase(op.arg);
-            }
+            finishVarMemFetch(pending.insert_req, data);
         } else if (pending.type == PendingMemOpType::RESCALE) {
             const size_t chunk_size = pending.size;
             const size_t entry_size = sizeof(VarMem);
@@ -648,6 +759,7 @@ void PipelinedHeap::handleMem(SST::Interfaces::StandardMem::Request* req) {
 
             uint64_t write_addr = read_resp->pAddr;
             if (tracer_) tracer_->emitMem(true, write_addr, (uint32_t)chunk_size);
+            if (mem_profile_) mem_profile_->issueWrite(chunk_size);
             memory->send(new SST::Interfaces::StandardMem::Write(write_addr, chunk_size, write_data));
 
             if (rescale_pending_reads > 0) {
@@ -693,7 +805,18 @@ void PipelinedHeap::handleMem(SST::Interfaces::StandardMem::Request* req) {
                 break;
             }
         }
+        return;
+    }
+    wakeClock();
+}
+
+bool PipelinedHeap::pipelineEmpty() const {
+    for (int level = 0; level < MAX_HEAP_LEVELS; ++level) {
+        for (int stage = 0; stage < PIPELINE_DEPTH; ++stage) {
+            if (stages[level][stage].valid) return false;
+        }
     }
+    return true;
 }
 
 bool PipelinedHeap::isPipelineIdle() const {
@@ -753,11 +876,16 @@ void PipelinedHeap::initHeap(uint64_t random_seed) {
         }
     }
 
-    std::vector<uint8_t> buffer((heap_size + 1) * sizeof(VarMem));
-    memcpy(buffer.data(), values.data(), buffer.size());
-    memory->sendUntimedData(new SST::Interfaces::StandardMem::Write(
-        varMemAddr(0), buffer.size(), buffer,
-        true, 0x1));  // posted, and not cacheable
+    size_t bytes = (heap_size + 1) * sizeof(VarMem);
+    if (preloader_) {
+        preloader_->write(memory, varMemAddr(0), reinterpret_cast<const uint8_t*>(values.data()), bytes);
+    } else {
+        std::vector<uint8_t> buffer(bytes);
+        memcpy(buffer.data(), values.data(), bytes);
+        memory->sendUntimedData(new SST::Interfaces::StandardMem::Write(
+            varMemAddr(0), buffer.size(), buffer,
+            true, 0x1));  // posted, and not cacheable
+    }
 
     output.verbose(CALL_INFO, 1, 0, "Heap Size: %lu variables and activities, %lu bytes\n",
                    (heap_size + 1), (heap_size + 1) * (sizeof(Var) + sizeof(double)));
@@ -806,6 +934,7 @@ void PipelinedHeap::setVarMem(Var v, VarMem p) {
     }
 
     if (tracer_) tracer_->emitMem(true, addr, (uint32_t)size);
+    if (mem_profile_) mem_profile_->issueWrite(size);
     memory->send(new SST::Interfaces::StandardMem::Write(addr, size, data));
 }
 
@@ -820,22 +949,7 @@ void PipelinedHeap::getVarMem(Var v, bool bump) {
             assert(size == store_queue[idx].size);
             VarMem data;
             memcpy(&data, store_queue[idx].data.data(), size);
-            if (bump_active) {
-                if (data.act + *(var_inc_ptr) > 1e100)
-                    rescaleAct(v, data);
-                data.act += *(var_inc_ptr);
-                if (data.addr != 0)  // bump and var in the heap
-                    insert_queue.emplace_back(InsReq(v, data.act, bump, data.addr));
-                else {
-                    if (!rescale) setVarMem(v, data);  // update the varmem with bumped activity
-                    bump_active = false;
-                }
-            } else {
-                if (data.addr == 0)  // insert if var not in heap
-                    insert_queue.emplace_back(InsReq(v, data.act, bump, data.addr));
-                else if (in_progress_vars.find(v) != in_progress_vars.end())
-                    in_progress_vars.erase(v);
-            }
+            finishVarMemFetch(InsReq(v, 0.0, bump, 0), data);
             return;
         }
     }
@@ -844,12 +958,44 @@ void PipelinedHeap::getVarMem(Var v, bool bump) {
     auto req = new SST::Interfaces::StandardMem::Read(addr, size);
     req_to_op[req->getID()] = PendingMemOp(InsReq(v, 0.0, bump, 0));
     if (tracer_) tracer_->emitMem(false, addr, (uint32_t)size);
+    if (mem_profile_) mem_profile_->issueRead(req->getID(), size);
     memory->send(req);
 }
 
+// VarMem of an INSERT/BUMP request has arrived: queue the pipeline operation
+void PipelinedHeap::finishVarMemFetch(InsReq op, VarMem data, bool may_park) {
+    op.dest = data.addr;
+    op.activity = data.act;
+
+    if (op.bump) {
+        if (data.act + *(var_inc_ptr) > 1e100) {
+            if (may_park && (!req_to_op.empty() || !insert_queue.empty() || active_inserts > 0
+                             || active_bumps > 1 || !pipelineEmpty())) {
+                parked_bumps.emplace_back(op, data, rescale_epoch);
+                return;
+            }
+            rescaleAct(op.arg, data);
+        }
+        data.act += *(var_inc_ptr);
+        op.activity = data.act;
+        if (data.addr != 0)  // bump and var in the heap
+            insert_queue.emplace_back(op);
+        else {
+            if (!rescale) setVarMem(op.arg, data);  // update the varmem with bumped activity
+            finishBump(op.arg);
+        }
+    } else {
+        if (data.addr == 0)  // insert if var not in heap
+            insert_queue.emplace_back(op);
+        else if (in_progress_vars.find(op.arg) != in_progress_vars.end())
+            in_progress_vars.erase(op.arg);
+    }
+}
+
 void PipelinedHeap::rescaleAct(Var v, VarMem& vmem) {
     output.verbose(CALL_INFO, 2, 0, "Rescaling variable activities\n");
     rescale = true;
+    rescale_epoch++;
     *var_inc_ptr *= 1e-100;
     vmem.act *= 1e-100;
 
@@ -895,6 +1041,7 @@ void PipelinedHeap::readBurstAll(uint64_t start_addr, size_t total_size) {
         req_to_op.emplace(req->getID(), PendingMemOp(type, offset, chunk_size));
         rescale_pending_reads++;
         if (tracer_) tracer_->emitMem(false, current_addr, (uint32_t)chunk_size);
+        if (mem_profile_) mem_profile_->issueRead(req->getID(), chunk_size);
         memory->send(req);
 
         offset += chunk_size;
@@ -9,8 +9,12 @@
 #include <vector>
 #include <deque>
 #include <unordered_map>
+#include <unordered_set>
+#include <memory>
 #include "structs.h"
 #include "trace_writer.h"
+#include "untimed_preloader.h"
+#include "mem_profile.h"
 
 // Define maximum number of heap levels and corresponding parameters
 #define MAX_HEAP_LEVELS 22
@@ -91,7 +95,9 @@ struct PipelineStageOp {
     }
 };
 
-// Structure for bypassing data between stages
+// Structure for bypassing data between stages, and between lanes: the latest
+// on-chip position (node_idx holds the heap index) of a var whose bump is in
+// flight, written by other operations after its VarMem was fetched
 struct BypassData {
     bool valid;
     int node_idx;
@@ -99,6 +105,7 @@ struct BypassData {
     double act;
 
     BypassData() : valid(false), node_idx(0), var(0), act(0.0) {}
+    BypassData(int idx, Var v, double a) : valid(true), node_idx(idx), var(v), act(a) {}
 
     void reset() {
         valid = false;
@@ -145,6 +152,22 @@ public:
     void setVarIncPtr(double* ptr) { var_inc_ptr = ptr; }
     void setLineSize(size_t size) { line_size = size; }
     void setTracer(TraceWriter* t, uint8_t /*ds_id*/) { tracer_ = t; }
+    void setPreloader(UntimedPreloader* p) { preloader_ = p; }
+    void setHeapLanes(int n) { lanes = n; }
+    // Memory profile of the VarMem traffic (see AsyncBase::enableMemProfile)
+    void enableMemProfile(MemProfile::Clock clock) { mem_profile_.reset(new MemProfile(clock)); }
+    const MemProfile* memProfile() const { return mem_profile_.get(); }
+
+    // Lane statistics
+    uint64_t peakBumps() const { return peak_bumps; }
+    uint64_t laneHazardStalls() const { return lane_hazard_stalls; }
+    uint64_t laneBypassHits() const { return lane_bypass_hits; }
+    uint64_t batchRequests() const { return batch_requests; }
+
+    // Driven by the solver's clock gating (see SATSolver::wakeClock)
+    void parentSleeping() { parent_sleeping = true; }
+    void parentWoke();
+    uint64_t gatedCycles() const { return gated_cycles; }
 
     // Initialize heap with given size
     void initHeap(uint64_t random_seed = 0);
@@ -189,6 +212,8 @@ private:
 
     // Trace writer (shared, not owned).
     TraceWriter* tracer_ = nullptr;
+    UntimedPreloader* preloader_ = nullptr;
+    std::unique_ptr<MemProfile> mem_profile_;
 
     // Request queues
     std::deque<PendingRequest> request_queue;
@@ -197,18 +222,53 @@ private:
     // Parallel Var Activity Memory Reads
     // maps memory request ID to Heap ins/bump request
     std::unordered_map<uint64_t, PendingMemOp> req_to_op;
-    bool bump_active;
-    bool bump_mem_inflight;
     uint32_t active_inserts;
     std::unordered_set<Var> in_progress_vars;
     bool rescale;
     size_t rescale_pending_reads;
 
+    // Lanes: up to `lanes` bumps in flight (fetch to final write), and up to
+    // `lanes` INSERT/BUMP requests accepted per cycle. With one lane a bump
+    // waits for an idle pipeline as before.
+    int lanes;
+    uint32_t active_bumps;
+    std::unordered_set<Var> bumping_vars;               // vars with a bump in flight
+    std::unordered_map<Var, BypassData> lane_bypass;    // moves of bumping vars since their fetch
+    std::unordered_map<uint32_t, Var> inflight_ops;     // dest index -> bumped var (var_Undef for inserts)
+    struct ParkedBump {
+        InsReq req;
+        VarMem data;
+        uint32_t epoch;
+        ParkedBump(const InsReq& r, const VarMem& d, uint32_t e) : req(r), data(d), epoch(e) {}
+    };
+    std::deque<ParkedBump> parked_bumps;                // bumps waiting to rescale on a drained heap
+    uint32_t rescale_epoch;
+    uint64_t peak_bumps;
+    uint64_t lane_hazard_stalls;
+    uint64_t lane_bypass_hits;
+    uint64_t batch_requests;
+
     // Pipeline control functions
     void advancePipeline();
     bool canStartOperation(HeapOpType op);
     void startOperation(HeapOpType op, int arg, double activity, bool bump, int dest);
     bool isPipelineIdle() const;
+    bool pipelineEmpty() const;
+    bool replaceInFlight() const;
+    bool acceptRequest(const PendingRequest& pending);
+    bool resolveBumpDest(InsReq& op);
+    void finishVarMemFetch(InsReq op, VarMem data, bool may_park = true);
+    void finishBump(Var v);
+
+    // Clock gating: the heap only sleeps while the solver's clock is gated
+    // (no requests can arrive) and is woken by its own memory responses.
+    SST::TimeConverter* clock_tc;
+    SST::Clock::HandlerBase* clock_handler;
+    bool parent_sleeping;
+    bool clock_gated;
+    SST::Cycle_t gated_at;
+    uint64_t gated_cycles;
+    void wakeClock();
 
     // Stage operations
     void executeStageOp(int level, int stage);
@@ -1,59 +1,181 @@
 #ifndef REORDER_BUFFER_H
 #define REORDER_BUFFER_H
 
-#include <unordered_map>
 #include <vector>
 #include <cstdint>
+#include <cstring>
+#include <cassert>
 
+// Maps outstanding request IDs to workers and holds one response buffer per
+// worker. Both sides are flat arrays: a worker-indexed slot array whose buffers
+// keep their capacity across requests, and a small open-addressed (linear
+// probing, backward-shift delete) table for req_id -> worker_id. After warm-up
+// the response path performs no allocation and a single memcpy.
 class ReorderBuffer {
 public:
+    ReorderBuffer() : num_entries(0) { table.resize(INIT_TABLE_SIZE); }
+
     // Register a request ID with its worker ID
     void registerRequest(uint64_t req_id, int worker_id) {
-        req_to_worker[req_id] = worker_id;
+        assert(worker_id >= 0);
+        if ((num_entries + 1) * 2 > table.size()) growTable();
+        size_t i = probe(req_id);
+        if (table[i].worker < 0) num_entries++;
+        table[i].req_id = req_id;
+        table[i].worker = worker_id;
+        slot(worker_id);  // make sure the worker slot exists before the response
     }
 
-    int lookUpWorkerId(uint64_t req_id) {
-        auto it = req_to_worker.find(req_id);
+    int lookUpWorkerId(uint64_t req_id) const {
+        size_t i = probe(req_id);
         // discarded requests may happen
-        if (it == req_to_worker.end()) return -1;
-        return it->second;
+        return table[i].worker;
     }
-    
+
     // Store response data for a specific request ID
-    void storeResponse(uint64_t req_id, const std::vector<uint8_t> data, bool burst = false, uint64_t offset = 0) {
-        int worker_id = lookUpWorkerId(req_id);
+    void storeResponse(uint64_t req_id, const std::vector<uint8_t>& data, bool burst = false, uint64_t offset = 0) {
+        size_t i = probe(req_id);
+        int worker_id = table[i].worker;
         if (worker_id < 0) return;  // invalid worker_id, skip storing
-        if (burst) {
-            std::memcpy(worker_to_data[worker_id].data() + offset, data.data(), data.size());
-        }
-        else worker_to_data[worker_id] = data;
-        req_to_worker.erase(req_id);  // Clean up the mapping after use
+        copyIn(worker_id, data.data(), data.size(), burst, offset);
+        erase(i);  // Clean up the mapping after use
     }
-    
+
     // Store data directly by worker ID (for store queue forwarding)
     void storeDataByWorkerId(int worker_id, const std::vector<uint8_t>& data, bool burst = false, uint64_t offset = 0) {
-        if (burst) std::memcpy(worker_to_data[worker_id].data() + offset, data.data(), data.size());
-        else worker_to_data[worker_id] = data;
+        copyIn(worker_id, data.data(), data.size(), burst, offset);
     }
-    
+
     // Retrieve response data for a specific worker ID
     const std::vector<uint8_t>& getResponse(int worker_id) const {
-        auto it = worker_to_data.find(worker_id);
-        assert(it != worker_to_data.end());
-        return it->second;
+        assert(worker_id >= 0 && (size_t)worker_id < slots.size() && slots[worker_id].valid);
+        return slots[worker_id].data;
+    }
+
+    // Size worker_id's buffer to bytes and hand it out for writing in place
+    uint8_t* prepare(int worker_id, size_t bytes) {
+        Slot& s = slot(worker_id);
+        s.data.resize(bytes);
+        s.valid = true;
+        return s.data.data();
+    }
+
+    // Size worker_id's buffer to bytes for a fill that may not happen (store
+    // queue forwarding); the slot only holds a response after markValid()
+    uint8_t* reserve(int worker_id, size_t bytes) {
+        Slot& s = slot(worker_id);
+        s.data.resize(bytes);
+        s.valid = false;
+        return s.data.data();
+    }
+    void markValid(int worker_id) { slot(worker_id).valid = true; }
+
+    // Burst buffer set up by startBurst(), for direct partial fills
+    uint8_t* burstBuffer(int worker_id) {
+        assert(worker_id >= 0 && (size_t)worker_id < slots.size() && slots[worker_id].valid);
+        return slots[worker_id].data.data();
+    }
+
+    const uint8_t* responseData(int worker_id) const {
+        return getResponse(worker_id).data();
     }
 
     void reset() {
-        req_to_worker.clear();
-        worker_to_data.clear();
+        for (auto& e : table) e = Entry();
+        num_entries = 0;
+        for (auto& s : slots) s.valid = false;
     }
 
-    void startBurst(int worker_id, uint64_t bytes) { worker_to_data[worker_id].resize(bytes); }
-    
+    void startBurst(int worker_id, uint64_t bytes) {
+        Slot& s = slot(worker_id);
+        s.data.resize(bytes);
+        s.valid = true;
+    }
+
+    size_t outstanding() const { return num_entries; }
 
 private:
-    std::unordered_map<uint64_t, int> req_to_worker;  // Maps request ID to worker ID
-    std::unordered_map<int, std::vector<uint8_t>> worker_to_data;  // Maps worker ID to response data
+    static const size_t INIT_TABLE_SIZE = 64;  // power of two
+
+    struct Entry {
+        uint64_t req_id;
+        int worker;     // -1 = empty
+        Entry() : req_id(0), worker(-1) {}
+    };
+
+    struct Slot {
+        std::vector<uint8_t> data;  // capacity is retained across requests
+        bool valid;
+        Slot() : valid(false) {}
+    };
+
+    static size_t hash(uint64_t key) {
+        // request IDs are mostly sequential; mix them so probes stay short
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        return (size_t)key;
+    }
+
+    // index of req_id's entry, or of the empty entry where it would go
+    size_t probe(uint64_t req_id) const {
+        size_t mask = table.size() - 1;
+        size_t i = hash(req_id) & mask;
+        while (table[i].worker >= 0 && table[i].req_id != req_id) i = (i + 1) & mask;
+        return i;
+    }
+
+    void erase(size_t i) {
+        size_t mask = table.size() - 1;
+        table[i] = Entry();
+        num_entries--;
+        // backward-shift the following cluster so lookups never need tombstones
+        size_t j = (i + 1) & mask;
+        while (table[j].worker >= 0) {
+            size_t home = hash(table[j].req_id) & mask;
+            // move entry j into the hole if its home is not within (i, j]
+            if (((j - home) & mask) >= ((j - i) & mask)) {
+                table[i] = table[j];
+                table[j] = Entry();
+                i = j;
+            }
+            j = (j + 1) & mask;
+        }
+    }
+
+    void growTable() {
+        std::vector<Entry> old;
+        old.swap(table);
+        table.resize(old.size() * 2);
+        num_entries = 0;
+        for (const auto& e : old) {
+            if (e.worker < 0) continue;
+            size_t i = probe(e.req_id);
+            table[i] = e;
+            num_entries++;
+        }
+    }
+
+    Slot& slot(int worker_id) {
+        if ((size_t)worker_id >= slots.size()) slots.resize(worker_id + 1);
+        return slots[worker_id];
+    }
+
+    void copyIn(int worker_id, const uint8_t* src, size_t bytes, bool burst, uint64_t offset) {
+        Slot& s = slot(worker_id);
+        if (burst) {
+            assert(offset + bytes <= s.data.size());
+        } else {
+            s.data.resize(bytes);
+            offset = 0;
+        }
+        std::memcpy(s.data.data() + offset, src, bytes);
+        s.valid = true;
+    }
+
+    std::vector<Entry> table;  // Maps request ID to worker ID
+    size_t num_entries;
+    std::vector<Slot> slots;   // Response data indexed by worker ID
 };
 
 #endif // REORDER_BUFFER_H
@@ -0,0 +1,99 @@
+#ifndef REUSE_SAMPLER_H
+#define REUSE_SAMPLER_H
+
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <cstdint>
+#include <cmath>
+
+// Online LRU stack (reuse) distance with spatial sampling, after SHARDS
+// (Waldspurger et al., FAST '15). A line is in the sample iff the hash of its
+// address falls below rate * 2^24, so every access to a sampled line is seen
+// and the sampled lines form a uniform subset of the address space. The
+// number of distinct sampled lines touched between two accesses to a line,
+// divided by the rate, estimates its stack distance in the full stream.
+//
+// Distinct lines between accesses are counted with a Fenwick tree over
+// access timestamps, where a timestamp is marked while it is the latest
+// access of its line. The timestamps are renumbered when the tree fills, so
+// memory stays proportional to the number of sampled lines.
+class ReuseSampler {
+public:
+    static const int64_t COLD = -1;
+
+    explicit ReuseSampler(double rate = 0.01)
+        : rate(std::min(1.0, std::max(0.0, rate))), now(0), tree(1025, 0), num_sampled(0) {
+        threshold = (uint32_t)(this->rate * (double)(1u << 24));
+    }
+
+    bool enabled() const { return threshold > 0; }
+    bool sampled(uint64_t line) const { return (hash(line) & 0xFFFFFF) < threshold; }
+
+    // Record an access to a sampled line. Returns the estimated distance in
+    // lines, or COLD on the first access to the line.
+    int64_t access(uint64_t line) {
+        num_sampled++;
+        if (now + 1 >= tree.size()) compact();
+        size_t t = now++;
+        auto it = last.find(line);
+        int64_t dist = COLD;
+        if (it != last.end()) {
+            size_t prev = it->second;
+            uint64_t between = prefix(t) - prefix(prev + 1);
+            dist = (int64_t)std::llround((double)between / rate);
+            add(prev, -1);
+            it->second = t;
+        } else {
+            last.emplace(line, t);
+        }
+        add(t, 1);
+        return dist;
+    }
+
+    uint64_t sampledAccesses() const { return num_sampled; }
+    size_t sampledLines() const { return last.size(); }
+    double sampleRate() const { return rate; }
+
+private:
+    static uint64_t hash(uint64_t x) {  // splitmix64 finalizer
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    void add(size_t i, int32_t d) {
+        for (++i; i < tree.size(); i += i & (~i + 1)) tree[i] += d;
+    }
+    uint64_t prefix(size_t i) const {  // marks in [0, i)
+        uint64_t s = 0;
+        for (; i > 0; i -= i & (~i + 1)) s += tree[i];
+        return s;
+    }
+
+    // Renumber the live timestamps 0..n-1 in order and rebuild the tree with
+    // room for as many accesses again
+    void compact() {
+        std::vector<std::pair<size_t, uint64_t>> order;
+        order.reserve(last.size());
+        for (auto& kv : last) order.emplace_back(kv.second, kv.first);
+        std::sort(order.begin(), order.end());
+        tree.assign(std::max<size_t>(1024, 2 * order.size()) + 1, 0);
+        for (size_t i = 0; i < order.size(); i++) {
+            last[order[i].second] = i;
+            add(i, 1);
+        }
+        now = order.size();
+    }
+
+    double rate;
+    uint32_t threshold;
+    size_t now;                               // next timestamp
+    std::vector<uint32_t> tree;               // Fenwick tree over timestamps
+    std::unordered_map<uint64_t, size_t> last;  // sampled line -> latest timestamp
+    uint64_t num_sampled;
+};
+
+#endif // REUSE_SAMPLER_H
@@ -5,6 +5,9 @@
 #include "sst/core/statapi/stataccumulator.h"
 #include <algorithm>  // For std::sort
 #include <cmath>      // For pow function
+#include <set>
+#include <map>
+#include <numeric>    // For std::iota
 #include <fstream>    // For file reading
 #include "directedprefetch.h" // Include for PrefetchRequestEvent
 #include <sst/core/realtimeAction.h>  // For current simulation time
@@ -67,7 +70,11 @@ SATSolver::SATSolver(SST::ComponentId_t id, SST::Params& params) :
     cycles_insert_watchers(0),
     cycles_polling(0),
     main_active(false),
-    spec_literal(lit_Undef),
+    spec_depth(1),
+    spec_reuse(false),
+    spec_reusable(false),
+    spec_open_depth(-1),
+    spec_depth_mark(0),
     spec_active(false),
     spec_conflicts(0),
     spec_coroutine(nullptr),
@@ -78,24 +85,57 @@ SATSolver::SATSolver(SST::ComponentId_t id, SST::Params& params) :
     output.init("MAIN-> ",verbose, 0, SST::Output::STDOUT);
 
     // Configure clock
-    registerClock(params.find<std::string>("clock", "1GHz"),
-                  new SST::Clock::Handler2<SATSolver, &SATSolver::clockTick>(this));
-
-    // Print build-time/static configuration from structs.h
-    output.output("==================[ SATSolver Configuration (structs.h) ]==================\n");
-    output.output("PARA_LITS           : %d\n", PARA_LITS);
-    output.output("PROPAGATORS         : %d\n", PROPAGATORS);
+    clock_handler = new SST::Clock::Handler2<SATSolver, &SATSolver::clockTick>(this);
+    clock_tc = registerClock(params.find<std::string>("clock", "1GHz"), clock_handler);
+    clock_gating = params.find<bool>("clock_gating", true);
+    clock_gated = false;
+    clock_resumed = false;
+    gated_at = 0;
+    gated_cycles = 0;
+    wake_pending = false;
+
+    // Runtime parallelism configuration
+    cfg.para_lits = params.find<int>("para_lits", 1);
+    cfg.propagators = params.find<int>("propagators", 1);
+    cfg.learners = params.find<int>("learners", 1);
+    cfg.minimizers = params.find<int>("minimizers", 1);
+    cfg.heaplanes = params.find<int>("heaplanes", 1);
+    cfg.pre_watchers = params.find<int>("pre_watchers", 0);
+    cfg.reducers = params.find<int>("reducers", 4);
+    if (cfg.para_lits < 1 || cfg.learners < 1 || cfg.minimizers < 1 || cfg.heaplanes < 1 || cfg.reducers < 1)
+        output.fatal(CALL_INFO, -1, "para_lits, learners, minimizers, heaplanes and reducers must be >= 1\n");
+    if (cfg.propagators < 1 || cfg.propagators > MAX_PROPAGATORS)
+        output.fatal(CALL_INFO, -1, "propagators must be in [1, %d], got %d\n",
+                     MAX_PROPAGATORS, cfg.propagators);
+    // pre-watchers are propagated as a pseudo watcher block
+    if (cfg.pre_watchers < 0 || cfg.pre_watchers > cfg.propagators)
+        output.fatal(CALL_INFO, -1, "pre_watchers must be in [0, propagators], got %d\n",
+                     cfg.pre_watchers);
+    cfg.finalize();
+
+    // Enough stacks for the top-level, literal, watcher and spec coroutines at full parallelism
+    size_t fiber_stack = params.find<size_t>("fiber_stack_size", 0);
+    if (fiber_stack > 0) fibers.setStackSize(fiber_stack);
+    fibers.reserve(2 + cfg.para_lits * (1 + cfg.propagators)
+                   + std::max({cfg.learners, cfg.minimizers, cfg.reducers}) + cfg.propagators);
+
+    // Print the solver configuration
+    output.output("==================[ SATSolver Configuration ]==================\n");
+    output.output("PARA_LITS           : %d\n", cfg.para_lits);
+    output.output("PROPAGATORS         : %d\n", cfg.propagators);
     output.output("MAX_CONFL           : %d\n", MAX_CONFL);
-    output.output("LEARNERS            : %d\n", LEARNERS);
-    output.output("HEAPLANES           : %d\n", HEAPLANES);
-    output.output("MINIMIZERS          : %d\n", MINIMIZERS);
+    output.output("LEARNERS            : %d\n", cfg.learners);
+    output.output("HEAPLANES           : %d\n", cfg.heaplanes);
+    output.output("MINIMIZERS          : %d\n", cfg.minimizers);
+    output.output("REDUCERS            : %d\n", cfg.reducers);
     output.output("OVERLAP_HEAP_INSERT : %s\n", OVERLAP_HEAP_INSERT ? "true" : "false");
     output.output("OVERLAP_HEAP_BUMP   : %s\n", OVERLAP_HEAP_BUMP ? "true" : "false");
     output.output("WRITE_BUFFER        : %s\n", WRITE_BUFFER ? "true" : "false");
-    output.output("PRE_WATCHERS        : %d\n", PRE_WATCHERS);
+    output.output("PRE_WATCHERS        : %d\n", cfg.pre_watchers);
     output.output("USE_FREE_LIST       : %d\n", USE_FREE_LIST);
-    output.output("FREE_IDX_BITS       : %d\n", FREE_IDX_BITS);
-    output.output("=============================================================================\n");
+    output.output("FREE_IDX_BITS       : %d\n", cfg.free_idx_bits);
+    output.output("SPEC_WORKER_BASE    : %d\n", cfg.spec_worker_base);
+    output.output("================================================================\n");
 
     // Get CNF file path
     cnf_file_path = params.find<std::string>("cnf_file", "");
@@ -105,6 +145,8 @@ SATSolver::SATSolver(SST::ComponentId_t id, SST::Params& params) :
 
     random_seed = params.find<uint64_t>("random_seed", 8888);
     sort_clauses = params.find<bool>("sort_clauses", true);
+    parse_threads = params.find<int>("parse_threads", 0);
+    cnf_cache_dir = params.find<std::string>("cnf_cache_dir", "");
 
     // Initialize activity-related variables
     var_decay = params.find<double>("var_decay", 0.95);
@@ -144,16 +186,52 @@ SATSolver::SATSolver(SST::ComponentId_t id, SST::Params& params) :
     }
 
     // Create Variables object by passing point of yield_ptr
-    variables = Variables(verbose, global_memory, variables_base_addr, &yield_ptr);
+    std::string var_layout = params.find<std::string>("var_layout", "split");
+    Variables::Layout layout = Variables::SPLIT;
+    if (var_layout == "packed") layout = Variables::PACKED;
+    else if (var_layout == "soa") layout = Variables::SOA;
+    else if (var_layout != "split") {
+        output.fatal(CALL_INFO, -1, "Invalid var_layout '%s' (split, packed or soa)\n", var_layout.c_str());
+    }
+    variables = Variables(verbose, global_memory, variables_base_addr, &yield_ptr, layout);
     variables.setReorderBuffer(&reorder_buffer);
     
     // Create Watches object
-    watches = Watches(verbose, global_memory, watches_base_addr, watch_nodes_base_addr, &yield_ptr);
+    watches = Watches(verbose, global_memory, watches_base_addr, watch_nodes_base_addr, &yield_ptr,
+                      cfg.propagators, cfg.pre_watchers);
     watches.setReorderBuffer(&reorder_buffer);
     
     // Create Clauses object
     clauses = Clauses(verbose, global_memory, clauses_cmd_base_addr, clauses_base_addr, &yield_ptr);
     clauses.setReorderBuffer(&reorder_buffer);
+
+    // Hits come back through the memory handler like any other clause read
+    clause_scratchpad = loadUserSubComponent<ClauseScratchpad>("clause_scratchpad",
+        SST::ComponentInfo::SHARE_NONE);
+    if (clause_scratchpad) {
+        // hits carry the logical address, the handler expects a physical one
+        clause_scratchpad->setResponseHandler([this](SST::Interfaces::StandardMem::Request* req) {
+            auto* resp = static_cast<SST::Interfaces::StandardMem::ReadResp*>(req);
+            resp->pAddr = address_layout.toPhysical(resp->pAddr);
+            handleGlobalMemEvent(req);
+        });
+        clauses.setScratchpad(clause_scratchpad);
+    }
+
+    // All init-time untimed writes are coalesced into large regions
+    preloader.setMaxRegionBytes(params.find<size_t>("preload_region_bytes", 64 << 20));
+    variables.setPreloader(&preloader);
+    watches.setPreloader(&preloader);
+    clauses.setPreloader(&preloader);
+
+    // Store queue depth shared by the solver-side data structures (0 = unbounded)
+    sq_depth = params.find<size_t>("store_queue_depth", 0);
+    variables.setStoreQueueDepth(sq_depth);
+    watches.setStoreQueueDepth(sq_depth);
+    clauses.setStoreQueueDepth(sq_depth);
+
+    // Must come before the untimed initialization writes the structures
+    configureLayout(params);
     
     // Load the selected heap subcomponent depending on build flag
 #ifdef USE_CLASSIC_HEAP
@@ -166,6 +244,8 @@ SATSolver::SATSolver(SST::ComponentId_t id, SST::Params& params) :
         global_memory, var_act_base_addr);
 #endif
     sst_assert(order_heap != nullptr, CALL_INFO, -1, "Unable to load Heap subcomponent\n");
+    order_heap->setHeapLanes(cfg.heaplanes);
+    order_heap->setPreloader(&preloader);
     in_decision = false;
     heap_resp_cnt = 0;
 
@@ -179,17 +259,144 @@ SATSolver::SATSolver(SST::ComponentId_t id, SST::Params& params) :
         prefetch_link = configureLink("prefetch_port");
         sst_assert(prefetch_link != nullptr, CALL_INFO, -1, "Error: 'prefetch_port' is not connected to a link\n");
     }
+    // Functional fast-forward, mirrors must exist before the untimed init
+    ff_conflicts = params.find<uint64_t>("fast_forward_conflicts", 0);
+    ff_decisions = params.find<uint64_t>("fast_forward_decisions", 0);
+    sample_interval = params.find<uint64_t>("sample_interval", 0);
+    sample_warmup = params.find<uint64_t>("sample_warmup", 1000);
+    sample_detail = params.find<uint64_t>("sample_detail", 1000);
+    if (sample_interval > 0 && (sample_detail == 0 || sample_warmup + sample_detail >= sample_interval)) {
+        output.fatal(CALL_INFO, -1, "Need sample_detail > 0 and sample_warmup + sample_detail < sample_interval\n");
+    }
+    if (sample_interval > 0 && ff_decisions > 0) {
+        output.fatal(CALL_INFO, -1, "Sampling counts conflicts, use fast_forward_conflicts for its first functional span\n");
+    }
+    fast_forwarding = ff_conflicts > 0 || ff_decisions > 0 || sample_interval > 0;
+    conflicts_total = decisions_total = 0;
+    ff_switch_cycle = 0;
+    ff_materialized = 0;
+    sample_phase = SAMPLE_FUNCTIONAL;
+    sample_next = ff_conflicts > 0 ? ff_conflicts : sample_interval - sample_warmup - sample_detail;
+    sample_start_conflicts = 0;
+    std::fill(std::begin(sample_start), std::end(sample_start), 0);
+    if (fast_forwarding) {
+        AsyncBase* mirrored[] = { &variables, &watches, &clauses };
+        for (AsyncBase* ds : mirrored) {
+            ds->enableMirror();
+            ds->setFunctional(true);
+        }
+        if (sample_interval > 0) {
+            output.output("Sampling every %lu conflicts: %lu warm-up + %lu measured, first after %lu\n",
+                sample_interval, sample_warmup, sample_detail, sample_next);
+        } else {
+            output.output("Fast-forward until %lu conflicts / %lu decisions (0 = no limit), heap stays timed\n",
+                ff_conflicts, ff_decisions);
+        }
+    }
+
+    // Portfolio peers, if any: share_port_0, share_port_1, ...
+    portfolio_id = params.find<int>("portfolio_id", 0);
+    portfolio_winner = -1;
+    share_max_lbd = params.find<int>("share_max_lbd", 2);
+    share_max_size = params.find<int>("share_max_size", 2);
+    share_bytes_per_cycle = params.find<uint64_t>("share_bytes_per_cycle", 0);
+    share_queue = params.find<size_t>("share_queue", 4096);
+    for (int i = 0; isPortConnected("share_port_" + std::to_string(i)); i++) {
+        share_links.push_back(configureLink("share_port_" + std::to_string(i),
+            new SST::Event::Handler2<SATSolver, &SATSolver::handleShareEvent>(this)));
+        sst_assert(share_links.back() != nullptr, CALL_INFO, -1, "Unable to configure share_port_%d\n", i);
+    }
+    share_busy_until.assign(share_links.size(), 0);
+    if (!share_links.empty()) {
+        output.output("Portfolio solver %d: sharing with %zu peers (LBD <= %d or size <= %d)\n",
+            portfolio_id, share_links.size(), share_max_lbd, share_max_size);
+    }
+
+    for (int i = 0; isPortConnected("profile_port_" + std::to_string(i)); i++) {
+        profile_links.push_back(configureLink("profile_port_" + std::to_string(i)));
+        sst_assert(profile_links.back() != nullptr, CALL_INFO, -1, "Unable to configure profile_port_%d\n", i);
+    }
+
+    prefetch_chase = prefetch_enabled && params.find<bool>("prefetch_chase", false);
+    prefetch_lookahead = std::max(1, params.find<int>("prefetch_lookahead", 2));
+    prefetch_chased = 0;
 
     enable_speculative = params.find<bool>("enable_speculative", false);
+    spec_depth = params.find<int>("spec_depth", 1);
+    if (spec_depth < 1 || spec_depth > MAX_SPEC_DEPTH) {
+        output.fatal(CALL_INFO, -1, "spec_depth must be in [1, %d], got %d\n", MAX_SPEC_DEPTH, spec_depth);
+    }
+    spec_reuse = params.find<bool>("spec_reuse", false);
+    // a functional span only matches the timed run it replaces when the
+    // worker interleaving cannot depend on memory timing
+    if (fast_forwarding && (cfg.para_lits > 1 || cfg.propagators > 1 || cfg.learners > 1
+                            || cfg.minimizers > 1 || enable_speculative || !share_links.empty())) {
+        output.fatal(CALL_INFO, -1, "Fast-forward and sampling need para_lits, propagators, learners "
+            "and minimizers = 1, no speculation and no portfolio sharing\n");
+    }
     timeout_cycles = params.find<uint64_t>("timeout_cycles", 0);
+    timed_out = false;
+    timeout_link = nullptr;
+    if (timeout_cycles > 0) {
+        timeout_link = configureSelfLink("timeout", clock_tc,
+            new SST::Event::Handler2<SATSolver, &SATSolver::handleTimeout>(this));
+    }
     profile_2wl = params.find<bool>("profile_2wl", false);
     profile_prop_timing = params.find<bool>("profile_prop_timing", false);
+    profile_mem = params.find<bool>("profile_mem", false);
+    if (profile_mem) {
+        MemProfile::Clock clock = [this]() -> uint64_t { return getCurrentSimTime(clock_tc); };
+        variables.enableMemProfile(clock);
+        watches.enableMemProfile(clock);
+        clauses.enableMemProfile(clock);
+        order_heap->enableMemProfile(clock);
+    }
     // Speculative profiling depends on the same per-literal cycle data, so
     // force the timing breakdown on whenever speculation is enabled.
     if (enable_speculative) profile_prop_timing = true;
     if (profile_prop_timing) {
         output.output("Per-propagation timing breakdown enabled\n");
     }
+    gc_compact = params.find<bool>("gc_compact", false);
+    gc_interval = std::max(1, params.find<int>("gc_interval", 1));
+    std::string gc_order = params.find<std::string>("gc_order", "activity");
+    if (gc_order != "activity" && gc_order != "address") {
+        output.fatal(CALL_INFO, -1, "Invalid gc_order '%s' (activity or address)\n", gc_order.c_str());
+    }
+    gc_by_activity = gc_order == "activity";
+    reductions_since_gc = 0;
+    binary_watchers = params.find<bool>("binary_watchers", false);
+    watch_compact_lists = std::max(0, params.find<int>("watch_compact_lists", 0));
+    reduce_unit = params.find<bool>("reduce_unit", false);
+    std::string reduce_select = params.find<std::string>("reduce_select", "median");
+    if (reduce_select != "median" && reduce_select != "bitonic") {
+        output.fatal(CALL_INFO, -1, "Invalid reduce_select '%s' (median or bitonic)\n", reduce_select.c_str());
+    }
+    reduce_bitonic = reduce_select == "bitonic";
+    reduce_width = std::max(1, params.find<int>("reduce_width", 16));
+    learnt_tiers = params.find<bool>("learnt_tiers", false);
+    if (learnt_tiers && !reduce_unit) {
+        output.fatal(CALL_INFO, -1, "learnt_tiers needs reduce_unit (tiers are read from the clause summaries)\n");
+    }
+    tier_core_lbd = params.find<int>("tier_core_lbd", 2);
+    tier_mid_lbd = params.find<int>("tier_mid_lbd", 6);
+    if (tier_core_lbd < 1 || tier_mid_lbd < tier_core_lbd || tier_mid_lbd > CLAUSE_MAX_LBD) {
+        output.fatal(CALL_INFO, -1, "Need 1 <= tier_core_lbd <= tier_mid_lbd <= %d\n", CLAUSE_MAX_LBD);
+    }
+    std::fill(std::begin(tier_kept), std::end(tier_kept), 0);
+    clauses.setTierRegions(params.find<uint32_t>("tier_core_bytes", 0), params.find<uint32_t>("tier_mid_bytes", 0));
+    std::string clause_placement = params.find<std::string>("clause_placement", "packed");
+    ClausePlacement placement = PLACE_PACKED;
+    if (clause_placement == "line") placement = PLACE_LINE;
+    else if (clause_placement == "head") placement = PLACE_HEAD;
+    else if (clause_placement == "split") placement = PLACE_SPLIT;
+    else if (clause_placement != "packed") {
+        output.fatal(CALL_INFO, -1, "Invalid clause_placement '%s' (packed, line, head or split)\n",
+                     clause_placement.c_str());
+    }
+    clauses.setPlacement(placement);
+    watches.setClausePlacement(placement, clauses_base_addr);
+    watches.setBinaryWatchers(binary_watchers);
     glucose_restart = params.find<bool>("glucose_restart", false);
     if (glucose_restart) {
         output.output("Glucose-style LBD-based restarts enabled\n");
@@ -216,6 +423,17 @@ SATSolver::SATSolver(SST::ComponentId_t id, SST::Params& params) :
     stat_learned = registerStatistic<uint64_t>("learned");
     stat_removed = registerStatistic<uint64_t>("removed");
     stat_db_reductions = registerStatistic<uint64_t>("db_reductions");
+    stat_reduce_cycles = registerStatistic<uint64_t>("reduce_cycles");
+    stat_reduce_bytes = registerStatistic<uint64_t>("reduce_stream_bytes");
+    stat_reduce_select = registerStatistic<uint64_t>("reduce_select_cycles");
+    stat_reduce_lists = registerStatistic<uint64_t>("reduce_watch_lists");
+    stat_tier_promoted = registerStatistic<uint64_t>("tier_promoted");
+    stat_tier_demoted = registerStatistic<uint64_t>("tier_demoted");
+    stat_share_exported = registerStatistic<uint64_t>("share_exported");
+    stat_share_imported = registerStatistic<uint64_t>("share_imported");
+    stat_share_dropped = registerStatistic<uint64_t>("share_dropped");
+    stat_share_satisfied = registerStatistic<uint64_t>("share_satisfied");
+    stat_share_bytes = registerStatistic<uint64_t>("share_bytes");
     stat_minimized_literals = registerStatistic<uint64_t>("minimized_literals");
     stat_restarts = registerStatistic<uint64_t>("restarts");
     stat_watcher_occ = registerStatistic<uint64_t>("watcher_occ");
@@ -224,6 +442,16 @@ SATSolver::SATSolver(SST::ComponentId_t id, SST::Params& params) :
     stat_para_vars = registerStatistic<uint64_t>("para_vars");
     stat_spec_started = registerStatistic<uint64_t>("spec_started");
     stat_spec_finished = registerStatistic<uint64_t>("spec_finished");
+    for (int d = 0; d < spec_depth; d++) {
+        std::string sub = "d" + std::to_string(d);
+        stat_spec_depth[d].started = registerStatistic<uint64_t>("spec_depth_started", sub);
+        stat_spec_depth[d].hits = registerStatistic<uint64_t>("spec_depth_hits", sub);
+        stat_spec_depth[d].dropped = registerStatistic<uint64_t>("spec_depth_dropped", sub);
+        stat_spec_depth[d].lines = registerStatistic<uint64_t>("spec_depth_lines", sub);
+        stat_spec_depth[d].wasted_lines = registerStatistic<uint64_t>("spec_wasted_lines", sub);
+    }
+    stat_spec_adopted = registerStatistic<uint64_t>("spec_adopted");
+    stat_spec_rejected = registerStatistic<uint64_t>("spec_rejected");
     stat_total_occ = registerStatistic<uint64_t>("total_occ");
     stat_watcher_traversed = registerStatistic<uint64_t>("watcher_traversed");
     stat_learnt_length = registerStatistic<uint64_t>("learnt_length");
@@ -231,32 +459,66 @@ SATSolver::SATSolver(SST::ComponentId_t id, SST::Params& params) :
     stat_learnt_lbd = registerStatistic<uint64_t>("learnt_lbd");
     stat_bt_level = registerStatistic<uint64_t>("bt_level");
     stat_bt_distance = registerStatistic<uint64_t>("bt_distance");
+    stat_sq_forwards = registerStatistic<uint64_t>("sq_forwards");
+    stat_sq_full_stalls = registerStatistic<uint64_t>("sq_full_stalls");
+    stat_sq_full_writes = registerStatistic<uint64_t>("sq_full_writes");
+    const char* mem_names[MEM_PROFILED] = { "variables", "watches", "clauses", "var_activity" };
+    for (int i = 0; i < MEM_PROFILED; i++) {
+        stat_mem[i].read_latency = registerStatistic<uint64_t>("mem_read_latency", mem_names[i]);
+        stat_mem[i].outstanding = registerStatistic<uint64_t>("mem_outstanding", mem_names[i]);
+        stat_mem[i].read_bytes = registerStatistic<uint64_t>("mem_read_bytes", mem_names[i]);
+        stat_mem[i].write_bytes = registerStatistic<uint64_t>("mem_write_bytes", mem_names[i]);
+        stat_mem[i].busy_cycles = registerStatistic<uint64_t>("mem_busy_cycles", mem_names[i]);
+    }
+    stat_value_reads = registerStatistic<uint64_t>("value_reads");
+    for (int i = 0; i < NUM_SIZE_CLASSES; i++) {
+        if (!CLAUSE_CLASS_NAMES[i]) continue;
+        stat_clause_lines[i].reads = registerStatistic<uint64_t>("clause_reads", CLAUSE_CLASS_NAMES[i]);
+        stat_clause_lines[i].lines = registerStatistic<uint64_t>("clause_read_lines", CLAUSE_CLASS_NAMES[i]);
+        stat_clause_lines[i].min_lines = registerStatistic<uint64_t>("clause_min_lines", CLAUSE_CLASS_NAMES[i]);
+    }
+    stat_gc_compactions = registerStatistic<uint64_t>("gc_compactions");
+    stat_gc_moved = registerStatistic<uint64_t>("gc_moved");
+    stat_chain_blocks = registerStatistic<uint64_t>("watch_chain_blocks");
+    stat_chain_watchers = registerStatistic<uint64_t>("watch_chain_watchers");
+    stat_watch_compactions = registerStatistic<uint64_t>("watch_compactions");
+    stat_watch_blocks_freed = registerStatistic<uint64_t>("watch_blocks_freed");
+    stat_watch_colocated = registerStatistic<uint64_t>("watch_blocks_colocated");
+    if (address_layout.numStripes() > 1) {
+        for (int s = 0; s < address_layout.numStripes(); s++) {
+            std::string sub = "s" + std::to_string(s);
+            stat_stripe_reads.push_back(registerStatistic<uint64_t>("layout_stripe_reads", sub));
+            stat_stripe_writes.push_back(registerStatistic<uint64_t>("layout_stripe_writes", sub));
+        }
+    }
 
     // Binary memory-access trace writer (opt-in).
     std::string trace_file = params.find<std::string>("trace_file", "");
     if (!trace_file.empty()) {
         tracer_ = new TraceWriter();
         size_t trace_buf = params.find<size_t>("trace_buffer_bytes", 4*1024*1024);
-        if (!tracer_->open(trace_file, trace_buf)) {
+        std::string trace_compression = params.find<std::string>("trace_compression", "zlib");
+        int trace_level = params.find<int>("trace_compression_level", 1);
+        TraceWriter::Codec trace_codec = TraceWriter::CODEC_ZLIB;
+        if (trace_compression == "none") trace_codec = TraceWriter::CODEC_NONE;
+        else if (trace_compression != "zlib")
+            output.fatal(CALL_INFO, -1, "trace_compression must be zlib or none, got %s\n",
+                         trace_compression.c_str());
+        if (trace_level < 1 || trace_level > 9)
+            output.fatal(CALL_INFO, -1, "trace_compression_level must be 1-9\n");
+        if (!tracer_->open(trace_file, trace_buf, trace_codec, trace_level)) {
             output.fatal(CALL_INFO, -1, "trace_file: could not open %s\n", trace_file.c_str());
         }
         TraceWriter::DsMap m;
-        m.nibble[(heap_base_addr        >> 28) & 0xF] = TraceWriter::DS_HEAP;
-        m.nibble[(indices_base_addr     >> 28) & 0xF] = TraceWriter::DS_INDICES;
-        m.nibble[(variables_base_addr   >> 28) & 0xF] = TraceWriter::DS_VARIABLES;
-        m.nibble[(watches_base_addr     >> 28) & 0xF] = TraceWriter::DS_WATCHES;
-        m.nibble[(watch_nodes_base_addr >> 28) & 0xF] = TraceWriter::DS_WATCH_NODES;
-        m.nibble[(clauses_cmd_base_addr >> 28) & 0xF] = TraceWriter::DS_CLAUSES_CMD;
-        m.nibble[(clauses_base_addr     >> 28) & 0xF] = TraceWriter::DS_CLAUSES;
-        m.nibble[(var_act_base_addr     >> 28) & 0xF] = TraceWriter::DS_VAR_ACT;
+        for (const auto& r : address_layout.regionTable()) m.add(r.base, (TraceWriter::DsId)r.id);
         tracer_->setDsMap(m);
 
         variables.setTracer(tracer_, TraceWriter::DS_VARIABLES);
         watches  .setTracer(tracer_, TraceWriter::DS_WATCHES);
         clauses  .setTracer(tracer_, TraceWriter::DS_CLAUSES);
         order_heap->setTracer(tracer_, TraceWriter::DS_HEAP);
-        output.output("Binary trace writer enabled: %s (buffer=%zu B)\n",
-                      trace_file.c_str(), trace_buf);
+        output.output("Binary trace writer enabled: %s (buffer=%zu B, %s)\n",
+                      trace_file.c_str(), trace_buf, trace_compression.c_str());
     }
 
     // Component should not end simulation until solution is found
@@ -296,17 +558,28 @@ void SATSolver::init(unsigned int phase) {
         // "naive" occurrence cost reflects the original CNF only.
         if (profile_2wl) {
             lit_occ_count.resize(2 * (num_vars + 1), 0);
-            for (auto& c : parsed_clauses) {
-                for (auto& lit : c.literals) {
-                    lit_occ_count[toWatchIndex(~lit)]++;
-                }
+            for (Lit lit : parsed_clauses.lits) {
+                lit_occ_count[toWatchIndex(~lit)]++;
             }
         }
 
+        // The simulated memory now holds the clauses
+        parsed_clauses.clear();
+
         order_heap->setDecisionFlags(decision);
         order_heap->setHeapSize(num_vars);
         order_heap->setVarIncPtr(&var_inc);
         order_heap->initHeap(random_seed);
+
+        // Detach it so later untimed writes go straight to memory instead of
+        // waiting for a flush that never comes
+        preloader.flush();
+        variables.setPreloader(nullptr);
+        watches.setPreloader(nullptr);
+        clauses.setPreloader(nullptr);
+        order_heap->setPreloader(nullptr);
+        output.verbose(CALL_INFO, 1, 0, "Preloaded %lu bytes: %lu untimed writes in %lu regions\n",
+                       preloader.bytes(), preloader.writes(), preloader.regions());
     }
     output.verbose(CALL_INFO, 3, 0, "SATSolver initialized in phase %u\n", phase);
 }
@@ -323,6 +596,11 @@ void SATSolver::setup() {
     watches.setLineSize(line_size);
     clauses.setLineSize(line_size);
     order_heap->setLineSize(line_size);
+    std::string layout_err = address_layout.finalize(line_size);
+    if (!layout_err.empty()) output.fatal(CALL_INFO, -1, "address_layout: %s\n", layout_err.c_str());
+
+    // delay in solver cycles from cycle 0
+    if (timeout_link) timeout_link->send(timeout_cycles, new SST::Event());
 
     // Write the trace file header now that num_vars/num_clauses are known
     // (populated by init(phase=0) before setup runs). No trace events have
@@ -346,6 +624,8 @@ void SATSolver::finish() {
     // Flush and close the binary trace writer (if enabled).
     if (tracer_) {
         tracer_->close(total_cycles);
+        output.verbose(CALL_INFO, 1, 0, "Trace: %lu events in %lu blocks, %lu B on disk, %lu flush stalls\n",
+                       tracer_->events(), tracer_->blocks(), tracer_->fileBytes(), tracer_->stalls());
         delete tracer_;
         tracer_ = nullptr;
     }
@@ -355,6 +635,18 @@ void SATSolver::finish() {
         decision_output_stream.close();
         output.verbose(CALL_INFO, 1, 0, "Closed decision output file\n");
     }
+    output.verbose(CALL_INFO, 1, 0, "Clock gated for %lu of %lu cycles (heap %lu)\n",
+                   gated_cycles, total_cycles, order_heap->gatedCycles());
+#ifndef USE_CLASSIC_HEAP
+    output.verbose(CALL_INFO, 1, 0, "Heap lanes: %d, peak %lu bumps in flight, %lu hazard stalls, "
+                   "%lu bypassed positions, %lu batched requests\n",
+                   cfg.heaplanes, order_heap->peakBumps(), order_heap->laneHazardStalls(),
+                   order_heap->laneBypassHits(), order_heap->batchRequests());
+#endif
+    output.verbose(CALL_INFO, 1, 0, "Lock waits: %lu on clauses, %lu on watch lists\n",
+                   clause_waiters.waits(), watch_waiters.waits());
+    output.verbose(CALL_INFO, 1, 0, "Fibers: %lu spawned on %zu pooled stacks of %zu bytes (peak %zu live)\n",
+                   fibers.spawns(), fibers.stacksAllocated(), fibers.stackSize(), fibers.peakInUse());
     
     // Print solver statistics
     output.output("============================[ Solver Statistics ]============================\n");
@@ -364,8 +656,56 @@ void SATSolver::finish() {
     output.output("Learned      : %lu\n", getStatCount(stat_learned));
     output.output("Removed      : %lu\n", getStatCount(stat_removed));
     output.output("DB_Reductions: %lu\n", getStatCount(stat_db_reductions));
+    if (reduce_unit && getStatCount(stat_db_reductions) > 0) {
+        output.output("Reduce unit  : %lu bytes streamed, %lu select cycles, %lu watch lists walked\n",
+            getStatCount(stat_reduce_bytes), getStatCount(stat_reduce_select), getStatCount(stat_reduce_lists));
+    }
+    if (learnt_tiers) {
+        output.output("Learnt tiers : %lu promoted, %lu demoted, last reduction kept %lu core / %lu mid / %lu local\n",
+            getStatCount(stat_tier_promoted), getStatCount(stat_tier_demoted),
+            tier_kept[TIER_CORE], tier_kept[TIER_MID], tier_kept[TIER_LOCAL]);
+    }
+    if (clauses.tierRegions()) {
+        output.output("Tier regions : %lu clauses spilled to the local region\n", clauses.regionSpills());
+    }
+    if (clause_scratchpad) {
+        uint64_t sp_reads = clause_scratchpad->hits() + clause_scratchpad->misses();
+        output.output("Scratchpad   : %lu/%lu clause reads hit (%.1f%%), %lu bytes saved, %lu evictions (%s, %lu bytes)\n",
+            clause_scratchpad->hits(), sp_reads,
+            sp_reads ? 100.0 * clause_scratchpad->hits() / sp_reads : 0.0,
+            clause_scratchpad->bytesSaved(), clause_scratchpad->evictions(),
+            clause_scratchpad->policyName().c_str(), clause_scratchpad->capacity());
+    }
+    if (sample_interval > 0) printSampling();
+    else if (ff_conflicts > 0 || ff_decisions > 0) {
+        if (fast_forwarding) output.output("Fast-forward : limit not reached, the whole run was functional\n");
+        else output.output("Fast-forward : switched to timed at cycle %lu (%lu timed cycles), %lu bytes materialized\n",
+            (uint64_t)ff_switch_cycle, total_cycles - ff_switch_cycle, ff_materialized);
+    }
+    if (!share_links.empty()) {
+        output.output("Portfolio    : solver %d, %lu clauses sent (%lu bytes), %lu imported, %lu satisfied, %lu dropped%s\n",
+            portfolio_id, getStatCount(stat_share_exported), getStatCount(stat_share_bytes),
+            getStatCount(stat_share_imported), getStatCount(stat_share_satisfied), getStatCount(stat_share_dropped),
+            portfolio_winner >= 0 ? ", stopped by a peer" : "");
+    }
+    if (gc_compact) {
+        output.output("Compactions  : %lu (%lu clauses moved)\n",
+            getStatCount(stat_gc_compactions), getStatCount(stat_gc_moved));
+    }
+    uint64_t chain_blocks = getStatCount(stat_chain_blocks), chain_watchers = getStatCount(stat_chain_watchers);
+    output.output("Watch chains : %.3f blocks/watcher (%lu blocks read for %lu watchers, %.3f when full)\n",
+        chain_watchers ? (double)chain_blocks / chain_watchers : 0.0, chain_blocks, chain_watchers,
+        1.0 / cfg.propagators);
+    if (watch_compact_lists > 0) {
+        output.output("Watch compact: %lu lists compacted, %lu blocks freed, %zu sparse lists pending\n",
+            getStatCount(stat_watch_compactions), getStatCount(stat_watch_blocks_freed), watches.numSparse());
+    }
     output.output("Assigns      : %lu\n", getStatCount(stat_assigns));
     output.output("UnAssigns    : %lu\n", getStatCount(stat_unassigns));
+    if (variables.valuesInMemory()) {
+        output.output("Value Reads  : %lu (%s variable layout)\n", getStatCount(stat_value_reads),
+            variables.getLayout() == Variables::PACKED ? "packed" : "soa");
+    }
     output.output("Minimized    : %lu\n", getStatCount(stat_minimized_literals));
     output.output("Restarts     : %lu\n", getStatCount(stat_restarts));
     // Speculative propagation statistics
@@ -433,6 +773,69 @@ void SATSolver::finish() {
         }
     }
     
+    // Store queue statistics
+    if (WRITE_BUFFER) {
+        const AsyncBase* queues[] = { &variables, &watches, &clauses };
+        const char* names[] = { "Variables", "Watches", "Clauses" };
+        uint64_t total_fwd = 0, total_stalls = 0, total_full_writes = 0;
+        output.output("=========================[ Store Queue Statistics ]========================\n");
+        output.output("Depth        : %zu%s\n", sq_depth, sq_depth == 0 ? " (unbounded)" : "");
+        for (int i = 0; i < 3; i++) {
+            const StoreQueue& sq = queues[i]->storeQueue();
+            output.output("%-12s : forwards %lu, full stalls %lu, full writes %lu, max occupancy %lu\n", names[i],
+                sq.getForwardHits(), sq.getFullStalls(), sq.getFullWrites(), sq.getMaxOccupancy());
+            total_fwd += sq.getForwardHits();
+            total_stalls += sq.getFullStalls();
+            total_full_writes += sq.getFullWrites();
+        }
+        output.output("===========================================================================\n");
+        stat_sq_forwards->addData(total_fwd);
+        stat_sq_full_stalls->addData(total_stalls);
+        stat_sq_full_writes->addData(total_full_writes);
+    }
+
+    // Memory profile: latency, achieved MLP and bandwidth of each structure
+    if (profile_mem) {
+        const MemProfile* profiles[MEM_PROFILED] = {
+            variables.memProfile(), watches.memProfile(), clauses.memProfile(), order_heap->memProfile() };
+        const char* names[MEM_PROFILED] = { "Variables", "Watches", "Clauses", "VarActivity" };
+        output.output("=========================[ Memory Profile Statistics ]=====================\n");
+        for (int i = 0; i < MEM_PROFILED; i++) {
+            const MemProfile* p = profiles[i];
+            if (!p) continue;
+            double cycles = total_cycles > 0 ? (double)total_cycles : 1.0;
+            output.output("%-12s : %lu reads, %lu B read, %lu B written, latency %.1f mean / %lu max, "
+                          "MLP %.2f (peak %lu), %lu busy cycles, %.3f B/cycle\n",
+                names[i], p->reads(), p->readBytes(), p->writeBytes(), p->meanLatency(), p->maxLatency(),
+                p->achievedMlp(), p->peakOutstanding(), p->busyCycles(),
+                (p->readBytes() + p->writeBytes()) / cycles);
+
+            const std::vector<uint64_t>& lat = p->latencyCounts();
+            for (size_t l = 0; l < lat.size(); l++)
+                if (lat[l]) stat_mem[i].read_latency->addDataNTimes(lat[l], l);
+            const std::vector<uint64_t>& occ = p->occupancyCounts();
+            for (size_t n = 0; n < occ.size(); n++)
+                if (occ[n]) stat_mem[i].outstanding->addDataNTimes(occ[n], n);
+            stat_mem[i].read_bytes->addData(p->readBytes());
+            stat_mem[i].write_bytes->addData(p->writeBytes());
+            stat_mem[i].busy_cycles->addData(p->busyCycles());
+        }
+        output.output("===========================================================================\n");
+    }
+
+    output.output("=========================[ Clause Line Statistics ]=======================\n");
+    for (int i = 0; i < NUM_SIZE_CLASSES; i++) {
+        const Clauses::LineStats& ls = clauses.lineStats(i);
+        if (ls.reads == 0) continue;
+        output.output("%-12s : %10lu reads, %10lu lines, %.3f lines/read, %.3f min lines/read\n",
+            CLAUSE_CLASS_NAMES[i], ls.reads, ls.lines, (double)ls.lines / ls.reads,
+            (double)ls.min_lines / ls.reads);
+        stat_clause_lines[i].reads->addData(ls.reads);
+        stat_clause_lines[i].lines->addData(ls.lines);
+        stat_clause_lines[i].min_lines->addData(ls.min_lines);
+    }
+    output.output("===========================================================================\n");
+
     // Reduced clause access statistics (only meaningful when profile_2wl is enabled).
     // Note: lit_occ_count tracks the original CNF only, so total_occ_sum is a
     // conservative under-count of what a naive occurrence-list propagator would do.
@@ -551,7 +954,52 @@ void SATSolver::finish() {
         output.output("Max cache lines per propagation: %lu\n", max_cache_lines);
         output.output("===========================================================================\n");
     }
+
+    // Per depth: contexts run, speculated literals decided as predicted
+    // (hits) or dropped, and the lines they brought in
+    if (enable_speculative) {
+        output.output("======================[ Speculation Depth Statistics ]====================\n");
+        for (int d = 0; d < spec_depth; d++) {
+            const SpecDepthStats& st = stat_spec_depth[d];
+            uint64_t hits = getStatCount(st.hits), dropped = getStatCount(st.dropped);
+            output.output("Depth %d      : %10lu contexts, %8lu hits, %8lu dropped (%.1f%% hit), %10lu lines, %10lu wasted\n",
+                d, getStatCount(st.started), hits, dropped,
+                hits + dropped > 0 ? 100.0 * hits / (hits + dropped) : 0.0,
+                getStatCount(st.lines), getStatCount(st.wasted_lines));
+        }
+        if (spec_reuse) {
+            output.output("Reused       : %lu implications adopted, %lu rejected\n",
+                getStatCount(stat_spec_adopted), getStatCount(stat_spec_rejected));
+        }
+        output.output("===========================================================================\n");
+    }
     
+    // Solver-side requests per memory stripe; a busiest stripe well above
+    // the mean leaves the other channels idle
+    if (address_layout.numStripes() > 1) {
+        static const char* const policy_names[] = { "linear", "interleave", "hash" };
+        int stripes = address_layout.numStripes();
+        output.output("=======================[ Address Layout Statistics ]======================\n");
+        output.output("Layout       : %s, %d stripes\n", policy_names[address_layout.getPolicy()], stripes);
+        uint64_t total = 0, busiest = 0;
+        for (int st = 0; st < stripes; st++) {
+            uint64_t reads = address_layout.stripeReads(st), writes = address_layout.stripeWrites(st);
+            stat_stripe_reads[st]->addDataNTimes(reads, 1);
+            stat_stripe_writes[st]->addDataNTimes(writes, 1);
+            output.output("Stripe %-6d: %10lu reads, %10lu writes\n", st, reads, writes);
+            total += reads + writes;
+            busiest = std::max(busiest, reads + writes);
+        }
+        output.output("Balance      : busiest stripe %.2fx the mean\n",
+            total > 0 ? (double)busiest * stripes / total : 0.0);
+        if (watches.colocating()) {
+            stat_watch_colocated->addDataNTimes(watches.colocatedBlocks(), 1);
+            output.output("Colocated    : %lu watcher blocks, %lu bytes of watcher nodes spanned\n",
+                watches.colocatedBlocks(), watches.nodesEnd() - watch_nodes_base_addr);
+        }
+        output.output("===========================================================================\n");
+    }
+
     // Add new detailed propagation statistics (gated by profile_prop_timing)
     if (profile_prop_timing) {
         output.output("======================[ Propagation Detail Statistics ]===================\n");
@@ -591,135 +1039,40 @@ void SATSolver::finish() {
 
 void SATSolver::parseDIMACS(const std::string& filename) {
     output.output("Starting DIMACS parsing from file: %s\n", filename.c_str());
-    
-    // Open file safely for direct reading
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        output.fatal(CALL_INFO, -1, "Failed to open CNF file: %s\n", filename.c_str());
-    }
-    
-    std::string line;
-    Clause pending_clause;  // accumulates literals across lines until 0-terminator
-    while (std::getline(file, line)) {
-        // Skip empty lines
-        if (line.empty()) continue;
-        
-        // Remove any trailing carriage returns or whitespace
-        while (!line.empty() && (line.back() == '\r' || line.back() == '\n' || line.back() == ' ' || line.back() == '\t')) {
-            line.pop_back();
-        }
-        
-        // Skip empty lines after cleaning
-        if (line.empty()) continue;
-        
-        // Skip whitespace at start
-        size_t firstChar = line.find_first_not_of(" \t");
-        if (firstChar == std::string::npos) continue;
-        
-        // Process based on first character
-        switch (line[firstChar]) {
-            case 'c':  // Comment line
-                output.verbose(CALL_INFO, 8, 0,
-                    "Comment: %s\n", line.substr(firstChar + 1).c_str());
-                break;
-                
-            case 'p': {  // Problem line
-                std::istringstream pline(line);
-                std::string p, cnf;
-                pline >> p >> cnf;
-                if (cnf != "cnf") {
-                    output.fatal(CALL_INFO, -1,
-                        "Invalid DIMACS format: expected 'cnf' but got '%s'\n",
-                        cnf.c_str());
-                }
-                pline >> num_vars >> num_clauses;
-                output.verbose(CALL_INFO, 1, 0,
-                    "Problem: vars=%u clauses=%u\n", num_vars, num_clauses);
-                break;
-            }
-                
-            default: {  // Clause line
-                std::istringstream clause_iss(line);
-                int dimacs_lit;
-
-                // Validate the line contains only valid DIMACS literals
-                bool valid_clause = true;
-                for (char c : line) {
-                    if (!std::isdigit(c) && c != '-' && c != ' ' && c != '\t' && c != '0') {
-                        valid_clause = false;
-                        break;
-                    }
-                }
-
-                if (!valid_clause) {
-                    output.verbose(CALL_INFO, 4, 0, "Skipping invalid clause line: %s\n", line.c_str());
-                    continue;
-                }
-
-                // Accumulate literals into pending_clause; emit when 0 is seen.
-                // This handles clauses that span multiple lines.
-                while (clause_iss >> dimacs_lit) {
-                    if (dimacs_lit == 0) {
-                        // Clause terminator: emit the accumulated clause
-                        if (pending_clause.literals.empty()) continue;
-
-                        if (pending_clause.literals.size() == 1) {  // Unit clause
-                            if (std::find(initial_units.begin(), initial_units.end(),
-                                          pending_clause.literals[0]) == initial_units.end()) {
-                                initial_units.push_back(pending_clause.literals[0]);
-                            }
-                            num_clauses--;
-                            output.verbose(CALL_INFO, 3, 0,
-                                "Unit clause: %d\n", toInt(pending_clause.literals[0]));
-                        } else {
-                            if (sort_clauses) {
-                                std::sort(pending_clause.literals.begin(), pending_clause.literals.end());
-                            }
-
-                            pending_clause.literals.erase(
-                                std::unique(pending_clause.literals.begin(), pending_clause.literals.end()),
-                                pending_clause.literals.end());
 
-                            pending_clause.num_lits = pending_clause.literals.size();
-                            parsed_clauses.push_back(pending_clause);
-
-                            output.verbose(CALL_INFO, 6, 0, "Added clause %lu: %s\n",
-                                           parsed_clauses.size() - 1, printClause(pending_clause.literals).c_str());
-                        }
-                        pending_clause = Clause();
-                    } else {
-                        Lit lit = toLit(dimacs_lit);
-                        pending_clause.literals.push_back(lit);
-                    }
-                }
-                // No break: if line had no 0, pending_clause carries over to next line
-                break;
-            }
-        }
+    CnfLoader loader(parse_threads, sort_clauses);
+    ParsedCnf cnf;
+    if (!loader.load(filename, cnf_cache_dir, cnf)) {
+        output.fatal(CALL_INFO, -1, "%s\n", loader.error().c_str());
     }
-    
-    // Flush any remaining pending clause (file ended without trailing 0)
-    if (!pending_clause.literals.empty()) {
-        if (pending_clause.literals.size() == 1) {
-            if (std::find(initial_units.begin(), initial_units.end(),
-                          pending_clause.literals[0]) == initial_units.end()) {
-                initial_units.push_back(pending_clause.literals[0]);
-            }
-            num_clauses--;
-        } else {
-            if (sort_clauses) {
-                std::sort(pending_clause.literals.begin(), pending_clause.literals.end());
-            }
-            pending_clause.literals.erase(
-                std::unique(pending_clause.literals.begin(), pending_clause.literals.end()),
-                pending_clause.literals.end());
-            pending_clause.num_lits = pending_clause.literals.size();
-            parsed_clauses.push_back(pending_clause);
-        }
+    if (loader.fromCache()) {
+        output.output("Loaded parsed CNF from cache (hash %016lx)\n", loader.fileHash());
+    } else {
+        output.verbose(CALL_INFO, 1, 0, "Parsed CNF with %d threads%s\n", loader.threadsUsed(),
+                       loader.cacheWritten() ? ", cache written" : "");
     }
+    loadParsedCnf(cnf);
+}
 
-    // Close the file explicitly to ensure clean up
-    file.close();
+void SATSolver::loadParsedCnf(ParsedCnf& cnf) {
+    num_vars = cnf.num_vars;
+    num_clauses = cnf.num_clauses;
+    output.verbose(CALL_INFO, 1, 0,
+        "Problem: vars=%u clauses=%u\n", num_vars, num_clauses);
+
+    // Unit clauses are enqueued at level 0 rather than stored
+    initial_units = std::move(cnf.units);
+    num_clauses -= cnf.unit_clauses;
+
+    // Clauses stay in the flat literal pool until init streams them out
+    parsed_clauses = std::move(cnf.clauses);
+    if (output.getVerboseLevel() >= 6) {
+        for (size_t i = 0; i < parsed_clauses.size(); i++) {
+            const Lit* lits = parsed_clauses.lits_of(i);
+            std::vector<Lit> c(lits, lits + parsed_clauses.litSize(i));
+            output.verbose(CALL_INFO, 6, 0, "Added clause %zu: %s\n", i, printClause(c).c_str());
+        }
+    }
 
     sst_assert(parsed_clauses.size() == num_clauses, CALL_INFO, -1,
         "Parsing error: Expected %u clauses but got %zu\n",
@@ -747,87 +1100,140 @@ void SATSolver::handleCnfMemEvent(SST::Interfaces::StandardMem::Request* req) {
         dimacs_content = std::string(data.begin(), data.end());
         output.verbose(CALL_INFO, 1, 0,
             "Received %zu bytes from memory\n", resp->data.size());
-        parseDIMACS(dimacs_content);
+        CnfLoader loader(parse_threads, sort_clauses);
+        ParsedCnf cnf;
+        if (!loader.parseBuffer(dimacs_content.data(), dimacs_content.size(), cnf)) {
+            output.fatal(CALL_INFO, -1, "%s\n", loader.error().c_str());
+        }
+        loadParsedCnf(cnf);
         output.verbose(CALL_INFO, 1, 0,
             "Parsed %u variables, %u clauses\n\n", num_vars, num_clauses);
         state = INIT;
     }
     delete resp;
+    wakeClock();
 }
 
 void SATSolver::handleGlobalMemEvent(SST::Interfaces::StandardMem::Request* req) {
     sst_assert(req != nullptr, CALL_INFO, -1, "Received null request in handleGlobalMemEvent\n");
     if (auto* read_resp = dynamic_cast<SST::Interfaces::StandardMem::ReadResp*>(req)) {
-        uint64_t addr = read_resp->pAddr;
+        // the data structures see their logical addresses
+        uint64_t addr = read_resp->pAddr = address_layout.toLogical(read_resp->pAddr);
 
         // only used if it is not heap's response, because heap has its own reorder buffer
         int worker_id = -1;
 
-        // Route the request to the appropriate handler based on address range
-        if (addr >= var_act_base_addr) {  // Variable activity request
-            order_heap->handleMem(req);
-        } else if (addr >= clauses_cmd_base_addr) {  // Clauses request
+        // Route the response to the structure owning its region
+        AsyncBase* owner = region_owner[address_layout.classify(addr, TraceWriter::DS_HEAP)];
+        if (owner) {
             worker_id = reorder_buffer.lookUpWorkerId(read_resp->getID());
-            clauses.handleMem(req);
-            if (worker_id >= 0 && state != STEP) {
+            owner->handleMem(req);
+            if (worker_id >= 0 && state != STEP && state != DONE) {
                 saved_state = state;
                 state = STEP;
             }
-        } else if (addr >= watches_base_addr) {  // Watches request
-            worker_id = reorder_buffer.lookUpWorkerId(read_resp->getID());
-            watches.handleMem(req);
-            if (worker_id >= 0 && state != STEP) {
-                saved_state = state;
-                state = STEP;
-            }
-        } else if (addr >= variables_base_addr) {  // Variables request
-            worker_id = reorder_buffer.lookUpWorkerId(read_resp->getID());
-            variables.handleMem(req);
-            if (worker_id >= 0 && state != STEP) {
-                saved_state = state;
-                state = STEP;
-            }
-        } else order_heap->handleMem(req);  // Heap request
-
-        // Activate appropriate workers based on worker_id range.
-        // Two-part guard:
-        //   (1) spec_coroutine != nullptr — don't classify as spec when no
-        //       spec coroutine exists.
-        //   (2) worker_id >= SPEC_WORKER_BASE — SPEC_WORKER_BASE is strictly
-        //       greater than every main-side worker_id (unitPropagate /
-        //       execAnalyze / execMinimize), so it's a sufficient
-        //       discriminator when spec *is* running.
-        if (worker_id >= 0) {
-            if (spec_coroutine != nullptr && worker_id >= SPEC_WORKER_BASE) {
-                int spec_worker = worker_id - SPEC_WORKER_BASE;
-                assert(spec_worker <= (int)spec_active_workers.size());
-                if (spec_active_workers.size() > 0)
-                    spec_active_workers[spec_worker] = true;
-                spec_active = true;
-            } else {
-                assert(worker_id <= (int)active_workers.size());
-                if (active_workers.size() > 0)
-                    active_workers[worker_id] = true;
-                main_active = true;
-            }
-        }
+        } else order_heap->handleMem(req);  // Heap or variable activity request
+
+        // a solver stopped by a portfolio peer leaves its coroutines suspended
+        if (worker_id >= 0 && state != DONE) activateWorker(worker_id);
         output.verbose(CALL_INFO, 8, 0, "handleGlobalMemEvent received for 0x%lx, worker %d\n", addr, worker_id);
     } else if (auto* write_resp = dynamic_cast<SST::Interfaces::StandardMem::WriteResp*>(req)) {
         if (WRITE_BUFFER) {
             // for popping write queue
-            uint64_t addr = write_resp->pAddr;
-            if (addr >= var_act_base_addr) {  // Variable activity request
-                order_heap->handleMem(req);
-            } else if (addr >= clauses_cmd_base_addr) {  // Clauses request
-                clauses.handleMem(req);
-            } else if (addr >= watches_base_addr) {  // Watches request
-                watches.handleMem(req);
-            } else if (addr >= variables_base_addr) {  // Variables request
-                variables.handleMem(req);
-            } else order_heap->handleMem(req);  // Heap request
+            uint64_t addr = write_resp->pAddr = address_layout.toLogical(write_resp->pAddr);
+            AsyncBase* owner = region_owner[address_layout.classify(addr, TraceWriter::DS_HEAP)];
+            if (owner) owner->handleMem(req);
+            else order_heap->handleMem(req);  // Heap or variable activity request
+
+            // Retired writes may unblock workers stalled on a full store queue
+            std::vector<int> waiters;
+            AsyncBase* queues[] = { &clauses, &watches, &variables };
+            for (AsyncBase* q : queues) {
+                if (!q->takeStoreQueueWaiters(waiters) || state == DONE) continue;
+                for (int w : waiters) {
+                    if (state != STEP) {
+                        saved_state = state;
+                        state = STEP;
+                    }
+                    activateWorker(w);
+                }
+                waiters.clear();
+            }
         }
     }
     delete req;
+    wakeClock();
+}
+
+// Re-register the tick handler after a response gave the FSM work again.
+// Called at the end of the response handlers, so the tick that processes the
+// response is the same one an ungated clock would have run.
+void SATSolver::wakeClock() {
+    if (!clock_gated || state == IDLE) return;
+    if (state == WAIT_HEAP && heap_resp_cnt > 0) return;
+    clock_gated = false;
+    clock_resumed = true;
+    SST::Cycle_t next = reregisterClock(clock_tc, clock_handler);
+    if (next > gated_at + 1) gated_cycles += next - gated_at - 1;
+    order_heap->parentWoke();
+}
+
+// Unregister the tick handler (the caller returns true) until wakeClock()
+bool SATSolver::sleepClock(SST::Cycle_t cycle) {
+    clock_gated = true;
+    gated_at = cycle;
+    order_heap->parentSleeping();
+    return true;
+}
+
+// Run independent sub-coroutines to completion. Each cycle only the workers
+// whose responses arrived are resumed, in slot order; finished workers are
+// recycled into the fiber pool.
+void SATSolver::stepWorkers(std::vector<coro_t::pull_type*>& coroutines,
+                            std::vector<coro_t::push_type*>& yield_ptrs,
+                            ReadyQueue& rq, coro_t::push_type* parent_yield_ptr) {
+    int live = 0;
+    for (auto*& coro : coroutines) {
+        if (*coro) live++;
+        else fibers.release(coro);  // finished without yielding
+    }
+
+    std::vector<int> ready;
+    while (live > 0) {
+        (*parent_yield_ptr)();  // yield back to IDLE
+        rq.readyWorkers(ready);
+        for (int w : ready) {
+            yield_ptr = yield_ptrs[w];
+            (*coroutines[w])();
+            rq.deactivate(w);
+            if (!(*coroutines[w])) {
+                fibers.release(coroutines[w]);
+                yield_ptrs[w] = nullptr;
+                live--;
+            }
+        }
+    }
+}
+
+// Activate appropriate workers based on worker_id range.
+// Two-part guard:
+//   (1) spec_coroutine != nullptr — don't classify as spec when no
+//       spec coroutine exists.
+//   (2) worker_id >= cfg.spec_worker_base — spec_worker_base is strictly
+//       greater than every main-side worker_id (unitPropagate /
+//       execAnalyze / execMinimize / reduceDBUnit), so it's a sufficient
+//       discriminator when spec *is* running.
+void SATSolver::activateWorker(int worker_id) {
+    if (spec_coroutine != nullptr && worker_id >= cfg.spec_worker_base) {
+        int spec_worker = worker_id - cfg.spec_worker_base;
+        assert(spec_ready_q.size() == 0 || spec_worker < (int)spec_ready_q.size());  // empty between phases
+        spec_ready_q.activate(spec_worker);
+        spec_active = true;
+    } else {
+        assert(ready_q.size() == 0 || worker_id < (int)ready_q.size());  // empty between phases
+        ready_q.activate(worker_id);
+        main_active = true;
+    }
 }
 
 void SATSolver::handleHeapResponse(SST::Event* ev) {
@@ -836,25 +1242,31 @@ void SATSolver::handleHeapResponse(SST::Event* ev) {
     output.verbose(CALL_INFO, 8, 0, "HandleHeapResponse: response %d\n", resp->result);
     heap_resp = resp->result;
     heap_resp_cnt--;
-    if (in_decision && heap_resp_cnt == 0) {
+    if (in_decision && heap_resp_cnt == 0 && state != DONE) {
         state = STEP;
         main_active = true;
     }
     assert(heap_resp_cnt >= 0);
     delete resp;
+    wakeClock();
+}
+
+// One-shot event at timeout_cycles, so the limit holds to the cycle even
+// while the clock is gated and no response would wake it
+void SATSolver::handleTimeout(SST::Event* ev) {
+    delete ev;
+    if (state == DONE) return;
+    output.output("====================[ Timeout Reached ]====================\n");
+    output.output("Cycle %lu >= timeout limit %lu. Terminating early.\n", timeout_cycles, timeout_cycles);
+    output.output("===========================================================\n");
+    state = DONE;
+    timed_out = true;
+    total_cycles = timeout_cycles;
+    primaryComponentOKToEndSim();
 }
 
 bool SATSolver::clockTick(SST::Cycle_t cycle) {
-    // Check for timeout before doing any work. If exceeded, terminate simulation.
-    if (timeout_cycles > 0 && cycle >= timeout_cycles && state != DONE) {
-        output.output("====================[ Timeout Reached ]====================\n");
-        output.output("Cycle %lu >= timeout limit %lu. Terminating early.\n", (uint64_t)cycle, timeout_cycles);
-        output.output("===========================================================\n");
-        state = DONE;
-        total_cycles = cycle;
-        primaryComponentOKToEndSim();
-        return true; // signal done
-    }
+    if (timed_out) return true;  // stopped by handleTimeout
 
     // Trace-side: snapshot phase/level/cycle at the top of every tick so
     // memory events emitted during this tick inherit the latest labels.
@@ -877,6 +1289,15 @@ bool SATSolver::clockTick(SST::Cycle_t cycle) {
         }
     }
 
+    // Same phase labels for the cache profilers
+    if (!profile_links.empty()) {
+        uint8_t phase = (state == STEP) ? (uint8_t)saved_state : (uint8_t)state;
+        if (phase != profile_phase_cache_) {
+            for (SST::Link* link : profile_links) link->send(new SolverPhaseEvent(phase));
+            profile_phase_cache_ = phase;
+        }
+    }
+
     // Calculate elapsed cycles since last state change if we're not in IDLE or STEP
     if (state != IDLE && state != STEP && prev_state != state) {
         // Update cycle counts based on previous state
@@ -928,7 +1349,7 @@ bool SATSolver::clockTick(SST::Cycle_t cycle) {
             switch (prev_state) {
                 case ANALYZE:
                 case BTLEVEL: {
-                    double sf = std::min((int)conflicts.size(), LEARNERS);
+                    double sf = std::min((int)conflicts.size(), cfg.learners);
                     if (sf < 1.0) sf = 1.0;
                     coproc_sf_hw_learning += (uint64_t)(elapsed * sf);
                     uint64_t trail_entries = 0;
@@ -939,7 +1360,7 @@ bool SATSolver::clockTick(SST::Cycle_t cycle) {
                 }
                 case MINIMIZE:
                     coproc_sf_hw_minimize += (uint64_t)(elapsed *
-                        std::max(1.0, (double)std::min((int)learnt_clause.size() - 1, MINIMIZERS)));
+                        std::max(1.0, (double)std::min((int)learnt_clause.size() - 1, cfg.minimizers)));
                     coproc_dep_minimize += (learnt_clause.size() + LITS_PER_CL - 1) / LITS_PER_CL;
                     break;
                 case DECIDE:
@@ -964,24 +1385,29 @@ bool SATSolver::clockTick(SST::Cycle_t cycle) {
         last_state_change = cycle;
     }
 
-    if (cycle % 100000 == 0 && cycle > 0) {
+    // A gated clock may have skipped the cycle the progress line is due on
+    bool progress_due = clock_resumed ? cycle / 100000 > gated_at / 100000 : cycle % 100000 == 0;
+    if (progress_due && cycle > 0) {
         output.verbose(CALL_INFO, 2, 0, "Propagations: %lu, Conflicts: %lu, Decisions: %lu, Learnt: %lu\n",
             getStatCount(stat_propagations), getStatCount(stat_conflicts),
             getStatCount(stat_decisions), getStatCount(stat_learned));
     }
+    clock_resumed = false;
 
     switch (state) {
-        case IDLE: return false; // skip prints
+        case IDLE:
+            // Every worker waits on memory or the heap: sleep until a response
+            if (clock_gating) return sleepClock(cycle);
+            return false; // skip prints
         case INIT: 
-            coroutine = new coro_t::pull_type(
+            coroutine = fibers.spawn(
                 [this](coro_t::push_type &yield) {
                     yield_ptr = &yield;
                     initialize();
                 });
             if (!(*coroutine)) {
                 output.verbose(CALL_INFO, 8, 0, "Coroutine never paused but completed\n");
-                delete coroutine;
-                coroutine = nullptr;
+                fibers.release(coroutine);
                 yield_ptr = nullptr;
             } else state = IDLE;
             break;
@@ -996,8 +1422,7 @@ bool SATSolver::clockTick(SST::Cycle_t cycle) {
                 } else {
                     output.verbose(CALL_INFO, 8, 0, "coroutine completed\n");
                     assert(state != STEP);
-                    delete coroutine;
-                    coroutine = nullptr;  // coroutine will set the next state
+                    fibers.release(coroutine);  // coroutine will set the next state
                     yield_ptr = nullptr;  // Clear yield pointer when coroutine completes
                 }
                 main_active = false;
@@ -1012,8 +1437,7 @@ bool SATSolver::clockTick(SST::Cycle_t cycle) {
                     output.verbose(CALL_INFO, 8, 0, "speculative coroutine paused\n");
                 } else {
                     output.verbose(CALL_INFO, 8, 0, "speculative coroutine completed\n");
-                    delete spec_coroutine;
-                    spec_coroutine = nullptr;  // coroutine will set the next state
+                    fibers.release(spec_coroutine);  // coroutine will set the next state
                     spec_yield_ptr = nullptr;  // Clear yield pointer when coroutine completes
                 }
                 spec_active = false;
@@ -1022,56 +1446,57 @@ bool SATSolver::clockTick(SST::Cycle_t cycle) {
             break;
         }
         case PROPAGATE:
-            coroutine = new coro_t::pull_type(
+            coroutine = fibers.spawn(
                 [this](coro_t::push_type &yield) {
                     yield_ptr = &yield;
                     execPropagate(); 
                 });
             if (!(*coroutine)) {
-                delete coroutine;
-                coroutine = nullptr;
+                fibers.release(coroutine);
                 yield_ptr = nullptr;
             } else state = IDLE;
             
-            // Launch speculative propagation coroutine if spec_literal is defined
-            if (spec_literal != lit_Undef && spec_coroutine == nullptr) {
+            // Launch speculative propagation coroutine if there are literals to speculate on
+            if (!spec_literals.empty() && spec_coroutine == nullptr) {
                 coro_t::push_type* saved_yield_ptr = yield_ptr;
                 resetSpecState();
-                spec_coroutine = new coro_t::pull_type(
+                spec_coroutine = fibers.spawn(
                     [this](coro_t::push_type &yield) {
                         yield_ptr = &yield;
                         spec_yield_ptr = &yield;
                         speculativePropagate();
                     });
                 if (!(*spec_coroutine)) {
-                    delete spec_coroutine;
-                    spec_coroutine = nullptr;
+                    fibers.release(spec_coroutine);
                     spec_yield_ptr = nullptr;
                 } else state = IDLE;
                 yield_ptr = saved_yield_ptr; // Restore original yield_ptr
             }
             break;
         case DECIDE:
-            coroutine = new coro_t::pull_type(
+            coroutine = fibers.spawn(
                 [this](coro_t::push_type &yield) {
                     yield_ptr = &yield;
-                    execDecide(); 
+                    // switch between functional and timed simulation between two decisions
+                    if (sample_interval > 0) {
+                        if (conflicts_total >= sample_next) sampleStep();
+                        execDecide();
+                    } else if (fast_forwarding && fastForwardDone()) endFastForward();
+                    else execDecide(); 
                 });
             if (!(*coroutine)) {
-                delete coroutine;
-                coroutine = nullptr;
+                fibers.release(coroutine);
                 yield_ptr = nullptr;
             } else state = IDLE;
             break;
         case ANALYZE:
-            coroutine = new coro_t::pull_type(
+            coroutine = fibers.spawn(
                 [this](coro_t::push_type &yield) {
                     yield_ptr = &yield;
                     execAnalyze(); 
                 });
             if (!(*coroutine)) {
-                delete coroutine;
-                coroutine = nullptr;
+                fibers.release(coroutine);
                 yield_ptr = nullptr;
             } else state = IDLE;
             break;
@@ -1081,14 +1506,13 @@ bool SATSolver::clockTick(SST::Cycle_t cycle) {
                 break;
             }
 
-            coroutine = new coro_t::pull_type(
+            coroutine = fibers.spawn(
                 [this](coro_t::push_type &yield) {
                     yield_ptr = &yield;
                     execMinimize(); 
                 });
             if (!(*coroutine)) {
-                delete coroutine;
-                coroutine = nullptr;
+                fibers.release(coroutine);
                 yield_ptr = nullptr;
             } else state = IDLE;
             break;
@@ -1103,14 +1527,13 @@ bool SATSolver::clockTick(SST::Cycle_t cycle) {
                 } else state = BACKTRACK;
 #endif
             } else {
-                coroutine = new coro_t::pull_type(
+                coroutine = fibers.spawn(
                     [this](coro_t::push_type &yield) {
                         yield_ptr = &yield;
                         findBtLevel(); 
                     });
                 if (!(*coroutine)) {
-                    delete coroutine;
-                    coroutine = nullptr;
+                    fibers.release(coroutine);
                     yield_ptr = nullptr;
                 } else state = IDLE;
             }
@@ -1118,48 +1541,67 @@ bool SATSolver::clockTick(SST::Cycle_t cycle) {
         case BACKTRACK:
             saved_trail_size = trail.size();
             saved_bt_level = bt_level;
-            coroutine = new coro_t::pull_type(
+            coroutine = fibers.spawn(
                 [this](coro_t::push_type &yield) {
                     yield_ptr = &yield;
                     execBacktrack();
                 });
             if (!(*coroutine)) {
-                delete coroutine;
-                coroutine = nullptr;
+                fibers.release(coroutine);
                 yield_ptr = nullptr;
             } else state = IDLE;
             break;
         case REDUCE:
-            coroutine = new coro_t::pull_type(
+            coroutine = fibers.spawn(
                 [this](coro_t::push_type &yield) {
                     yield_ptr = &yield;
                     execReduce(); 
                 });
             if (!(*coroutine)) {
-                delete coroutine;
-                coroutine = nullptr;
+                fibers.release(coroutine);
                 yield_ptr = nullptr;
             } else state = IDLE;
             break;
         case RESTART:
             saved_trail_size = trail.size();
-            coroutine = new coro_t::pull_type(
+            coroutine = fibers.spawn(
                 [this](coro_t::push_type &yield) {
                     yield_ptr = &yield;
                     execRestart(); 
                 });
             if (!(*coroutine)) {
-                delete coroutine;
-                coroutine = nullptr;
+                fibers.release(coroutine);
                 yield_ptr = nullptr;
             } else state = IDLE;
             break;
         case WAIT_HEAP:
             if (heap_resp_cnt == 0) state = next_state;
+            else if (clock_gating) return sleepClock(cycle);  // woken by the last heap response
             return false;
-        case DONE: total_cycles = cycle; primaryComponentOKToEndSim(); return true;
+        case DONE:
+            total_cycles = cycle;
+            if (portfolio_winner < 0) {
+                // first to finish: stop the rest of the portfolio
+                for (size_t i = 0; i < share_links.size(); i++)
+                    share_links[i]->send(new ShareClauseEvent(ShareClauseEvent::DONE, portfolio_id));
+            }
+            primaryComponentOKToEndSim();
+            return true;
         default: output.fatal(CALL_INFO, -1, "Invalid state: %d\n", state);
     }
+
+    // The main coroutine yielded with a wake-up of its own pending (busy
+    // cycles, workers woken by a lock release), not only on memory. Whether
+    // it was just spawned or resumed, no response will come for it, so it
+    // runs again next cycle.
+    if (wake_pending) {
+        wake_pending = false;
+        if (coroutine != nullptr && state == IDLE) {
+            saved_state = state;
+            state = STEP;
+            main_active = true;
+        }
+    }
     output.verbose(CALL_INFO, 7, 0, "=== Clock Tick %ld === State: %d\n", cycle, state);
     return false;
 }
@@ -1181,6 +1623,7 @@ void SATSolver::execPropagate() {
     // If we have conflicts
     if (!conflicts.empty()) {
         conflictC ++;  // for restart
+        conflicts_total ++;
         stat_conflicts->addDataNTimes(conflicts.size(), 1);
         if (decision_output_stream.is_open()) decision_output_stream << "#Conflict" << std::endl;
         
@@ -1220,61 +1663,42 @@ void SATSolver::execAnalyze() {
     }
 
     coro_t::push_type* parent_yield_ptr = yield_ptr;
-    int workers = std::min(LEARNERS, (int)conflicts.size());
-    active_workers.resize(workers, false);
+    int workers = std::min(cfg.learners, (int)conflicts.size());
+    ready_q.reset(workers);
     std::vector<coro_t::pull_type*> coroutines(workers);
     std::vector<coro_t::push_type*> yield_ptrs(workers);
     bt_level = std::numeric_limits<int>::max();
-    bool done = true;
 
     // spawn sub-coroutines for each literal
     for (int worker_id = 0; worker_id < workers; worker_id++) {
-        coroutines[worker_id] = new coro_t::pull_type(
+        coroutines[worker_id] = fibers.spawn(
             [this, worker_id, &yield_ptrs](coro_t::push_type &yield) {
                 yield_ptr = &yield;
                 yield_ptrs[worker_id] = yield_ptr;
                 analyze(conflicts[worker_id], worker_id);
             });
-        if (*coroutines[worker_id]) done = false;  // may finish without yielding
     }
-    if (!done) (*parent_yield_ptr)();  // yield back to IDLE
-
-    // stepping sub-coroutines
-    while (!done) {
-        done = true;
-        // Check if any worker is active
-        for (int worker_id = 0; worker_id < workers; worker_id++) {
-            if (active_workers[worker_id]) {
-                yield_ptr = yield_ptrs[worker_id];
-                (*coroutines[worker_id])();
-                active_workers[worker_id] = false;
-                if (*coroutines[worker_id]) {
-                    done = false;
-                } else {
-                    delete coroutines[worker_id];
-                    coroutines[worker_id] = nullptr;
-                    yield_ptrs[worker_id] = nullptr;
-                }
-            // waiting workers
-            } else if (coroutines[worker_id] != nullptr) done = false;
-        }
+    stepWorkers(coroutines, yield_ptrs, ready_q, parent_yield_ptr);
 
-        if (!done) (*parent_yield_ptr)();  // yield back to IDLE
-    }
-    
     // finished all sub-coroutines
-    active_workers.clear();
+    ready_q.clear();
     yield_ptr = parent_yield_ptr;
 
+#ifdef USE_CLASSIC_HEAP
     for (const Var& v : v_to_bump) {
         order_heap->handleRequest(new HeapReqEvent(HeapReqEvent::BUMP, v));
-#ifdef USE_CLASSIC_HEAP
         heap_resp_cnt++;
-#endif
     }
-    for (const Cref& c : c_to_bump) {
-        const Clause& cdata = clauses.readClause(c);
-        claBumpActivity(c, cdata.act());
+#else
+    // one message for the whole list; the heap spreads it over its lanes
+    if (!v_to_bump.empty())
+        order_heap->handleRequest(new HeapReqEvent(HeapReqEvent::BUMP, v_to_bump));
+#endif
+    for (size_t i = 0; i < c_to_bump.size(); i++) {
+        const Clause& cdata = clauses.readClause(c_to_bump[i]);
+        clauses.offerClause(c_to_bump[i], cdata, ClauseScratchpad::OFFER_CONFLICT);
+        claBumpActivity(c_to_bump[i], cdata.act());
+        if (learnt_tiers) useLearnt(c_to_bump[i], cdata, c_to_bump_lbd[i]);
     }
 
     output.verbose(CALL_INFO, 3, 0, "Final learnt: %s\n",
@@ -1304,50 +1728,25 @@ void SATSolver::execMinimize() {
     if (ccmin_mode == 2) {
         // Deep minimization (more thorough)
         coro_t::push_type* parent_yield_ptr = yield_ptr;
-        int workers = std::min(MINIMIZERS, (int)learnt_clause.size() - 1);
-        active_workers.resize(workers, false);
+        int workers = std::min(cfg.minimizers, (int)learnt_clause.size() - 1);
+        ready_q.reset(workers);
         std::vector<coro_t::pull_type*> coroutines(workers);
         std::vector<coro_t::push_type*> yield_ptrs(workers);
         std::vector<bool> redundant(learnt_clause.size(), false);
-        bool done = true;
 
         // spawn sub-coroutines for each literal
         for (int worker_id = 0; worker_id < workers; worker_id++) {
-            coroutines[worker_id] = new coro_t::pull_type(
+            coroutines[worker_id] = fibers.spawn(
                 [this, worker_id, &redundant, &yield_ptrs](coro_t::push_type &yield) {
                     yield_ptr = &yield;
                     yield_ptrs[worker_id] = yield_ptr;
                     minimizeL2_sub(redundant, worker_id);
                 });
-            if (*coroutines[worker_id]) done = false;  // may finish without yielding
         }
-        if (!done) (*parent_yield_ptr)();  // yield back to IDLE
+        stepWorkers(coroutines, yield_ptrs, ready_q, parent_yield_ptr);
 
-        // stepping sub-coroutines
-        while (!done) {
-            done = true;
-            // Check if any worker is active
-            for (int worker_id = 0; worker_id < workers; worker_id++) {
-                if (active_workers[worker_id]) {
-                    yield_ptr = yield_ptrs[worker_id];
-                    (*coroutines[worker_id])();
-                    active_workers[worker_id] = false;
-                    if (*coroutines[worker_id]) {
-                        done = false;
-                    } else {
-                        delete coroutines[worker_id];
-                        coroutines[worker_id] = nullptr;
-                        yield_ptrs[worker_id] = nullptr;
-                    }
-                // waiting workers
-                } else if (coroutines[worker_id] != nullptr) done = false;
-            }
-
-            if (!done) (*parent_yield_ptr)();  // yield back to IDLE
-        }
-        
         // finished all sub-coroutines
-        active_workers.clear();
+        ready_q.clear();
         yield_ptr = parent_yield_ptr;
 
         for (i = j = 1; i < learnt_clause.size(); i++) {
@@ -1362,7 +1761,8 @@ void SATSolver::execMinimize() {
             if (var_data.reason == ClauseRef_Undef)
                 learnt_clause[j++] = learnt_clause[i];
             else {
-                Clause c = clauses.readClause(var_data.reason);
+                Clause c;
+                readClauseRef(var_data.reason, ~learnt_clause[i], c);
                 for (size_t k = 1; k < c.litSize(); k++) {
                     Var l = var(c[k]);
                     if (!seen[l] && var_data.level > 0) {
@@ -1405,6 +1805,8 @@ void SATSolver::execBacktrack() {
     stat_bt_level->addDataNTimes(bt_level, 1);
     stat_bt_distance->addDataNTimes(current_level() - bt_level, 1);
     if (learnt_clause.size() == 1) stat_learnt_units->addData(1);
+    if (!share_links.empty() && (learnt_lbd <= share_max_lbd || (int)learnt_clause.size() <= share_max_size))
+        exportLearnt(learnt_clause, learnt_lbd);
 
     if (learnt_clause.size() == 1) {
         // Unit learnt clause will be instantly propagated
@@ -1413,31 +1815,32 @@ void SATSolver::execBacktrack() {
     } else {
         // Add the learned clause
         Clause new_clause(learnt_clause, cla_inc);
+        new_clause.lbd = std::min(learnt_lbd, CLAUSE_MAX_LBD);
+        new_clause.tier = tierOf(learnt_lbd);
+        new_clause.used = true;   // survives its first reduction in the mid tier
         Cref addr = clauses.addClause(new_clause);
+        clauses.offerClause(addr, new_clause, ClauseScratchpad::OFFER_LEARNT);
         output.verbose(CALL_INFO, 3, 0,
             "Added learnt clause 0x%x: %s\n",
             addr, printClause(new_clause.literals).c_str());
         if (tracer_) tracer_->emitLearn(learnt_lbd, (int)learnt_clause.size(), bt_level, (int)addr);
         attachClause(addr, new_clause);
-        trailEnqueue(learnt_clause[0], addr);
+        bool binary = binary_watchers && learnt_clause.size() == 2;
+        trailEnqueue(learnt_clause[0], binary ? binaryReasonRef(learnt_clause[1]) : addr);
         stat_learned->addData(1);
     }
 
-    // terminate speculative propagation if conflict after backtracking
-    if (spec_literal != lit_Undef
-        && var_assigned[var(spec_literal)] 
-        && var_value[var(spec_literal)] != !sign(spec_literal)) {
+    // terminate speculative propagation if a speculated literal is false after backtracking
+    bool spec_wrong = false;
+    for (const SpecLit& s : spec_literals)
+        spec_wrong |= var_assigned[var(s.lit)] && var_value[var(s.lit)] != !sign(s.lit);
+    if (spec_wrong) {
         if (spec_coroutine != nullptr) terminateSpecPropagate();
-        insertVarOrder(var(spec_literal));  // decide with spec_literal
-        spec_literal = lit_Undef;
+        dropSpecLiterals();
     }
 
     // do not redo speculative propagation if completed
-    if (spec_literal != lit_Undef
-        && spec_coroutine == nullptr) {
-        insertVarOrder(var(spec_literal));  // decide with spec_literal
-        spec_literal = lit_Undef;
-    }
+    if (!spec_literals.empty() && spec_coroutine == nullptr) dropSpecLiterals();
 
     varDecayActivity();
     claDecayActivity();
@@ -1466,7 +1869,11 @@ void SATSolver::execBacktrack() {
 void SATSolver::execReduce() {
     output.verbose(CALL_INFO, 3, 0, "REDUCE: %d - %d >= %.0f\n", 
         nLearnts(), nAssigns(), max_learnts);
-    reduceDB();
+    SST::Cycle_t start = getCurrentSimTime(clock_tc);
+    if (reduce_unit) reduceDBUnit();
+    else reduceDB();
+    spec_reusable = false;  // reasons of the last round may be gone
+    stat_reduce_cycles->addData(getCurrentSimTime(clock_tc) - start);
     state = DECIDE;
 }
 
@@ -1479,10 +1886,15 @@ void SATSolver::execRestart() {
     stat_restarts->addData(1);
 
     // terminate speculative propagation because we are ready to choose a new decision
-    if (spec_literal != lit_Undef) {
+    if (!spec_literals.empty()) {
         if (spec_coroutine != nullptr) terminateSpecPropagate();
-        insertVarOrder(var(spec_literal));  // decide with spec_literal
-        spec_literal = lit_Undef;
+        dropSpecLiterals();
+    }
+
+    if (!share_inbox.empty() && !importShared()) {
+        output.output("UNSATISFIABLE: shared clause conflicts at level 0\n");
+        state = DONE;
+        return;
     }
 
     // Update the restart limit using Luby sequence or geometric progression
@@ -1502,9 +1914,229 @@ void SATSolver::execRestart() {
 #endif
 }
 
-void SATSolver::execDecide() {
-    // Finish any previous speculative propagation early
+// End of the functional fast-forward. The memory image of the mirrored
+// structures is written out (timed, so a bounded store queue stalls the
+// switch-over) and the next decision is the first timed one.
+void SATSolver::endFastForward() {
+    ff_switch_cycle = getCurrentSimTime(clock_tc);
+    setFunctionalMode(false);
+    output.output("Fast-forward done at cycle %lu: %lu conflicts, %lu decisions, %lu bytes materialized\n",
+        (uint64_t)ff_switch_cycle, conflicts_total, decisions_total, ff_materialized);
+    state = DECIDE;
+}
+
+// Switching to functional only flips the structures to their mirrors,
+// which timed writes keep current; switching back materializes them.
+void SATSolver::setFunctionalMode(bool on) {
     if (spec_coroutine != nullptr) terminateSpecPropagate();
+    fast_forwarding = on;
+    AsyncBase* mirrored[] = { &variables, &watches, &clauses };
+    for (AsyncBase* ds : mirrored) {
+        if (on) ds->setFunctional(true);
+        else ff_materialized += ds->materialize();
+    }
+}
+
+void SATSolver::sampleMetrics(uint64_t* out) {
+    out[0] = getCurrentSimTime(clock_tc);
+    out[1] = cycles_propagate;
+    out[2] = cycles_analyze;
+    out[3] = cycles_minimize;
+    out[4] = cycles_backtrack;
+    out[5] = cycles_decision;
+    out[6] = cycles_reduce;
+    out[7] = cycles_restart;
+    out[8] = cycles_heap_insert;
+    out[9] = cycles_heap_bump;
+
+    // the counters are only credited when a state ends, so close the
+    // interval of the current one at the window boundary
+    uint64_t open = out[0] > last_state_change ? out[0] - last_state_change : 0;
+    switch (prev_state) {
+        case PROPAGATE: out[1] += open; break;
+        case ANALYZE:   out[2] += open; break;
+        case BTLEVEL:
+        case MINIMIZE:  out[3] += open; break;
+        case BACKTRACK: out[4] += open; break;
+        case DECIDE:    out[5] += open; break;
+        case REDUCE:    out[6] += open; break;
+        case RESTART:   out[7] += open; break;
+        case WAIT_HEAP: out[state == BACKTRACK ? 9 : 8] += open; break;
+        default: break;
+    }
+}
+
+// Advance the sampling phases; a window ends at the first decision after
+// its last conflict, so windows can be a few conflicts longer than set
+void SATSolver::sampleStep() {
+    while (conflicts_total >= sample_next) {
+        switch (sample_phase) {
+        case SAMPLE_FUNCTIONAL:
+            setFunctionalMode(false);
+            sample_phase = SAMPLE_WARMUP;
+            sample_next = conflicts_total + sample_warmup;
+            output.verbose(CALL_INFO, 1, 0, "SAMPLE: warm-up from conflict %lu\n", conflicts_total);
+            break;
+        case SAMPLE_WARMUP:
+            sampleMetrics(sample_start);
+            sample_start_conflicts = conflicts_total;
+            sample_phase = SAMPLE_DETAIL;
+            sample_next = conflicts_total + sample_detail;
+            break;
+        case SAMPLE_DETAIL:
+            recordSample();
+            setFunctionalMode(true);
+            sample_phase = SAMPLE_FUNCTIONAL;
+            sample_next = conflicts_total + sample_interval - sample_warmup - sample_detail;
+            break;
+        }
+    }
+}
+
+void SATSolver::recordSample() {
+    uint64_t conflicts = conflicts_total - sample_start_conflicts;
+    if (conflicts == 0) return;
+    uint64_t now[SAMPLE_METRICS];
+    sampleMetrics(now);
+    SampleWindow w;
+    w.conflicts = conflicts;
+    for (int i = 0; i < SAMPLE_METRICS; i++) w.cycles[i] = now[i] - sample_start[i];
+    samples.push_back(w);
+    output.verbose(CALL_INFO, 1, 0, "SAMPLE: window %zu, %lu conflicts, %.1f cycles/conflict\n",
+        samples.size(), conflicts, (double)w.cycles[0] / conflicts);
+}
+
+// Estimates are the cycles per conflict of all measured windows together
+// (a ratio estimator, so longer windows weigh more) times all conflicts,
+// with a 95% confidence interval from the spread of the windows around it
+void SATSolver::printSampling() {
+    if (sample_phase == SAMPLE_DETAIL) {
+        recordSample();  // the window the run ended in
+        sample_phase = SAMPLE_FUNCTIONAL;
+    }
+    static const char* names[SAMPLE_METRICS] = {
+        "Total", "Propagate", "Analyze", "Minimize", "Backtrack",
+        "Decision", "Reduce DB", "Restart", "Heap Insert", "Heap Bump" };
+    size_t n = samples.size();
+    output.output("==========================[ Sampled Estimates ]============================\n");
+    output.output("Windows      : %zu measured, %lu conflicts in total\n", n, conflicts_total);
+    if (n == 0) {
+        output.output("No measured window completed, nothing to extrapolate\n");
+    }
+    uint64_t measured = 0;
+    for (const auto& w : samples) measured += w.conflicts;
+    for (int m = 0; n > 0 && m < SAMPLE_METRICS; m++) {
+        uint64_t cycles = 0;
+        for (const auto& w : samples) cycles += w.cycles[m];
+        double ratio = (double)cycles / measured;
+        double var = 0;
+        for (const auto& w : samples) {
+            double r = w.cycles[m] - ratio * w.conflicts;
+            var += r * r;
+        }
+        double mean_conflicts = (double)measured / n;
+        var = n > 1 ? var / (n - 1) / (mean_conflicts * mean_conflicts) : 0;
+        double est = ratio * conflicts_total;
+        double ci = 1.96 * std::sqrt(var / n) * conflicts_total;
+        output.output("%-12s : %.0f cycles +- %.0f (95%%), %.1f cycles/conflict\n", names[m], est, ci, ratio);
+    }
+    output.output("===========================================================================\n");
+}
+
+//-----------------------------------------------------------------------------------
+// portfolio clause sharing
+//-----------------------------------------------------------------------------------
+
+void SATSolver::handleShareEvent(SST::Event* ev) {
+    auto* share = dynamic_cast<ShareClauseEvent*>(ev);
+    sst_assert(share != nullptr, CALL_INFO, -1, "Unexpected event on a share port\n");
+    if (share->type == ShareClauseEvent::DONE) {
+        if (state != DONE) {
+            output.output("Portfolio: solver %d finished first, stopping solver %d\n", share->src, portfolio_id);
+            portfolio_winner = share->src;
+            state = DONE;  // the DONE tick records the cycles and ends the sim
+            wakeClock();
+        }
+    } else if (state != DONE) {
+        std::vector<Lit> lits(share->lits.size());
+        for (size_t i = 0; i < lits.size(); i++) lits[i].x = share->lits[i];
+        share_inbox.emplace_back(std::move(lits), share->lbd);
+        if (share_inbox.size() > share_queue) {
+            share_inbox.pop_front();
+            stat_share_dropped->addData(1);
+        }
+    }
+    delete ev;
+}
+
+// Send on every share link. A link carries share_bytes_per_cycle, so a
+// message waits for the ones ahead of it to be serialized.
+void SATSolver::sendShare(ShareClauseEvent* ev) {
+    SST::Cycle_t now = getCurrentSimTime(clock_tc);
+    SST::Cycle_t occupancy = share_bytes_per_cycle == 0 ? 0 :
+        (ev->bytes() + share_bytes_per_cycle - 1) / share_bytes_per_cycle;
+    for (size_t i = 0; i < share_links.size(); i++) {
+        ShareClauseEvent* copy = i + 1 < share_links.size() ? new ShareClauseEvent(*ev) : ev;
+        SST::Cycle_t start = std::max(now, share_busy_until[i]);
+        share_busy_until[i] = start + occupancy;
+        share_links[i]->send(share_busy_until[i] - now, copy);
+        stat_share_bytes->addDataNTimes(copy->bytes(), 1);
+    }
+    stat_share_exported->addDataNTimes(share_links.size(), 1);
+}
+
+void SATSolver::exportLearnt(const std::vector<Lit>& lits, int lbd) {
+    auto* ev = new ShareClauseEvent(ShareClauseEvent::CLAUSE, portfolio_id, lbd);
+    ev->lits.reserve(lits.size());
+    for (const Lit& l : lits) ev->lits.push_back(l.x);
+    output.verbose(CALL_INFO, 4, 0, "SHARE: exporting %s (lbd %d)\n", printClause(lits).c_str(), lbd);
+    sendShare(ev);
+}
+
+// Add the buffered peer clauses, right after backtracking to level 0.
+// Literals false at level 0 are dropped, clauses already satisfied are
+// skipped and those left with one literal become units. Returns false if a
+// clause is falsified, i.e. the instance is unsatisfiable.
+bool SATSolver::importShared() {
+    assert(current_level() == 0);
+    std::vector<Lit> lits;
+    while (!share_inbox.empty()) {
+        auto item = std::move(share_inbox.front());
+        share_inbox.pop_front();
+
+        bool satisfied = false;
+        lits.clear();
+        for (const Lit& l : item.first) {
+            if (!var_assigned[var(l)]) lits.push_back(l);
+            else if (value(l)) { satisfied = true; break; }
+        }
+        if (satisfied) {
+            stat_share_satisfied->addData(1);
+            continue;
+        }
+        if (lits.empty()) return false;
+        stat_share_imported->addData(1);
+        if (lits.size() == 1) {
+            trailEnqueue(lits[0]);
+            continue;
+        }
+
+        Clause c(lits, cla_inc);
+        c.lbd = std::min(item.second, CLAUSE_MAX_LBD);
+        c.tier = tierOf(item.second);
+        c.used = true;
+        Cref addr = clauses.addClause(c);
+        clauses.offerClause(addr, c, ClauseScratchpad::OFFER_LEARNT);
+        attachClause(addr, c);
+        output.verbose(CALL_INFO, 4, 0, "SHARE: imported 0x%x: %s\n", addr, printClause(c.literals).c_str());
+    }
+    return true;
+}
+
+void SATSolver::execDecide() {
+    // Finish any previous speculative propagation early; decide() may
+    // still adopt what it implied
+    if (spec_coroutine != nullptr) terminateSpecPropagate(true);
 
     in_decision = true;
     if (!decide()) {
@@ -1527,6 +2159,7 @@ void SATSolver::execDecide() {
 
 bool SATSolver::decide() {
     stat_decisions->addData(1);
+    decisions_total++;
     Lit lit = lit_Undef;
     
     // Use decision sequence if available and not exhausted
@@ -1557,9 +2190,24 @@ bool SATSolver::decide() {
         }
     }
 
-    // decide with spec_literal
-    if (spec_literal != lit_Undef && !var_assigned[var(spec_literal)]) {
-        lit = spec_literal;
+    // decide with the nearest speculated literal. Speculated literals the
+    // solver assigned meanwhile are dropped; if one is false, so is the
+    // speculation built on top of it.
+    while (!spec_literals.empty() && var_assigned[var(spec_literals[0].lit)]) {
+        const SpecLit& s = spec_literals[0];
+        bool is_false = var_value[var(s.lit)] != !sign(s.lit);
+        stat_spec_depth[s.depth].dropped->addData(1);
+        stat_spec_depth[s.depth].wasted_lines->addDataNTimes(s.lines, 1);
+        spec_literals.erase(spec_literals.begin());
+        spec_reusable = false;
+        if (is_false) dropSpecLiterals();
+    }
+    bool from_spec = !spec_literals.empty();
+    if (from_spec) {
+        const SpecLit& s = spec_literals[0];
+        lit = s.lit;
+        stat_spec_depth[s.depth].hits->addData(1);
+        spec_literals.erase(spec_literals.begin());
         output.verbose(CALL_INFO, 2, 0, "DECISION: Using speculative lit %d\n", toInt(lit));
     }
 
@@ -1577,13 +2225,10 @@ bool SATSolver::decide() {
     trail_lim.push_back(trail.size());  // new decision level
     if (tracer_) tracer_->emitDecision(var(lit), sign(lit), current_level());
     trailEnqueue(lit);
+    if (from_spec && spec_reuse) adoptSpecImplications(lit);
 
-    // Extract speculative literal for next decision
-    if (enable_speculative) {
-        spec_literal = chooseBranchVariable();
-        // spec_literal = peekBranchVariable();
-        output.verbose(CALL_INFO, 2, 0, "Selected next speculative lit %d \n", toInt(spec_literal));
-    }
+    // Extract speculative literals for the next decisions
+    if (enable_speculative) refillSpecLiterals();
 
     return true;
 }
@@ -1595,6 +2240,7 @@ bool SATSolver::decide() {
 void SATSolver::unitPropagate() {
     output.verbose(CALL_INFO, 4, 0, "PROPAGATE: Starting unit propagation\n");
     conflicts.clear();
+    binary_conflicts.clear();
 
     // Track the current batch of variables that can be processed in parallel
     size_t batch_start = qhead;
@@ -1604,20 +2250,19 @@ void SATSolver::unitPropagate() {
     clause_locks.clear();
 
     while (qhead < trail.size()) {
-        // Process literals in parallel batches of PARA_LITS
+        // Process literals in parallel batches of para_lits
         coro_t::push_type* parent_yield_ptr = yield_ptr;
-        int workers = std::min(PARA_LITS, int(trail.size() - qhead));
-        std::vector<coro_t::pull_type*> coroutines(PARA_LITS, nullptr);
-        std::vector<coro_t::push_type*> yield_ptrs(PARA_LITS, nullptr);
-        active_workers.resize(PARA_LITS * PROPAGATORS, false);
-        polling.resize(PARA_LITS * PROPAGATORS, false);
+        int workers = std::min(cfg.para_lits, int(trail.size() - qhead));
+        std::vector<coro_t::pull_type*> coroutines(cfg.para_lits, nullptr);
+        std::vector<coro_t::push_type*> yield_ptrs(cfg.para_lits, nullptr);
+        ready_q.reset(cfg.para_lits * cfg.propagators);
 
         // Track times for each literal worker
-        std::vector<uint64_t> lit_read_headptr(PARA_LITS, 0);
-        std::vector<uint64_t> lit_read_watcher_blocks(PARA_LITS, 0);
-        std::vector<uint64_t> lit_read_clauses(PARA_LITS, 0);
-        std::vector<uint64_t> lit_insert_watchers(PARA_LITS, 0);
-        std::vector<uint64_t> lit_polling(PARA_LITS, 0);
+        std::vector<uint64_t> lit_read_headptr(cfg.para_lits, 0);
+        std::vector<uint64_t> lit_read_watcher_blocks(cfg.para_lits, 0);
+        std::vector<uint64_t> lit_read_clauses(cfg.para_lits, 0);
+        std::vector<uint64_t> lit_insert_watchers(cfg.para_lits, 0);
+        std::vector<uint64_t> lit_polling(cfg.para_lits, 0);
         int last_worker = -1;
 
         // Spawn coroutines for each literal in this batch
@@ -1635,7 +2280,7 @@ void SATSolver::unitPropagate() {
             }
 
             // when watcher coroutines are not launched, assume lit coroutine uses the start
-            coro_t::pull_type* lit_coro = new coro_t::pull_type(
+            coro_t::pull_type* lit_coro = fibers.spawn(
                 [this, lit_idx, &lit_read_headptr, &lit_read_watcher_blocks, &lit_read_clauses, 
                  &lit_insert_watchers, &lit_polling, &yield_ptrs]
                 (coro_t::push_type &yield) {
@@ -1656,32 +2301,35 @@ void SATSolver::unitPropagate() {
         // Initial yield if any coroutines are active
         if (!done) (*parent_yield_ptr)();
 
-        // Process all coroutines until completion
-        while (!done) {
-            // Check for active workers within each lit coroutine
-            for (int j = 0; j < PARA_LITS; j++) {
-                for (int jj = 0; jj < PROPAGATORS; jj++) {
-                    if (active_workers[j * PROPAGATORS + jj]) {
-                        yield_ptr = yield_ptrs[j];
-                        (*coroutines[j])();
-                        active_workers[j * PROPAGATORS + jj] = false;
-                        break;
-                    }
+        // Resume each lit coroutine with an active worker once; it steps
+        // its own watcher workers. Slots of lit j are [j*P, (j+1)*P).
+        std::vector<int> ready;
+        auto resume_ready_lits = [&]() {
+            ready_q.readyWorkers(ready);
+            for (size_t k = 0; k < ready.size(); k++) {
+                int j = ready[k] / cfg.propagators;
+                if (k > 0 && ready[k - 1] / cfg.propagators == j) continue;
+                if (coroutines[j] == nullptr || !(*coroutines[j])) {
+                    ready_q.deactivate(ready[k]);
+                    continue;
                 }
+                uint32_t stamp = ready_q.stamp(ready[k]);
+                yield_ptr = yield_ptrs[j];
+                (*coroutines[j])();
+                ready_q.deactivate(ready[k], stamp);
             }
+        };
 
-            for (int j = 0; j < PARA_LITS; j++) {
-                for (int jj = 0; jj < PROPAGATORS; jj++) {
-                    if (polling[j * PROPAGATORS + jj]) {
-                        yield_ptr = yield_ptrs[j];
-                        (*coroutines[j])();
-                        break;
-                    }
-                }
-            }
+        // Process all coroutines until completion
+        while (!done) {
+            resume_ready_lits();
+
+            // Workers woken by a lock release in the first pass continue in
+            // the same cycle, the way polling workers used to re-check
+            resume_ready_lits();
 
             // launch new lit coroutines if there are empty slots
-            for (int j = 0; j < PARA_LITS; j++) {
+            for (int j = 0; j < cfg.para_lits; j++) {
                 bool lit_done = true;
                 if (coroutines[j] != nullptr)
                     if (*coroutines[j])
@@ -1701,8 +2349,8 @@ void SATSolver::unitPropagate() {
                     output.verbose(CALL_INFO, 4, 0,
                         "PROPAGATE: spawning literal coroutine (1/%lu) at L%d\n",
                         trail.size() - qhead, j);
-                    delete coroutines[j];
-                    coro_t::pull_type* lit_coro = new coro_t::pull_type(
+                    if (coroutines[j] != nullptr) fibers.release(coroutines[j]);
+                    coro_t::pull_type* lit_coro = fibers.spawn(
                         [this, j, &lit_read_headptr, &lit_read_watcher_blocks, &lit_read_clauses,
                          &lit_insert_watchers, &lit_polling, &yield_ptrs]
                         (coro_t::push_type &yield) {
@@ -1723,30 +2371,33 @@ void SATSolver::unitPropagate() {
             // Check if any workers are still active
             // we can just check the parent coroutines
             done = true;
-            for (int j = 0; j < PARA_LITS; j++) {
+            for (int j = 0; j < cfg.para_lits; j++) {
                 if (coroutines[j] != nullptr) {
                     if (*coroutines[j]) done = false;
                     else {
                         last_worker = j;
-                        delete coroutines[j];
-                        coroutines[j] = nullptr;
+                        fibers.release(coroutines[j]);
                         yield_ptrs[j] = nullptr;
                     }
                 }
             }
 
+            // Wake-ups from the second pass run on the next cycle, even if
+            // no memory response arrives
+            if (!done && ready_q.anyActive()) wake_pending = true;
+
             // If not done, yield back to IDLE
             if (!done) (*parent_yield_ptr)();
         }
 
         // Cleanup any remaining coroutines
-        for (auto* coro : coroutines) {
-            if (coro) delete coro;
+        for (auto*& coro : coroutines) {
+            if (coro) fibers.release(coro);
         }
 
         // Cleanup the shared coroutine structures
-        active_workers.clear();
-        polling.clear();
+        assert(watch_waiters.empty() && clause_waiters.empty());
+        ready_q.clear();
         yield_ptr = parent_yield_ptr;
 
         // Accumulate timing data of the last finished worker (gated)
@@ -1756,7 +2407,7 @@ void SATSolver::unitPropagate() {
             // spawned lit coroutine completed synchronously without yielding
             // (the while(!done) body above is skipped). Guard to avoid UB
             // from vector[-1] indexing — mirrors the guard in propagateLiteral.
-            if (last_worker >= 0 && last_worker < PARA_LITS) {
+            if (last_worker >= 0 && last_worker < cfg.para_lits) {
                 cycles_read_headptr += lit_read_headptr[last_worker];
                 cycles_read_watcher_blocks += lit_read_watcher_blocks[last_worker];
                 cycles_read_clauses += lit_read_clauses[last_worker];
@@ -1799,16 +2450,15 @@ void SATSolver::propagateLiteral(
         output.verbose(CALL_INFO, 2, 0, "lit %d was speculatively propagated\n", toInt(p));
     
     // assuming we are using base_worker_id when watcher coroutines are not launched
-    int base_worker_id = lit_worker_id * PROPAGATORS;
+    int base_worker_id = lit_worker_id * cfg.propagators;
     Lit not_p = ~p;
     int watch_idx = toWatchIndex(p);
 
     // Wait for any previous watchlist insertion
     while (wl_q.count(watch_idx) > 0) {
-        polling[base_worker_id] = true;
-        (*yield_ptr)();  // Yield to allow other workers to process
+        watch_waiters.wait(watch_idx, base_worker_id);
+        (*yield_ptr)();  // Sleep until the insertion completes
     }
-    polling[base_worker_id] = false;
 
     output.verbose(CALL_INFO, 2, 0,
         "PROPAGATE[L%d]: Processing watchers for literal %d\n", 
@@ -1823,29 +2473,35 @@ void SATSolver::propagateLiteral(
     }
 
     // Prefetch the next watch metadata if available
-    if (qhead < trail.size()) {
+    if (prefetch_chase) {
+        sendPrefetchLink(watches.watchesAddr(watch_idx), wmd.head_ptr, wmd.pre_watchers, cfg.pre_watchers);
+        chaseAhead();
+    } else if (qhead < trail.size()) {
         issuePrefetch(watches.watchesAddr(toWatchIndex(trail[qhead])));
     }
 
-    bool do_prewatch = PRE_WATCHERS > 0;
+    bool do_prewatch = cfg.pre_watchers > 0;
     uint32_t curr_addr = wmd.head_ptr;
     uint32_t prev_addr = 0;
-    WatcherBlock prev_block;
+    WatcherBlock prev_block = watches.newBlock();
 
     uint64_t para_watchers = 0;  // watchers inspected in this propagation
     uint64_t watcher_occ = 0;    // number of watchers residing in watch lists
+    uint64_t chain_blocks = 0;   // watcher blocks read
+    uint64_t chain_watchers = 0; // valid watchers in them
+    uint64_t live_blocks = 0, live_watchers = 0;  // left in the chain after this propagation
 
     // Traverse the linked list
     while (curr_addr != 0 || do_prewatch) {
         bool block_modified = false;
-        WatcherBlock curr_block;
+        WatcherBlock curr_block = watches.newBlock();
         if (do_prewatch) {
             curr_block.setNextBlock(curr_addr);
-            for (int i = 0; i < PRE_WATCHERS; i++) {
+            for (int i = 0; i < cfg.pre_watchers; i++) {
                 curr_block.nodes[i] = wmd.pre_watchers[i];
             }
 
-            if (curr_addr != 0) issuePrefetch(curr_addr);
+            if (curr_addr != 0 && !prefetch_chase) issuePrefetch(curr_addr);
         } else {
             // Read current block with optional timing
             SST::Cycle_t start_block = profile_prop_timing ? (getCurrentSimCycle() / 1000) : 0;
@@ -1855,16 +2511,24 @@ void SATSolver::propagateLiteral(
                 read_watcher_blocks_cycles += (end_block - start_block);
             }
 
-            if (curr_block.getNextBlock() != 0) issuePrefetch(curr_block.getNextBlock());
+            if (prefetch_chase) {
+                sendPrefetchLink(curr_addr, curr_block.getNextBlock(), curr_block.nodes, cfg.propagators);
+            } else if (curr_block.getNextBlock() != 0) issuePrefetch(curr_block.getNextBlock());
+        }
+
+        if (!do_prewatch) {
+            chain_blocks++;
+            chain_watchers += curr_block.countValidNodes();
         }
 
         // Collect valid nodes that need processing
         std::vector<int> valid_nodes;
-        for (int i = 0; i < PROPAGATORS; i++) {
-            if (!curr_block.nodes[i].valid) continue;
+        for (uint32_t mask = curr_block.validMask(); mask != 0; mask &= mask - 1) {
+            int i = __builtin_ctz(mask);
             watcher_occ++;
 
             Lit blocker = curr_block.nodes[i].blocker;
+            readValue(var(blocker), base_worker_id);
             if (var_assigned[var(blocker)] && value(blocker) == true) {
                 // Blocker is true, skip to next watcher
                 output.verbose(CALL_INFO, 4, 0,
@@ -1873,27 +2537,35 @@ void SATSolver::propagateLiteral(
                 continue;
             }
 
+            // The blocker of a binary watcher is the other literal, so the
+            // clause is unit or conflicting without reading it
+            if (curr_block.nodes[i].isBinary()) {
+                para_watchers++;
+                propagateBinary(not_p, curr_block.nodes[i], lit_worker_id);
+                continue;
+            }
+
             valid_nodes.push_back(i);
         }
         para_watchers += valid_nodes.size();
         
         // Propagate watchers in parallel batches
         coro_t::push_type* parent_yield_ptr = yield_ptr;
-        int workers = std::min(PROPAGATORS, (int)valid_nodes.size());
+        int workers = std::min(cfg.propagators, (int)valid_nodes.size());
         std::vector<coro_t::pull_type*> coroutines(workers);
         std::vector<coro_t::push_type*> yield_ptrs(workers);
         bool done = true;
         int last_worker = -1;
 
         // Track cycles for worker operations
-        std::vector<uint64_t> worker_read_clauses(PROPAGATORS, 0);
-        std::vector<uint64_t> worker_insert_watchers(PROPAGATORS, 0);
-        std::vector<uint64_t> worker_polling(PROPAGATORS, 0);
+        std::vector<uint64_t> worker_read_clauses(cfg.propagators, 0);
+        std::vector<uint64_t> worker_insert_watchers(cfg.propagators, 0);
+        std::vector<uint64_t> worker_polling(cfg.propagators, 0);
         output.verbose(CALL_INFO, 4, 0, "PROPAGATE[L%d]: spawning %d watcher coroutines\n",
             lit_worker_id, workers);
         // Create watcher coroutines
         for (int worker_id = 0; worker_id < workers; worker_id++) {
-            coroutines[worker_id] = new coro_t::pull_type(
+            coroutines[worker_id] = fibers.spawn(
                 [this, worker_id, lit_worker_id, &valid_nodes, not_p,
                  &block_modified, &curr_block, &yield_ptrs,
                  &worker_read_clauses, &worker_insert_watchers, &worker_polling
@@ -1915,23 +2587,20 @@ void SATSolver::propagateLiteral(
         while (!done) {
             // Check if any worker is active
             for (int j = 0; j < workers; j++) {
-                // printf("Worker %d: active=%d, polling=%d, done=%d\n",
-                //     j, (bool)active_workers[base_worker_id + j], (bool)polling[base_worker_id + j], (bool)(coroutines[j] == nullptr));
-                if (active_workers[base_worker_id + j]) {
+                if (ready_q.isActive(base_worker_id + j)) {
                     yield_ptr = yield_ptrs[j];
                     (*coroutines[j])();
-                    active_workers[base_worker_id + j] = false;
+                    ready_q.deactivate(base_worker_id + j);
                 }
             }
 
-            // since the polling workers never get triggered,
-            // we need to check them after completing the active workers
-            // polling status may also change after processing active workers
+            // workers woken by a sibling's lock release in the first pass
+            // continue right away, as the polling workers used to
             for (int j = 0; j < workers; j++) {
-                if (polling[base_worker_id + j]) {
-                    polling[base_worker_id + j] = false;
+                if (ready_q.isActive(base_worker_id + j)) {
                     yield_ptr = yield_ptrs[j];
                     (*coroutines[j])();
+                    ready_q.deactivate(base_worker_id + j);
                 }
             }
 
@@ -1942,8 +2611,7 @@ void SATSolver::propagateLiteral(
                     if (*coroutines[j]) done = false;
                     else {
                         last_worker = j; // Track the last worker to complete
-                        delete coroutines[j];
-                        coroutines[j] = nullptr;
+                        fibers.release(coroutines[j]);
                         yield_ptrs[j] = nullptr;
                     }
                 }
@@ -1951,7 +2619,10 @@ void SATSolver::propagateLiteral(
 
             if (!done) (*parent_yield_ptr)();  // yield back to IDLE
         }
-        // finished all sub-coroutines
+        // finished all sub-coroutines; recycle those that never yielded
+        for (auto*& coro : coroutines) {
+            if (coro) fibers.release(coro);
+        }
         yield_ptr = parent_yield_ptr;
         output.verbose(CALL_INFO, 4, 0, "PROPAGATE[L%d]: Finished a watch block\n", lit_worker_id);
 
@@ -1976,6 +2647,8 @@ void SATSolver::propagateLiteral(
         if (curr_block.countValidNodes() != 0 && !do_prewatch) {
             prev_addr = curr_addr;
             prev_block = curr_block;
+            live_blocks++;
+            live_watchers += curr_block.countValidNodes();
         }
         
         // Move to next block
@@ -1986,6 +2659,14 @@ void SATSolver::propagateLiteral(
 
     stat_para_watchers->addData(para_watchers);
     stat_watcher_occ->addData(watcher_occ);
+    stat_chain_blocks->addDataNTimes(chain_blocks, 1);
+    stat_chain_watchers->addDataNTimes(chain_watchers, 1);
+    // a complete walk knows whether the list could drop blocks; no watcher
+    // is inserted into the list being propagated, so the count holds
+    if (watch_compact_lists > 0 && curr_addr == 0) {
+        if (live_blocks > (live_watchers + cfg.propagators - 1) / cfg.propagators) watches.markSparse(watch_idx);
+        else watches.clearSparse(watch_idx);
+    }
     if (profile_2wl) {
         stat_total_occ->addDataNTimes(lit_occ_count[watch_idx], 1);
         stat_watcher_traversed->addDataNTimes(watcher_occ, 1);
@@ -2021,7 +2702,7 @@ void SATSolver::propagateWatchers(
     uint64_t& polling_cycles
 ) {
     // Calculate the global worker ID for reporting
-    int global_worker_id = lit_worker_id * PROPAGATORS + worker_id;
+    int global_worker_id = lit_worker_id * cfg.propagators + worker_id;
 
     // Need to inspect the clause
     Cref clause_addr = curr_block.nodes[watcher_i].getClauseAddr();
@@ -2029,8 +2710,8 @@ void SATSolver::propagateWatchers(
     // Check if the clause is already being processed by another worker
     SST::Cycle_t start_poll = profile_prop_timing ? (getCurrentSimCycle() / 1000) : 0;
     while (clause_locks.count(clause_addr) > 0) {
-        polling[global_worker_id] = true;
-        (*yield_ptr)();  // Yield to allow other workers to process
+        clause_waiters.wait(clause_addr, global_worker_id);
+        (*yield_ptr)();  // Sleep until the clause is unlocked
     }
     if (profile_prop_timing) {
         SST::Cycle_t end_poll = getCurrentSimCycle() / 1000;
@@ -2042,7 +2723,12 @@ void SATSolver::propagateWatchers(
 
     // Time the reading of clauses (gated)
     SST::Cycle_t start_read = profile_prop_timing ? (getCurrentSimCycle() / 1000) : 0;
-    Clause c = clauses.readClause(clause_addr, global_worker_id);
+    Clause& c = scratchClause(global_worker_id);
+    // split placement: the literals past the watched two are read below,
+    // once the first watched literal turns out not true
+    bool split = clauses.getPlacement() == PLACE_SPLIT;
+    if (split) clauses.readClauseHead(clause_addr, c, global_worker_id);
+    else clauses.readClause(clause_addr, c, global_worker_id);
     if (profile_prop_timing) {
         SST::Cycle_t end_read = getCurrentSimCycle() / 1000;
         read_clauses_cycles += (end_read - start_read);
@@ -2065,6 +2751,7 @@ void SATSolver::propagateWatchers(
 
     // If first literal is already true, just update the blocker and continue
     Lit first = c[0];
+    readValue(var(first), global_worker_id);
     if (var_assigned[var(first)] && value(first) == true) {
         output.verbose(CALL_INFO, 4, 0,
             "  First literal %d is true\n", toInt(first));
@@ -2072,13 +2759,20 @@ void SATSolver::propagateWatchers(
         block_modified = true;
 
         // Release the lock on this clause
-        clause_locks.erase(clause_addr);
+        unlockClause(clause_addr);
         return;
     }
 
+    if (split) {
+        SST::Cycle_t start_tail = profile_prop_timing ? (getCurrentSimCycle() / 1000) : 0;
+        clauses.readClauseTail(clause_addr, c, global_worker_id);
+        if (profile_prop_timing) read_clauses_cycles += getCurrentSimCycle() / 1000 - start_tail;
+    }
+
     // Look for a new literal to watch
     for (size_t k = 2; k < c.litSize(); k++) {
         Lit lit = c[k];
+        readValue(var(lit), global_worker_id);
         if (!var_assigned[var(lit)] || value(lit) == true) {
             // Swap to position 1 and update watcher
             std::swap(c.literals[1], c.literals[k]);
@@ -2092,8 +2786,8 @@ void SATSolver::propagateWatchers(
             // Time spent polling for busy watches (gated)
             SST::Cycle_t start_poll2 = profile_prop_timing ? (getCurrentSimCycle() / 1000) : 0;
             while (watches.isBusy(toWatchIndex(~c[1]))) {
-                polling[global_worker_id] = true;
-                (*yield_ptr)();  // Yield to allow other workers to process
+                watch_waiters.wait(toWatchIndex(~c[1]), global_worker_id);
+                (*yield_ptr)();  // Sleep until the other insertion completes
             }
             if (profile_prop_timing) {
                 SST::Cycle_t end_poll2 = getCurrentSimCycle() / 1000;
@@ -2118,9 +2812,9 @@ void SATSolver::propagateWatchers(
             curr_block.nodes[watcher_i].valid = 0;
             block_modified = true;
 
-            // Release the lock on this clause
-            clause_locks.erase(clause_addr);
-            wl_q.remove(toWatchIndex(~c[1]));
+            // Release the lock on this clause and the target watch list
+            unlockClause(clause_addr);
+            unlockWatch(toWatchIndex(~c[1]));
             return;
         }
     }
@@ -2146,17 +2840,89 @@ void SATSolver::propagateWatchers(
     }
 
     // Release the lock on this clause
-    clause_locks.erase(clause_addr);
+    unlockClause(clause_addr);
+}
+
+void SATSolver::propagateBinary(Lit not_p, const WatcherNode& node, int lit_worker_id) {
+    Cref clause_addr = node.getClauseAddr();
+    Lit other = node.blocker;
+    output.verbose(CALL_INFO, 4, 0,
+        "[L%d] Binary watcher: clause 0x%x, other literal %d\n",
+        lit_worker_id, clause_addr, toInt(other));
+
+    if (var_assigned[var(other)]) {
+        // other is false, otherwise the watcher was skipped by its blocker
+        bool dup = false;
+        for (const BinaryConflict& bc : binary_conflicts) dup |= bc.addr == clause_addr;
+        if (!dup && conflicts.size() < MAX_CONFL) {
+            conflicts.push_back(binaryConflictRef(binary_conflicts.size()));
+            binary_conflicts.push_back({clause_addr, not_p, other});
+            if (tracer_) tracer_->emitConflict((int)clause_addr);
+            output.verbose(CALL_INFO, 3, 0,
+                "  Conflict #%zu: binary clause 0x%x has all literals false\n",
+                conflicts.size(), clause_addr);
+        } else { output.verbose(CALL_INFO, 3, 0, "  Conflict, but ignored\n"); }
+    } else {
+        output.verbose(CALL_INFO, 4, 0, "  forces literal %d (to true)\n", toInt(other));
+        if (conflicts.empty()) trailEnqueue(other, binaryReasonRef(not_p));
+    }
+}
+
+// Read a conflict or reason clause. Implicit binary references are rebuilt
+// from the literals they encode; implied is the literal the reason forced
+// and ends up at position 0, as in a clause read from memory.
+void SATSolver::readClauseRef(Cref ref, Lit implied, Clause& out, int worker_id) {
+    if (!isBinaryRef(ref)) {
+        clauses.readClause(ref, out, worker_id);
+        return;
+    }
+    out.num_lits = 2;
+    out.literals.resize(2);
+    out.activity = 0;
+    if (isBinaryConflict(ref)) {
+        const BinaryConflict& bc = binary_conflicts[binaryConflictIdx(ref)];
+        out.literals[0] = bc.a;
+        out.literals[1] = bc.b;
+    } else {
+        out.literals[0] = implied;
+        out.literals[1] = binaryReasonLit(ref);
+    }
 }
 
 // Add a new method to issue prefetches
 void SATSolver::issuePrefetch(uint64_t addr) {
-    if (prefetch_enabled) {
+    if (prefetch_enabled && !fast_forwarding) {
         output.verbose(CALL_INFO, 4, 0, "Issuing prefetch for address 0x%lx\n", addr);
-        prefetch_link->send(new PrefetchRequestEvent(addr));
+        prefetch_link->send(new PrefetchRequestEvent(address_layout.toPhysical(addr)));
     }
 }
 
+// Ask the prefetch engine to walk the watch lists of the next trail
+// literals while the current ones are still propagating. Each trail entry
+// is sent once; backtrack() rewinds the cursor.
+void SATSolver::chaseAhead() {
+    size_t end = std::min(trail.size(), (size_t)qhead + prefetch_lookahead);
+    for (size_t i = std::max(prefetch_chased, (size_t)qhead); i < end; i++) {
+        uint64_t addr = watches.watchesAddr(toWatchIndex(trail[i]));
+        output.verbose(CALL_INFO, 4, 0, "Chasing watch list of literal %d at 0x%lx\n", toInt(~trail[i]), addr);
+        prefetch_link->send(new PrefetchRequestEvent(address_layout.toPhysical(addr), PrefetchRequestEvent::CHASE));
+    }
+    prefetch_chased = std::max(prefetch_chased, end);
+}
+
+// Forward the links of a watch-list node the solver just read, as the
+// addresses the prefetcher sees. Binary watchers are left out, their
+// clauses are never fetched.
+void SATSolver::sendPrefetchLink(uint64_t addr, uint64_t next, const WatcherNode* nodes, int count) {
+    PrefetchRequestEvent* ev = new PrefetchRequestEvent(address_layout.toPhysical(addr), PrefetchRequestEvent::LINK);
+    ev->targets.push_back(next != 0 ? address_layout.toPhysical(next) : 0);
+    for (int i = 0; i < count; i++) {
+        if (nodes[i].valid && !nodes[i].isBinary())
+            ev->targets.push_back(address_layout.toPhysical(clauses.memAddr(nodes[i].getClauseAddr())));
+    }
+    prefetch_link->send(ev);
+}
+
 //-----------------------------------------------------------------------------------
 // analyze
 //-----------------------------------------------------------------------------------
@@ -2174,6 +2940,8 @@ void SATSolver::analyze(Cref conflict, int worker_id) {
     int tmp_lbd = 0;
     std::vector<bool> lbd_levels(current_level() + 1, false);
     std::vector<Cref> tmp_c_to_bump;
+    std::vector<int> tmp_c_lbd;
+    std::vector<int> clause_levels;
     std::vector<Var> tmp_v_to_bump;
 
     int pathC = 0;  // Counter for literals at current decision level
@@ -2184,10 +2952,15 @@ void SATSolver::analyze(Cref conflict, int worker_id) {
     do {
         sst_assert(conflict != ClauseRef_Undef, CALL_INFO, -1,  // (otherwise should be UIP)
             "ANALYZE[%d]: conflict clause is undefined\n", worker_id);
-        const Clause& c = clauses.readClause(conflict, worker_id);
+        Clause c;
+        readClauseRef(conflict, p, c, worker_id);
         
         // Bump activity for learnt clauses
-        if (clauses.isLearnt(conflict)) tmp_c_to_bump.push_back(conflict);
+        bool learnt = !isBinaryRef(conflict) && clauses.isLearnt(conflict);
+        if (learnt) tmp_c_to_bump.push_back(conflict);
+        // levels of the clause, for its current LBD (the implied literal is at this level)
+        clause_levels.clear();
+        if (p != lit_Undef) clause_levels.push_back(current_level());
 
         // Debug print for current clause
         output.verbose(CALL_INFO, 5, 0, "ANALYZE[%d]: current clause (0x%x): %s\n",
@@ -2202,6 +2975,7 @@ void SATSolver::analyze(Cref conflict, int worker_id) {
 
             // Read variable data individually for each variable in the conflict clause
             Variable v_data = variables.readVar(v, worker_id);
+            if (v_data.level > 0) clause_levels.push_back(v_data.level);
 
             if (!tmp_seen[v] && v_data.level > 0) {
                 // Bump activity for seen variables
@@ -2227,6 +3001,11 @@ void SATSolver::analyze(Cref conflict, int worker_id) {
             }
         }
 
+        if (learnt && learnt_tiers) {
+            std::sort(clause_levels.begin(), clause_levels.end());
+            tmp_c_lbd.push_back(std::unique(clause_levels.begin(), clause_levels.end()) - clause_levels.begin());
+        }
+
         // Select next literal to expand from the trail
         // HACK: may need to check the entire trail if trail is not in order
         // index = trail.size() - 1;
@@ -2262,6 +3041,7 @@ void SATSolver::analyze(Cref conflict, int worker_id) {
         learnt_clause = std::move(tmp_learnt);
         seen = std::move(tmp_seen);
         c_to_bump = std::move(tmp_c_to_bump);
+        c_to_bump_lbd = std::move(tmp_c_lbd);
         v_to_bump = std::move(tmp_v_to_bump);
     }
     // order_heap->handleRequest(new HeapReqEvent(HeapReqEvent::DEBUG_HEAP, 0));
@@ -2329,9 +3109,9 @@ void SATSolver::backtrack(int backtrack_level) {
         // peek version
         // insertVarOrder(v);
 
-        // decide with spec_literal
-        if (v != var(spec_literal)) {
-            insertVarOrder(v);
+        // speculated literals are out of the heap until decided or dropped
+        if (!isSpecLiteral(v)) {
+            insertVarOrder(v, true);
         }
         
         output.verbose(CALL_INFO, 5, 0,
@@ -2339,9 +3119,12 @@ void SATSolver::backtrack(int backtrack_level) {
             v, polarity[v] ? "false" : "true");
     }
     
+    flushVarOrder();
+    
     qhead = trail_lim[backtrack_level];
     trail.resize(trail_lim[backtrack_level]);
     trail_lim.resize(backtrack_level);
+    prefetch_chased = std::min(prefetch_chased, trail.size());
 }
 
 //-----------------------------------------------------------------------------------
@@ -2377,8 +3160,12 @@ void SATSolver::reduceDB() {
         "REDUCEDB: Found %zu learnt clauses, extra_lim = %f\n", 
         learnts.size(), extra_lim);
     
+    // Compacting rebuilds the allocator, so removed clauses need not be freed
+    bool compact = gc_compact && ++reductions_since_gc >= gc_interval;
+
     // 4. mark for removal
     std::vector<Cref> to_keep;
+    std::vector<std::pair<Cref, float>> survivors;
     int removed = 0;
     for (size_t i = 0; i < learnts.size(); i++) {
         Cref addr = learnts[i].first;
@@ -2392,14 +3179,22 @@ void SATSolver::reduceDB() {
 
             // remove watchers
             detachClause(addr);
-            clauses.freeClause(addr, cls_size);
+            if (!compact) clauses.freeClause(addr, cls_size);
             removed++;
         }
-        else to_keep.push_back(addr);
+        else {
+            to_keep.push_back(addr);
+            survivors.push_back(learnts[i]);
+        }
     }
 
+    compactWatchLists();
+
     // 5. Compact clauses by moving non-removed learnt clauses forward
-    clauses.reduceDB(to_keep);
+    if (compact) {
+        compactLearnts(survivors);
+        reductions_since_gc = 0;
+    } else clauses.reduceDB(to_keep);
 
     output.verbose(CALL_INFO, 4, 0, 
         "REDUCEDB: Removed %d learnt clauses, new clause count: %zu\n", 
@@ -2410,6 +3205,245 @@ void SATSolver::reduceDB() {
     if (tracer_) tracer_->emitReduce(removed, (int)to_keep.size());
 }
 
+// reduceDB on a modeled reduction unit. The learnt address table and the
+// leading 16 bytes of every learnt (size, activity, watched literals) are
+// streamed once into on-chip buffers over cfg.reducers parallel read
+// streams, instead of reading sizes from memory inside the sort comparator.
+// The removal set is chosen on chip; selectCycles models its cost. The
+// ranking equals the one of reduceDB, so both remove the same clauses and
+// only timing differs. Dead watchers are dropped with one walk per watch
+// list rather than one per removed clause.
+void SATSolver::reduceDBUnit() {
+    output.verbose(CALL_INFO, 4, 0, "REDUCEDB: Starting clause database reduction (reduction unit)\n");
+
+    size_t nl = nLearnts();
+    std::vector<Cref> learnts_addr = clauses.readAllAddr();
+    std::vector<ClauseSummary> summary(nl);
+
+    // stream the clause summaries, stream w takes every workers-th clause
+    int workers = std::min(cfg.reducers, (int)nl);
+    if (workers > 0) {
+        coro_t::push_type* parent_yield_ptr = yield_ptr;
+        ready_q.reset(workers);
+        std::vector<coro_t::pull_type*> coroutines(workers);
+        std::vector<coro_t::push_type*> yield_ptrs(workers);
+        for (int worker_id = 0; worker_id < workers; worker_id++) {
+            coroutines[worker_id] = fibers.spawn(
+                [this, worker_id, workers, &learnts_addr, &summary, &yield_ptrs](coro_t::push_type &yield) {
+                    yield_ptr = &yield;
+                    yield_ptrs[worker_id] = yield_ptr;
+                    for (size_t i = worker_id; i < learnts_addr.size(); i += workers)
+                        clauses.readSummary(learnts_addr[i], summary[i], worker_id);
+                });
+        }
+        stepWorkers(coroutines, yield_ptrs, ready_q, parent_yield_ptr);
+        ready_q.clear();
+        yield_ptr = parent_yield_ptr;
+    }
+    stat_reduce_bytes->addDataNTimes(nl * (sizeof(Cref) + sizeof(ClauseSummary)), 1);
+
+    // rank on chip: binaries last, then by activity; with tiers only the
+    // first `candidates` entries of the order (the local tier) may go
+    std::vector<uint32_t> order(nl);
+    size_t candidates = nl;
+    if (learnt_tiers) {
+        candidates = rankTiers(learnts_addr, summary, order);
+    } else {
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            return summary[a].litSize() > 2 && (summary[b].litSize() == 2 || summary[a].activity < summary[b].activity);
+        });
+    }
+
+    // activities are non-negative, so their bit patterns order like the values
+    std::vector<uint32_t> keys(candidates);
+    for (size_t k = 0; k < candidates; k++) {
+        const ClauseSummary& s = summary[order[k]];
+        if (s.litSize() == 2) keys[k] = UINT32_MAX;
+        else memcpy(&keys[k], &s.activity, sizeof(uint32_t));
+    }
+    uint64_t select_cycles = selectCycles(keys);
+    stat_reduce_select->addDataNTimes(select_cycles, 1);
+    busyCycles(select_cycles);
+
+    double extra_lim = nl > 0 ? cla_inc / nl : 0;
+    bool compact = gc_compact && ++reductions_since_gc >= gc_interval;
+
+    std::vector<Cref> to_keep;
+    std::vector<std::pair<Cref, float>> survivors;
+    std::map<int, std::unordered_set<Cref>> dead_watchers;  // watch list -> removed clauses
+    std::fill(std::begin(tier_kept), std::end(tier_kept), 0);
+    int removed = 0;
+    for (size_t k = 0; k < nl; k++) {
+        Cref addr = learnts_addr[order[k]];
+        const ClauseSummary& s = summary[order[k]];
+
+        // Only remove non-binary, unlocked clauses
+        if (k < candidates && s.litSize() > 2 && !locked(addr, s.watched[0])
+            && (k < candidates / 2 || s.activity < extra_lim)) {
+            output.verbose(CALL_INFO, 4, 0,
+                "REDUCEDB: Marking clause 0x%x for removal\n", addr);
+            dead_watchers[toWatchIndex(~s.watched[0])].insert(addr);
+            dead_watchers[toWatchIndex(~s.watched[1])].insert(addr);
+            if (!compact) clauses.freeClause(addr, s.litSize());
+            removed++;
+        } else {
+            to_keep.push_back(addr);
+            survivors.push_back(std::make_pair(addr, s.activity));
+            if (learnt_tiers) tier_kept[s.tier()]++;
+        }
+    }
+    for (const auto& kv : dead_watchers) watches.removeWatchers(kv.first, kv.second);
+    stat_reduce_lists->addDataNTimes(dead_watchers.size(), 1);
+    compactWatchLists();
+
+    if (compact) {
+        compactLearnts(survivors);
+        reductions_since_gc = 0;
+    } else clauses.reduceDB(to_keep);
+
+    output.verbose(CALL_INFO, 4, 0,
+        "REDUCEDB: Removed %d learnt clauses, new clause count: %zu\n",
+        removed, clauses.size());
+
+    stat_db_reductions->addData(1);
+    stat_removed->addDataNTimes(removed, 1);
+    if (tracer_) tracer_->emitReduce(removed, (int)to_keep.size());
+}
+
+// Tier pass of the reduction unit over the streamed summaries. Core learnts
+// always stay. Mid learnts used since the last reduction stay; unused ones
+// drop to the local tier, and are kept this round. Local learnts used since
+// the last reduction get one more round; the others are the candidates,
+// ranked like the untiered policy and placed first in order. Changed size
+// words are written back. Returns the number of candidates.
+size_t SATSolver::rankTiers(const std::vector<Cref>& addrs, std::vector<ClauseSummary>& summary,
+                            std::vector<uint32_t>& order) {
+    order.clear();
+    std::vector<uint32_t> kept;
+    for (uint32_t i = 0; i < summary.size(); i++) {
+        ClauseSummary& s = summary[i];
+        int tier = s.tier();
+        if (tier == TIER_CORE || tier == TIER_NONE) {
+            kept.push_back(i);
+            continue;
+        }
+        if (s.used()) {
+            s.header = clauseHeader(s.litSize(), s.lbd(), tier, false);
+            clauses.writeHeader(addrs[i], s.header);
+            kept.push_back(i);
+        } else if (tier == TIER_MID) {
+            s.header = clauseHeader(s.litSize(), s.lbd(), TIER_LOCAL, false);
+            clauses.writeHeader(addrs[i], s.header);
+            stat_tier_demoted->addData(1);
+            kept.push_back(i);
+        } else {
+            order.push_back(i);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return summary[a].litSize() > 2 && (summary[b].litSize() == 2 || summary[a].activity < summary[b].activity);
+    });
+    size_t candidates = order.size();
+    order.insert(order.end(), kept.begin(), kept.end());
+    return candidates;
+}
+
+// Modeled cycles to choose the removal set from n on-chip keys at
+// reduce_width comparisons per cycle.
+//  bitonic: sort network over n padded to a power of two,
+//           n/2 * log n * (log n + 1) / 2 comparisons
+//  median:  radix select of the median with 8-bit digits; each pass
+//           histograms the keys matching the digits chosen so far, and a
+//           last pass marks the keys below the median
+uint64_t SATSolver::selectCycles(const std::vector<uint32_t>& keys) {
+    size_t n = keys.size();
+    if (n < 2) return 0;
+
+    uint64_t ops = 0;
+    if (reduce_bitonic) {
+        uint64_t padded = 1, lg = 0;
+        while (padded < n) { padded <<= 1; lg++; }
+        ops = padded / 2 * lg * (lg + 1) / 2;
+    } else {
+        uint64_t rank = n / 2;
+        uint32_t prefix = 0, mask = 0;
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            uint64_t hist[256] = {0};
+            for (uint32_t k : keys) {
+                if ((k & mask) != prefix) continue;
+                hist[(k >> shift) & 0xff]++;
+                ops++;
+            }
+            ops += 256;  // scan the histogram
+            int d = 0;
+            while (rank >= hist[d]) rank -= hist[d++];
+            prefix |= (uint32_t)d << shift;
+            mask |= 0xffu << shift;
+        }
+        ops += n;
+    }
+    return (ops + reduce_width - 1) / reduce_width;
+}
+
+// Spend n cycles on on-chip work of the main coroutine: each yield leaves a
+// pending wake-up, so the coroutine resumes on the next cycle.
+void SATSolver::busyCycles(uint64_t n) {
+    if (fast_forwarding) return;
+    for (uint64_t i = 0; i < n; i++) {
+        wake_pending = true;
+        (*yield_ptr)();
+    }
+}
+
+// Relocate the surviving learnt clauses into one contiguous run and rewrite
+// everything that refers to them: the two watchers of each moved clause and
+// the reason of the variable it implies, if any. Most active clauses go
+// first with gc_by_activity, so the hot part of the learnt DB shares lines.
+// The address table is rewritten by Clauses.
+void SATSolver::compactLearnts(std::vector<std::pair<Cref, float>>& survivors) {
+    // speculative workers hold clause and watcher addresses; DECIDE, which
+    // follows every reduction, would terminate them anyway
+    if (spec_coroutine != nullptr) terminateSpecPropagate();
+
+    if (gc_by_activity) {
+        std::stable_sort(survivors.begin(), survivors.end(),
+            [](const auto& a, const auto& b) { return a.second > b.second; });
+    } else {
+        std::sort(survivors.begin(), survivors.end());
+    }
+
+    std::vector<Cref> old_addr(survivors.size());
+    for (size_t i = 0; i < survivors.size(); i++) old_addr[i] = survivors[i].first;
+    std::vector<Clause> contents;
+    std::vector<Cref> new_addr = clauses.compactLearnts(old_addr, contents);
+
+    std::unordered_map<Cref, Cref> moved;
+    std::set<int> lists;  // ordered, so the fix-up traffic is deterministic
+    for (size_t i = 0; i < survivors.size(); i++) {
+        if (new_addr[i] == old_addr[i]) continue;
+        const Clause& c = contents[i];
+        moved[old_addr[i]] = new_addr[i];
+        lists.insert(toWatchIndex(~c[0]));
+        lists.insert(toWatchIndex(~c[1]));
+
+        Var v = var(c[0]);
+        if (var_assigned[v] && value(c[0]) == true) {
+            Variable var_data = variables.readVar(v);
+            if (var_data.reason == old_addr[i]) {
+                var_data.reason = new_addr[i];
+                variables[v] = var_data;
+            }
+        }
+    }
+    for (int lit_idx : lists) watches.relocateWatchers(lit_idx, moved);
+
+    output.verbose(CALL_INFO, 4, 0, "REDUCEDB: Compacted %zu learnt clauses, %zu moved, %zu watch lists updated\n",
+        survivors.size(), moved.size(), lists.size());
+    stat_gc_compactions->addData(1);
+    stat_gc_moved->addDataNTimes(moved.size(), 1);
+}
+
 //-----------------------------------------------------------------------------------
 // Trail Management
 //-----------------------------------------------------------------------------------
@@ -2423,6 +3457,7 @@ void SATSolver::trailEnqueue(Lit literal, int reason) {
     Variable var_data;
     var_data.level = current_level();
     var_data.reason = reason;
+    var_data.value = sign(literal) ? VAL_FALSE : VAL_TRUE;
     variables[v] = var_data;
     
     // Add to trail
@@ -2434,6 +3469,7 @@ void SATSolver::trailEnqueue(Lit literal, int reason) {
 
 void SATSolver::unassignVariable(Var v) {
     var_assigned[v] = false;
+    variables.clearValue(v);
     stat_unassigns->addData(1);
 }
 
@@ -2445,8 +3481,27 @@ void SATSolver::attachClause(Cref clause_addr, const Clause& c) {
     // Watch the first two literals in the clause, use each other as a blocker
     output.verbose(CALL_INFO, 5, 0, "ATTACH: clause 0x%x with literals %d and %d\n",
         clause_addr, toInt(c[0]), toInt(c[1]));
-    watches.insertWatcher(toWatchIndex(~c[0]), clause_addr, c[1]);
-    watches.insertWatcher(toWatchIndex(~c[1]), clause_addr, c[0]);
+    bool binary = binary_watchers && c.litSize() == 2;
+    watches.insertWatcher(toWatchIndex(~c[0]), clause_addr, c[1], 0, binary);
+    watches.insertWatcher(toWatchIndex(~c[1]), clause_addr, c[0], 0, binary);
+}
+
+// Merge sparse watch lists into fewer blocks, oldest candidates first and
+// at most watch_compact_lists per reduction; the rest wait for the next
+// one. Runs in REDUCE, after the removed clauses are detached, as nothing
+// else walks or inserts into the lists then. Propagation only nominates
+// lists (see propagateLiteral): compacting there would race the inserts
+// of concurrent literal workers.
+void SATSolver::compactWatchLists() {
+    for (int n = 0; n < watch_compact_lists; n++) {
+        int lit_idx = watches.nextSparse();
+        if (lit_idx < 0) break;
+        int freed = watches.compactList(lit_idx);
+        if (freed > 0) {
+            stat_watch_compactions->addData(1);
+            stat_watch_blocks_freed->addDataNTimes(freed, 1);
+        }
+    }
 }
 
 void SATSolver::detachClause(Cref clause_addr) {
@@ -2508,16 +3563,26 @@ Lit SATSolver::peekBranchVariable() {
     return mkLit(next, polarity[next]);
 }
 
-void SATSolver::insertVarOrder(Var v) {
+void SATSolver::insertVarOrder(Var v, bool batched) {
     if (decision[v]) {
-        order_heap->handleRequest(new HeapReqEvent(HeapReqEvent::INSERT, v));
 #ifdef USE_CLASSIC_HEAP
+        order_heap->handleRequest(new HeapReqEvent(HeapReqEvent::INSERT, v));
         heap_resp_cnt++;
+#else
+        if (batched) heap_batch.push_back(v);
+        else order_heap->handleRequest(new HeapReqEvent(HeapReqEvent::INSERT, v));
 #endif
         output.verbose(CALL_INFO, 7, 0, "Insert var %d into order heap\n", v);
     }
 }
 
+// Send the inserts collected by insertVarOrder(v, true) as one batch
+void SATSolver::flushVarOrder() {
+    if (heap_batch.empty()) return;
+    order_heap->handleRequest(new HeapReqEvent(HeapReqEvent::INSERT, std::move(heap_batch)));
+    heap_batch.clear();
+}
+
 void SATSolver::varDecayActivity() {
     var_inc *= 1.0 / var_decay;
     output.verbose(CALL_INFO, 4, 0,
@@ -2549,7 +3614,36 @@ void SATSolver::claBumpActivity(Cref clause_addr, float act) {
     output.verbose(CALL_INFO, 4, 0, "ACTIVITY: Bumped clause 0x%x\n", clause_addr);
 }
 
+int SATSolver::tierOf(int lbd) const {
+    if (lbd <= tier_core_lbd) return TIER_CORE;
+    if (lbd <= tier_mid_lbd) return TIER_MID;
+    return TIER_LOCAL;
+}
+
+// A learnt took part in conflict analysis: mark it used and, if its LBD
+// dropped, store the new LBD and promote it. The clause stays where it is
+// until a compaction moves it into its new tier's region.
+void SATSolver::useLearnt(Cref clause_addr, const Clause& c, int lbd) {
+    int new_lbd = std::min<int>(c.lbd, std::min(lbd, CLAUSE_MAX_LBD));
+    int new_tier = std::min<int>(c.tier, tierOf(new_lbd));
+    if (c.used && new_lbd == c.lbd && new_tier == c.tier) return;
+    if (new_tier < c.tier) {
+        stat_tier_promoted->addData(1);
+        output.verbose(CALL_INFO, 4, 0, "TIERS: Promoted clause 0x%x to tier %d (lbd %d)\n",
+            clause_addr, new_tier, new_lbd);
+    }
+    clauses.writeHeader(clause_addr, clauseHeader(c.litSize(), new_lbd, new_tier, true));
+}
+
 // Check if a clause is "locked" -- cannot be removed
+// Same check with the first literal already at hand; the reason is only
+// read when the literal is true.
+bool SATSolver::locked(Cref clause_addr, Lit first) {
+    Var v = var(first);
+    if (!var_assigned[v] || value(first) != true) return false;
+    return variables.getReason(v) == clause_addr;
+}
+
 bool SATSolver::locked(Cref clause_addr) {
     const Clause& c = clauses.readClause(clause_addr);
     assert(c.litSize() != 0);
@@ -2566,7 +3660,7 @@ bool SATSolver::locked(Cref clause_addr) {
 //-----------------------------------------------------------------------------------
 
 void SATSolver::minimizeL2_sub(std::vector<bool>& redundant, int worker_id) {
-    for (size_t i = worker_id + 1; i < learnt_clause.size(); i += MINIMIZERS) {
+    for (size_t i = worker_id + 1; i < learnt_clause.size(); i += cfg.minimizers) {
         output.verbose(CALL_INFO, 5, 0, 
             "MIN[%d]: Checking literal %d at position %zu\n", 
             worker_id, toInt(learnt_clause[i]), i);
@@ -2588,7 +3682,8 @@ bool SATSolver::litRedundant(Lit p, int worker_id) {
     assert(seen[var(p)] == seen_undef || seen[var(p)] == seen_source);
     
     std::vector<ShrinkStackElem> analyze_stack; // Stack for clause minimization
-    Clause c = clauses.readClause(reason, worker_id);
+    Clause c;
+    readClauseRef(reason, ~p, c, worker_id);
     
     for (size_t i = 1; ; i++) {
         if (i < c.litSize()) {
@@ -2621,7 +3716,7 @@ bool SATSolver::litRedundant(Lit p, int worker_id) {
             analyze_stack.push_back(ShrinkStackElem(i, p));
             i = 0;
             p = l;
-            c = clauses.readClause(v_data.reason, worker_id);
+            readClauseRef(v_data.reason, ~p, c, worker_id);
         } else {
             // Finished examining current reason clause
             if (seen[var(p)] == seen_undef) {
@@ -2642,7 +3737,7 @@ bool SATSolver::litRedundant(Lit p, int worker_id) {
             analyze_stack.pop_back();
             i = e.i;
             p = e.l;
-            c = clauses.readClause(variables.getReason(var(p), worker_id), worker_id);
+            readClauseRef(variables.getReason(var(p), worker_id), ~p, c, worker_id);
         }
     }
 }
@@ -2724,6 +3819,87 @@ void SATSolver::printHist(Statistic<uint64_t>* stat_hist) {
     }
 }
 
+// Region table of the data structures, the physical mapping of the
+// solver-side ones and watcher block colocation. The heap subcomponents
+// address memory on their own, so their regions are only classified.
+void SATSolver::configureLayout(SST::Params& params) {
+    struct { const char* name; uint64_t base; TraceWriter::DsId ds; AsyncBase* owner; } regions[] = {
+        {"heap",         heap_base_addr,        TraceWriter::DS_HEAP,        nullptr},
+        {"indices",      indices_base_addr,     TraceWriter::DS_INDICES,     nullptr},
+        {"variables",    variables_base_addr,   TraceWriter::DS_VARIABLES,   &variables},
+        {"watches",      watches_base_addr,     TraceWriter::DS_WATCHES,     &watches},
+        {"watch_nodes",  watch_nodes_base_addr, TraceWriter::DS_WATCH_NODES, &watches},
+        {"clauses_cmd",  clauses_cmd_base_addr, TraceWriter::DS_CLAUSES_CMD, &clauses},
+        {"clauses",      clauses_base_addr,     TraceWriter::DS_CLAUSES,     &clauses},
+        {"var_activity", var_act_base_addr,     TraceWriter::DS_VAR_ACT,     nullptr},
+    };
+    std::fill(std::begin(region_owner), std::end(region_owner), nullptr);
+    for (const auto& r : regions) {
+        address_layout.addRegion(r.name, r.base, r.ds);
+        region_owner[r.ds] = r.owner;
+    }
+
+    std::string policy = params.find<std::string>("address_layout", "linear");
+    if (policy == "interleave") address_layout.setPolicy(AddressLayout::INTERLEAVE);
+    else if (policy == "hash") address_layout.setPolicy(AddressLayout::HASH);
+    else if (policy != "linear") {
+        output.fatal(CALL_INFO, -1, "Invalid address_layout '%s' (linear, interleave or hash)\n", policy.c_str());
+    }
+    int stripes = params.find<int>("layout_stripes", 1);
+    int stripe_shift = params.find<int>("layout_stripe_shift", 6);
+    if (stripes < 1 || (stripes & (stripes - 1)))
+        output.fatal(CALL_INFO, -1, "layout_stripes must be a power of two, got %d\n", stripes);
+    if (stripe_shift < 0 || stripe_shift > 40)
+        output.fatal(CALL_INFO, -1, "layout_stripe_shift must be 0-40, got %d\n", stripe_shift);
+    address_layout.setStripes(stripe_shift, __builtin_ctz(stripes));
+
+    // "bytes[,region:bytes...]": the default for the solver-side regions,
+    // then per-region overrides
+    std::string spec = params.find<std::string>("layout_interleave", "64");
+    size_t pos = 0;
+    for (bool first = true; pos <= spec.size(); first = false) {
+        size_t end = std::min(spec.find(',', pos), spec.size());
+        std::string item = spec.substr(pos, end - pos);
+        pos = end + 1;
+        size_t colon = item.find(':');
+        std::string name = colon == std::string::npos ? "" : item.substr(0, colon);
+        uint64_t bytes = 0;
+        try {
+            bytes = std::stoull(colon == std::string::npos ? item : item.substr(colon + 1), nullptr, 0);
+        } catch (const std::exception&) {
+            output.fatal(CALL_INFO, -1, "layout_interleave: cannot parse '%s'\n", item.c_str());
+        }
+        bool ok = true;
+        if (name.empty() && first) {
+            for (const auto& r : regions) if (r.owner) ok = ok && address_layout.setInterleave(r.name, bytes);
+        } else {
+            bool solver_side = false;
+            for (const auto& r : regions) solver_side = solver_side || (r.owner && name == r.name);
+            if (!solver_side) {
+                output.fatal(CALL_INFO, -1, "layout_interleave: '%s' is not a solver-side region "
+                             "(variables, watches, watch_nodes, clauses_cmd or clauses)\n", item.c_str());
+            }
+            ok = address_layout.setInterleave(name, bytes);
+        }
+        if (!ok) output.fatal(CALL_INFO, -1, "layout_interleave: %s is not a power of two\n", item.c_str());
+    }
+
+    // checked again against the memory's line size in setup()
+    std::string err = address_layout.finalize(64);
+    if (!err.empty()) output.fatal(CALL_INFO, -1, "address_layout: %s\n", err.c_str());
+    variables.setLayout(&address_layout);
+    watches.setLayout(&address_layout);
+    clauses.setLayout(&address_layout);
+
+    if (params.find<bool>("layout_colocate_watches", false)) {
+        if (stripes < 2) output.fatal(CALL_INFO, -1, "layout_colocate_watches needs layout_stripes > 1\n");
+        watches.setColocation([this](Cref c) { return address_layout.stripeOfLogical(clauses.memAddr(c)); });
+    }
+    output.verbose(CALL_INFO, 1, 0, "Address layout: %s, %d stripes from bit %d, interleave %s%s\n",
+                   policy.c_str(), stripes, stripe_shift, spec.c_str(),
+                   watches.colocating() ? ", watcher blocks colocated" : "");
+}
+
 void SATSolver::loadDecisionSequence(const std::string& filename) {
     std::ifstream file(filename);
     if (!file.is_open()) {
@@ -2763,20 +3939,21 @@ void SATSolver::dumpDecision(Lit lit) {
 // Speculative Propagation
 //-----------------------------------------------------------------------------------
 
-// Reset speculative propagation state
-void SATSolver::terminateSpecPropagate() {
+// Reset speculative propagation state. keep_round leaves the trail of the
+// round to adoptSpecImplications.
+void SATSolver::terminateSpecPropagate(bool keep_round) {
     output.verbose(CALL_INFO, 2, 0, "Terminated previous speculative propagation\n");
-    for (auto corot : spec_sub_coroutines) {
-        if (corot != nullptr) delete corot;
+    closeSpecDepth();
+    for (auto& corot : spec_sub_coroutines) {
+        if (corot != nullptr) fibers.release(corot);
     }
     spec_sub_coroutines.clear();
     spec_sub_yield_ptrs.clear();
-    spec_active_workers.clear();
+    spec_ready_q.clear();
     // Terminate the speculative coroutine
-    delete spec_coroutine;
-    spec_coroutine = nullptr;
+    fibers.release(spec_coroutine);
     spec_active = false;
-    spec_trail.clear();
+    if (!keep_round) spec_reusable = false;
     // clear any pending requests
     reorder_buffer.reset();
     clauses.reset();
@@ -2791,6 +3968,12 @@ void SATSolver::resetSpecState() {
     prev_spec_var_propagated = spec_var_propagated;
     
     spec_trail.clear();
+    spec_lim.clear();
+    spec_reason.clear();
+    spec_reason_end.clear();
+    spec_reason_lits.clear();
+    spec_open_depth = -1;
+    spec_reusable = spec_reuse;
     
     // Initialize or reset speculative assignment tracking
     if (spec_var_assigned.size() != num_vars + 1) {
@@ -2809,6 +3992,125 @@ void SATSolver::resetSpecState() {
     spec_conflicts = 0;
 }
 
+bool SATSolver::isSpecLiteral(Var v) const {
+    for (const SpecLit& s : spec_literals) {
+        if (var(s.lit) == v) return true;
+    }
+    return false;
+}
+
+// Give the speculated literals back to the heap; the lines they brought in
+// count as wasted
+void SATSolver::dropSpecLiterals() {
+    for (const SpecLit& s : spec_literals) {
+        stat_spec_depth[s.depth].dropped->addData(1);
+        stat_spec_depth[s.depth].wasted_lines->addDataNTimes(s.lines, 1);
+        insertVarOrder(var(s.lit));
+    }
+    spec_literals.clear();
+    spec_reusable = false;
+}
+
+// Take the next decisions from the heap until spec_depth are speculated on
+void SATSolver::refillSpecLiterals() {
+    while ((int)spec_literals.size() < spec_depth) {
+        Lit lit = chooseBranchVariable();
+        if (lit == lit_Undef) break;
+        spec_literals.push_back({lit, (int)spec_literals.size(), 0});
+        output.verbose(CALL_INFO, 2, 0, "Selected next speculative lit %d (depth %zu)\n",
+            toInt(lit), spec_literals.size() - 1);
+    }
+}
+
+// Charge the lines read since the open depth began to its literal
+void SATSolver::closeSpecDepth() {
+    if (spec_open_depth < 0 || spec_prop_cache_lines.empty()) return;
+    SpecLit& s = spec_literals[spec_open_depth];
+    uint64_t lines = spec_prop_cache_lines.back() - spec_depth_mark;
+    s.lines += lines;
+    stat_spec_depth[s.depth].lines->addDataNTimes(lines, 1);
+    spec_open_depth = -1;
+}
+
+// Put p on the speculative trail. With spec_reuse, the literals of its
+// reason (lits, n of them) are kept for adoptSpecImplications.
+void SATSolver::specEnqueue(Lit p, Cref reason, const Lit* lits, size_t n) {
+    spec_trail.push_back(p);
+    spec_var_assigned[var(p)] = true;
+    spec_var_value[var(p)] = !sign(p);
+    if (spec_reuse) {
+        spec_reason.push_back(reason);
+        spec_reason_lits.insert(spec_reason_lits.end(), lits, lits + n);
+        spec_reason_end.push_back(spec_reason_lits.size());
+    }
+}
+
+// spec_reuse: enqueue what the last round implied from decision, the
+// round's depth 0 literal, at the decision's level. The round ran against an
+// older, partial assignment, so each implication is checked again: it is
+// still unassigned and every other literal of its reason is false now,
+// counting the implications taken before it. The implied literal must also
+// be watched, so that it can be moved to position 0 where locked() and
+// analysis expect it; the heads of the reasons are read again for that, in
+// parallel and mostly from the lines the round left in cache.
+void SATSolver::adoptSpecImplications(Lit decision) {
+    if (!spec_reusable || spec_lim.empty() || spec_lim[0] >= spec_trail.size()
+        || spec_trail[spec_lim[0]] != decision) return;
+    spec_reusable = false;
+    size_t begin = spec_lim[0] + 1;
+    size_t end = spec_lim.size() > 1 ? spec_lim[1] : spec_trail.size();
+    if (begin >= end) return;
+
+    std::vector<size_t> clause_entries;  // binary references have no clause to read
+    for (size_t i = begin; i < end; i++) {
+        if (!isBinaryRef(spec_reason[i])) clause_entries.push_back(i);
+    }
+    std::vector<ClauseSummary> heads(clause_entries.size());
+    int workers = std::min(cfg.propagators, (int)clause_entries.size());
+    if (workers > 0) {
+        coro_t::push_type* parent_yield_ptr = yield_ptr;
+        ready_q.reset(workers);
+        std::vector<coro_t::pull_type*> coroutines(workers);
+        std::vector<coro_t::push_type*> yield_ptrs(workers);
+        for (int worker_id = 0; worker_id < workers; worker_id++) {
+            coroutines[worker_id] = fibers.spawn(
+                [this, worker_id, workers, &clause_entries, &heads, &yield_ptrs](coro_t::push_type &yield) {
+                    yield_ptr = &yield;
+                    yield_ptrs[worker_id] = yield_ptr;
+                    for (size_t k = worker_id; k < clause_entries.size(); k += workers)
+                        clauses.readSummary(spec_reason[clause_entries[k]], heads[k], worker_id);
+                });
+        }
+        stepWorkers(coroutines, yield_ptrs, ready_q, parent_yield_ptr);
+        ready_q.clear();
+        yield_ptr = parent_yield_ptr;
+    }
+
+    size_t h = 0;
+    for (size_t i = begin; i < end; i++) {
+        Lit p = spec_trail[i];
+        Cref reason = spec_reason[i];
+        const ClauseSummary* head = isBinaryRef(reason) ? nullptr : &heads[h++];
+        bool holds = !var_assigned[var(p)];
+        for (uint32_t k = spec_reason_end[i - 1]; holds && k < spec_reason_end[i]; k++) {
+            Lit q = spec_reason_lits[k];
+            if (q != p) holds = var_assigned[var(q)] && value(q) == false;
+        }
+        if (holds && head) holds = head->watched[0] == p || head->watched[1] == p;
+        if (!holds) {
+            stat_spec_rejected->addData(1);
+            continue;
+        }
+        if (head && head->watched[1] == p) {
+            clauses.writeLiteral(reason, p, 0);
+            clauses.writeLiteral(reason, head->watched[0], 1);
+        }
+        output.verbose(CALL_INFO, 4, 0, "SPEC: adopted %d, reason 0x%x\n", toInt(p), reason);
+        trailEnqueue(p, reason);
+        stat_spec_adopted->addData(1);
+    }
+}
+
 // Check if a variable is assigned in speculative propagation
 bool SATSolver::isSpecAssigned(Var v) const {
     return var_assigned[v] || spec_var_assigned[v];
@@ -2825,16 +4127,13 @@ bool SATSolver::getSpecValue(Lit p) const {
     return getSpecValue(var(p)) ^ sign(p);
 }
 
-// Speculative propagation - reads watchlists and clauses without making writes
+// Speculative propagation - reads watchlists and clauses without making writes.
+// The speculated decisions are taken in order, each on top of the ones
+// before it, as the solver would take them; depth d propagates literal d
+// on the implications of depths 0..d-1. A conflict, or a literal made false
+// by a shallower depth, ends the chain.
 void SATSolver::speculativePropagate() {
-    if (spec_literal == lit_Undef) return;
-
-    // Add the speculative literal to the temporary trail
-    spec_trail.push_back(spec_literal);
-    Var v = var(spec_literal);
-    spec_var_assigned[v] = true;
-    spec_var_value[v] = !sign(spec_literal);
-    output.verbose(CALL_INFO, 2, 0, "SPEC: propagate %d (decision)\n", toInt(spec_literal));
+    if (spec_literals.empty()) return;
 
     // Initialize cache line counter for this speculativePropagate() call
     // Push immediately so it's preserved even if speculation terminates early
@@ -2842,6 +4141,37 @@ void SATSolver::speculativePropagate() {
     uint64_t& cache_lines_read = spec_prop_cache_lines.back();
 
     uint spec_qhead = 0;
+    for (size_t d = 0; d < spec_literals.size() && spec_conflicts < MAX_CONFL; d++) {
+        Lit lit = spec_literals[d].lit;
+        if (isSpecAssigned(var(lit)) && !getSpecValue(lit)) break;
+        spec_lim.push_back(spec_trail.size());
+        stat_spec_depth[d].started->addData(1);
+        spec_open_depth = d;
+        spec_depth_mark = cache_lines_read;
+
+        // a literal implied by a shallower depth needs no context of its own
+        if (!isSpecAssigned(var(lit))) {
+            // Add the speculative literal to the temporary trail
+            specEnqueue(lit, ClauseRef_Undef, nullptr, 0);
+            output.verbose(CALL_INFO, 2, 0, "SPEC: propagate %d (decision, depth %zu)\n", toInt(lit), d);
+            speculateDepth(spec_qhead, cache_lines_read);
+        }
+        closeSpecDepth();
+    }
+
+    // Cache line count already stored in vector via reference
+    output.verbose(CALL_INFO, 2, 0, 
+        "SPEC: speculativePropagate() processed %zu literals in %zu depths and brought in %lu cache lines\n",
+        spec_trail.size(), spec_lim.size(), cache_lines_read);
+
+    stat_spec_finished->addDataNTimes(spec_trail.size(), 1);
+    output.verbose(CALL_INFO, 2, 0,
+        "Speculative propagation finished: trail_size=%zu, conflicts=%d\n", 
+        spec_trail.size(), spec_conflicts);
+}
+
+// Propagate the speculative trail from spec_qhead to its end
+void SATSolver::speculateDepth(uint& spec_qhead, uint64_t& cache_lines_read) {
     while (spec_qhead < spec_trail.size() && spec_conflicts < MAX_CONFL) {
         Lit p = spec_trail[spec_qhead];
         Lit not_p = ~p;
@@ -2852,9 +4182,9 @@ void SATSolver::speculativePropagate() {
         
         output.verbose(CALL_INFO, 2, 0, "SPEC: Processing literal %d\n", toInt(not_p));
         
-        // Use dedicated worker IDs starting from SPEC_WORKER_BASE so they
+        // Use dedicated worker IDs starting from spec_worker_base so they
         // never collide with any main-side phase's worker_id range.
-        int base_worker_id = SPEC_WORKER_BASE;
+        int base_worker_id = cfg.spec_worker_base;
         
         // Read watch metadata - count as 1 cache line read
         cache_lines_read++;
@@ -2865,15 +4195,15 @@ void SATSolver::speculativePropagate() {
         //     return;
         // }
         
-        bool do_prewatch = PRE_WATCHERS > 0;
+        bool do_prewatch = cfg.pre_watchers > 0;
         uint32_t curr_addr = wmd.head_ptr;
         
         // Traverse the watchlist (prewatchers and blocks)
         while (curr_addr != 0 || do_prewatch) {
-            WatcherBlock curr_block;
+            WatcherBlock curr_block = watches.newBlock();
             if (do_prewatch) {
                 curr_block.setNextBlock(curr_addr);
-                for (int i = 0; i < PRE_WATCHERS; i++) {
+                for (int i = 0; i < cfg.pre_watchers; i++) {
                     curr_block.nodes[i] = wmd.pre_watchers[i];
                 }
                 do_prewatch = false;
@@ -2889,8 +4219,8 @@ void SATSolver::speculativePropagate() {
             
             // Collect valid nodes
             std::vector<int> valid_nodes;
-            for (int i = 0; i < PROPAGATORS; i++) {
-                if (!curr_block.nodes[i].valid) continue;
+            for (uint32_t mask = curr_block.validMask(); mask != 0; mask &= mask - 1) {
+                int i = __builtin_ctz(mask);
 
                 Lit blocker = curr_block.nodes[i].blocker;
                 if (isSpecAssigned(var(blocker)) && getSpecValue(blocker)) {
@@ -2901,24 +4231,37 @@ void SATSolver::speculativePropagate() {
                     continue;
                 }
 
+                // Binary watcher: the blocker is the other literal
+                if (curr_block.nodes[i].isBinary()) {
+                    if (isSpecAssigned(var(blocker))) {
+                        spec_conflicts++;
+                        output.verbose(CALL_INFO, 4, 0,
+                            "SPEC: binary conflict found, count=%d\n", spec_conflicts);
+                    } else {
+                        Lit reason_lits[2] = {blocker, not_p};
+                        specEnqueue(blocker, binaryReasonRef(not_p), reason_lits, 2);
+                        output.verbose(CALL_INFO, 4, 0, "SPEC: propagate %d\n", toInt(blocker));
+                    }
+                    continue;
+                }
+
                 valid_nodes.push_back(i);
             }
             
             // Process watchers in parallel batches
             coro_t::push_type* parent_yield_ptr = yield_ptr;
-            int workers = std::min(PROPAGATORS, (int)valid_nodes.size());
+            int workers = std::min(cfg.propagators, (int)valid_nodes.size());
             spec_sub_coroutines.resize(workers);
             spec_sub_yield_ptrs.resize(workers);
-            assert(spec_active_workers.size() == 0);
-            spec_active_workers.resize(workers, false);
-            bool done = true;
+            assert(spec_ready_q.size() == 0);
+            spec_ready_q.reset(workers);
             
             output.verbose(CALL_INFO, 4, 0, "SPEC: spawning %d watcher coroutines\n", workers);
             
             // Create watcher coroutines
             for (int worker_id = 0; worker_id < workers; worker_id++) {
                 int watcher_i = valid_nodes[worker_id];
-                spec_sub_coroutines[worker_id] = new coro_t::pull_type(
+                spec_sub_coroutines[worker_id] = fibers.spawn(
                     [this, watcher_i, not_p, &curr_block, worker_id, base_worker_id, &cache_lines_read]
                     (coro_t::push_type &yield) {
 
@@ -2930,7 +4273,8 @@ void SATSolver::speculativePropagate() {
                     
                     // Read clause - 1 line for size if not terminated
                     cache_lines_read++;
-                    Clause c = clauses.readClause(clause_addr, global_worker_id);
+                    Clause& c = scratchClause(global_worker_id);
+                    clauses.readClause(clause_addr, c, global_worker_id);
 
                     // additional lines if clause spans multiple cache lines
                     cache_lines_read += std::ceil(c.size() / 64) - 1;
@@ -2967,43 +4311,18 @@ void SATSolver::speculativePropagate() {
                                 "SPEC: conflict found, count=%d\n", spec_conflicts);
                         } else {
                             // Propagate
-                            spec_trail.push_back(first);
-                            spec_var_assigned[var(first)] = true;
-                            spec_var_value[var(first)] = !sign(first);
+                            specEnqueue(first, clause_addr, c.literals.data(), c.litSize());
                             output.verbose(CALL_INFO, 4, 0, "SPEC: propagate %d\n", toInt(first));
                         }
                     }
                 });
-
-                if (*spec_sub_coroutines[worker_id]) done = false;
-            }
-            
-            if (!done) (*parent_yield_ptr)();  // yield back to main
-            
-            // Step sub-coroutines
-            while (!done) {
-                done = true;
-                for (int worker_id = 0; worker_id < workers; worker_id++) {
-                    if (spec_active_workers[worker_id]) {
-                        (*spec_sub_coroutines[worker_id])();
-                        spec_active_workers[worker_id] = false;
-                        if (!(*spec_sub_coroutines[worker_id])) {
-                            delete spec_sub_coroutines[worker_id];
-                            spec_sub_coroutines[worker_id] = nullptr;
-                            spec_sub_yield_ptrs[worker_id] = nullptr;
-                        } else {
-                            done = false;
-                        }
-                    } else if (spec_sub_coroutines[worker_id] != nullptr)
-                        done = false;
-                }
-                if (!done) (*parent_yield_ptr)();
             }
+            stepWorkers(spec_sub_coroutines, spec_sub_yield_ptrs, spec_ready_q, parent_yield_ptr);
 
             // Cleanup coroutines
             spec_sub_coroutines.clear();
             spec_sub_yield_ptrs.clear();
-            spec_active_workers.clear();
+            spec_ready_q.clear();
             yield_ptr = parent_yield_ptr;
 
             // early stop
@@ -3020,14 +4339,4 @@ void SATSolver::speculativePropagate() {
         }
         spec_qhead++;
     }
-
-    // Cache line count already stored in vector via reference
-    output.verbose(CALL_INFO, 2, 0, 
-        "SPEC: speculativePropagate() processed %zu literals and brought in %lu cache lines\n",
-        spec_trail.size(), cache_lines_read);
-
-    stat_spec_finished->addDataNTimes(spec_trail.size(), 1);
-    output.verbose(CALL_INFO, 2, 0,
-        "Speculative propagation finished: trail_size=%zu, conflicts=%d\n", 
-        spec_trail.size(), spec_conflicts);
 }
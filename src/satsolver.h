@@ -5,6 +5,7 @@
 #include <sst/core/output.h>
 #include <sst/core/interfaces/stdMem.h>
 #include <vector>
+#include <deque>
 #include <string>
 #include <fstream>    // For reading decision file
 #include <boost/coroutine2/all.hpp>
@@ -17,6 +18,8 @@
 #include "async_clauses.h"
 #include "async_activity.h"
 #include "trace_writer.h"
+#include "cnf_loader.h"
+#include "fiber_pool.h"
 
 //-----------------------------------------------------------------------------------
 // Type Definitions and Constants
@@ -62,6 +65,10 @@ public:
         {"cnf_file", "Path to the CNF file to solve", ""},
         {"random_seed", "Random seed for decision making", "8888"},
         {"sort_clauses", "Sort clauses by activity", "true"},
+        {"parse_threads", "Threads for parsing the CNF file (0 = hardware concurrency)", "0"},
+        {"preload_region_bytes", "Max bytes per coalesced untimed init write", "67108864"},
+        {"fiber_stack_size", "Stack bytes per pooled worker coroutine (0 = boost default)", "0"},
+        {"cnf_cache_dir", "Directory for the binary parsed-CNF cache, keyed by file hash (empty disables)", ""},
         {"var_decay", "Variable activity decay factor", "0.95"},
         {"clause_decay", "Clause activity decay factor", "0.999"},
         {"random_var_freq", "Frequency of random decisions", "0.02"},
@@ -75,13 +82,59 @@ public:
         {"clauses_data_base_addr", "Base address for clauses data memory", "0x50000000"},
         {"watch_nodes_base_addr", "Base address for watch nodes memory", "0x60000000"},
         {"var_act_base_addr", "Base address for variable activity memory", "0x70000000"},
+        {"address_layout", "Mapping of the solver-side structures to physical addresses: linear, interleave (consecutive layout_interleave chunks go to consecutive stripes) or hash (interleave, XORed with the higher address bits); the heap structures are never remapped", "linear"},
+        {"layout_stripes", "Channel/bank stripes of the memory's address mapping (power of two, 1 = no remapping or colocation)", "1"},
+        {"layout_stripe_shift", "Lowest address bit of the stripe index in the memory's address mapping", "6"},
+        {"layout_interleave", "Interleave granularity in bytes, then optional region:bytes overrides, e.g. 256,clauses:64 (regions: variables, watches, watch_nodes, clauses_cmd, clauses)", "64"},
+        {"layout_colocate_watches", "Allocate each watcher block in the stripe of the clause of its first watcher (needs layout_stripes > 1)", "false"},
         {"prefetch_enabled", "Enable prefetching", "false"},
+        {"prefetch_chase", "Let the prefetcher chase watch lists from the links the solver reads (needs prefetch_enabled)", "false"},
+        {"prefetch_lookahead", "Upcoming trail literals whose watch lists are chased ahead of propagation", "2"},
         {"enable_speculative", "Enable speculative propagation", "false"},
+        {"spec_depth", "Upcoming decisions speculated on, each on top of the ones before it (1-8)", "1"},
+        {"spec_reuse", "Enqueue the speculated implications of a decision that was speculated on, after checking their reasons against the real assignment", "false"},
         {"timeout_cycles", "Maximum solver cycles before timing out (0 = no timeout)", "0"},
+        {"clock_gating", "Unregister the solver and heap clocks while they wait on memory or heap responses", "true"},
         {"profile_2wl", "Enable 2WL clause-access reduction profiling (host-side; counts only original clauses)", "false"},
+        {"profile_mem", "Profile read latency, reads in flight and bytes moved per data structure (mem_* statistics)", "false"},
         {"profile_prop_timing", "Enable per-propagation timing breakdown (cycles_read_headptr/blocks/clauses/insert/polling and spec/normal metrics). Auto-enabled when enable_speculative=true.", "false"},
         {"trace_file", "Path to binary memory-access trace. Empty disables tracing.", ""},
-        {"trace_buffer_bytes", "Ring buffer size for trace writer (bytes).", "4194304"},
+        {"trace_buffer_bytes", "Size of each of the trace writer's two buffers (bytes), also the raw size of a trace block.", "4194304"},
+        {"trace_compression", "Trace block compression: zlib or none.", "zlib"},
+        {"trace_compression_level", "zlib level (1-9) of trace blocks.", "1"},
+        {"para_lits", "Number of literals propagated in parallel", "1"},
+        {"propagators", "Number of watchers propagated in parallel (watcher block width, 1-8)", "1"},
+        {"learners", "Number of parallel learners for conflict analysis", "1"},
+        {"minimizers", "Number of parallel clause minimizers", "1"},
+        {"heaplanes", "Number of heap lanes: parallel workers in the classic heap, concurrent bumps and requests accepted per cycle in the pipelined heap", "1"},
+        {"pre_watchers", "Number of pre-watchers stored in watch metadata (0-propagators)", "0"},
+        {"var_layout", "Assignment memory: split (16-byte level/reason records, values free), packed (8-byte value/level/reason records) or soa (value array + 8-byte level/reason records); packed and soa make value checks reads", "split"},
+        {"store_queue_depth", "Store queue entries per data structure before reads stall (0 = unbounded)", "0"},
+        {"clause_placement", "Clause placement: packed, line (one-line clauses never straddle two lines), head (nor the size/activity/watched-literal head of longer ones) or split (head placement; propagation reads the tail only when the first watched literal is not true)", "packed"},
+        {"gc_compact", "Compact the learnt clause region during DB reductions", "false"},
+        {"gc_interval", "Compact on every Nth DB reduction", "1"},
+        {"gc_order", "Order of the compacted learnts: activity (most active first) or address", "activity"},
+        {"watch_compact_lists", "Sparse watch lists merged into fewer blocks per DB reduction, at most (0 = no watch list compaction)", "0"},
+        {"binary_watchers", "Propagate binary clauses from their watchers without fetching the clause", "false"},
+        {"reduce_unit", "Reduce the learnt DB with the streaming reduction unit (false = comparator sort reading memory)", "false"},
+        {"reducers", "Parallel read streams of the reduction unit", "4"},
+        {"reduce_select", "Removal-set selection of the reduction unit: median (radix select) or bitonic (sort network)", "median"},
+        {"reduce_width", "Key comparisons per cycle of the reduction unit", "16"},
+        {"learnt_tiers", "Keep learnts in core/mid/local tiers by LBD and only reduce the local tier (needs reduce_unit)", "false"},
+        {"tier_core_lbd", "Largest LBD of a core tier learnt", "2"},
+        {"tier_mid_lbd", "Largest LBD of a mid tier learnt", "6"},
+        {"tier_core_bytes", "Bytes of the learnt region reserved for core tier clauses (0 = no separate region)", "0"},
+        {"tier_mid_bytes", "Bytes of the learnt region reserved for mid tier clauses (0 = no separate region)", "0"},
+        {"fast_forward_conflicts", "Run functionally (solver memory untimed, heap timed; serial workers only) until this many conflicts (0 = no limit)", "0"},
+        {"fast_forward_decisions", "Run functionally (solver memory untimed, heap timed; serial workers only) until this many decisions (0 = no limit)", "0"},
+        {"sample_interval", "Sampled simulation: conflicts per sampling period (0 = off); the rest of a period runs functionally", "0"},
+        {"sample_warmup", "Timed conflicts that warm the caches before each measured window", "1000"},
+        {"sample_detail", "Measured timed conflicts per sampling period", "1000"},
+        {"portfolio_id", "Index of this solver in a portfolio, reported to the peers", "0"},
+        {"share_max_lbd", "Learnts with at most this LBD are sent to the peers (0 = none by LBD)", "2"},
+        {"share_max_size", "Learnts with at most this many literals are sent to the peers (0 = none by size)", "2"},
+        {"share_bytes_per_cycle", "Bandwidth of each share link in bytes per cycle (0 = unlimited)", "0"},
+        {"share_queue", "Received clauses buffered until the next restart; older ones are dropped", "4096"},
     )
 
     SST_ELI_DOCUMENT_STATISTICS(
@@ -101,23 +154,65 @@ public:
         {"para_vars", "Number of variables processed per unitPropagate before conflict", "count", 1},
         {"spec_started", "Total literals started in speculative propagation", "count", 1},
         {"spec_finished", "Total literals finished in speculative propagation", "count", 1},
+        {"spec_depth_started", "Speculative contexts started (subId: depth d0, d1, ...)", "count", 1},
+        {"spec_depth_hits", "Speculated literals that became the next decision (subId: depth first speculated at)", "count", 1},
+        {"spec_depth_dropped", "Speculated literals dropped or assigned before their decision (subId: depth first speculated at)", "count", 1},
+        {"spec_depth_lines", "Cache lines brought in by speculation (subId: depth the literal was first speculated at)", "lines", 1},
+        {"spec_wasted_lines", "Cache lines brought in for dropped speculated literals (subId: depth first speculated at)", "lines", 1},
+        {"spec_adopted", "Speculated implications enqueued at their decision (spec_reuse)", "count", 1},
+        {"spec_rejected", "Speculated implications whose reason no longer held at their decision (spec_reuse)", "count", 1},
         {"total_occ", "Sum of occurrence list sizes per propagation", "count", 1},
         {"watcher_traversed", "Sum of watchers traversed per propagation", "count", 1},
         {"learnt_length", "Total length of learnt clauses", "count", 1},
         {"learnt_units", "Number of unit-literal learnt clauses", "count", 1},
         {"learnt_lbd", "Total LBD of learnt clauses", "count", 1},
         {"bt_level", "Total backtrack level", "count", 1},
+        {"sq_forwards", "Reads forwarded from the store queues", "count", 1},
+        {"sq_full_stalls", "Reads stalled on a full store queue", "count", 1},
+        {"sq_full_writes", "Writes pushed into a full store queue (writes do not stall)", "count", 1},
+        {"mem_read_latency", "Cycles from issue to response per read request (subId: data structure), with profile_mem", "cycles", 1},
+        {"mem_outstanding", "Reads in flight at each read issue, including it (subId: data structure), with profile_mem", "requests", 1},
+        {"mem_read_bytes", "Bytes read from memory (subId: data structure), with profile_mem", "bytes", 1},
+        {"mem_write_bytes", "Bytes written to memory (subId: data structure), with profile_mem", "bytes", 1},
+        {"mem_busy_cycles", "Cycles with at least one read in flight (subId: data structure), with profile_mem", "cycles", 1},
+        {"value_reads", "Variable value reads by propagation (var_layout packed or soa)", "count", 1},
+        {"clause_reads", "Clause reads (subId: literal range of the size class)", "count", 1},
+        {"clause_read_lines", "Cache lines touched by clause reads (subId: literal range of the size class)", "lines", 1},
+        {"clause_min_lines", "Fewest cache lines the clauses read could occupy (subId: literal range of the size class)", "lines", 1},
+        {"gc_compactions", "Number of learnt region compactions", "count", 1},
+        {"gc_moved", "Number of learnt clauses relocated by compaction", "count", 1},
+        {"watch_chain_blocks", "Watcher blocks read by propagation", "count", 1},
+        {"watch_chain_watchers", "Valid watchers found in the watcher blocks read by propagation", "count", 1},
+        {"watch_compactions", "Watch lists merged into fewer blocks during DB reductions", "count", 1},
+        {"watch_blocks_freed", "Watcher blocks freed by watch list compaction", "count", 1},
+        {"watch_blocks_colocated", "Watcher blocks allocated in the stripe of their first clause (layout_colocate_watches)", "count", 1},
+        {"layout_stripe_reads", "Solver-side reads sent to memory per stripe (subId: s0, s1, ...; layout_stripes > 1)", "count", 1},
+        {"layout_stripe_writes", "Solver-side writes sent to memory per stripe (subId: s0, s1, ...; layout_stripes > 1)", "count", 1},
+        {"reduce_cycles", "Cycles spent per DB reduction", "cycles", 1},
+        {"reduce_stream_bytes", "Bytes streamed into the reduction unit", "count", 1},
+        {"reduce_select_cycles", "Modeled removal-set selection cycles of the reduction unit", "count", 1},
+        {"reduce_watch_lists", "Watch lists walked to detach removed clauses", "count", 1},
+        {"tier_promoted", "Learnts moved to a higher tier after their LBD dropped", "count", 1},
+        {"tier_demoted", "Mid tier learnts moved to the local tier for going unused", "count", 1},
+        {"share_exported", "Learnt clauses sent to the portfolio peers (once per peer)", "count", 1},
+        {"share_imported", "Clauses from peers added to the clause DB or the trail", "count", 1},
+        {"share_dropped", "Clauses from peers dropped because the receive queue overflowed", "count", 1},
+        {"share_satisfied", "Clauses from peers skipped at import because level 0 satisfies them", "count", 1},
+        {"share_bytes", "Bytes sent over the share links", "bytes", 1},
     )
 
     SST_ELI_DOCUMENT_PORTS(
         {"global_mem_link", "Connection to global memory", {"memHierarchy.MemEventBase"}},
         {"heap_port", "Link to external heap subcomponent", {"sst.Event"}},
-        {"prefetch_port", "Port to send prefetch requests", {"SST::Event"}}
+        {"prefetch_port", "Port to send prefetch requests", {"SST::Event"}},
+        {"share_port_%(portnum)d", "Links to the other solvers of a portfolio, numbered from 0", {"ShareClauseEvent"}},
+        {"profile_port_%(portnum)d", "Phase change notifications for CacheProfilers, numbered from 0", {"SolverPhaseEvent"}}
     )
     
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
         {"global_memory", "Memory interface for Heap and Variables", "SST::Interfaces::StandardMem"},
-        {"order_heap", "ordered heap for VSIDS", "Heap"}
+        {"order_heap", "ordered heap for VSIDS", "Heap"},
+        {"clause_scratchpad", "Optional scratchpad in front of the clause data", "ClauseScratchpad"}
     )
 
     // Component Lifecycle Methods
@@ -133,6 +228,10 @@ public:
     void handleCnfMemEvent(SST::Interfaces::StandardMem::Request* req);
     void handleGlobalMemEvent(SST::Interfaces::StandardMem::Request* req);
     void handleHeapResponse(SST::Event* ev);
+    void activateWorker(int worker_id);
+    void stepWorkers(std::vector<coro_t::pull_type*>& coroutines,
+                     std::vector<coro_t::push_type*>& yield_ptrs,
+                     ReadyQueue& rq, coro_t::push_type* parent_yield_ptr);
 
     // Top level FSM
     bool clockTick(SST::Cycle_t currentCycle);
@@ -147,6 +246,7 @@ public:
     
     // Input Processing
     void parseDIMACS(const std::string& filename);
+    void loadParsedCnf(ParsedCnf& cnf);
     
     // Core CDCL Algorithm
     void initialize();
@@ -162,6 +262,8 @@ public:
                            int lit_worker_id, int worker_id,
                            uint64_t& read_clauses_cycles, uint64_t& insert_watchers_cycles, 
                            uint64_t& polling_cycles);
+    void propagateBinary(Lit not_p, const WatcherNode& node, int lit_worker_id);
+    void readClauseRef(Cref ref, Lit implied, Clause& out, int worker_id = 0);
     void analyze(Cref conflict, int worker_id = 0);
     void findBtLevel();
     void backtrack(int backtrack_level);
@@ -178,15 +280,26 @@ public:
     // Decision Heuristics
     Lit chooseBranchVariable();
     Lit peekBranchVariable();
-    void insertVarOrder(Var v);   // Insert variable into order heap
+    void insertVarOrder(Var v, bool batched = false);   // Insert variable into order heap
+    void flushVarOrder();         // Send the batched inserts
     void varDecayActivity();       // Decay all variable activities
     void varBumpActivity(Var v);   // Bump a variable's activity
     
     // Clause Activity
     void claDecayActivity();
     void claBumpActivity(Cref clause_addr, float act);
+    int tierOf(int lbd) const;
+    void useLearnt(Cref clause_addr, const Clause& c, int lbd);
+    size_t rankTiers(const std::vector<Cref>& addrs, std::vector<ClauseSummary>& summary,
+                     std::vector<uint32_t>& order);
     void reduceDB();               // Reduce the learnt clause database
+    void reduceDBUnit();           // reduceDB on the streaming reduction unit
+    uint64_t selectCycles(const std::vector<uint32_t>& keys);
+    void busyCycles(uint64_t n);
     bool locked(Cref clause_addr);   // Check if clause is locked (reason for assignment)
+    bool locked(Cref clause_addr, Lit first);
+    void compactLearnts(std::vector<std::pair<Cref, float>>& survivors);
+    void compactWatchLists();      // merge sparse watch lists, up to watch_compact_lists
 
     // Clause Minimization
     void minimizeL2_sub(std::vector<bool>& redundant, int worker_id = 0);  // coroutine function
@@ -198,6 +311,14 @@ public:
     // Utility Functions
     inline bool value(Var v) { return var_value[v]; }
     inline bool value(Lit p) { return var_value[var(p)] ^ sign(p); }
+    // A value check of the propagation unit. With the values in memory
+    // (var_layout packed or soa) it first reads the value; the read yields,
+    // so var_assigned/var_value, which decide, are current once it is back.
+    inline void readValue(Var v, int worker_id) {
+        if (!variables.valuesInMemory()) return;
+        variables.readValue(v, worker_id);
+        stat_value_reads->addData(1);
+    }
     void ensureVarCapacity(Var v);
     double drand(uint64_t& seed);                  // Random number generator
     int irand(uint64_t& seed, int size);           // Integer random in range [0,size-1]
@@ -207,6 +328,7 @@ public:
     std::string printClause(const std::vector<Lit>& literals);
     void printHist(Statistic<uint64_t>* stat_hist);
     void loadDecisionSequence(const std::string& filename);  // user-defined decision sequence
+    void configureLayout(SST::Params& params);               // address_layout and layout_* params
     void dumpDecision(Lit lit);
 
 private:
@@ -219,11 +341,28 @@ private:
   
     // State Variables
     SolverState state, next_state, saved_state;
+    SolverConfig cfg;                  // Runtime parallelism configuration
     SST::Output output;
     SST::Interfaces::StandardMem* global_memory; // For heap and variables operations
     std::string dimacs_content;
     SST::Cycle_t currentCycle;
     uint64_t timeout_cycles;           // timeout parameter, 0 means no timeout
+    SST::Link* timeout_link;           // self link delivering the timeout
+    bool timed_out;
+    void handleTimeout(SST::Event* ev);
+
+    // Clock gating: the tick handler unregisters while the FSM is IDLE (every
+    // worker waits on a response) and the next response re-registers it.
+    // Cycle numbers stay absolute, so state accounting is unaffected.
+    SST::TimeConverter* clock_tc;
+    SST::Clock::HandlerBase* clock_handler;
+    bool clock_gating;                 // gating enabled
+    bool clock_gated;                  // handler currently unregistered
+    bool clock_resumed;                // first tick after re-registering
+    SST::Cycle_t gated_at;             // last tick before the handler was removed
+    uint64_t gated_cycles;             // ticks skipped while gated
+    void wakeClock();
+    bool sleepClock(SST::Cycle_t cycle);
     int heap_resp;
 
     // Parsing state
@@ -231,8 +370,10 @@ private:
     uint32_t num_vars;
     uint32_t num_clauses;
     bool sort_clauses;
+    int parse_threads;                 // CNF parser threads (0 = auto)
+    std::string cnf_cache_dir;         // Parsed-CNF cache directory (empty = off)
     std::vector<Lit> initial_units;             // Initial unit clauses from DIMACS
-    std::vector<Clause> parsed_clauses;         // Temporary storage during parsing
+    ClausePool parsed_clauses;                  // Original clauses, released after init
     
     // SAT solver state
     Clauses clauses;                    // all clauses stored in external memory
@@ -246,12 +387,16 @@ private:
     
     // Clause learning
     std::vector<Cref> conflicts;                // Conflict clauses from propagation
+    struct BinaryConflict { Cref addr; Lit a, b; };
+    std::vector<BinaryConflict> binary_conflicts;  // conflicts found by binary watchers, see binaryConflictRef
     std::vector<Lit> learnt_clause;             // Learnt clause from conflict analysis
     int bt_level;                               // Backtrack level from conflict analysis
     int learnt_lbd;                             // LBD of learnt clause from conflict analysis
     std::vector<char> seen;                     // Temporary array for conflict analysis
     std::vector<Cref> c_to_bump;
+    std::vector<int> c_to_bump_lbd;             // LBD of each c_to_bump clause in this conflict
     std::vector<Var> v_to_bump;
+    std::vector<Var> heap_batch;        // inserts collected during backtrack
 
     // Clause minimization
     int ccmin_mode;                             // Conflict clause minimization mode
@@ -296,6 +441,11 @@ private:
     uint64_t clauses_base_addr;         // Base address for clauses
     uint64_t clauses_cmd_base_addr;  // Base address for clause offsets
 
+    // Region table of all structures and the physical mapping of the
+    // solver-side ones; responses go to the owner of their region
+    AddressLayout address_layout;
+    AsyncBase* region_owner[TraceWriter::DS_COUNT];  // null: the heap's
+
     // DB reduction parameters
     double learntsize_factor;
     double learntsize_inc;
@@ -304,6 +454,19 @@ private:
     double learnt_adjust_inc;
     double learnt_adjust_confl;
     int learnt_adjust_cnt;
+    bool gc_compact;                    // compact the learnt region instead of freeing clauses
+    int gc_interval;                    // compact on every Nth reduction
+    bool gc_by_activity;                // compacted order: activity (true) or address
+    int reductions_since_gc;
+    bool binary_watchers;               // binary clauses propagate from the watcher alone
+    int watch_compact_lists;            // sparse lists compacted per reduction
+    bool reduce_unit;                   // stream the learnt DB once instead of sorting in memory
+    bool reduce_bitonic;                // selection model: bitonic sort (true) or radix select
+    int reduce_width;                   // comparisons per cycle
+    bool learnt_tiers;                  // core/mid/local learnt tiers, only local is reduced
+    int tier_core_lbd;
+    int tier_mid_lbd;
+    uint64_t tier_kept[TIER_LOCAL + 1]; // survivors per tier at the last reduction
 
     // Restart parameters
     bool luby_restart;                  // Whether to use Luby sequence for restarts
@@ -323,13 +486,35 @@ private:
 
     // simulating parallel execution support
     ReorderBuffer reorder_buffer;                   // Reorder buffer for managing parallel read requests
+    FiberPool fibers;                               // Pooled stacks for every solver coroutine
     coro_t::pull_type* coroutine;                   // coroutine in the top level FSM
     coro_t::push_type* yield_ptr;                   // current yield pointer
     bool main_active;
-    std::vector<bool> active_workers;               // Track completion of sub coroutines
-    std::vector<bool> polling;                      // Track workers in polling state
+    ReadyQueue ready_q;                             // Active / polling sub coroutines of the current phase
     std::unordered_set<Cref> clause_locks;          // Track locked clauses during parallel propagation
     WatchListQueue wl_q;                            // Track locked watchlists during parallel propagation
+    WaitQueue clause_waiters;                       // Workers sleeping on a locked clause
+    WaitQueue watch_waiters;                        // Workers sleeping on a busy / pending watch list
+    bool wake_pending;                              // Woken workers left for the next cycle
+
+    void unlockClause(Cref c) {
+        clause_locks.erase(c);
+        clause_waiters.wake(c, ready_q);
+    }
+    // Also wakes workers waiting for Watches::isBusy, the insertion is done
+    void unlockWatch(int watch_idx) {
+        wl_q.remove(watch_idx);
+        watch_waiters.wake(watch_idx, ready_q);
+    }
+    size_t sq_depth;                                // Store queue depth (0 = unbounded)
+    UntimedPreloader preloader;                     // Coalesces init-time untimed writes
+    std::deque<Clause> clause_scratch;              // Per-worker clause buffers, literal storage is reused
+
+    // deque keeps references held by suspended workers valid while it grows
+    Clause& scratchClause(int worker_id) {
+        if ((size_t)worker_id >= clause_scratch.size()) clause_scratch.resize(worker_id + 1);
+        return clause_scratch[worker_id];
+    }
 
 
     // Statistics
@@ -349,6 +534,16 @@ private:
     Statistic<uint64_t>* stat_para_vars;
     Statistic<uint64_t>* stat_spec_started;
     Statistic<uint64_t>* stat_spec_finished;
+    struct SpecDepthStats {
+        Statistic<uint64_t>* started;
+        Statistic<uint64_t>* hits;
+        Statistic<uint64_t>* dropped;
+        Statistic<uint64_t>* lines;
+        Statistic<uint64_t>* wasted_lines;
+    };
+    SpecDepthStats stat_spec_depth[MAX_SPEC_DEPTH];
+    Statistic<uint64_t>* stat_spec_adopted;
+    Statistic<uint64_t>* stat_spec_rejected;
     Statistic<uint64_t>* stat_total_occ;          // Accumulator: sum of occurrence list sizes per propagation
     Statistic<uint64_t>* stat_watcher_traversed;  // Accumulator: sum of watchers traversed per propagation
     Statistic<uint64_t>* stat_learnt_length;      // Accumulator: total length of learnt clauses
@@ -356,6 +551,51 @@ private:
     Statistic<uint64_t>* stat_learnt_lbd;         // Accumulator: total LBD of learnt clauses
     Statistic<uint64_t>* stat_bt_level;           // Accumulator: total backtrack level (destination level)
     Statistic<uint64_t>* stat_bt_distance;        // Accumulator: total backtrack distance (levels jumped)
+    Statistic<uint64_t>* stat_sq_forwards;        // Accumulator: store queue forward hits
+    Statistic<uint64_t>* stat_sq_full_stalls;     // Accumulator: reads stalled on a full store queue
+    Statistic<uint64_t>* stat_sq_full_writes;     // Accumulator: writes pushed past the store queue depth
+    Statistic<uint64_t>* stat_value_reads;        // Accumulator: value reads by propagation
+    Statistic<uint64_t>* stat_gc_compactions;
+    Statistic<uint64_t>* stat_gc_moved;
+    Statistic<uint64_t>* stat_chain_blocks;
+    Statistic<uint64_t>* stat_chain_watchers;
+    Statistic<uint64_t>* stat_watch_compactions;
+    Statistic<uint64_t>* stat_watch_blocks_freed;
+    Statistic<uint64_t>* stat_watch_colocated;
+    std::vector<Statistic<uint64_t>*> stat_stripe_reads;
+    std::vector<Statistic<uint64_t>*> stat_stripe_writes;
+
+    // Memory profiles (profile_mem): variables, watches, clauses, and the
+    // heap's activity array, in that order
+    static const int MEM_PROFILED = 4;
+    struct MemProfileStats {
+        Statistic<uint64_t>* read_latency;
+        Statistic<uint64_t>* outstanding;
+        Statistic<uint64_t>* read_bytes;
+        Statistic<uint64_t>* write_bytes;
+        Statistic<uint64_t>* busy_cycles;
+    };
+    MemProfileStats stat_mem[MEM_PROFILED];
+    bool profile_mem;
+    // Clause reads by allocator size class: reads, lines touched, fewest
+    // lines possible (see Clauses::LineStats)
+    struct ClauseLineStats {
+        Statistic<uint64_t>* reads;
+        Statistic<uint64_t>* lines;
+        Statistic<uint64_t>* min_lines;
+    };
+    ClauseLineStats stat_clause_lines[NUM_SIZE_CLASSES];
+    Statistic<uint64_t>* stat_reduce_cycles;
+    Statistic<uint64_t>* stat_reduce_bytes;
+    Statistic<uint64_t>* stat_reduce_select;
+    Statistic<uint64_t>* stat_reduce_lists;
+    Statistic<uint64_t>* stat_tier_promoted;
+    Statistic<uint64_t>* stat_tier_demoted;
+    Statistic<uint64_t>* stat_share_exported;
+    Statistic<uint64_t>* stat_share_imported;
+    Statistic<uint64_t>* stat_share_dropped;
+    Statistic<uint64_t>* stat_share_satisfied;
+    Statistic<uint64_t>* stat_share_bytes;
 
     std::vector<uint32_t> lit_occ_count;          // Precomputed occurrence count per literal index
 
@@ -396,8 +636,77 @@ private:
 
     // Prefetch support
     bool prefetch_enabled;
+    bool prefetch_chase;                // hand watch-list traversal to the prefetch engine
+    int prefetch_lookahead;
+    size_t prefetch_chased;             // trail entries whose watch lists were sent for chasing
     SST::Link* prefetch_link;
+    ClauseScratchpad* clause_scratchpad;  // null when no scratchpad is configured
+
+    // Functional fast-forward: variables, watches and clauses are served
+    // from host mirrors until a conflict or decision limit, then the mirrors
+    // are materialized into memory and timing starts. The order heap and
+    // the variable activities live in the heap subcomponent's memory, which
+    // is not mirrored: heap operations stay timed throughout, so its image
+    // never needs materializing and only the solver's own accesses are
+    // skipped. Only serial workers without speculation are accepted, the
+    // configurations where the result matches a fully timed run.
+    bool fast_forwarding;
+    uint64_t ff_conflicts;
+    uint64_t ff_decisions;
+    uint64_t conflicts_total;
+    uint64_t decisions_total;
+    SST::Cycle_t ff_switch_cycle;
+    uint64_t ff_materialized;
+    bool fastForwardDone() const {
+        return (ff_conflicts > 0 && conflicts_total >= ff_conflicts)
+            || (ff_decisions > 0 && decisions_total >= ff_decisions);
+    }
+    void endFastForward();
+    void setFunctionalMode(bool on);
+
+    // Sampled simulation. Each period of sample_interval conflicts runs
+    // functionally, then sample_warmup timed conflicts warm the caches and
+    // the last sample_detail conflicts are measured. Cycles per conflict of
+    // all measured windows together extrapolate the whole run. The first
+    // functional span is fast_forward_conflicts long if given.
+    enum SamplePhase { SAMPLE_FUNCTIONAL, SAMPLE_WARMUP, SAMPLE_DETAIL };
+    static const int SAMPLE_METRICS = 10;  // total cycles, then the per-state counters
+    uint64_t sample_interval;
+    uint64_t sample_warmup;
+    uint64_t sample_detail;
+    SamplePhase sample_phase;
+    uint64_t sample_next;                  // conflicts_total at the next phase change
+    uint64_t sample_start_conflicts;
+    uint64_t sample_start[SAMPLE_METRICS];
+    struct SampleWindow {
+        uint64_t conflicts;
+        uint64_t cycles[SAMPLE_METRICS];
+    };
+    std::vector<SampleWindow> samples;     // measured windows
+    void sampleMetrics(uint64_t* out);
+    void sampleStep();
+    void recordSample();
+    void printSampling();
+
+    // Portfolio clause sharing. Peers solve the same instance, so literals
+    // are exchanged as-is; imports wait for a restart, where they can be
+    // simplified against the level 0 assignment.
+    int portfolio_id;
+    int portfolio_winner;               // peer that finished first, -1 while racing
+    std::vector<SST::Link*> share_links;
+    std::vector<SST::Cycle_t> share_busy_until;  // serialization on each link
+    int share_max_lbd;
+    int share_max_size;
+    uint64_t share_bytes_per_cycle;
+    size_t share_queue;
+    std::deque<std::pair<std::vector<Lit>, int>> share_inbox;  // literals, LBD
+    void handleShareEvent(SST::Event* ev);
+    void sendShare(ShareClauseEvent* ev);
+    void exportLearnt(const std::vector<Lit>& lits, int lbd);
+    bool importShared();
     void issuePrefetch(uint64_t addr);
+    void chaseAhead();
+    void sendPrefetchLink(uint64_t addr, uint64_t next, const WatcherNode* nodes, int count);
 
     // 2WL clause-access reduction profiling (host-side, no simulated memory access)
     bool profile_2wl;
@@ -413,6 +722,10 @@ private:
     int32_t tracer_level_cache_ = -1;
     uint64_t tracer_events_at_tick_start_ = 0;
 
+    // CacheProfilers told about phase changes (profile_port_0, ...)
+    std::vector<SST::Link*> profile_links;
+    uint8_t profile_phase_cache_ = 0;
+
     // Propagation timing counters
     uint64_t cycles_read_headptr;        // Time spent reading head pointers
     uint64_t cycles_read_watcher_blocks; // Time spent reading watcher blocks
@@ -437,7 +750,23 @@ private:
 
     // Speculative Propagation
     bool enable_speculative;
-    Lit spec_literal;                    // Next decision literal for speculative propagation
+    // Next decisions to speculate on, nearest first; literal d is
+    // speculated on top of literals 0..d-1 (spec_depth of them)
+    struct SpecLit {
+        Lit lit;
+        int depth;                       // depth it was first speculated at
+        uint64_t lines;                  // cache lines its contexts brought in
+    };
+    std::vector<SpecLit> spec_literals;
+    int spec_depth;
+    bool spec_reuse;                     // adopt the implications of a matching decision
+    bool spec_reusable;                  // the trail of the last round may still be adopted
+    std::vector<size_t> spec_lim;        // spec_trail index of each depth's decision
+    std::vector<Cref> spec_reason;       // reason of each spec_trail entry (spec_reuse)
+    std::vector<uint32_t> spec_reason_end;  // end of its literals in spec_reason_lits
+    std::vector<Lit> spec_reason_lits;
+    int spec_open_depth;                 // depth being speculated, -1 when none
+    uint64_t spec_depth_mark;            // cache lines of the round when it began
     bool spec_active;                    // Whether speculative propagation is active
     std::vector<Lit> spec_trail;         // Temporary trail for speculative assignments
     std::vector<bool> spec_var_assigned; // Temporary assignments for speculative propagation
@@ -449,13 +778,20 @@ private:
     int spec_conflicts;                  // Number of conflicts in speculative propagation
     coro_t::pull_type* spec_coroutine;   // Coroutine for speculative propagation
     coro_t::push_type* spec_yield_ptr;   // current yield pointer
-    std::vector<bool> spec_active_workers; // Track completion of spec propagation workers
+    ReadyQueue spec_ready_q;             // Active spec propagation workers
     std::vector<coro_t::pull_type*> spec_sub_coroutines;
     std::vector<coro_t::push_type*> spec_sub_yield_ptrs;
 
     // Speculative propagation methods
-    void terminateSpecPropagate();
+    void terminateSpecPropagate(bool keep_round = false);
     void speculativePropagate();
+    void speculateDepth(uint& spec_qhead, uint64_t& cache_lines_read);
+    void specEnqueue(Lit p, Cref reason, const Lit* lits, size_t n);
+    void closeSpecDepth();
+    bool isSpecLiteral(Var v) const;
+    void dropSpecLiterals();
+    void refillSpecLiterals();
+    void adoptSpecImplications(Lit decision);
     void resetSpecState();
     bool isSpecAssigned(Var v) const;
     bool getSpecValue(Var v) const;
@@ -0,0 +1,193 @@
+#ifndef STORE_QUEUE_H
+#define STORE_QUEUE_H
+
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+#include "line_buffer_pool.h"
+
+// Bounded store queue for Write->Read forwarding.
+// Entries are kept in program order and retire when the memory system acks
+// the write (matched by request ID). Forwarding lookups only visit entries
+// that touch the cache lines of the read, via a per-line index.
+// Entry data lives in pooled line-sized buffers. depth == 0 means unbounded.
+// Only reads stall on a full queue (their worker is known); a write pushed
+// past the depth is counted in full_writes.
+class StoreQueue {
+public:
+    StoreQueue() : line_size(64), depth(0), base_seq(0), live(0),
+                   forward_hits(0), full_stalls(0), full_writes(0), max_occupancy(0) {}
+
+    void setLineSize(size_t size) { assert(live == 0); line_size = size; pool.setBufferSize(size); }
+    void setDepth(size_t d) { depth = d; }
+    size_t getDepth() const { return depth; }
+    size_t occupancy() const { return live; }
+    bool full() const { return depth > 0 && live >= depth; }
+
+    void push(uint64_t addr, size_t size, const uint8_t* data, uint64_t req_id) {
+        if (full()) full_writes++;
+        uint64_t seq = base_seq + entries.size();
+        entries.emplace_back();
+        Entry& e = entries.back();
+        e.addr = addr;
+        e.size = size;
+        e.req_id = req_id;
+        e.live = true;
+        e.data = pool.alloc(size);  // oversized writes get their own buffer
+        memcpy(e.data, data, size);
+        req_to_seq[req_id] = seq;
+        for (uint64_t line = firstLine(addr); line <= lastLine(addr, size); line++) {
+            line_index[line].push_back(seq);
+        }
+        live++;
+        max_occupancy = std::max(max_occupancy, (uint64_t)live);
+    }
+
+    // Retire the entry of an acked write. Returns false if nothing matched.
+    bool retire(uint64_t req_id, uint64_t addr) {
+        uint64_t seq;
+        auto it = req_to_seq.find(req_id);
+        if (it != req_to_seq.end()) {
+            seq = it->second;
+            req_to_seq.erase(it);
+        } else if (!findOldestByAddr(addr, seq)) {
+            return false;
+        } else {
+            req_to_seq.erase(entry(seq).req_id);
+        }
+
+        Entry& e = entry(seq);
+        for (uint64_t line = firstLine(e.addr); line <= lastLine(e.addr, e.size); line++) {
+            auto lit = line_index.find(line);
+            assert(lit != line_index.end());
+            auto& seqs = lit->second;
+            seqs.erase(std::find(seqs.begin(), seqs.end(), seq));
+            if (seqs.empty()) line_index.erase(lit);
+        }
+        e.live = false;
+        pool.release(e.data, e.size);
+        e.data = nullptr;
+        live--;
+
+        // drop retired entries from the head so seq -> index stays O(1)
+        while (!entries.empty() && !entries.front().live) {
+            entries.pop_front();
+            base_seq++;
+        }
+        return true;
+    }
+
+    // Try to forward [addr, addr+size) from the store queue.
+    // Conservative: forwards iff some single entry fully covers the read.
+    // When a covering entry exists, newer overlapping entries are merged on
+    // top so the returned data is never stale.
+    // out_data must have room for size bytes and is only written on success.
+    bool forward(uint64_t addr, size_t size, uint8_t* out_data) {
+        if (live == 0) return false;
+        uint64_t read_end = addr + size;
+
+        const std::vector<uint64_t>* cands = nullptr;
+        uint64_t first = firstLine(addr), last = lastLine(addr, size);
+        if (first == last) {
+            auto lit = line_index.find(first);
+            if (lit == line_index.end()) return false;
+            cands = &lit->second;
+        } else {
+            scratch.clear();
+            for (uint64_t line = first; line <= last; line++) {
+                auto lit = line_index.find(line);
+                if (lit == line_index.end()) continue;
+                scratch.insert(scratch.end(), lit->second.begin(), lit->second.end());
+            }
+            std::sort(scratch.begin(), scratch.end());
+            scratch.erase(std::unique(scratch.begin(), scratch.end()), scratch.end());
+            cands = &scratch;
+        }
+
+        // Newest->oldest: find the first covering entry, while remembering
+        // whether any newer entry partially overlapped our read range.
+        bool saw_overlap = false;
+        int cov = -1;
+        for (int i = (int)cands->size() - 1; i >= 0; i--) {
+            const Entry& e = entry((*cands)[i]);
+            uint64_t sq_end = e.addr + e.size;
+            if (addr >= e.addr && read_end <= sq_end) { cov = i; break; }
+            if (std::max(addr, e.addr) < std::min(read_end, sq_end)) saw_overlap = true;
+        }
+        if (cov < 0) return false;
+
+        const Entry& base = entry((*cands)[cov]);
+        memcpy(out_data, base.data + (addr - base.addr), size);
+        forward_hits++;
+        if (!saw_overlap) return true;
+
+        // Slow path: overlay newer overlapping entries on top, newest-wins.
+        written.assign(size, 0);
+        for (int j = (int)cands->size() - 1; j > cov; j--) {
+            const Entry& e = entry((*cands)[j]);
+            uint64_t os = std::max(addr, e.addr);
+            uint64_t oe = std::min(read_end, e.addr + e.size);
+            for (uint64_t b = os; b < oe; b++) {
+                size_t dst = b - addr;
+                if (!written[dst]) {
+                    out_data[dst] = e.data[b - e.addr];
+                    written[dst] = true;
+                }
+            }
+        }
+        return true;
+    }
+
+    void countStall() { full_stalls++; }
+
+    uint64_t getForwardHits() const { return forward_hits; }
+    uint64_t getFullStalls() const { return full_stalls; }
+    uint64_t getFullWrites() const { return full_writes; }
+    uint64_t getMaxOccupancy() const { return max_occupancy; }
+
+private:
+    struct Entry {
+        uint64_t addr;
+        size_t size;
+        uint8_t* data;             // from the pool, which heap-allocates oversized writes
+        uint64_t req_id;
+        bool live;
+        Entry() : addr(0), size(0), data(nullptr), req_id(0), live(false) {}
+    };
+
+    uint64_t firstLine(uint64_t addr) const { return addr / line_size; }
+    uint64_t lastLine(uint64_t addr, size_t size) const { return (addr + size - 1) / line_size; }
+    Entry& entry(uint64_t seq) { return entries[seq - base_seq]; }
+
+    bool findOldestByAddr(uint64_t addr, uint64_t& seq) {
+        auto lit = line_index.find(firstLine(addr));
+        if (lit == line_index.end()) return false;
+        for (uint64_t s : lit->second) {
+            if (entry(s).addr == addr) { seq = s; return true; }
+        }
+        return false;
+    }
+
+    size_t line_size;
+    size_t depth;
+    std::deque<Entry> entries;        // program order, head may be retired lazily
+    uint64_t base_seq;                // seq of entries.front()
+    size_t live;                      // entries not yet acked
+    std::unordered_map<uint64_t, std::vector<uint64_t>> line_index;  // line -> seqs (oldest first)
+    std::unordered_map<uint64_t, uint64_t> req_to_seq;              // write req ID -> seq
+    std::vector<uint64_t> scratch;    // candidate merge for multi-line reads
+    std::vector<uint8_t> written;     // byte mask for the overlay slow path
+    LineBufferPool pool;              // entry data buffers
+
+    // statistics
+    uint64_t forward_hits;
+    uint64_t full_stalls;
+    uint64_t full_writes;
+    uint64_t max_occupancy;
+};
+
+#endif // STORE_QUEUE_H
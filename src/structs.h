@@ -4,44 +4,57 @@
 #include <boost/coroutine2/all.hpp>
 #include <vector>
 #include <cstddef>
+#include <algorithm>
 
 using coro_t = boost::coroutines2::coroutine<void>;
 
-// const int PARA_LITS = 8;  // Number of parallel literals to propagate
-// const int PROPAGATORS = 7;  // Number of watchers to propagate
 // const int MAX_CONFL = 8;  // Maximum number of learned clauses
-// const int LEARNERS = 8;  // Number of learners for clause learning
-// const int HEAPLANES = 8;  // Number of heap lanes for parallel execution
-// const int MINIMIZERS = 4;  // Number of minimizers
 // const bool OVERLAP_HEAP_INSERT = true;  // overlaps heap insertions (backtracking) with propagation
 // const bool OVERLAP_HEAP_BUMP = true;  // overlaps heap bumping with clause minimization and find bt level
 // const bool WRITE_BUFFER = true;  // enables write request buffering for improved performance
-// const int PRE_WATCHERS = 7;  // Number of pre-watchers to store in metadata
 // const int USE_FREE_LIST = 1;  // Use free list for watcher insertion
 
-const int PARA_LITS = 1;  // Number of parallel literals to propagate
-const int PROPAGATORS = 1;  // Number of watchers to propagate
+// Parallelism widths are SATSolver params (see SolverConfig below); the
+// compile-time constants that remain here are feature switches.
 const int MAX_CONFL = 1;  // Maximum number of learned clauses
-const int LEARNERS = 1;  // Number of learners for clause learning
-const int HEAPLANES = 1;  // Number of heap lanes for parallel execution
-const int MINIMIZERS = 1;  // Number of minimizers
 const bool OVERLAP_HEAP_INSERT = true;  // overlaps heap insertions (backtracking) with propagation
 const bool OVERLAP_HEAP_BUMP = true;  // overlaps heap bumping with clause minimization and find bt level
 const bool WRITE_BUFFER = true;  // enables write request buffering for improved performance
-const int PRE_WATCHERS = 0;  // Number of pre-watchers to store in metadata
 const int USE_FREE_LIST = 0;  // Use free list for watcher insertion
 
-// helpers
-const int FREE_IDX_BITS = pow(2, ceil(log(PROPAGATORS)/log(2)));  // next power of 2
+// Upper bounds for the runtime widths; they size the inline node arrays of
+// WatcherBlock/WatchMetaData, the on-memory layout only uses the runtime width.
+const int MAX_PROPAGATORS = 8;
+const int MAX_PRE_WATCHERS = 8;
+// Deepest speculation chain (spec_depth param)
+const int MAX_SPEC_DEPTH = 8;
 
-// Base worker_id for speculative-propagation workers. Must be strictly greater
-// than every worker_id that a main-side phase (unitPropagate / execAnalyze /
-// execMinimize) can produce, otherwise handleGlobalMemEvent misroutes main
-// responses into the spec path.
-constexpr int SPEC_WORKER_BASE =
-    (PARA_LITS * PROPAGATORS > LEARNERS
-        ? (PARA_LITS * PROPAGATORS > MINIMIZERS ? PARA_LITS * PROPAGATORS : MINIMIZERS)
-        : (LEARNERS > MINIMIZERS ? LEARNERS : MINIMIZERS));
+// Runtime parallelism configuration, read from SATSolver params
+struct SolverConfig {
+    int para_lits;      // Number of parallel literals to propagate
+    int propagators;    // Number of watchers to propagate (watcher block width)
+    int learners;       // Number of learners for clause learning
+    int heaplanes;      // Number of heap lanes for parallel execution
+    int minimizers;     // Number of minimizers
+    int pre_watchers;   // Number of pre-watchers to store in metadata
+    int reducers;       // Number of streams of the DB reduction unit
+
+    // derived values, valid after finalize()
+    int free_idx_bits;     // next power of 2 of propagators
+    int spec_worker_base;  // base worker_id for speculative-propagation workers
+
+    SolverConfig() : para_lits(1), propagators(1), learners(1), heaplanes(1),
+                     minimizers(1), pre_watchers(0), reducers(1), free_idx_bits(1), spec_worker_base(1) {}
+
+    void finalize() {
+        free_idx_bits = 1;
+        while (free_idx_bits < propagators) free_idx_bits <<= 1;
+        // Must be strictly greater than every worker_id that a main-side phase
+        // (unitPropagate / execAnalyze / execMinimize / reduceDB) can produce, otherwise
+        // handleGlobalMemEvent misroutes main responses into the spec path.
+        spec_worker_base = std::max({para_lits * propagators, learners, minimizers, reducers});
+    }
+};
 
 // Define types for variables and literals
 typedef int Var;
@@ -60,18 +73,57 @@ struct Lit {
 };
 const Lit lit_Undef = { 0 }; // Special undefined literal
 
+// Assignment value of a variable in memory. Zeroed memory reads as
+// unassigned, so the value array needs no initialization.
+enum VarValue : uint8_t { VAL_UNDEF = 0, VAL_FALSE = 2, VAL_TRUE = 3 };
+
 struct Variable {
     size_t level;   // Decision level when variable was assigned
     Cref reason;     // Index of clause that caused this assignment
-    
-    Variable() : level(0), reason(ClauseRef_Undef) {}
+    uint8_t value;  // VarValue, only kept in memory by the packed layout
+
+    Variable() : level(0), reason(ClauseRef_Undef), value(VAL_UNDEF) {}
 };
 
+// 8-byte assignment record of the packed and soa variable layouts:
+// bits 0-1 value, 2-31 level, 32-63 reason. The soa layout keeps the value
+// in its own array and leaves bits 0-1 clear.
+const size_t PACKED_VAR_MAX_LEVEL = (1u << 30) - 1;
+inline uint64_t packVariable(const Variable& v) {
+    assert(v.level <= PACKED_VAR_MAX_LEVEL);
+    return (uint64_t)(v.value & 3) | ((uint64_t)v.level << 2) | ((uint64_t)(uint32_t)v.reason << 32);
+}
+inline Variable unpackVariable(uint64_t r) {
+    Variable v;
+    v.value = r & 3;
+    v.level = (r >> 2) & PACKED_VAR_MAX_LEVEL;
+    v.reason = (Cref)(uint32_t)(r >> 32);
+    return v;
+}
+
 const int CLAUSE_MEMBER_SIZE = 4;  // bytes, union of size of num_lits, activity, and Lit
+// The size word of a clause in memory also holds the learnt metadata:
+// bits 0-23 literal count, 24-28 LBD (saturated), 29-30 tier, 31 used since
+// the last reduction. Original clauses keep the upper bits clear.
+enum ClauseTier { TIER_NONE = 0, TIER_CORE = 1, TIER_MID = 2, TIER_LOCAL = 3 };
+const uint32_t CLAUSE_SIZE_MASK = 0x00FFFFFF;
+const int CLAUSE_MAX_LBD = 31;
+inline uint32_t clauseHeader(uint32_t num_lits, int lbd, int tier, bool used) {
+    assert(num_lits <= CLAUSE_SIZE_MASK);
+    return num_lits | ((uint32_t)std::min(lbd, CLAUSE_MAX_LBD) << 24) | ((uint32_t)tier << 29) | ((uint32_t)used << 31);
+}
+inline uint32_t headerLits(uint32_t h) { return h & CLAUSE_SIZE_MASK; }
+inline int headerLbd(uint32_t h) { return (h >> 24) & 0x1f; }
+inline int headerTier(uint32_t h) { return (h >> 29) & 0x3; }
+inline bool headerUsed(uint32_t h) { return (h >> 31) != 0; }
+
 struct Clause {
     uint32_t num_lits;  // Number of literals in the clause
     float activity;     // Activity score for the clause
     std::vector<Lit> literals;
+    uint8_t lbd = 0;    // learnt metadata, packed into the size word in memory
+    uint8_t tier = TIER_NONE;
+    bool used = false;
 
     Clause() : activity(0.0) {}
     
@@ -89,6 +141,65 @@ struct Clause {
     uint32_t size() const { return CLAUSE_MEMBER_SIZE * 2 + litSize() * sizeof(Lit); }
     float act() const { return activity; }
     Lit operator[] (size_t i) const { return literals[i]; }
+
+    uint32_t header() const { return clauseHeader(num_lits, lbd, tier, used); }
+    void setHeader(uint32_t h) {
+        num_lits = headerLits(h);
+        lbd = headerLbd(h);
+        tier = headerTier(h);
+        used = headerUsed(h);
+    }
+};
+
+// Clause placement policies (clause_placement param), each adds to the one
+// before it:
+//  PLACE_PACKED  blocks back to back
+//  PLACE_LINE    a clause that fits in a cache line does not straddle two
+//  PLACE_HEAD    nor does the head of a longer clause: size word, activity
+//                and the two watched literals
+//  PLACE_SPLIT   head placement, and propagation reads the head on its own
+//                and the tail only when the first watched literal is not true
+enum ClausePlacement { PLACE_PACKED, PLACE_LINE, PLACE_HEAD, PLACE_SPLIT };
+static const uint32_t CLAUSE_HEAD_BYTES = 4 * CLAUSE_MEMBER_SIZE;
+
+// Leading bytes of a clause body of `bytes` bytes that have to share a line
+inline uint32_t placementSpan(uint32_t bytes, ClausePlacement p, uint32_t line_size) {
+    if (p == PLACE_PACKED) return 0;
+    if (bytes <= line_size) return bytes;
+    return p >= PLACE_HEAD ? CLAUSE_HEAD_BYTES : 0;
+}
+
+// Bytes a clause body starting at address `at` moves up to meet the policy
+inline uint32_t placementPad(uint64_t at, uint32_t bytes, ClausePlacement p, uint32_t line_size) {
+    uint32_t span = placementSpan(bytes, p, line_size);
+    uint32_t off = at % line_size;
+    return (span == 0 || off + span <= line_size) ? 0 : line_size - off;
+}
+
+// Flat clause storage used during initialization: clause i is
+// lits[offsets[i], offsets[i+1]). One literal pool instead of a heap vector
+// per clause.
+struct ClausePool {
+    std::vector<uint64_t> offsets;
+    std::vector<Lit> lits;
+
+    ClausePool() : offsets(1, 0) {}
+
+    size_t size() const { return offsets.size() - 1; }
+    bool empty() const { return size() == 0; }
+    uint32_t litSize(size_t i) const { return offsets[i + 1] - offsets[i]; }
+    const Lit* lits_of(size_t i) const { return lits.data() + offsets[i]; }
+    // bytes of clause i in the simulated arena, same layout as Clause::size()
+    uint32_t bytes(size_t i) const { return CLAUSE_MEMBER_SIZE * 2 + litSize(i) * sizeof(Lit); }
+
+    void add(const Lit* l, size_t n) {
+        lits.insert(lits.end(), l, l + n);
+        offsets.push_back(lits.size());
+    }
+    void clear() {
+        std::vector<uint64_t>(1, 0).swap(offsets);
+        std::vector<Lit>().swap(lits);
+    }
 };
 
 // Store queue entry for Write->Read ordering
@@ -128,14 +239,18 @@ public:
     enum OpType { INSERT, REMOVE_MAX, READ, BUMP, DEBUG_HEAP };
     OpType op;
     int arg;
+    std::vector<Var> batch;     // INSERT/BUMP of several vars in one message, arg unused
     HeapReqEvent() : op(HeapReqEvent::INSERT), arg(0) {}
     HeapReqEvent(OpType o, int a = 0)
         : op(o), arg(a) {}
+    HeapReqEvent(OpType o, std::vector<Var> vars)
+        : op(o), arg(0), batch(std::move(vars)) {}
     
     void serialize_order(SST::Core::Serialization::serializer& ser) override {
         Event::serialize_order(ser);
         SST_SER(op);
         SST_SER(arg);
+        SST_SER(batch);
     }
     ImplementSerializable(HeapReqEvent);
 };
@@ -153,6 +268,48 @@ public:
     ImplementSerializable(HeapRespEvent);
 };
 
+// Message between the solvers of a portfolio.
+// CLAUSE carries a learnt clause (literals as Lit::x) for the peers to import
+// at their next restart; DONE tells them the sender has solved the instance.
+// Plain values only, so it can cross MPI ranks.
+class ShareClauseEvent : public SST::Event {
+public:
+    enum Type { CLAUSE, DONE };
+    Type type;
+    int src;        // portfolio_id of the sender
+    int lbd;
+    std::vector<int> lits;
+    ShareClauseEvent() : type(CLAUSE), src(0), lbd(0) {}
+    ShareClauseEvent(Type t, int src, int lbd = 0) : type(t), src(src), lbd(lbd) {}
+
+    // bytes on the wire: a word each for the header and every literal
+    size_t bytes() const { return (lits.size() + 1) * sizeof(int); }
+
+    void serialize_order(SST::Core::Serialization::serializer& ser) override {
+        Event::serialize_order(ser);
+        SST_SER(type);
+        SST_SER(src);
+        SST_SER(lbd);
+        SST_SER(lits);
+    }
+    ImplementSerializable(ShareClauseEvent);
+};
+
+// Solver FSM phase change (a SolverState value), sent on the profile ports
+// so cache profilers can attribute their accesses to the phase issuing them
+class SolverPhaseEvent : public SST::Event {
+public:
+    uint8_t phase;
+    SolverPhaseEvent() : phase(0) {}
+    explicit SolverPhaseEvent(uint8_t phase) : phase(phase) {}
+
+    void serialize_order(SST::Core::Serialization::serializer& ser) override {
+        Event::serialize_order(ser);
+        SST_SER(phase);
+    }
+    ImplementSerializable(SolverPhaseEvent);
+};
+
 // Helper functions for literals
 inline Lit mkLit(Var var, bool sign = false) { Lit p; p.x = var + var + (int)sign; return p; }
 inline Lit operator ~(Lit p) { Lit q; q.x = p.x ^ 1; return q; }
@@ -165,4 +322,15 @@ inline Lit toLit(int dimacs_lit) {
 inline int toInt(Lit p) { return sign(p) ? -var(p) : var(p); }
 inline int toWatchIndex(Lit p) { return p.x; }
 
+// Implicit clause references for binary watchers (see Watches::setBinaryWatchers).
+// Clause addresses are 4-byte aligned, so the low bits are free: a reason
+// ending in 1 names the other literal of a binary clause, and a conflict
+// ending in 2 indexes the solver's list of binary conflicts.
+inline bool isBinaryRef(Cref r) { return (r & 3) != 0; }
+inline Cref binaryReasonRef(Lit other) { return (other.x << 1) | 1; }
+inline Lit binaryReasonLit(Cref r) { Lit p; p.x = r >> 1; return p; }
+inline bool isBinaryConflict(Cref r) { return (r & 3) == 2; }
+inline Cref binaryConflictRef(size_t idx) { return (Cref)(idx << 2) | 2; }
+inline size_t binaryConflictIdx(Cref r) { return r >> 2; }
+
 #endif // structs_h
\ No newline at end of file
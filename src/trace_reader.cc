@@ -0,0 +1,712 @@
+#include "trace_reader.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+#include <zlib.h>
+
+namespace {
+
+uint32_t get_u32(const uint8_t* p) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= (uint32_t)p[i] << (8*i);
+    return v;
+}
+uint64_t get_u64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v |= (uint64_t)p[i] << (8*i);
+    return v;
+}
+
+// Bounds-checked LEB128; false if the varint runs past the end
+inline bool read_uvarint(const uint8_t*& p, const uint8_t* end, uint64_t& v) {
+    v = 0;
+    int shift = 0;
+    while (p < end && shift < 64) {
+        uint8_t b = *p++;
+        v |= (uint64_t)(b & 0x7f) << shift;
+        if ((b & 0x80) == 0) return true;
+        shift += 7;
+    }
+    return false;
+}
+inline bool read_svarint(const uint8_t*& p, const uint8_t* end, int64_t& v) {
+    uint64_t u;
+    if (!read_uvarint(p, end, u)) return false;
+    v = (int64_t)(u >> 1) ^ -(int64_t)(u & 1);
+    return true;
+}
+
+const uint32_t SIZE_CLASSES[7] = {1, 2, 4, 8, 16, 32, 64};
+
+// Fenwick tree over stream positions for LRU stack distances
+class Fenwick {
+public:
+    explicit Fenwick(size_t n) : t(n + 1, 0) {}
+    void add(size_t i, int32_t d) {
+        for (++i; i < t.size(); i += i & (~i + 1)) t[i] += d;
+    }
+    // sum of [0, i)
+    uint64_t prefix(size_t i) const {
+        uint64_t s = 0;
+        for (; i > 0; i -= i & (~i + 1)) s += t[i];
+        return s;
+    }
+private:
+    std::vector<uint32_t> t;
+};
+
+inline unsigned log2_bin(uint64_t d) {
+    return d == 0 ? 0 : 64 - (unsigned)__builtin_clzll(d);
+}
+
+} // namespace
+
+// Visitors
+
+struct TraceReader::MemVisitor {
+    uint64_t lo = 0, hi = UINT64_MAX;
+    MemColumns cols;
+
+    void mem(const State& st, bool is_write, uint8_t ds, uint64_t addr, uint32_t size) {
+        if (st.cycle < lo || st.cycle >= hi) return;
+        cols.cycle.push_back(st.cycle);
+        cols.addr.push_back(addr);
+        cols.conflict.push_back(st.conflicts);
+        cols.size.push_back(size);
+        cols.level.push_back(st.level);
+        cols.ds.push_back(ds);
+        cols.phase.push_back(st.phase);
+        cols.is_write.push_back(is_write ? 1 : 0);
+    }
+    void record(uint8_t, const State&) {}
+    void finish(uint64_t, uint64_t, uint32_t) {}
+    void stream(const uint8_t*, size_t) {}
+};
+
+struct TraceReader::SummaryVisitor {
+    Summary s;
+    uint32_t crc = 0;     // zlib convention: finalized CRC of the bytes so far
+    uint64_t len = 0;
+
+    SummaryVisitor() { std::memset(&s, 0, sizeof(s)); }
+
+    void mem(const State&, bool is_write, uint8_t ds, uint64_t, uint32_t size) {
+        s.tags[is_write ? TraceWriter::TAG_MEM_WRITE : TraceWriter::TAG_MEM_READ]++;
+        if (ds < DS_COUNT) s.ds_events[ds]++;
+        s.mem_bytes += size;
+    }
+    void record(uint8_t tag, const State& st) {
+        s.tags[tag]++;
+        if (tag == TraceWriter::TAG_PHASE) s.phases[st.phase]++;
+    }
+    void finish(uint64_t total_cycles, uint64_t events, uint32_t crc32) {
+        s.tags[TraceWriter::TAG_FINISH]++;
+        s.finished = true;
+        s.total_cycles = total_cycles;
+        s.events_written = events;
+        s.crc32 = crc32;
+    }
+    void stream(const uint8_t* p, size_t n) {
+        uint32_t c = (uint32_t)::crc32(0L, p, (uInt)n);
+        crc = (uint32_t)crc32_combine(crc, c, (z_off_t)n);
+        len += n;
+    }
+};
+
+// MemColumns
+
+void TraceReader::MemColumns::clear() {
+    cycle.clear(); addr.clear(); conflict.clear(); size.clear();
+    level.clear(); ds.clear(); phase.clear(); is_write.clear();
+}
+
+void TraceReader::MemColumns::append(const MemColumns& o) {
+    cycle.insert(cycle.end(), o.cycle.begin(), o.cycle.end());
+    addr.insert(addr.end(), o.addr.begin(), o.addr.end());
+    conflict.insert(conflict.end(), o.conflict.begin(), o.conflict.end());
+    size.insert(size.end(), o.size.begin(), o.size.end());
+    level.insert(level.end(), o.level.begin(), o.level.end());
+    ds.insert(ds.end(), o.ds.begin(), o.ds.end());
+    phase.insert(phase.end(), o.phase.begin(), o.phase.end());
+    is_write.insert(is_write.end(), o.is_write.begin(), o.is_write.end());
+}
+
+// Opening
+
+bool TraceReader::fail(const std::string& msg) {
+    error_ = path_ + ": " + msg;
+    return false;
+}
+
+bool TraceReader::open(const std::string& path) {
+    path_ = path;
+    header_.clear();
+    segments_.clear();
+    indexed_ = false;
+
+    FILE* fp = std::fopen(path.c_str(), "rb");
+    if (!fp) return fail("cannot open");
+
+    char magic[8];
+    if (std::fread(magic, 1, 8, fp) != 8 || std::memcmp(magic, "SSTSAT\0\0", 8) != 0) {
+        std::fclose(fp);
+        return fail("bad magic");
+    }
+    char line[4096];
+    bool terminated = false;
+    while (std::fgets(line, sizeof(line), fp)) {
+        if (std::strcmp(line, "---\n") == 0) { terminated = true; break; }
+        std::string l(line);
+        if (!l.empty() && l.back() == '\n') l.pop_back();
+        size_t eq = l.find('=');
+        if (eq != std::string::npos) header_[l.substr(0, eq)] = l.substr(eq + 1);
+    }
+    if (!terminated) {
+        std::fclose(fp);
+        return fail("header terminator (---) not found");
+    }
+    body_offset_ = (uint64_t)ftello(fp);
+    fseeko(fp, 0, SEEK_END);
+    uint64_t file_size = (uint64_t)ftello(fp);
+
+    int major = 1, minor = 0;
+    auto v = header_.find("version");
+    if (v != header_.end()) std::sscanf(v->second.c_str(), "%d.%d", &major, &minor);
+    blocked_ = major > 1 || (major == 1 && minor >= 1);
+
+    bool ok;
+    if (!blocked_) {
+        Segment seg;
+        seg.offset = body_offset_;
+        seg.raw_size = seg.stored_size = file_size - body_offset_;
+        seg.codec = TraceWriter::CODEC_NONE;
+        seg.has_state = true;
+        segments_.push_back(seg);
+        ok = true;
+    } else {
+        ok = readIndex(fp, file_size) || (error_.empty() && scanBlocks(fp, file_size));
+    }
+    std::fclose(fp);
+    return ok;
+}
+
+// Quietly returns false if there is no index; fails on a corrupt one
+bool TraceReader::readIndex(FILE* fp, uint64_t file_size) {
+    if (file_size < body_offset_ + TraceWriter::TRAILER_BYTES) return false;
+    uint8_t trailer[TraceWriter::TRAILER_BYTES];
+    fseeko(fp, (off_t)(file_size - TraceWriter::TRAILER_BYTES), SEEK_SET);
+    if (std::fread(trailer, 1, sizeof(trailer), fp) != sizeof(trailer)) return false;
+    if (std::memcmp(trailer + 8, TraceWriter::INDEX_MAGIC, sizeof(TraceWriter::INDEX_MAGIC)) != 0)
+        return false;
+
+    uint64_t index_offset = get_u64(trailer);
+    uint8_t head[5];
+    fseeko(fp, (off_t)index_offset, SEEK_SET);
+    if (std::fread(head, 1, 5, fp) != 5 || head[0] != TraceWriter::INDEX_MARKER)
+        return fail("bad index marker");
+    uint32_t count = get_u32(head + 1);
+    std::vector<uint8_t> raw((size_t)count * TraceWriter::INDEX_ENTRY_BYTES);
+    if (std::fread(raw.data(), 1, raw.size(), fp) != raw.size())
+        return fail("truncated index");
+
+    uint8_t bh[TraceWriter::BLOCK_HEADER_BYTES];
+    for (uint32_t k = 0; k < count; ++k) {
+        const uint8_t* e = raw.data() + (size_t)k * TraceWriter::INDEX_ENTRY_BYTES;
+        Segment seg;
+        uint64_t block = get_u64(e);
+        seg.state.cycle = get_u64(e + 8);
+        seg.state.conflicts = get_u64(e + 16);
+        // e + 24: events before the block, not needed to decode
+        seg.state.level = get_u32(e + 32);
+        seg.state.phase = e[36];
+        for (int d = 0; d < DS_COUNT; ++d) seg.state.last_addr[d] = get_u64(e + 37 + 8*d);
+        seg.has_state = true;
+
+        fseeko(fp, (off_t)block, SEEK_SET);
+        if (std::fread(bh, 1, sizeof(bh), fp) != sizeof(bh) || bh[0] != TraceWriter::BLOCK_MARKER)
+            return fail("index points at a non-block offset");
+        seg.codec = bh[1];
+        seg.raw_size = get_u32(bh + 2);
+        seg.stored_size = get_u32(bh + 6);
+        seg.offset = block + sizeof(bh);
+        segments_.push_back(seg);
+    }
+    indexed_ = true;
+    return true;
+}
+
+// Walk the block headers of a trace without an index. Only the first block's
+// state is known, so such traces decode on one thread.
+bool TraceReader::scanBlocks(FILE* fp, uint64_t file_size) {
+    uint8_t bh[TraceWriter::BLOCK_HEADER_BYTES];
+    uint64_t off = body_offset_;
+    while (off + sizeof(bh) <= file_size) {
+        fseeko(fp, (off_t)off, SEEK_SET);
+        if (std::fread(bh, 1, sizeof(bh), fp) != sizeof(bh) || bh[0] != TraceWriter::BLOCK_MARKER)
+            break;
+        Segment seg;
+        seg.codec = bh[1];
+        seg.raw_size = get_u32(bh + 2);
+        seg.stored_size = get_u32(bh + 6);
+        seg.offset = off + sizeof(bh);
+        seg.has_state = segments_.empty();
+        if (seg.offset + seg.stored_size > file_size) break;  // truncated last block
+        segments_.push_back(seg);
+        off = seg.offset + seg.stored_size;
+    }
+    return true;
+}
+
+bool TraceReader::load(FILE* fp, const Segment& seg, std::vector<uint8_t>& raw,
+                       std::string& err) const {
+    std::vector<uint8_t> stored(seg.stored_size);
+    fseeko(fp, (off_t)seg.offset, SEEK_SET);
+    if (std::fread(stored.data(), 1, stored.size(), fp) != stored.size()) {
+        err = path_ + ": short read";
+        return false;
+    }
+    if (seg.codec == TraceWriter::CODEC_NONE) {
+        raw.swap(stored);
+        return true;
+    }
+    if (seg.codec != TraceWriter::CODEC_ZLIB) {
+        err = path_ + ": unknown block codec " + std::to_string(seg.codec);
+        return false;
+    }
+    raw.resize(seg.raw_size);
+    uLongf n = (uLongf)seg.raw_size;
+    if (uncompress(raw.data(), &n, stored.data(), (uLong)stored.size()) != Z_OK || n != seg.raw_size) {
+        err = path_ + ": corrupt block at offset " + std::to_string(seg.offset);
+        return false;
+    }
+    return true;
+}
+
+// Decoding
+
+template<typename V>
+bool TraceReader::decode(const uint8_t* p, size_t n, State& st, V& v, std::string& err) {
+    const uint8_t* begin = p;
+    const uint8_t* end = p + n;
+    uint64_t u, u2, u3, u4;
+    int64_t s;
+    while (p < end) {
+        const uint8_t* rec = p;
+        uint8_t tag = *p++;
+        bool ok = true;
+        switch (tag) {
+        case TraceWriter::TAG_MEM_READ:
+        case TraceWriter::TAG_MEM_WRITE: {
+            if (p >= end) { ok = false; break; }
+            uint8_t packed = *p++;
+            uint8_t sc = (packed >> 4) & 0x7;
+            uint8_t ds = packed & 0xF;
+            if (ds >= DS_COUNT || !read_svarint(p, end, s)) { ok = false; break; }
+            st.last_addr[ds] += (uint64_t)s;
+            uint32_t size;
+            if (sc == 7) {
+                if (!read_uvarint(p, end, u)) { ok = false; break; }
+                size = (uint32_t)u;
+            } else {
+                size = SIZE_CLASSES[sc];
+            }
+            v.mem(st, tag == TraceWriter::TAG_MEM_WRITE, ds, st.last_addr[ds], size);
+            continue;
+        }
+        case TraceWriter::TAG_TICK:
+            ok = read_uvarint(p, end, u);
+            st.cycle += u;
+            break;
+        case TraceWriter::TAG_PHASE:
+            if (p >= end) { ok = false; break; }
+            st.phase = *p++;
+            break;
+        case TraceWriter::TAG_LEVEL:
+            ok = read_uvarint(p, end, u);
+            st.level = (uint32_t)u;
+            break;
+        case TraceWriter::TAG_DECIDE:
+            ok = read_uvarint(p, end, u) && p < end && (++p, read_uvarint(p, end, u2));
+            break;
+        case TraceWriter::TAG_ENQUEUE:
+            ok = read_uvarint(p, end, u) && p < end && (++p, read_svarint(p, end, s));
+            break;
+        case TraceWriter::TAG_CONFLICT:
+            ok = read_uvarint(p, end, u);
+            break;
+        case TraceWriter::TAG_LEARN:
+            ok = read_uvarint(p, end, u) && read_uvarint(p, end, u2) &&
+                 read_uvarint(p, end, u3) && read_uvarint(p, end, u4);
+            break;
+        case TraceWriter::TAG_BACKTRACK:
+        case TraceWriter::TAG_REDUCE:
+            ok = read_uvarint(p, end, u) && read_uvarint(p, end, u2);
+            break;
+        case TraceWriter::TAG_RESTART:
+            ok = read_uvarint(p, end, u);
+            break;
+        case TraceWriter::TAG_FINISH:
+            if (end - p < 20) { ok = false; break; }
+            v.stream(begin, (size_t)(rec - begin));
+            v.finish(get_u64(p), get_u64(p + 8), get_u32(p + 16));
+            return true;
+        default:
+            err = "unknown tag " + std::to_string(tag);
+            return false;
+        }
+        if (!ok) {
+            err = "truncated record, tag " + std::to_string(tag);
+            return false;
+        }
+        v.record(tag, st);
+        // CONFLICT counts for the records after it
+        if (tag == TraceWriter::TAG_CONFLICT) st.conflicts++;
+    }
+    v.stream(begin, n);
+    return true;
+}
+
+template<typename V>
+bool TraceReader::decodeRange(size_t first, size_t last, V& v, std::string& err) const {
+    if (first >= last) return true;
+    FILE* fp = std::fopen(path_.c_str(), "rb");
+    if (!fp) { err = path_ + ": cannot open"; return false; }
+    State st = segments_[first].state;
+    std::vector<uint8_t> raw;
+    bool ok = true;
+    for (size_t i = first; i < last && ok; ++i) {
+        ok = load(fp, segments_[i], raw, err);
+        if (ok && !decode(raw.data(), raw.size(), st, v, err)) {
+            err = path_ + ": segment " + std::to_string(i) + ": " + err;
+            ok = false;
+        }
+    }
+    std::fclose(fp);
+    return ok;
+}
+
+template<typename V>
+bool TraceReader::decodeParallel(size_t first, size_t last, const V& proto, std::vector<V>& parts) {
+    // Cut [first, last) into runs of about equal stored bytes, each starting
+    // at a segment whose state is known
+    std::vector<size_t> cuts(1, first);
+    bool all_state = true;
+    uint64_t total = 0;
+    for (size_t i = first; i < last; ++i) {
+        all_state = all_state && segments_[i].has_state;
+        total += segments_[i].stored_size;
+    }
+    int threads = all_state ? std::max(1, std::min<int>(threads_, (int)(last - first))) : 1;
+    uint64_t acc = 0;
+    for (size_t i = first; i < last && (int)cuts.size() < threads; ++i) {
+        acc += segments_[i].stored_size;
+        if (acc * threads >= total * cuts.size() && i + 1 < last) cuts.push_back(i + 1);
+    }
+    cuts.push_back(last);
+
+    size_t runs = cuts.size() - 1;
+    parts.assign(runs, proto);
+    std::vector<std::string> errs(runs);
+    std::vector<char> ok(runs, 0);
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < runs; ++t) {
+        pool.emplace_back([&, t] { ok[t] = decodeRange(cuts[t], cuts[t+1], parts[t], errs[t]); });
+    }
+    ok[0] = decodeRange(cuts[0], cuts[1], parts[0], errs[0]);
+    for (std::thread& th : pool) th.join();
+    for (size_t t = 0; t < runs; ++t) {
+        if (!ok[t]) { error_ = errs[t]; return false; }
+    }
+    return true;
+}
+
+bool TraceReader::readMem(MemColumns& out, uint64_t cycle_lo, uint64_t cycle_hi) {
+    out.clear();
+    size_t first = 0, last = segments_.size();
+    if (indexed_) {
+        // A block's records carry at most its successor's starting cycle
+        while (first + 1 < last && segments_[first + 1].state.cycle < cycle_lo) first++;
+        while (last > first + 1 && segments_[last - 1].state.cycle >= cycle_hi) last--;
+    }
+    MemVisitor proto;
+    proto.lo = cycle_lo;
+    proto.hi = cycle_hi;
+    std::vector<MemVisitor> parts;
+    if (!decodeParallel(first, last, proto, parts)) return false;
+    size_t n = 0;
+    for (MemVisitor& p : parts) n += p.cols.count();
+    out.cycle.reserve(n); out.addr.reserve(n); out.conflict.reserve(n); out.size.reserve(n);
+    out.level.reserve(n); out.ds.reserve(n); out.phase.reserve(n); out.is_write.reserve(n);
+    for (MemVisitor& p : parts) {
+        out.append(p.cols);
+        p.cols.clear();
+    }
+    return true;
+}
+
+bool TraceReader::summarize(Summary& out) {
+    std::vector<SummaryVisitor> parts;
+    if (!decodeParallel(0, segments_.size(), SummaryVisitor(), parts)) return false;
+    std::memset(&out, 0, sizeof(out));
+    uint32_t crc = 0;
+    for (const SummaryVisitor& p : parts) {
+        for (int t = 0; t < 256; ++t) {
+            out.tags[t] += p.s.tags[t];
+            out.phases[t] += p.s.phases[t];
+        }
+        for (int d = 0; d < DS_COUNT; ++d) out.ds_events[d] += p.s.ds_events[d];
+        out.mem_bytes += p.s.mem_bytes;
+        if (p.s.finished) {
+            out.finished = true;
+            out.total_cycles = p.s.total_cycles;
+            out.events_written = p.s.events_written;
+            out.crc32 = p.s.crc32;
+        }
+        crc = (uint32_t)crc32_combine(crc, p.crc, (z_off_t)p.len);
+    }
+    out.crc32_actual = crc;
+    return true;
+}
+
+// Aggregations
+
+void TraceReader::strideHistogram(const MemColumns& m, unsigned line_bytes, int max_stride,
+                                  std::vector<uint64_t>& out) {
+    size_t bins = 2 * (size_t)max_stride + 3;
+    out.assign(DS_COUNT * bins, 0);
+    int64_t prev[DS_COUNT];
+    bool seen[DS_COUNT] = {false};
+    for (size_t i = 0; i < m.count(); ++i) {
+        uint8_t ds = m.ds[i];
+        int64_t line = (int64_t)(m.addr[i] / line_bytes);
+        if (seen[ds]) {
+            int64_t stride = line - prev[ds];
+            size_t bin;
+            if (stride < -max_stride) bin = 0;
+            else if (stride > max_stride) bin = bins - 1;
+            else bin = (size_t)(stride + max_stride + 1);
+            out[ds * bins + bin]++;
+        }
+        seen[ds] = true;
+        prev[ds] = line;
+    }
+}
+
+size_t TraceReader::naturalGroups(const MemColumns& m, GroupBy by) {
+    if (by == BY_DS) return DS_COUNT;
+    uint32_t mx = 0;
+    for (size_t i = 0; i < m.count(); ++i)
+        mx = std::max(mx, by == BY_PHASE ? (uint32_t)m.phase[i] : m.level[i]);
+    return (size_t)mx + 1;
+}
+
+void TraceReader::reuseHistogram(const MemColumns& m, unsigned line_bytes, GroupBy by,
+                                 size_t groups, std::vector<uint64_t>& out) {
+    if (groups == 0) groups = 1;
+    out.assign(groups * REUSE_BINS, 0);
+    size_t n = m.count();
+    // Position i is marked while it is the latest access to its line, so
+    // the marks strictly between two accesses to a line count the distinct
+    // lines touched in between.
+    Fenwick marks(n);
+    std::unordered_map<uint64_t, size_t> last;
+    last.reserve(n / 4 + 16);
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t line = m.addr[i] / line_bytes;
+        size_t g = by == BY_DS ? m.ds[i] : by == BY_PHASE ? m.phase[i] : m.level[i];
+        if (g >= groups) g = groups - 1;
+        auto it = last.find(line);
+        if (it == last.end()) {
+            out[g * REUSE_BINS + REUSE_BINS - 1]++;
+            last.emplace(line, i);
+        } else {
+            size_t prev = it->second;
+            uint64_t d = marks.prefix(i) - marks.prefix(prev + 1);
+            out[g * REUSE_BINS + log2_bin(d)]++;
+            marks.add(prev, -1);
+            it->second = i;
+        }
+        marks.add(i, 1);
+    }
+}
+
+void TraceReader::footprint(const MemColumns& m, unsigned line_bytes, uint64_t window_cycles,
+                            std::vector<uint64_t>& starts, std::vector<uint64_t>& distinct,
+                            std::vector<uint64_t>& cumulative) {
+    starts.clear(); distinct.clear(); cumulative.clear();
+    if (window_cycles == 0) window_cycles = 1;
+    std::unordered_map<uint64_t, uint64_t> seen;  // line -> last window + 1
+    uint64_t cur = 0, count = 0;
+    bool open_window = false;
+    for (size_t i = 0; i < m.count(); ++i) {
+        uint64_t w = m.cycle[i] / window_cycles + 1;
+        if (!open_window || w != cur) {
+            if (open_window) {
+                starts.push_back((cur - 1) * window_cycles);
+                distinct.push_back(count);
+                cumulative.push_back(seen.size());
+            }
+            cur = w;
+            count = 0;
+            open_window = true;
+        }
+        uint64_t& s = seen[m.addr[i] / line_bytes];
+        if (s != cur) { s = cur; count++; }
+    }
+    if (open_window) {
+        starts.push_back((cur - 1) * window_cycles);
+        distinct.push_back(count);
+        cumulative.push_back(seen.size());
+    }
+}
+
+// C API
+
+namespace {
+
+struct Handle {
+    TraceReader reader;
+    TraceReader::MemColumns mem;
+    std::string error;
+    // last tr_footprint result, so the sizing and filling calls decode once
+    uint32_t fp_line = 0;
+    uint64_t fp_window = 0;
+    std::vector<uint64_t> fp_starts, fp_distinct, fp_cumulative;
+};
+
+thread_local std::string open_error;
+
+template<typename T>
+void copy_out(T* dst, const std::vector<T>& src) {
+    if (dst && !src.empty()) std::memcpy(dst, src.data(), src.size() * sizeof(T));
+}
+
+} // namespace
+
+extern "C" {
+
+void* tr_open(const char* path, int threads) {
+    Handle* h = new Handle();
+    h->reader.setThreads(threads);
+    if (!h->reader.open(path)) {
+        open_error = h->reader.error();
+        delete h;
+        return nullptr;
+    }
+    return h;
+}
+
+void tr_close(void* h) {
+    delete static_cast<Handle*>(h);
+}
+
+const char* tr_error(void* h) {
+    if (!h) return open_error.c_str();
+    Handle* hd = static_cast<Handle*>(h);
+    hd->error = hd->reader.error();
+    return hd->error.c_str();
+}
+
+const char* tr_header(void* h, const char* key) {
+    const auto& hdr = static_cast<Handle*>(h)->reader.header();
+    auto it = hdr.find(key);
+    return it == hdr.end() ? nullptr : it->second.c_str();
+}
+
+int64_t tr_blocks(void* h) {
+    return (int64_t)static_cast<Handle*>(h)->reader.blocks();
+}
+
+int32_t tr_indexed(void* h) {
+    return static_cast<Handle*>(h)->reader.indexed() ? 1 : 0;
+}
+
+int32_t tr_summarize(void* h, tr_summary* out) {
+    TraceReader::Summary s;
+    if (!static_cast<Handle*>(h)->reader.summarize(s)) return -1;
+    std::memcpy(out->tags, s.tags, sizeof(s.tags));
+    std::memcpy(out->ds_events, s.ds_events, sizeof(s.ds_events));
+    std::memcpy(out->phases, s.phases, sizeof(s.phases));
+    out->mem_bytes = s.mem_bytes;
+    out->total_cycles = s.total_cycles;
+    out->events_written = s.events_written;
+    out->crc32 = s.crc32;
+    out->crc32_actual = s.crc32_actual;
+    out->finished = s.finished ? 1 : 0;
+    return 0;
+}
+
+int64_t tr_load(void* h, uint64_t cycle_lo, uint64_t cycle_hi) {
+    Handle* hd = static_cast<Handle*>(h);
+    hd->fp_line = 0;
+    if (!hd->reader.readMem(hd->mem, cycle_lo, cycle_hi)) return -1;
+    return (int64_t)hd->mem.count();
+}
+
+int64_t tr_mem_columns(void* h, uint64_t* cycle, uint64_t* addr, uint64_t* conflict,
+                       uint32_t* size, uint32_t* level, uint8_t* ds, uint8_t* phase,
+                       uint8_t* is_write) {
+    const TraceReader::MemColumns& m = static_cast<Handle*>(h)->mem;
+    copy_out(cycle, m.cycle);
+    copy_out(addr, m.addr);
+    copy_out(conflict, m.conflict);
+    copy_out(size, m.size);
+    copy_out(level, m.level);
+    copy_out(ds, m.ds);
+    copy_out(phase, m.phase);
+    copy_out(is_write, m.is_write);
+    return (int64_t)m.count();
+}
+
+int64_t tr_stride_bins(int32_t max_stride) {
+    return max_stride < 0 ? -1 : 2 * (int64_t)max_stride + 3;
+}
+
+int64_t tr_stride_hist(void* h, uint32_t line_bytes, int32_t max_stride, uint64_t* out) {
+    if (line_bytes == 0 || max_stride < 0) return -1;
+    std::vector<uint64_t> hist;
+    TraceReader::strideHistogram(static_cast<Handle*>(h)->mem, line_bytes, max_stride, hist);
+    copy_out(out, hist);
+    return (int64_t)hist.size();
+}
+
+int64_t tr_reuse_bins() {
+    return TraceReader::REUSE_BINS;
+}
+
+int64_t tr_groups(void* h, int32_t by) {
+    if (by < TraceReader::BY_DS || by > TraceReader::BY_LEVEL) return -1;
+    return (int64_t)TraceReader::naturalGroups(static_cast<Handle*>(h)->mem,
+                                               (TraceReader::GroupBy)by);
+}
+
+int64_t tr_reuse_hist(void* h, uint32_t line_bytes, int32_t by, int64_t groups, uint64_t* out) {
+    if (line_bytes == 0 || groups <= 0 || by < TraceReader::BY_DS || by > TraceReader::BY_LEVEL)
+        return -1;
+    std::vector<uint64_t> hist;
+    TraceReader::reuseHistogram(static_cast<Handle*>(h)->mem, line_bytes,
+                                (TraceReader::GroupBy)by, (size_t)groups, hist);
+    copy_out(out, hist);
+    return (int64_t)hist.size();
+}
+
+int64_t tr_footprint(void* h, uint32_t line_bytes, uint64_t window_cycles,
+                     uint64_t* starts, uint64_t* distinct, uint64_t* cumulative) {
+    if (line_bytes == 0 || window_cycles == 0) return -1;
+    Handle* hd = static_cast<Handle*>(h);
+    if (hd->fp_line != line_bytes || hd->fp_window != window_cycles) {
+        TraceReader::footprint(hd->mem, line_bytes, window_cycles,
+                               hd->fp_starts, hd->fp_distinct, hd->fp_cumulative);
+        hd->fp_line = line_bytes;
+        hd->fp_window = window_cycles;
+    }
+    copy_out(starts, hd->fp_starts);
+    copy_out(distinct, hd->fp_distinct);
+    copy_out(cumulative, hd->fp_cumulative);
+    return (int64_t)hd->fp_starts.size();
+}
+
+} // extern "C"
@@ -0,0 +1,193 @@
+#ifndef TRACE_READER_H
+#define TRACE_READER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "trace_writer.h"
+
+// Native decoder for the traces TraceWriter produces, and the aggregations
+// the analysis tools in tools/ run over them.
+//
+// Format spec: TRACE_FORMAT.md (repo root). This is the exact mirror of
+// TraceWriter's encoding: same tags, size classes, zigzag varints and per-DS
+// address deltas. v1.1 traces are decoded in parallel, one contiguous run of
+// blocks per thread, each thread starting from the seek index state of its
+// first block. v1.0 traces, and v1.1 traces whose run never wrote the index,
+// are decoded on one thread.
+//
+// No SST dependency: built standalone as libtracereader.so (make tracereader)
+// and driven from Python through the C API at the bottom of this file.
+class TraceReader {
+public:
+    static const int DS_COUNT = TraceWriter::DS_COUNT;
+    static const int REUSE_BINS = 66;  // 0, [2^(b-1), 2^b) for b = 1..64, cold
+
+    enum GroupBy { BY_DS = 0, BY_PHASE = 1, BY_LEVEL = 2 };
+
+    // Memory events, one entry per event in stream order
+    struct MemColumns {
+        std::vector<uint64_t> cycle;
+        std::vector<uint64_t> addr;
+        std::vector<uint64_t> conflict;  // CONFLICT records before the event
+        std::vector<uint32_t> size;
+        std::vector<uint32_t> level;
+        std::vector<uint8_t>  ds;
+        std::vector<uint8_t>  phase;
+        std::vector<uint8_t>  is_write;
+
+        size_t count() const { return addr.size(); }
+        void clear();
+        void append(const MemColumns& o);
+    };
+
+    struct Summary {
+        uint64_t tags[256];             // records per tag
+        uint64_t ds_events[DS_COUNT];   // memory events per DS
+        uint64_t phases[256];           // PHASE records per phase value
+        uint64_t mem_bytes;
+        uint64_t total_cycles;          // from FINISH
+        uint64_t events_written;        // from FINISH
+        uint32_t crc32;                 // from FINISH
+        uint32_t crc32_actual;          // computed over the decoded stream
+        bool     finished;              // FINISH record seen
+    };
+
+    TraceReader() = default;
+    TraceReader(const TraceReader&) = delete;
+    TraceReader& operator=(const TraceReader&) = delete;
+
+    // Parses the header and the seek index (or scans block boundaries)
+    bool open(const std::string& path);
+    const std::string& error() const { return error_; }
+    const std::map<std::string, std::string>& header() const { return header_; }
+    size_t blocks() const { return segments_.size(); }
+    bool indexed() const { return indexed_; }
+
+    void setThreads(int n) { threads_ = n < 1 ? 1 : n; }
+
+    // Memory events with cycle in [cycle_lo, cycle_hi). With an index, blocks
+    // outside the window are not decoded.
+    bool readMem(MemColumns& out, uint64_t cycle_lo = 0, uint64_t cycle_hi = UINT64_MAX);
+    bool summarize(Summary& out);
+
+    // Aggregations over decoded columns
+
+    // Per DS, histogram of the stride in lines between consecutive accesses
+    // of the DS: bin 0 holds strides < -max_stride, bins 1..2*max_stride+1
+    // strides -max_stride..max_stride, the last bin strides > max_stride.
+    // out has DS_COUNT * (2*max_stride + 3) entries.
+    static void strideHistogram(const MemColumns& m, unsigned line_bytes, int max_stride,
+                                std::vector<uint64_t>& out);
+
+    // LRU stack distance in distinct lines of the whole stream (what one
+    // fully associative cache in front of every DS would see), attributed
+    // to the group of the reusing access. out has groups * REUSE_BINS
+    // entries; levels >= groups - 1 share the last group.
+    static void reuseHistogram(const MemColumns& m, unsigned line_bytes, GroupBy by,
+                               size_t groups, std::vector<uint64_t>& out);
+    static size_t naturalGroups(const MemColumns& m, GroupBy by);
+
+    // Distinct lines touched in each window of window_cycles cycles, and
+    // the cumulative footprint at the end of the window. Windows with no
+    // accesses are omitted.
+    static void footprint(const MemColumns& m, unsigned line_bytes, uint64_t window_cycles,
+                          std::vector<uint64_t>& starts, std::vector<uint64_t>& distinct,
+                          std::vector<uint64_t>& cumulative);
+
+private:
+    // Decoder state, identical to an index entry
+    struct State {
+        uint64_t cycle = 0;
+        uint64_t conflicts = 0;
+        uint32_t level = 0;
+        uint8_t  phase = 0;
+        uint64_t last_addr[DS_COUNT] = {0};
+    };
+
+    // A decodable piece of the event stream: a v1.1 block, or the whole
+    // body of a v1.0 trace
+    struct Segment {
+        uint64_t offset;       // payload offset in the file
+        uint64_t raw_size;
+        uint64_t stored_size;
+        uint8_t  codec;
+        bool     has_state;    // state is known without decoding earlier segments
+        State    state;
+    };
+
+    struct MemVisitor;
+    struct SummaryVisitor;
+
+    bool fail(const std::string& msg);
+    bool readIndex(FILE* fp, uint64_t file_size);
+    bool scanBlocks(FILE* fp, uint64_t file_size);
+    bool load(FILE* fp, const Segment& seg, std::vector<uint8_t>& raw, std::string& err) const;
+
+    // Visitors provide mem(), record(), finish() and stream(); see the .cc.
+    // stream() receives the segment bytes in front of any FINISH record.
+    // Returns false on a malformed stream.
+    template<typename V>
+    static bool decode(const uint8_t* p, size_t n, State& st, V& v, std::string& err);
+    // Decode segments [first, last) in order on the calling thread
+    template<typename V>
+    bool decodeRange(size_t first, size_t last, V& v, std::string& err) const;
+    // Split [first, last) over the threads, parts[t] visiting the t-th run
+    template<typename V>
+    bool decodeParallel(size_t first, size_t last, const V& proto, std::vector<V>& parts);
+
+    std::string path_;
+    std::string error_;
+    std::map<std::string, std::string> header_;
+    uint64_t body_offset_ = 0;
+    bool blocked_ = false;   // v1.1 framing
+    bool indexed_ = false;
+    int threads_ = 1;
+    std::vector<Segment> segments_;
+};
+
+// C API for the Python tools (ctypes). Every call taking a handle returns a
+// negative value on error; tr_error() describes it. Output arrays are
+// caller-allocated; pointers may be NULL to skip a column.
+extern "C" {
+    typedef struct tr_summary {
+        uint64_t tags[256];
+        uint64_t ds_events[TraceWriter::DS_COUNT];
+        uint64_t phases[256];
+        uint64_t mem_bytes;
+        uint64_t total_cycles;
+        uint64_t events_written;
+        uint32_t crc32;
+        uint32_t crc32_actual;
+        int32_t  finished;
+    } tr_summary;
+
+    void*       tr_open(const char* path, int threads);
+    void        tr_close(void* h);
+    const char* tr_error(void* h);             // also valid for a failed tr_open (h = NULL)
+    const char* tr_header(void* h, const char* key);  // NULL if absent
+    int64_t     tr_blocks(void* h);
+    int32_t     tr_indexed(void* h);
+    int32_t     tr_summarize(void* h, tr_summary* out);
+
+    // Decode the memory events of [cycle_lo, cycle_hi) into the handle;
+    // returns their count. The calls below work on the loaded events.
+    int64_t tr_load(void* h, uint64_t cycle_lo, uint64_t cycle_hi);
+    int64_t tr_mem_columns(void* h, uint64_t* cycle, uint64_t* addr, uint64_t* conflict,
+                           uint32_t* size, uint32_t* level, uint8_t* ds, uint8_t* phase,
+                           uint8_t* is_write);
+    int64_t tr_stride_bins(int32_t max_stride);
+    int64_t tr_stride_hist(void* h, uint32_t line_bytes, int32_t max_stride, uint64_t* out);
+    int64_t tr_reuse_bins();
+    int64_t tr_groups(void* h, int32_t by);
+    int64_t tr_reuse_hist(void* h, uint32_t line_bytes, int32_t by, int64_t groups, uint64_t* out);
+    // Returns the number of windows; fills the arrays if they are non-NULL
+    // (call once to size them, once to fill)
+    int64_t tr_footprint(void* h, uint32_t line_bytes, uint64_t window_cycles,
+                         uint64_t* starts, uint64_t* distinct, uint64_t* cumulative);
+}
+
+#endif // TRACE_READER_H
@@ -3,6 +3,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <zlib.h>
 
 namespace {
 
@@ -24,6 +25,18 @@ uint32_t crc32_update(uint32_t crc, const uint8_t* data, size_t n) {
     return crc;
 }
 
+// Little-endian fixed-width fields of block headers, index and trailer.
+uint8_t* put_u32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; ++i) *p++ = (uint8_t)((v >> (8*i)) & 0xFF);
+    return p;
+}
+uint8_t* put_u64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; ++i) *p++ = (uint8_t)((v >> (8*i)) & 0xFF);
+    return p;
+}
+
+const size_t  MAX_RING_BYTES = (size_t)1 << 30;  // raw_size is a u32
+
 } // namespace
 
 TraceWriter::TraceWriter() = default;
@@ -31,104 +44,179 @@ TraceWriter::TraceWriter() = default;
 TraceWriter::~TraceWriter() {
     if (fp_) close(0);
     if (buf_) { std::free(buf_); buf_ = nullptr; }
+    if (spare_) { std::free(spare_); spare_ = nullptr; }
 }
 
-bool TraceWriter::open(const std::string& path, size_t ring_bytes) {
+bool TraceWriter::open(const std::string& path, size_t ring_bytes,
+                       Codec codec, int level) {
     if (ring_bytes < 4096) ring_bytes = 4096;
+    if (ring_bytes > MAX_RING_BYTES) ring_bytes = MAX_RING_BYTES;
     size_t alloc = ring_bytes + 64;
     buf_ = static_cast<uint8_t*>(std::malloc(alloc));
-    if (!buf_) return false;
+    spare_ = static_cast<uint8_t*>(std::malloc(alloc));
+    if (!buf_ || !spare_) {
+        std::free(buf_);
+        std::free(spare_);
+        buf_ = spare_ = nullptr;
+        return false;
+    }
     cap_ = ring_bytes;
     pos_ = 0;
+    codec_ = codec;
+    level_ = level;
+    if (codec_ == CODEC_ZLIB) zbuf_.resize(compressBound((uLong)alloc));
 
     fp_ = std::fopen(path.c_str(), "wb");
     if (!fp_) {
         std::free(buf_);
-        buf_ = nullptr;
+        std::free(spare_);
+        buf_ = spare_ = nullptr;
         return false;
     }
     // Hint sequential access to the page cache.
     std::setvbuf(fp_, nullptr, _IONBF, 0);
+    snapshot(block_state_);
+    thread_ = std::thread(&TraceWriter::writerLoop, this);
     return true;
 }
 
 void TraceWriter::writeHeader(const std::string& cnf_path, uint64_t seed,
                               uint32_t num_vars, uint32_t num_clauses) {
-    if (!fp_ || failed_) return;
+    if (!fp_ || failed()) return;
+    waitIdle();
     // 8-byte magic
     const char magic[8] = {'S','S','T','S','A','T','\0','\0'};
-    if (std::fwrite(magic, 1, 8, fp_) != 8) { failed_ = true; return; }
-    bytes_ += 8;
+    if (!writeFile(magic, 8)) return;
 
     char line[1024];
     int n;
-    n = std::snprintf(line, sizeof(line), "version=1.0\n");          std::fwrite(line, 1, (size_t)n, fp_); bytes_ += n;
-    n = std::snprintf(line, sizeof(line), "cnf=%s\n", cnf_path.c_str()); std::fwrite(line, 1, (size_t)n, fp_); bytes_ += n;
+    n = std::snprintf(line, sizeof(line), "version=1.1\n");          writeFile(line, (size_t)n);
+    n = std::snprintf(line, sizeof(line), "cnf=%s\n", cnf_path.c_str()); writeFile(line, (size_t)n);
     n = std::snprintf(line, sizeof(line), "seed=%llu\n",
-                      (unsigned long long)seed);                     std::fwrite(line, 1, (size_t)n, fp_); bytes_ += n;
-    n = std::snprintf(line, sizeof(line), "num_vars=%u\n", num_vars);   std::fwrite(line, 1, (size_t)n, fp_); bytes_ += n;
-    n = std::snprintf(line, sizeof(line), "num_clauses=%u\n", num_clauses); std::fwrite(line, 1, (size_t)n, fp_); bytes_ += n;
+                      (unsigned long long)seed);                     writeFile(line, (size_t)n);
+    n = std::snprintf(line, sizeof(line), "num_vars=%u\n", num_vars);   writeFile(line, (size_t)n);
+    n = std::snprintf(line, sizeof(line), "num_clauses=%u\n", num_clauses); writeFile(line, (size_t)n);
+    n = std::snprintf(line, sizeof(line), "compression=%s\n",
+                      codec_ == CODEC_ZLIB ? "zlib" : "none");       writeFile(line, (size_t)n);
+    n = std::snprintf(line, sizeof(line), "block_bytes=%zu\n", cap_);  writeFile(line, (size_t)n);
     static const char marker[] = "---\n";
-    std::fwrite(marker, 1, 4, fp_); bytes_ += 4;
+    writeFile(marker, 4);
 }
 
 void TraceWriter::ensureSpace(size_t n) {
     if (pos_ + n >= cap_) flushLocked();
 }
 
+void TraceWriter::snapshot(BlockState& st) const {
+    st.cycle = last_cycle_;
+    st.conflicts = conflicts_;
+    st.events = events_;
+    st.level = cur_level_;
+    st.phase = cur_phase_;
+    std::memcpy(st.last_addr, last_addr_, sizeof(last_addr_));
+}
+
 void TraceWriter::flushLocked() {
     if (!fp_ || pos_ == 0) { pos_ = 0; return; }
-    if (failed_) { pos_ = 0; return; }
-    size_t wrote = std::fwrite(buf_, 1, pos_, fp_);
-    if (wrote != pos_) { failed_ = true; pos_ = 0; return; }
-    crc_ = crc32_update(crc_, buf_, pos_);
-    bytes_ += pos_;
+    if (failed()) { pos_ = 0; return; }
+    {
+        std::unique_lock<std::mutex> lk(mu_);
+        if (job_pending_) {
+            stalls_++;
+            cv_.wait(lk, [this] { return !job_pending_; });
+        }
+        std::swap(buf_, spare_);
+        job_len_ = pos_;
+        job_state_ = block_state_;
+        job_pending_ = true;
+    }
+    cv_.notify_all();
     pos_ = 0;
+    snapshot(block_state_);
 }
 
-void TraceWriter::writeRaw(const void* data, size_t n) {
-    if (!fp_ || failed_) return;
-    if (pos_ + n >= cap_) flushLocked();
-    if (n >= cap_) {
-        // oversized: flush buffer and write direct
-        if (std::fwrite(data, 1, n, fp_) != n) { failed_ = true; return; }
-        crc_ = crc32_update(crc_, static_cast<const uint8_t*>(data), n);
-        bytes_ += n;
-        return;
+void TraceWriter::waitIdle() {
+    std::unique_lock<std::mutex> lk(mu_);
+    cv_.wait(lk, [this] { return !job_pending_; });
+}
+
+void TraceWriter::writerLoop() {
+    std::unique_lock<std::mutex> lk(mu_);
+    for (;;) {
+        cv_.wait(lk, [this] { return job_pending_ || stop_; });
+        if (!job_pending_) return;
+        size_t n = job_len_;
+        BlockState st = job_state_;
+        lk.unlock();
+        writeBlock(spare_, n, st);
+        lk.lock();
+        job_pending_ = false;
+        cv_.notify_all();
+    }
+}
+
+bool TraceWriter::writeFile(const void* data, size_t n) {
+    if (std::fwrite(data, 1, n, fp_) != n) {
+        failed_.store(true, std::memory_order_relaxed);
+        return false;
+    }
+    bytes_ += n;
+    return true;
+}
+
+void TraceWriter::writeBlock(const uint8_t* data, size_t n, const BlockState& st) {
+    if (failed()) return;
+    crc_ = crc32_update(crc_, data, n);
+
+    const uint8_t* payload = data;
+    size_t stored = n;
+    uint8_t codec = CODEC_NONE;
+    if (codec_ == CODEC_ZLIB) {
+        uLongf zlen = (uLongf)zbuf_.size();
+        if (compress2(zbuf_.data(), &zlen, data, (uLong)n, level_) == Z_OK && zlen < n) {
+            payload = zbuf_.data();
+            stored = zlen;
+            codec = CODEC_ZLIB;
+        }
     }
-    std::memcpy(buf_ + pos_, data, n);
-    pos_ += n;
+
+    index_.push_back({bytes_, st});
+    uint8_t hdr[BLOCK_HEADER_BYTES];
+    uint8_t* p = hdr;
+    *p++ = BLOCK_MARKER;
+    *p++ = codec;
+    p = put_u32(p, (uint32_t)n);
+    p = put_u32(p, (uint32_t)stored);
+    if (!writeFile(hdr, sizeof(hdr))) return;
+    writeFile(payload, stored);
 }
 
 void TraceWriter::emitPhase(uint8_t phase) {
-    if (!fp_ || failed_) return;
+    if (!fp_ || failed()) return;
     ensureSpace(2);
     buf_[pos_++] = TAG_PHASE;
     buf_[pos_++] = phase;
+    cur_phase_ = phase;
     ++events_;
 }
 
 void TraceWriter::emitLevel(int32_t level) {
-    if (!fp_ || failed_) return;
+    if (!fp_ || failed()) return;
     ensureSpace(11);
+    cur_level_ = (uint32_t)(level < 0 ? 0 : level);
     buf_[pos_++] = TAG_LEVEL;
-    uint8_t* p = writeUVarint(buf_ + pos_, (uint64_t)(level < 0 ? 0 : level));
+    uint8_t* p = writeUVarint(buf_ + pos_, cur_level_);
     pos_ = (size_t)(p - buf_);
     ++events_;
 }
 
 void TraceWriter::emitTick(uint64_t cycle) {
-    if (!fp_ || failed_) return;
-    // Delta from the previous TICK. Use last_addr_[DS_UNKNOWN] as a
-    // convenient scratch slot so the fast path's 9-slot array can double
-    // as cycle state — the DS_UNKNOWN bucket is never hit by real mem
-    // events with a configured DsMap.
-    static thread_local uint64_t last_cycle = 0;
-    // Per-instance state would be cleaner; keep simple for v1.
-    uint64_t delta = cycle - last_cycle;
-    last_cycle = cycle;
-
+    if (!fp_ || failed()) return;
+    // Delta from the previous TICK
     ensureSpace(11);
+    uint64_t delta = cycle - last_cycle_;
+    last_cycle_ = cycle;
+
     buf_[pos_++] = TAG_TICK;
     uint8_t* p = writeUVarint(buf_ + pos_, delta);
     pos_ = (size_t)(p - buf_);
@@ -136,7 +224,7 @@ void TraceWriter::emitTick(uint64_t cycle) {
 }
 
 void TraceWriter::emitDecision(int var, bool sign, int new_level) {
-    if (!fp_ || failed_) return;
+    if (!fp_ || failed()) return;
     ensureSpace(1 + 10 + 1 + 10);
     buf_[pos_++] = TAG_DECIDE;
     uint8_t* p = writeUVarint(buf_ + pos_, (uint64_t)(var < 0 ? 0 : var));
@@ -148,7 +236,7 @@ void TraceWriter::emitDecision(int var, bool sign, int new_level) {
 }
 
 void TraceWriter::emitEnqueue(int var, bool sign, int reason_cref) {
-    if (!fp_ || failed_) return;
+    if (!fp_ || failed()) return;
     ensureSpace(1 + 10 + 1 + 10);
     buf_[pos_++] = TAG_ENQUEUE;
     uint8_t* p = writeUVarint(buf_ + pos_, (uint64_t)(var < 0 ? 0 : var));
@@ -160,16 +248,17 @@ void TraceWriter::emitEnqueue(int var, bool sign, int reason_cref) {
 }
 
 void TraceWriter::emitConflict(int cref) {
-    if (!fp_ || failed_) return;
+    if (!fp_ || failed()) return;
     ensureSpace(1 + 10);
     buf_[pos_++] = TAG_CONFLICT;
     uint8_t* p = writeUVarint(buf_ + pos_, (uint64_t)(cref < 0 ? 0 : cref));
     pos_ = (size_t)(p - buf_);
+    ++conflicts_;
     ++events_;
 }
 
 void TraceWriter::emitLearn(int lbd, int clause_size, int bt_level, int new_cref) {
-    if (!fp_ || failed_) return;
+    if (!fp_ || failed()) return;
     ensureSpace(1 + 4*10);
     buf_[pos_++] = TAG_LEARN;
     uint8_t* p = buf_ + pos_;
@@ -182,7 +271,7 @@ void TraceWriter::emitLearn(int lbd, int clause_size, int bt_level, int new_cref
 }
 
 void TraceWriter::emitBacktrack(int from_level, int to_level) {
-    if (!fp_ || failed_) return;
+    if (!fp_ || failed()) return;
     ensureSpace(1 + 2*10);
     buf_[pos_++] = TAG_BACKTRACK;
     uint8_t* p = buf_ + pos_;
@@ -193,7 +282,7 @@ void TraceWriter::emitBacktrack(int from_level, int to_level) {
 }
 
 void TraceWriter::emitRestart(int restart_idx) {
-    if (!fp_ || failed_) return;
+    if (!fp_ || failed()) return;
     ensureSpace(1 + 10);
     buf_[pos_++] = TAG_RESTART;
     uint8_t* p = writeUVarint(buf_ + pos_, (uint64_t)(restart_idx < 0 ? 0 : restart_idx));
@@ -202,7 +291,7 @@ void TraceWriter::emitRestart(int restart_idx) {
 }
 
 void TraceWriter::emitReduce(int removed, int kept) {
-    if (!fp_ || failed_) return;
+    if (!fp_ || failed()) return;
     ensureSpace(1 + 2*10);
     buf_[pos_++] = TAG_REDUCE;
     uint8_t* p = buf_ + pos_;
@@ -214,26 +303,46 @@ void TraceWriter::emitReduce(int removed, int kept) {
 
 void TraceWriter::close(uint64_t total_cycles) {
     if (!fp_) return;
-    if (!failed_) {
-        // Drain ring buffer, then append the FINISH record and flush once more.
+    if (!failed()) {
+        // Drain the event buffers; the CRC is final once the writer is idle.
+        flushLocked();
+        waitIdle();
+
+        // FINISH goes out as the last block of its own.
+        uint8_t* p = buf_;
+        *p++ = TAG_FINISH;
+        p = put_u64(p, total_cycles);
+        p = put_u64(p, events_);
+        p = put_u32(p, crc_ ^ 0xFFFFFFFFu);
+        pos_ = (size_t)(p - buf_);
         flushLocked();
+    }
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
 
-        uint8_t finish[1 + 8 + 8 + 4];
-        size_t p = 0;
-        finish[p++] = TAG_FINISH;
-        auto wu64 = [&](uint64_t v) {
-            for (int i = 0; i < 8; ++i) finish[p++] = (uint8_t)((v >> (8*i)) & 0xFF);
-        };
-        auto wu32 = [&](uint32_t v) {
-            for (int i = 0; i < 4; ++i) finish[p++] = (uint8_t)((v >> (8*i)) & 0xFF);
-        };
-        wu64(total_cycles);
-        wu64(events_);
-        uint32_t final_crc = crc_ ^ 0xFFFFFFFFu;
-        wu32(final_crc);
-
-        std::fwrite(finish, 1, sizeof(finish), fp_);
-        bytes_ += sizeof(finish);
+    if (!failed()) {
+        // Seek index, then the fixed-size trailer pointing at it
+        uint64_t index_offset = bytes_;
+        std::vector<uint8_t> out(1 + 4 + index_.size() * INDEX_ENTRY_BYTES + TRAILER_BYTES);
+        uint8_t* q = out.data();
+        *q++ = INDEX_MARKER;
+        q = put_u32(q, (uint32_t)index_.size());
+        for (const IndexEntry& e : index_) {
+            q = put_u64(q, e.offset);
+            q = put_u64(q, e.state.cycle);
+            q = put_u64(q, e.state.conflicts);
+            q = put_u64(q, e.state.events);
+            q = put_u32(q, e.state.level);
+            *q++ = e.state.phase;
+            for (int d = 0; d < DS_COUNT; ++d) q = put_u64(q, e.state.last_addr[d]);
+        }
+        q = put_u64(q, index_offset);
+        std::memcpy(q, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+        writeFile(out.data(), out.size());
     }
     std::fclose(fp_);
     fp_ = nullptr;
@@ -1,16 +1,26 @@
 #ifndef TRACE_WRITER_H
 #define TRACE_WRITER_H
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 // Compact binary trace writer for the SAT solver simulator.
 //
 // Format spec: TRACE_FORMAT.md (repo root).
-// Thread model: single-threaded. SST clockTick and coroutines run on one OS
-// thread; no locking. Do not reuse this class from multiple threads.
+// Thread model: the emit*() calls come from the simulator thread only (SST
+// clockTick and coroutines run on one OS thread) and never lock. Events are
+// encoded into one of two buffers; when it fills, the simulator swaps it with
+// the other one and a private writer thread compresses and writes the full
+// buffer as one block of the file. The simulator only waits if the writer
+// is still busy with the previous block.
 class TraceWriter {
 public:
     enum DsId : uint8_t {
@@ -26,9 +36,35 @@ public:
         DS_COUNT       = 9,
     };
 
+    // Region table; an address belongs to the region with the highest base
+    // at or below it, and to DS_UNKNOWN below every region. Unless the bases
+    // are too finely aligned, classify() reads the region off a table
+    // indexed by the address bits above the bases' common alignment.
     struct DsMap {
-        DsId nibble[16];
-        DsMap() { for (int i = 0; i < 16; ++i) nibble[i] = DS_UNKNOWN; }
+        struct Region {
+            uint64_t base;
+            DsId ds;
+        };
+        static const uint64_t MAX_LUT = 4096;
+        std::vector<Region> regions;  // ascending base
+        std::vector<DsId> lut;        // empty: search regions
+        int shift = 63;
+
+        void add(uint64_t base, DsId ds) {
+            regions.insert(std::upper_bound(regions.begin(), regions.end(), base,
+                [](uint64_t b, const Region& r) { return b < r.base; }), Region{base, ds});
+            shift = 63;
+            for (const Region& r : regions) if (r.base) shift = std::min(shift, __builtin_ctzll(r.base));
+            lut.clear();
+            if ((regions.back().base >> shift) >= MAX_LUT) return;
+            lut.resize((regions.back().base >> shift) + 1);
+            for (size_t i = 0; i < lut.size(); i++) lut[i] = search((uint64_t)i << shift);
+        }
+        DsId search(uint64_t addr) const {
+            auto it = std::upper_bound(regions.begin(), regions.end(), addr,
+                [](uint64_t a, const Region& r) { return a < r.base; });
+            return it == regions.begin() ? DS_UNKNOWN : std::prev(it)->ds;
+        }
     };
 
     // Event tag bytes (see TRACE_FORMAT.md).
@@ -48,12 +84,33 @@ public:
         TAG_FINISH    = 0x7f,
     };
 
+    // Block payload encoding (see TRACE_FORMAT.md)
+    enum Codec : uint8_t {
+        CODEC_NONE = 0,
+        CODEC_ZLIB = 1,
+    };
+
+    // v1.1 framing, shared with TraceReader (TRACE_FORMAT.md §2.1, §2.2)
+    static constexpr uint8_t BLOCK_MARKER = 0xB1;
+    static constexpr uint8_t INDEX_MARKER = 0x1D;
+    static constexpr size_t  BLOCK_HEADER_BYTES = 1 + 1 + 4 + 4;
+    static constexpr size_t  INDEX_ENTRY_BYTES = 4*8 + 4 + 1 + 8*DS_COUNT;
+    static constexpr size_t  TRAILER_BYTES = 16;
+    static constexpr char    INDEX_MAGIC[8] = {'S','S','T','I','D','X','\0','\0'};
+
     TraceWriter();
     ~TraceWriter();
 
-    bool open(const std::string& path, size_t ring_bytes);
-    bool enabled() const { return fp_ != nullptr && !failed_; }
+    // ring_bytes is the size of each of the two buffers, and so the raw size
+    // of a block and the granularity of the seek index
+    bool open(const std::string& path, size_t ring_bytes,
+              Codec codec = CODEC_ZLIB, int level = 1);
+    bool enabled() const { return fp_ != nullptr && !failed(); }
     uint64_t events() const { return events_; }
+    // Valid after close()
+    uint64_t blocks() const { return index_.size(); }
+    uint64_t fileBytes() const { return bytes_; }
+    uint64_t stalls() const { return stalls_; }
 
     void setDsMap(const DsMap& m) { ds_map_ = m; }
     void writeHeader(const std::string& cnf_path, uint64_t seed,
@@ -66,7 +123,7 @@ public:
     //   bytes 2..: zigzag varint `addr - last_addr_per_ds[ds]`
     //   [if size_class == 7]: uvarint explicit size
     inline void emitMem(bool is_write, uint64_t addr, uint32_t size) {
-        if (__builtin_expect(fp_ == nullptr || failed_, 0)) return;
+        if (__builtin_expect(fp_ == nullptr || failed(), 0)) return;
         if (__builtin_expect(pos_ + 32 >= cap_, 0)) flushLocked();
 
         DsId ds = classify(addr);
@@ -109,9 +166,26 @@ public:
     void emitRestart(int restart_idx);
     void emitReduce(int removed, int kept);
 
+    // Drains both buffers, then appends FINISH, the seek index and the
+    // trailer. Joins the writer thread.
     void close(uint64_t total_cycles);
 
 private:
+    // Decoder state at the first byte of a block, what a reader needs to
+    // start decoding there instead of at the beginning of the stream
+    struct BlockState {
+        uint64_t cycle;
+        uint64_t conflicts;  // CONFLICT records before the block
+        uint64_t events;     // records before the block
+        uint32_t level;
+        uint8_t  phase;
+        uint64_t last_addr[DS_COUNT];
+    };
+    struct IndexEntry {
+        uint64_t offset;     // file offset of the block
+        BlockState state;
+    };
+
     static inline uint8_t* writeUVarint(uint8_t* p, uint64_t v) {
         while (v >= 0x80) {
             *p++ = (uint8_t)(v | 0x80);
@@ -126,23 +200,56 @@ private:
     }
 
     inline DsId classify(uint64_t addr) const {
-        uint8_t nib = (uint8_t)((addr >> 28) & 0xF);
-        return ds_map_.nibble[nib];
+        if (__builtin_expect(ds_map_.lut.empty(), 0)) return ds_map_.search(addr);
+        uint64_t slot = addr >> ds_map_.shift;
+        return slot < ds_map_.lut.size() ? ds_map_.lut[slot] : ds_map_.lut.back();
     }
 
+    bool failed() const { return failed_.load(std::memory_order_relaxed); }
     void ensureSpace(size_t n);
+    // Hand the filled buffer to the writer thread and start the next block
     void flushLocked();
-    void writeRaw(const void* data, size_t n);
-    void updateCrc(const uint8_t* data, size_t n);
+    void waitIdle();
+    void snapshot(BlockState& st) const;
+
+    // Writer thread
+    void writerLoop();
+    void writeBlock(const uint8_t* data, size_t n, const BlockState& st);
+    bool writeFile(const void* data, size_t n);
 
     FILE*    fp_    = nullptr;
-    uint8_t* buf_   = nullptr;
+    uint8_t* buf_   = nullptr;   // filled by the simulator
+    uint8_t* spare_ = nullptr;   // owned by the writer while job_pending_
     size_t   cap_   = 0;     // usable capacity (real allocation - 64 B slack)
     size_t   pos_   = 0;
     uint64_t events_ = 0;
-    uint64_t bytes_  = 0;
+    uint64_t stalls_ = 0;    // flushes that waited for the writer
+    Codec    codec_ = CODEC_ZLIB;
+    int      level_ = 1;
+    std::atomic<bool> failed_{false};
+
+    // Decoder state mirrored for the seek index
+    BlockState block_state_;             // at the start of buf_
+    uint64_t last_cycle_ = 0;
+    uint64_t conflicts_  = 0;
+    uint32_t cur_level_  = 0;
+    uint8_t  cur_phase_  = 0;
+
+    // Handoff to the writer thread, one block in flight
+    std::thread thread_;
+    std::mutex mu_;
+    std::condition_variable cv_;
+    bool job_pending_ = false;
+    bool stop_ = false;
+    size_t job_len_ = 0;
+    BlockState job_state_;
+
+    // Writer-thread state; the simulator reads it only when the writer is
+    // idle or joined
+    uint64_t bytes_  = 0;    // file offset
     uint32_t crc_    = 0xFFFFFFFFu;
-    bool     failed_ = false;
+    std::vector<uint8_t> zbuf_;
+    std::vector<IndexEntry> index_;
 
     DsMap    ds_map_;
     uint64_t last_addr_[DS_COUNT] = {0};
@@ -0,0 +1,82 @@
+#ifndef UNTIMED_PRELOADER_H
+#define UNTIMED_PRELOADER_H
+
+#include <sst/core/interfaces/stdMem.h>
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <cstring>
+
+// Coalesces init-time untimed writes into large contiguous regions before
+// they are handed to StandardMem::sendUntimedData, so the number of untimed
+// events scales with the bytes preloaded rather than with the number of
+// objects or staging batches. A write that starts where an open region ends
+// (on the same interface) is appended to it; regions are sent once they
+// reach max_region_bytes or on flush(). Overlapping writes force the older
+// region out first, so write order is preserved.
+class UntimedPreloader {
+public:
+    explicit UntimedPreloader(size_t max_region_bytes = 64 << 20)
+        : max_region_bytes(max_region_bytes), num_writes(0), num_regions(0), num_bytes(0) {}
+
+    void setMaxRegionBytes(size_t bytes) { max_region_bytes = bytes; }
+
+    void write(SST::Interfaces::StandardMem* mem, uint64_t addr, const uint8_t* data, size_t size) {
+        if (size == 0) return;
+        num_writes++;
+        num_bytes += size;
+
+        // older overlapping regions must reach memory first
+        for (auto ov = open.upper_bound(addr); ov != open.end() && ov->second.addr < addr + size;
+             ov = open.upper_bound(addr)) {
+            send(ov->second);
+            open.erase(ov);
+        }
+
+        Region r;
+        auto it = open.find(addr);
+        if (it != open.end() && it->second.mem == mem) {
+            // extend the region that ends at addr, re-keyed by its new end
+            r = std::move(it->second);
+            open.erase(it);
+            r.data.insert(r.data.end(), data, data + size);
+        } else {
+            r.mem = mem;
+            r.addr = addr;
+            r.data.assign(data, data + size);
+        }
+        if (r.data.size() >= max_region_bytes) send(r);
+        else open.emplace(addr + size, std::move(r));
+    }
+
+    void flush() {
+        for (auto& kv : open) send(kv.second);
+        open.clear();
+    }
+
+    uint64_t writes() const { return num_writes; }
+    uint64_t regions() const { return num_regions; }
+    uint64_t bytes() const { return num_bytes; }
+
+private:
+    struct Region {
+        SST::Interfaces::StandardMem* mem;
+        uint64_t addr;
+        std::vector<uint8_t> data;
+    };
+
+    void send(Region& r) {
+        size_t size = r.data.size();
+        r.mem->sendUntimedData(new SST::Interfaces::StandardMem::Write(
+            r.addr, size, std::move(r.data), true, 0x1));  // posted, not cacheable
+        num_regions++;
+    }
+
+    size_t max_region_bytes;
+    std::map<uint64_t, Region> open;  // open regions keyed by end address
+    uint64_t num_writes;
+    uint64_t num_regions;
+    uint64_t num_bytes;
+};
+
+#endif // UNTIMED_PRELOADER_H
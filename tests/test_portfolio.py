@@ -0,0 +1,212 @@
+import sst
+import os
+import argparse
+
+# Portfolio of SATSolver components racing on one instance.
+# Every solver has its own L1; the L1s share an L2 and the memory controller
+# through a bus, with each solver's data structures in a disjoint 2 GiB
+# window of the address space. Learnt clauses are exchanged over a full mesh
+# of share links, and the first solver to finish stops the others.
+#
+# Runs serially or partitioned over MPI ranks, e.g.
+#   mpirun -np 4 sst tests/test_portfolio.py -- --solvers 4 --pin-ranks
+
+def parse_args():
+    """Parse command line arguments"""
+    parser = argparse.ArgumentParser(
+        description='Run a SAT solver portfolio with clause sharing in SST',
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter
+    )
+    parser.add_argument('--cnf', dest='cnf_path',
+                        default=os.path.join(os.path.dirname(__file__), "test.cnf"),
+                        help='Path to the CNF file')
+    parser.add_argument('--solvers', dest='solvers', type=int, default=2,
+                        help='Number of solvers in the portfolio')
+    parser.add_argument('--rand', dest='random_seed', type=int, default=0,
+                        help='Random seed of solver 0; solver i uses seed + i')
+    parser.add_argument('--random-freq', dest='random_var_freq', type=float, default=0.02,
+                        help='Frequency of random decisions (0.0-1.0), so the seeds diverge')
+    parser.add_argument('--restarts', dest='restarts', type=str, default='luby,glucose',
+                        help='Comma-separated restart policies (luby or glucose), assigned round-robin')
+    parser.add_argument('--share-max-lbd', dest='share_max_lbd', type=int, default=2,
+                        help='Share learnts with at most this LBD')
+    parser.add_argument('--share-max-size', dest='share_max_size', type=int, default=2,
+                        help='Share learnts with at most this many literals')
+    parser.add_argument('--share-latency', dest='share_latency', type=str, default='20ns',
+                        help='Latency of a share link')
+    parser.add_argument('--share-bw', dest='share_bytes_per_cycle', type=int, default=8,
+                        help='Bytes per cycle of a share link (0 = unlimited)')
+    parser.add_argument('--pin-ranks', dest='pin_ranks', action='store_true', default=False,
+                        help='Place each solver with its L1 on rank i %% ranks (shared L2 and memory on rank 0)')
+    parser.add_argument('--verbose', '-v', dest='verbose', type=int, default=1,
+                        help='Verbosity level (0-7)')
+    parser.add_argument('--timeout-cycles', dest='timeout_cycles', type=int, default=0,
+                        help='Per-solver timeout in cycles (0 = no timeout)')
+    parser.add_argument('--freq', dest='freq', type=str, default='2GHz',
+                        help='Clock frequency')
+    parser.add_argument('--l1-size', dest='l1_size', type=str, default='64KiB',
+                        help='L1 cache size of each solver')
+    parser.add_argument('--l1-latency', dest='l1_latency', type=str, default='1',
+                        help='L1 cache latency in cycles')
+    parser.add_argument('--l2-size', dest='l2_size', type=str, default='1MiB',
+                        help='Shared L2 cache size')
+    parser.add_argument('--l2-latency', dest='l2_latency', type=str, default='8',
+                        help='Shared L2 cache latency in cycles')
+    parser.add_argument('--mem-latency', dest='mem_latency', type=str, default='100ns',
+                        help='Memory access latency')
+    parser.add_argument('--stats-file', dest='stats_file', type=str, default='portfolio_stats.csv',
+                        help='Path to the statistics CSV file')
+    return parser.parse_args()
+
+
+args = parse_args()
+restart_policies = args.restarts.split(',')
+for policy in restart_policies:
+    if policy not in ('luby', 'glucose'):
+        raise ValueError(f"Unknown restart policy: {policy}")
+
+ranks = sst.getMPIRankCount() if args.pin_ranks else 1
+if args.pin_ranks:
+    sst.setProgramOption("partitioner", "sst.self")
+
+print(f"Portfolio of {args.solvers} solvers on {args.cnf_path} ({ranks} ranks)")
+
+# Address layout of one solver, relocated into its own window
+region_offsets = {
+    "heap_base_addr"        : 0x00000000,
+    "indices_base_addr"     : 0x10000000,
+    "variables_base_addr"   : 0x20000000,
+    "watches_base_addr"     : 0x30000000,
+    "watch_nodes_base_addr" : 0x40000000,
+    "clauses_cmd_base_addr" : 0x50000000,
+    "clauses_base_addr"     : 0x60000000,
+    "var_act_base_addr"     : 0x70000000,
+}
+window = 0x80000000
+mem_bytes = window * args.solvers
+
+# Shared L2 and memory
+bus = sst.Component("l1_bus", "memHierarchy.Bus")
+bus.addParams({
+    "bus_frequency" : args.freq,
+})
+
+l2cache = sst.Component("shared_l2cache", "memHierarchy.Cache")
+l2cache.addParams({
+    "cache_frequency"    : args.freq,
+    "cache_size"         : args.l2_size,
+    "cache_line_size"    : "64",
+    "associativity"      : "16",
+    "access_latency_cycles" : args.l2_latency,
+    "L1"                 : "0",
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MSI",
+})
+
+memctrl = sst.Component("global_memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : args.freq,
+    "addr_range_start" : "0",
+    "addr_range_end" : hex(mem_bytes - 1),
+    "mem_size" : f"{mem_bytes // (1 << 20)}MiB",
+})
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : args.mem_latency,
+    "mem_size" : f"{mem_bytes // (1 << 20)}MiB",
+})
+
+if args.pin_ranks:
+    for comp in (bus, l2cache, memctrl):
+        comp.setRank(0, 0)
+
+solvers = []
+for i in range(args.solvers):
+    policy = restart_policies[i % len(restart_policies)]
+    solver = sst.Component(f"solver{i}", "satsolver.SATSolver")
+    params = {
+        "clock" : args.freq,
+        "verbose" : str(args.verbose),
+        "cnf_file" : args.cnf_path,
+        "random_seed" : str(args.random_seed + i),
+        "random_var_freq" : str(args.random_var_freq),
+        "glucose_restart" : "true" if policy == "glucose" else "false",
+        "timeout_cycles" : str(args.timeout_cycles),
+        "portfolio_id" : str(i),
+        "share_max_lbd" : str(args.share_max_lbd),
+        "share_max_size" : str(args.share_max_size),
+        "share_bytes_per_cycle" : str(args.share_bytes_per_cycle),
+    }
+    for name, offset in region_offsets.items():
+        params[name] = hex(i * window + offset)
+    solver.addParams(params)
+    print(f"  solver{i}: seed {args.random_seed + i}, {policy} restarts")
+
+    heap = solver.setSubComponent("order_heap", "satsolver.PipelinedHeap")
+    heap.addParams({
+        "verbose" : str(args.verbose),
+    })
+    iface = solver.setSubComponent("global_memory", "memHierarchy.standardInterface")
+
+    l1cache = sst.Component(f"solver{i}_l1cache", "memHierarchy.Cache")
+    l1cache.addParams({
+        "cache_frequency"    : args.freq,
+        "cache_size"         : args.l1_size,
+        "cache_line_size"    : "64",
+        "associativity"      : "8",
+        "access_latency_cycles" : args.l1_latency,
+        "L1"                 : "1",
+        "replacement_policy" : "lru",
+        "coherence_protocol" : "MSI",
+    })
+    if args.pin_ranks:
+        solver.setRank(i % ranks, 0)
+        l1cache.setRank(i % ranks, 0)
+
+    heap_link = sst.Link(f"solver{i}_heap_link")
+    heap_link.connect((solver, "heap_port", "50ps"), (heap, "response", "50ps"))
+    cpu_link = sst.Link(f"solver{i}_cpu_to_cache_link")
+    cpu_link.connect((iface, "lowlink", "1ns"), (l1cache, "highlink", "1ns"))
+    bus_link = sst.Link(f"solver{i}_l1_to_bus_link")
+    bus_link.connect((l1cache, "lowlink", "1ns"), (bus, f"highlink{i}", "1ns"))
+    solvers.append(solver)
+
+bus_l2_link = sst.Link("bus_to_l2_link")
+bus_l2_link.connect((bus, "lowlink0", "1ns"), (l2cache, "highlink", "1ns"))
+l2_mem_link = sst.Link("l2_to_mem_link")
+l2_mem_link.connect((l2cache, "lowlink", "1ns"), (memctrl, "highlink", "1ns"))
+
+# Full mesh of share links; solver i reaches its peers on share_port_0..N-2
+next_port = [0] * args.solvers
+for i in range(args.solvers):
+    for j in range(i + 1, args.solvers):
+        share_link = sst.Link(f"share_link_{i}_{j}")
+        share_link.connect((solvers[i], f"share_port_{next_port[i]}", args.share_latency),
+                           (solvers[j], f"share_port_{next_port[j]}", args.share_latency))
+        next_port[i] += 1
+        next_port[j] += 1
+
+sst.setStatisticLoadLevel(7)
+sst.enableStatisticsForComponentType("satsolver.SATSolver", [
+    "decisions",
+    "conflicts",
+    "learned",
+    "restarts",
+    "share_exported",
+    "share_imported",
+    "share_dropped",
+    "share_satisfied",
+    "share_bytes",
+], {
+    "type": "sst.AccumulatorStatistic",
+    "rate": "1s"
+})
+sst.enableStatisticsForComponentType("memHierarchy.Cache", [
+    "CacheHits",
+    "CacheMisses",
+], {
+    "type": "sst.AccumulatorStatistic",
+    "rate": "1s"
+})
+sst.setStatisticOutput("sst.statOutputCSV",
+    {"filepath": args.stats_file, "separator": ","})
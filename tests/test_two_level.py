@@ -75,9 +75,24 @@ def parse_args():
     parser.add_argument('--prefetch', dest='enable_prefetch', 
                         action='store_true', default=False,
                         help='Enable directed prefetching')
+    parser.add_argument('--prefetch-chase', dest='prefetch_chase', action='store_true',
+                        help='Let the prefetcher chase watch lists ahead of propagation (with --prefetch)')
+    parser.add_argument('--prefetch-lookahead', dest='prefetch_lookahead', type=int, default=2,
+                        help='Upcoming trail literals whose watch lists are chased')
+    parser.add_argument('--chase-depth', dest='chase_depth', type=int, default=4,
+                        help='Max watcher blocks the prefetcher follows per watch list')
+    parser.add_argument('--chase-degree', dest='chase_degree', type=int, default=8,
+                        help='Max clauses the prefetcher fetches per watcher block')
+    parser.add_argument('--no-clock-gating', dest='clock_gating',
+                        action='store_false', default=True,
+                        help='Keep the solver and heap clocks running while they wait on responses')
     parser.add_argument('--spec', dest='enable_speculative',
                         action='store_true', default=False,
                         help='Enable speculative propagation')
+    parser.add_argument('--spec-depth', dest='spec_depth', type=int, default=1,
+                        help='Upcoming decisions speculated on (1-8)')
+    parser.add_argument('--spec-reuse', dest='spec_reuse', action='store_true', default=False,
+                        help='Enqueue the checked speculative implications of a matching decision')
     parser.add_argument('--classic-heap', dest='classic_heap',
                         action='store_true', default=False,
                         help='Use classic heap implementation instead of pipelined heap')
@@ -91,6 +106,9 @@ def parse_args():
     parser.add_argument('--profile-2wl', dest='profile_2wl',
                         action='store_true', default=False,
                         help='Enable 2WL clause-access reduction profiling (host-side)')
+    parser.add_argument('--profile-mem', dest='profile_mem',
+                        action='store_true', default=False,
+                        help='Profile memory latency, reads in flight and bandwidth per data structure')
     parser.add_argument('--profile-prop-timing', dest='profile_prop_timing',
                         action='store_true', default=False,
                         help='Enable per-propagation timing breakdown (auto-on with --spec)')
@@ -100,11 +118,100 @@ def parse_args():
     parser.add_argument('--cache-profiler', dest='cache_profiler',
                         action='store_true', default=False,
                         help='Attach the satsolver.CacheProfiler subcomponent to L1 and L2 caches')
+    parser.add_argument('--profiler-sample-rate', dest='profiler_sample_rate',
+                        type=float, default=0.01,
+                        help='Fraction of cache lines the profilers sample for reuse distances (0 disables)')
     parser.add_argument('--trace-file', dest='trace_file', default='',
                         help='Path to write binary memory-access trace (empty disables)')
     parser.add_argument('--trace-buffer-bytes', dest='trace_buffer_bytes',
                         type=int, default=4194304,
-                        help='Ring buffer size for trace writer (bytes)')
+                        help='Size of each trace writer buffer, and of a trace block (bytes)')
+    parser.add_argument('--trace-compression', dest='trace_compression',
+                        choices=['zlib', 'none'], default='zlib',
+                        help='Compression of trace blocks')
+    parser.add_argument('--para-lits', dest='para_lits', type=int, default=1,
+                        help='Number of literals propagated in parallel')
+    parser.add_argument('--propagators', dest='propagators', type=int, default=1,
+                        help='Number of watchers propagated in parallel (1-8)')
+    parser.add_argument('--learners', dest='learners', type=int, default=1,
+                        help='Number of parallel learners')
+    parser.add_argument('--minimizers', dest='minimizers', type=int, default=1,
+                        help='Number of parallel minimizers')
+    parser.add_argument('--reduce-unit', dest='reduce_unit', action='store_true', default=False,
+                        help='Reduce the learnt DB with the streaming reduction unit')
+    parser.add_argument('--reducers', dest='reducers', type=int, default=4,
+                        help='Parallel read streams of the DB reduction unit')
+    parser.add_argument('--reduce-select', dest='reduce_select', choices=['median', 'bitonic'], default='median',
+                        help='Removal-set selection model of the DB reduction unit')
+    parser.add_argument('--reduce-width', dest='reduce_width', type=int, default=16,
+                        help='Key comparisons per cycle of the DB reduction unit')
+    parser.add_argument('--learnt-tiers', dest='learnt_tiers', action='store_true',
+                        help='Keep learnts in core/mid/local tiers by LBD and only reduce the local tier (with --reduce-unit)')
+    parser.add_argument('--tier-core-lbd', dest='tier_core_lbd', type=int, default=2,
+                        help='Largest LBD of a core tier learnt')
+    parser.add_argument('--tier-mid-lbd', dest='tier_mid_lbd', type=int, default=6,
+                        help='Largest LBD of a mid tier learnt')
+    parser.add_argument('--tier-core-bytes', dest='tier_core_bytes', type=int, default=0,
+                        help='Bytes of the learnt region reserved for core tier clauses (0 = none)')
+    parser.add_argument('--tier-mid-bytes', dest='tier_mid_bytes', type=int, default=0,
+                        help='Bytes of the learnt region reserved for mid tier clauses (0 = none)')
+    parser.add_argument('--scratchpad-size', dest='scratchpad_size', type=int, default=0,
+                        help='Bytes of the clause scratchpad (0 = no scratchpad)')
+    parser.add_argument('--scratchpad-latency', dest='scratchpad_latency', type=str, default='2ns',
+                        help='Clause scratchpad hit latency')
+    parser.add_argument('--scratchpad-policy', dest='scratchpad_policy', type=str, default='recent',
+                        choices=['recent', 'lbd', 'small'],
+                        help='Which clauses the scratchpad pins')
+    parser.add_argument('--scratchpad-lbd', dest='scratchpad_lbd', type=int, default=3,
+                        help='Largest LBD pinned by the lbd scratchpad policy')
+    parser.add_argument('--ff-conflicts', dest='fast_forward_conflicts', type=int, default=0,
+                        help='Fast-forward functionally until this many conflicts (0 = no limit)')
+    parser.add_argument('--ff-decisions', dest='fast_forward_decisions', type=int, default=0,
+                        help='Fast-forward functionally until this many decisions (0 = no limit)')
+    parser.add_argument('--sample-interval', dest='sample_interval', type=int, default=0,
+                        help='Sampled simulation: conflicts per sampling period (0 = off)')
+    parser.add_argument('--sample-warmup', dest='sample_warmup', type=int, default=1000,
+                        help='Timed warm-up conflicts before each measured window')
+    parser.add_argument('--sample-detail', dest='sample_detail', type=int, default=1000,
+                        help='Measured conflicts per sampling period')
+    parser.add_argument('--heaplanes', dest='heaplanes', type=int, default=1,
+                        help='Number of heap lanes (classic heap workers, or concurrent bumps in the pipelined heap)')
+    parser.add_argument('--pre-watchers', dest='pre_watchers', type=int, default=0,
+                        help='Number of pre-watchers in watch metadata')
+    parser.add_argument('--sq-depth', dest='store_queue_depth', type=int, default=0,
+                        help='Store queue depth per data structure (0 = unbounded)')
+    parser.add_argument('--var-layout', dest='var_layout', choices=['split', 'packed', 'soa'], default='split',
+                        help='Assignment memory layout; packed and soa model value checks as reads')
+    parser.add_argument('--clause-placement', dest='clause_placement', choices=['packed', 'line', 'head', 'split'],
+                        default='packed', help='Clause placement policy relative to cache lines')
+    parser.add_argument('--watch-compact', dest='watch_compact_lists', type=int, default=0,
+                        help='Sparse watch lists compacted per DB reduction (0 = off)')
+    parser.add_argument('--address-layout', dest='address_layout', choices=['linear', 'interleave', 'hash'],
+                        default='linear', help='Physical address mapping of the solver-side data structures')
+    parser.add_argument('--layout-stripes', dest='layout_stripes', type=int, default=1,
+                        help='Channel/bank stripes of the DRAM address mapping (power of two)')
+    parser.add_argument('--layout-stripe-shift', dest='layout_stripe_shift', type=int, default=6,
+                        help='Lowest address bit of the stripe index in the DRAM address mapping')
+    parser.add_argument('--layout-interleave', dest='layout_interleave', default='64',
+                        help='Interleave granularity in bytes, with region:bytes overrides, e.g. 256,clauses:64')
+    parser.add_argument('--colocate-watches', dest='layout_colocate_watches', action='store_true',
+                        help='Allocate watcher blocks in the stripe of their first clause')
+    parser.add_argument('--parse-threads', dest='parse_threads', type=int, default=0,
+                        help='Threads for CNF parsing (0 = all hardware threads)')
+    parser.add_argument('--preload-region-bytes', dest='preload_region_bytes', type=int, default=64 << 20,
+                        help='Max bytes per coalesced untimed init write')
+    parser.add_argument('--fiber-stack-size', dest='fiber_stack_size', type=int, default=0,
+                        help='Stack bytes per pooled solver coroutine (0 = boost default)')
+    parser.add_argument('--cnf-cache-dir', dest='cnf_cache_dir', default='',
+                        help='Directory for the binary parsed-CNF cache (empty disables)')
+    parser.add_argument('--gc-compact', dest='gc_compact', action='store_true',
+                        help='Compact the learnt clause region during DB reductions')
+    parser.add_argument('--gc-interval', dest='gc_interval', type=int, default=1,
+                        help='Compact on every Nth DB reduction')
+    parser.add_argument('--gc-order', dest='gc_order', choices=['activity', 'address'], default='activity',
+                        help='Order of the compacted learnt clauses')
+    parser.add_argument('--binary-watchers', dest='binary_watchers', action='store_true',
+                        help='Propagate binary clauses from their watchers without fetching the clause')
 
     args = parser.parse_args()
     
@@ -196,7 +303,7 @@ else:
 if args.enable_prefetch:
     print(f"Directed prefetching enabled")
 if args.enable_speculative:
-    print(f"Speculative propagation enabled")
+    print(f"Speculative propagation enabled (depth {args.spec_depth}{', reusing implications' if args.spec_reuse else ''})")
 print(f"Clock frequency: {args.freq}")
 if args.timeout_cycles > 0:
     print(f"Solver timeout set to: {args.timeout_cycles} cycles")
@@ -204,6 +311,8 @@ if args.glucose_restart:
     print(f"Glucose-style LBD-based restarts enabled")
 if args.profile_2wl:
     print(f"2WL clause-access reduction profiling enabled")
+if args.profile_mem:
+    print(f"Per-structure memory profiling enabled")
 if args.profile_prop_timing or args.enable_speculative:
     print(f"Per-propagation timing breakdown enabled")
 if args.enable_histograms:
@@ -211,7 +320,7 @@ if args.enable_histograms:
 if args.cache_profiler:
     print(f"Cache profiler subcomponent enabled (L1+L2)")
 if args.trace_file:
-    print(f"Binary trace enabled: {args.trace_file} (buffer={args.trace_buffer_bytes} B)")
+    print(f"Binary trace enabled: {args.trace_file} (buffer={args.trace_buffer_bytes} B, {args.trace_compression})")
 
 # Create the SAT solver component
 solver = sst.Component("solver", "satsolver.SATSolver")
@@ -247,13 +356,57 @@ params = {
     "var_decay": str(args.var_decay),
     "clause_decay": str(args.clause_decay),
     "prefetch_enabled": str(args.enable_prefetch),
+    "prefetch_chase": str(args.prefetch_chase),
+    "prefetch_lookahead": str(args.prefetch_lookahead),
     "enable_speculative": str(args.enable_speculative),
+    "spec_depth": str(args.spec_depth),
+    "spec_reuse": str(args.spec_reuse),
+    "clock_gating": str(args.clock_gating),
     "timeout_cycles": str(args.timeout_cycles),
     "glucose_restart": str(args.glucose_restart),
     "profile_2wl": str(args.profile_2wl),
     "profile_prop_timing": str(args.profile_prop_timing),
+    "profile_mem": str(args.profile_mem),
     "trace_file": args.trace_file,
     "trace_buffer_bytes": str(args.trace_buffer_bytes),
+    "trace_compression": args.trace_compression,
+    "para_lits": str(args.para_lits),
+    "propagators": str(args.propagators),
+    "learners": str(args.learners),
+    "minimizers": str(args.minimizers),
+    "reduce_unit": str(args.reduce_unit),
+    "reducers": str(args.reducers),
+    "reduce_select": args.reduce_select,
+    "reduce_width": str(args.reduce_width),
+    "learnt_tiers": "true" if args.learnt_tiers else "false",
+    "tier_core_lbd": str(args.tier_core_lbd),
+    "tier_mid_lbd": str(args.tier_mid_lbd),
+    "tier_core_bytes": str(args.tier_core_bytes),
+    "tier_mid_bytes": str(args.tier_mid_bytes),
+    "fast_forward_conflicts": str(args.fast_forward_conflicts),
+    "fast_forward_decisions": str(args.fast_forward_decisions),
+    "sample_interval": str(args.sample_interval),
+    "sample_warmup": str(args.sample_warmup),
+    "sample_detail": str(args.sample_detail),
+    "heaplanes": str(args.heaplanes),
+    "pre_watchers": str(args.pre_watchers),
+    "store_queue_depth": str(args.store_queue_depth),
+    "var_layout": args.var_layout,
+    "clause_placement": args.clause_placement,
+    "watch_compact_lists": str(args.watch_compact_lists),
+    "address_layout": args.address_layout,
+    "layout_stripes": str(args.layout_stripes),
+    "layout_stripe_shift": str(args.layout_stripe_shift),
+    "layout_interleave": args.layout_interleave,
+    "layout_colocate_watches": str(args.layout_colocate_watches),
+    "parse_threads": str(args.parse_threads),
+    "cnf_cache_dir": args.cnf_cache_dir,
+    "preload_region_bytes": str(args.preload_region_bytes),
+    "fiber_stack_size": str(args.fiber_stack_size),
+    "gc_compact": str(args.gc_compact),
+    "gc_interval": str(args.gc_interval),
+    "gc_order": args.gc_order,
+    "binary_watchers": str(args.binary_watchers),
 }
 if args.decision_path:
     params["decision_file"] = args.decision_path
@@ -272,6 +425,16 @@ else:
 heap.addParams({
     "verbose" : str(args.verbose),
 })
+
+if args.scratchpad_size > 0:
+    scratchpad = solver.setSubComponent("clause_scratchpad", "satsolver.ClauseScratchpad")
+    scratchpad.addParams({
+        "size" : str(args.scratchpad_size),
+        "latency" : args.scratchpad_latency,
+        "policy" : args.scratchpad_policy,
+        "lbd_limit" : str(args.scratchpad_lbd),
+        "verbose" : str(args.verbose),
+    })
 print()
 
 # Configure memory interface for global operations (heap and variables)
@@ -302,10 +465,14 @@ if args.cache_profiler:
     global_cache_profiler.addParams({
         "cache_level": "L1",
         "heap_base_addr": hex(heap_base_addr),
+        "indices_base_addr": hex(indices_base_addr),
         "variables_base_addr": hex(variables_base_addr),
         "watches_base_addr": hex(watches_base_addr),
+        "watch_nodes_base_addr": hex(watch_nodes_base_addr),
         "clauses_cmd_base_addr": hex(clauses_cmd_base_addr),
+        "clauses_base_addr": hex(clauses_base_addr),
         "var_act_base_addr": hex(var_act_base_addr),
+        "reuse_sample_rate": str(args.profiler_sample_rate),
         "verbose": str(args.verbose),
         "exclude_cold_misses": "1"
     })
@@ -316,7 +483,11 @@ if args.cache_profiler:
 # prefetcher1 = global_cache.setSubComponent("prefetcher", "cassini.PalaPrefetcher", 1)
 if args.enable_prefetch:
     prefetcher = global_cache.setSubComponent("prefetcher", "satsolver.DirectedPrefetcher", 1)
-    prefetcher.addParams({"cache_line_size": "64"})
+    prefetcher.addParams({
+        "cache_line_size": "64",
+        "chase_depth": str(args.chase_depth),
+        "chase_degree": str(args.chase_degree),
+    })
     
     # Connect prefetcher to solver
     prefetch_link = sst.Link("prefetch_link")
@@ -352,15 +523,26 @@ if args.cache_profiler:
     global_l2cache_profiler.addParams({
         "cache_level": "L2",
         "heap_base_addr": hex(heap_base_addr),
+        "indices_base_addr": hex(indices_base_addr),
         "variables_base_addr": hex(variables_base_addr),
         "watches_base_addr": hex(watches_base_addr),
+        "watch_nodes_base_addr": hex(watch_nodes_base_addr),
         "clauses_cmd_base_addr": hex(clauses_cmd_base_addr),
+        "clauses_base_addr": hex(clauses_base_addr),
         "var_act_base_addr": hex(var_act_base_addr),
+        "reuse_sample_rate": str(args.profiler_sample_rate),
         "verbose": str(args.verbose),
         "exclude_cold_misses": "1"
     })
 
 
+# Solver phase changes, so the profilers can break their counts down by phase
+if args.cache_profiler:
+    for i, profiler in enumerate([global_cache_profiler, global_l2cache_profiler]):
+        profile_link = sst.Link("profile_link_%d" % i)
+        profile_link.connect((solver, "profile_port_%d" % i, "1ns"), (profiler, "phase_port", "1ns"))
+
+
 # Create memory controller for global operations
 global_memctrl = sst.Component("global_memory", "memHierarchy.MemController")
 global_memctrl.addParams({
@@ -433,15 +615,60 @@ solver_stats = [
     "bt_distance",
 ]
 if args.enable_speculative:
-    solver_stats += ["spec_started", "spec_finished"]
+    solver_stats += ["spec_started", "spec_finished", "spec_depth_started", "spec_depth_hits",
+                     "spec_depth_dropped", "spec_depth_lines", "spec_wasted_lines"]
+    if args.spec_reuse:
+        solver_stats += ["spec_adopted", "spec_rejected"]
 if args.profile_2wl:
     solver_stats += ["total_occ", "watcher_traversed"]
+solver_stats += ["watch_chain_blocks", "watch_chain_watchers"]
+if args.watch_compact_lists > 0:
+    solver_stats += ["watch_compactions", "watch_blocks_freed"]
+if args.layout_stripes > 1:
+    solver_stats += ["layout_stripe_reads", "layout_stripe_writes"]
+    if args.layout_colocate_watches:
+        solver_stats += ["watch_blocks_colocated"]
+if args.var_layout != "split":
+    solver_stats += ["value_reads"]
+if args.learnt_tiers:
+    solver_stats += ["tier_promoted", "tier_demoted"]
+if args.reduce_unit:
+    solver_stats += ["reduce_cycles", "reduce_stream_bytes", "reduce_select_cycles", "reduce_watch_lists"]
+if args.gc_compact:
+    solver_stats += ["gc_compactions", "gc_moved"]
 
 sst.enableStatisticsForComponentName("solver", solver_stats, {
     "type": "sst.AccumulatorStatistic",
     "rate": "1s"
 })
 
+# Memory profile (opt-in via --profile-mem): one statistic per data structure
+if args.profile_mem:
+    sst.enableStatisticsForComponentName("solver", [
+        "mem_read_bytes", "mem_write_bytes", "mem_busy_cycles",
+    ], {
+        "type": "sst.AccumulatorStatistic",
+        "rate": "1s"
+    })
+    sst.enableStatisticsForComponentName("solver", ["mem_read_latency"], {
+        "type": "sst.HistogramStatistic",
+        "minvalue": "0",
+        "binwidth": "4",
+        "numbins": "64",
+        "dumpbinsonoutput": "1",
+        "includeoutofbounds": "1",
+        "rate": "1s"
+    })
+    sst.enableStatisticsForComponentName("solver", ["mem_outstanding"], {
+        "type": "sst.HistogramStatistic",
+        "minvalue": "0",
+        "binwidth": "1",
+        "numbins": "32",
+        "dumpbinsonoutput": "1",
+        "includeoutofbounds": "1",
+        "rate": "1s"
+    })
+
 # Per-propagation histograms (opt-in via --enable-histograms)
 if args.enable_histograms:
     histogram_params = {
@@ -470,21 +697,28 @@ sst.enableStatisticsForComponentType("memHierarchy.Cache", [
 })
 
 if args.cache_profiler:
+    profiler_regions = ["heap", "indices", "variables", "watches", "watch_nodes",
+                        "clauses_cmd", "clauses", "var_activity"]
     sst.enableStatisticsForComponentType("satsolver.CacheProfiler", [
-        "heap_hits",
-        "heap_misses",
-        "variables_hits",
-        "variables_misses",
-        "watches_hits",
-        "watches_misses",
-        "clauses_hits",
-        "clauses_misses",
-        "var_activity_hits",
-        "var_activity_misses",
-    ], {
+        stat
+        for region in profiler_regions
+        for stat in (region + "_hits", region + "_misses", region + "_cold_misses")
+    ] + ["phase_hits", "phase_misses"], {
         "type": "sst.AccumulatorStatistic",
         "rate": "1s"
     })
+    # Reuse distances in lines; 256-line bins cover up to a 1 MiB cache
+    sst.enableStatisticsForComponentType("satsolver.CacheProfiler", [
+        region + "_reuse" for region in profiler_regions
+    ], {
+        "type": "sst.HistogramStatistic",
+        "minvalue": "0",
+        "binwidth": "256",
+        "numbins": "64",
+        "dumpbinsonoutput": "1",
+        "includeoutofbounds": "1",
+        "rate": "1s"
+    })
 
 # Set statistics output to CSV file
 sst.setStatisticOutput("sst.statOutputCSV", 
@@ -0,0 +1,189 @@
+# -*- coding: utf-8 -*-
+#
+# Small CNF regression runs for the solver features. Each test runs
+# test_two_level.py on a CNF in this directory, checks the answer and the
+# statistic the feature moves. Run with: sst-test-elements -w "*satsolver*"
+
+import os
+import re
+import shutil
+import sys
+
+from sst_unittest import *
+from sst_unittest_support import *
+
+SAT = "SATISFIABLE: All variables assigned"
+UNSAT = "UNSATISFIABLE"
+
+################################################################################
+
+class testcase_satsolver(SSTTestCase):
+
+    def setUp(self):
+        super(type(self), self).setUp()
+
+    def tearDown(self):
+        super(type(self), self).tearDown()
+
+#####
+
+    # Clock gating only skips idle cycles; every link has a positive
+    # latency, so the tick order within a cycle cannot change the result
+    def test_satsolver_clock_gating_ab(self):
+        for cnf, answer in (("planted_3sat.cnf", SAT), ("php_5_4.cnf", UNSAT)):
+            gated = self.solve("gated_" + cnf, cnf, answer)
+            ungated = self.solve("ungated_" + cnf, cnf, answer, "--no-clock-gating")
+            self.assertEqual(self.cycleStats(gated), self.cycleStats(ungated),
+                             "{0}: clock gating changed the cycle counts".format(cnf))
+            self.assertGreater(self.gatedCycles(gated), 0, "{0}: nothing was gated".format(cnf))
+            self.assertEqual(self.gatedCycles(ungated), 0)
+
+    # The timeout is an event of its own, so it lands on the limit even
+    # when the clock is gated at that cycle
+    def test_satsolver_timeout(self):
+        out = self.solve("timeout", "php_5_4.cnf", None, "--timeout-cycles 20000")
+        self.assertIn("Timeout Reached", out)
+        self.assertEqual(self.cycleStats(out)[-1], ("Total", "20000"))
+
+    # A slow L1 keeps the summaries written by recent conflicts in the store
+    # queue, so reductions run without waiting on memory and first yield in
+    # busyCycles; with the clock gated, that wake-up must not be lost
+    def test_satsolver_reduce_unit_forwarded(self):
+        out = self.solve("reduce_forwarded", "php_5_4.cnf", UNSAT,
+                         "--reduce-unit --reducers 1 --l1-latency 2000", timeout_sec=300)
+        self.assertGreater(self.stat(out, "DB_Reductions"), 0)
+        self.assertIn("Reduce unit  :", out)
+        m = re.search(r"^Clauses\s*: forwards (\d+)", out, re.M)
+        self.assertTrue(m and int(m.group(1)) > 0, "no clause reads were forwarded")
+
+    # A functional prefix must not change the search, only its timing
+    def test_satsolver_fast_forward(self):
+        timed = self.solve("ff_off", "php_5_4.cnf", UNSAT)
+        ff = self.solve("ff_on", "php_5_4.cnf", UNSAT, "--ff-conflicts 50")
+        self.assertIn("Fast-forward : switched to timed", ff)
+        for label in ("Decisions", "Propagations", "Conflicts", "Learned", "Removed"):
+            self.assertEqual(self.stat(ff, label), self.stat(timed, label), label)
+
+    # Sampling measures a few timed windows and extrapolates the rest; the
+    # search itself is that of a fully timed run
+    def test_satsolver_sampling(self):
+        timed = self.solve("sample_off", "php_5_4.cnf", UNSAT)
+        out = self.solve("sample_on", "php_5_4.cnf", UNSAT,
+                         "--sample-interval 60 --sample-warmup 10 --sample-detail 20")
+        m = re.search(r"^Windows\s*: (\d+) measured, (\d+) conflicts", out, re.M)
+        self.assertTrue(m and int(m.group(1)) > 0, "no measured window")
+        for label in ("Decisions", "Conflicts"):
+            self.assertEqual(self.stat(out, label), self.stat(timed, label), label)
+        self.assertIsNotNone(re.search(r"^Total\s*: \d+ cycles \+- \d+ \(95%\)", out, re.M))
+
+    # The second run loads the parsed CNF from the cache the first wrote
+    def test_satsolver_cnf_cache(self):
+        cache_dir = os.path.join(self.get_test_output_tmp_dir(), "cnf_cache")
+        shutil.rmtree(cache_dir, ignore_errors=True)
+        os.makedirs(cache_dir)
+        flags = "--cnf-cache-dir {0}".format(cache_dir)
+        first = self.solve("cache_cold", "php_5_4.cnf", UNSAT, flags)
+        second = self.solve("cache_warm", "php_5_4.cnf", UNSAT, flags)
+        self.assertIn("cache written", first)
+        self.assertNotIn("Loaded parsed CNF from cache", first)
+        self.assertIn("Loaded parsed CNF from cache", second)
+        for label in ("Decisions", "Conflicts"):
+            self.assertEqual(self.stat(second, label), self.stat(first, label), label)
+
+    # Compaction relocates the surviving learnts, so every watcher and
+    # reason it rewrites has to stay valid up to the final answer
+    def test_satsolver_gc_compact(self):
+        out = self.solve("gc_compact", "php_5_4.cnf", UNSAT, "--gc-compact")
+        self.assertGreater(self.stat(out, "DB_Reductions"), 0)
+        m = re.search(r"^Compactions\s*: (\d+) \((\d+) clauses moved\)", out, re.M)
+        self.assertTrue(m and int(m.group(1)) > 0, "no compaction ran")
+
+    # Binary clauses propagate from their watchers, so far fewer clause
+    # reads per propagation on an instance that is mostly binary clauses
+    def test_satsolver_binary_watchers(self):
+        plain = self.solve("binary_off", "php_5_4.cnf", UNSAT)
+        out = self.solve("binary_on", "php_5_4.cnf", UNSAT, "--binary-watchers")
+        plain_rate = self.clauseLines(plain)[0] / self.stat(plain, "Propagations")
+        rate = self.clauseLines(out)[0] / self.stat(out, "Propagations")
+        self.assertLess(rate, plain_rate, "binary watchers did not save clause reads")
+
+    # The compressed, indexed trace reads back whole: one FINISH record
+    # and a seek index; the native reader, when built (make -C src
+    # tracereader), also checks the FINISH checksum against the events
+    def test_satsolver_trace(self):
+        trace = os.path.join(self.get_test_output_run_dir(), "satsolver_php.trace.bin")
+        if os.path.exists(trace):
+            os.remove(trace)
+        self.solve("trace", "php_5_4.cnf", UNSAT, "--trace-file {0}".format(trace))
+
+        sys.path.insert(0, os.path.join(self.get_testsuite_dir(), "..", "tools"))
+        import trace_lib
+        summary = trace_lib.summarize(trace)
+        counts = summary["counts"]
+        self.assertEqual(counts.get("finish", 0), 1)
+        self.assertTrue(summary.get("crc_ok", True), "FINISH checksum does not match")
+        self.assertGreater(counts.get("conflict", 0), 0)
+        self.assertGreater(counts.get("mem_read", 0), 0)
+        self.assertTrue(trace_lib.read_index(trace), "no seek index")
+
+    # Line placement only moves clauses, so the same clause reads touch no
+    # more cache lines than packed placement, and never fewer than the minimum
+    def test_satsolver_clause_placement(self):
+        packed = self.clauseLines(self.solve("place_packed", "php_5_4.cnf", UNSAT))
+        line = self.clauseLines(self.solve("place_line", "php_5_4.cnf", UNSAT, "--clause-placement line"))
+        self.assertEqual(line[0], packed[0], "placement changed the clause reads")
+        self.assertLessEqual(line[1], packed[1])
+        self.assertGreaterEqual(line[1], line[2] * 0.999)  # lines/read is printed rounded
+
+#####
+
+    # Runs the solver on cnf and checks the answer (None: no answer
+    # expected); returns the output text
+    def solve(self, name, cnf, answer, flags="", timeout_sec=600):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        sdlfile = "{0}/test_two_level.py".format(test_path)
+        outfile = "{0}/satsolver_{1}.out".format(outdir, name)
+        errfile = "{0}/satsolver_{1}.err".format(outdir, name)
+        options = "--cnf {0}/{1} --stats-file {2}/satsolver_{3}.csv {4}".format(
+            test_path, cnf, outdir, name, flags)
+
+        self.run_sst(sdlfile, outfile, errfile, set_cwd=outdir, timeout_sec=timeout_sec,
+                     other_args='--model-options="{0}"'.format(options))
+
+        # drop the component prefixes ("MAIN-> ") so patterns can anchor
+        with open(outfile) as f:
+            out = re.sub(r"^\w+-> ", "", f.read(), flags=re.M)
+        if answer is None:
+            self.assertNotIn("SATISFIABLE", out, "{0}: expected no answer".format(name))
+            return out
+        self.assertIn(answer, out, "{0}: expected {1}".format(name, answer))
+        if answer == SAT:
+            self.assertNotIn(UNSAT, out, "{0}: expected {1}".format(name, answer))
+        return out
+
+    # Value of the first "<label>: <n>" line
+    def stat(self, out, label):
+        m = re.search(r"^{0}\s*:\s*(\d+)".format(re.escape(label)), out, re.M)
+        self.assertIsNotNone(m, "no '{0}' line in the output".format(label))
+        return int(m.group(1))
+
+    # Clause reads, lines and fewest possible lines over all size classes
+    def clauseLines(self, out):
+        rows = re.findall(r"^lits_\w+\s*:\s*(\d+) reads,\s*(\d+) lines, [\d.]+ lines/read, ([\d.]+) min",
+                          out, re.M)
+        self.assertTrue(rows, "no clause line statistics in the output")
+        reads = sum(int(r[0]) for r in rows)
+        lines = sum(int(r[1]) for r in rows)
+        min_lines = sum(int(r[0]) * float(r[2]) for r in rows)
+        return reads, lines, min_lines
+
+    # Per-state cycle counts and the run length
+    def cycleStats(self, out):
+        stats = re.findall(r"^(\w[\w ]*?)\s*: [\d.]+% \t\((\d+) cycles\)", out, re.M)
+        m = re.search(r"Clock gated for \d+ of (\d+) cycles", out)
+        self.assertIsNotNone(m, "no clock gating line in the output")
+        return stats + [("Total", m.group(1))]
+
+    def gatedCycles(self, out):
+        return int(re.search(r"Clock gated for (\d+) of", out).group(1))
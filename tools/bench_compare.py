@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""
+Micro-benchmark regression check (make -C src bench)
+
+Compares a Google Benchmark JSON run of build/micro_bench with a stored
+baseline. Two kinds of change are reported:
+
+- sim_cycles_per_op: the simulated cycles per operation against the mock
+  memory. These are deterministic, so any change beyond --cycle-tolerance
+  means the modeled behavior changed, whatever the host. This is the gate.
+- host time: cpu_time per iteration slower than the baseline by more than
+  --threshold (default 1.25x). Host timings are noisy and machine specific,
+  so they only warn, unless --gate-time is given on the machine that
+  recorded the baseline (make -C src bench-baseline).
+
+When the run has repetitions, the median aggregate is used. The baseline
+keeps only the numbers compared, with no host information.
+
+Usage: python bench_compare.py <baseline.json> <run.json> [--threshold 1.25] [--gate-time] [--warn-only]
+       python bench_compare.py --save <baseline.json> <run.json>
+
+Exits 1 when simulated cycles changed (or, with --gate-time, a benchmark got
+slower on the host), unless --warn-only.
+"""
+
+import sys
+import json
+import argparse
+import os
+
+
+def load_run(path):
+    """name -> {cpu_time_ns, real_time_ns, sim_cycles_per_op} from Google Benchmark JSON"""
+    with open(path) as f:
+        data = json.load(f)
+
+    to_ns = {'ns': 1.0, 'us': 1e3, 'ms': 1e6, 's': 1e9}
+    singles = {}
+    medians = {}
+    for b in data.get('benchmarks', []):
+        if b.get('error_occurred'):
+            continue
+        scale = to_ns.get(b.get('time_unit', 'ns'), 1.0)
+        entry = {
+            'cpu_time_ns': b['cpu_time'] * scale,
+            'real_time_ns': b['real_time'] * scale,
+        }
+        if 'sim_cycles_per_op' in b:
+            entry['sim_cycles_per_op'] = b['sim_cycles_per_op']
+
+        name = b.get('run_name', b['name'])
+        if b.get('run_type') == 'aggregate':
+            if b.get('aggregate_name') == 'median':
+                medians[name] = entry
+        elif name not in singles:
+            singles[name] = entry
+
+    singles.update(medians)
+    return singles
+
+
+def compare(baseline, run, threshold, cycle_tolerance):
+    """Print one row per benchmark, return the names whose simulated cycles
+    changed and the names that got slower on the host"""
+    changed = []
+    slower = []
+    print("%-44s %12s %12s %8s  %s" % ("benchmark", "base ns", "run ns", "ratio", "sim cycles/op"))
+    for name in sorted(set(baseline) | set(run)):
+        if name not in run:
+            print("%-44s %12s %12s %8s  missing from run" % (name, "", "", ""))
+            continue
+        if name not in baseline:
+            print("%-44s %12s %12.1f %8s  new" % (name, "", run[name]['cpu_time_ns'], ""))
+            continue
+
+        b, r = baseline[name], run[name]
+        ratio = r['cpu_time_ns'] / b['cpu_time_ns'] if b['cpu_time_ns'] > 0 else 1.0
+        notes = []
+        if ratio > threshold:
+            notes.append("slower")
+            slower.append(name)
+        cycles = ""
+        if 'sim_cycles_per_op' in b or 'sim_cycles_per_op' in r:
+            bc = b.get('sim_cycles_per_op')
+            rc = r.get('sim_cycles_per_op')
+            cycles = "%s -> %s" % ("-" if bc is None else "%.3f" % bc,
+                                   "-" if rc is None else "%.3f" % rc)
+            if bc is None or rc is None or abs(rc - bc) > cycle_tolerance * max(abs(bc), 1e-9):
+                notes.append("CYCLES CHANGED")
+                changed.append(name)
+        print("%-44s %12.1f %12.1f %7.2fx  %s %s" % (name, b['cpu_time_ns'], r['cpu_time_ns'],
+                                                   ratio, cycles, " ".join(notes)))
+    return changed, slower
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare micro_bench results with a baseline")
+    parser.add_argument('baseline', help="Baseline JSON (bench/baseline.json)")
+    parser.add_argument('run', help="Google Benchmark JSON of the current run")
+    parser.add_argument('--save', action='store_true', help="Write the run as the new baseline and exit")
+    parser.add_argument('--threshold', type=float, default=1.25,
+                        help="Host time ratio above which a benchmark counts as slower (default 1.25)")
+    parser.add_argument('--cycle-tolerance', type=float, default=0.01,
+                        help="Relative sim_cycles_per_op change tolerated (default 0.01)")
+    parser.add_argument('--gate-time', action='store_true',
+                        help="Also fail on host time slowdowns (only meaningful on the baseline's host)")
+    parser.add_argument('--warn-only', action='store_true', help="Report regressions but exit 0")
+    args = parser.parse_args()
+
+    run = load_run(args.run)
+    if args.save:
+        rounded = {name: {k: round(v, 3) for k, v in entry.items()} for name, entry in run.items()}
+        with open(args.baseline, 'w') as f:
+            json.dump({'benchmarks': rounded}, f, indent=2, sort_keys=True)
+            f.write("\n")
+        print("Saved %d benchmarks to %s" % (len(run), args.baseline))
+        return 0
+
+    if not os.path.exists(args.baseline):
+        print("No baseline at %s, run 'make -C src bench-baseline' to record one" % args.baseline)
+        return 0
+    with open(args.baseline) as f:
+        baseline = json.load(f)['benchmarks']
+
+    changed, slower = compare(baseline, run, args.threshold, args.cycle_tolerance)
+    if slower:
+        print("\n%d benchmark(s) slower than %.2fx on this host: %s" % (len(slower), args.threshold, ", ".join(slower)))
+    regressed = changed + (slower if args.gate_time else [])
+    if regressed:
+        print("\n%d benchmark(s) regressed: %s" % (len(regressed), ", ".join(regressed)))
+        return 0 if args.warn_only else 1
+    print("\nNo regressions against %s" % args.baseline)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -8,6 +8,9 @@ Borrows functions from plot_comparison.py.
 
 Usage:
     python plot_large_tests.py <folder1> <folder2> [...] --names "Baseline" "MiniSAT" "SATBlast"
+
+Folders from sampled runs (tools/runall.sh --sample N) are compared on their
+extrapolated cycles with --sampled.
 """
 
 import sys
@@ -40,6 +43,22 @@ MANUAL_EXCLUSIVE_TESTS = [
 ]
 
 
+def use_sampled_estimates(metrics, clock_ghz):
+    """Replace sim_time_ms of sampled runs by their extrapolated total.
+
+    A sampled run simulates its functional spans without memory timing, so
+    its simulated time is far too short; the Sampled Estimates total is the
+    full-run estimate. Returns the number of results that were replaced.
+    """
+    replaced = 0
+    for r in metrics['results']:
+        cycles = r.get('est_total_cycles')
+        if cycles is not None:
+            r['sim_time_ms'] = cycles / (clock_ghz * 1e6)
+            replaced += 1
+    return replaced
+
+
 def plot_per_test_speedups(folder_metrics, shared_tests, timeout_seconds, output_dir, baseline_name, geomean_results, pdf_basename='per_test_speedups', large_fonts=False):
     """Plot per-test speedup bars with legend above the plot.
     Modified from plot_comparison.py: legend moved above axes to avoid overlap with
@@ -198,6 +217,10 @@ Example:
                        help='Use much larger font sizes (useful when scaling down for side-by-side comparisons)')
     parser.add_argument('--normalize-sataccel', action='store_true',
                        help='Divide all runtimes in .txt file inputs by 4 (normalize SatAccel clock scaling)')
+    parser.add_argument('--sampled', action='store_true',
+                       help='Use the extrapolated cycles of sampled runs (Sampled Estimates) as their runtime')
+    parser.add_argument('--clock-ghz', type=float, default=1.0,
+                       help='Solver clock for converting sampled cycle estimates to time (default: 1.0)')
 
     args = parser.parse_args()
 
@@ -227,6 +250,8 @@ Example:
 
         print(f"\nProcessing {folder_name} ({folder_path})...")
         metrics = compute_metrics_for_folder(folder_path, args.timeout, normalize_sataccel=args.normalize_sataccel)
+        if args.sampled:
+            print(f"  Using sampled estimates for {use_sampled_estimates(metrics, args.clock_ghz)} tests")
 
         if not metrics['results']:
             print(f"  Warning: No valid results found in {folder_path}")
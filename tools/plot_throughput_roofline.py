@@ -9,9 +9,12 @@ Compares two configurations (baseline vs accelerator) using:
 
 Uses L1 cache miss data for bandwidth estimation (cache-aware roofline model).
 L1 misses represent the data movement demand from the accelerator to the memory hierarchy.
+Runs made with profile_mem (test_two_level.py --profile-mem) report the bytes each
+data structure actually moved; --bandwidth-source picks which of the two is used.
 
 Usage: python plot_throughput_roofline.py <folder1> <folder2> --peak-bandwidth <GB/s> --peak-compute <props/s>
        [--names "Baseline" "SATBlast"] [--timeout 36] [--output-dir results/]
+       [--bandwidth-source auto|measured|inferred]
 
 Examples:
     python plot_throughput_roofline.py runs/baseline runs/optimized --peak-bandwidth 16 --peak-compute 1e9
@@ -68,7 +71,7 @@ def get_folder_colors(folder_names):
     return colors
 
 
-def compute_metrics(results, timeout_ms):
+def compute_metrics(results, timeout_ms, bandwidth_source='auto'):
     """Compute per-benchmark throughput and bandwidth metrics.
 
     Uses L1 cache misses for bandwidth estimation (cache-aware roofline).
@@ -78,11 +81,13 @@ def compute_metrics(results, timeout_ms):
     Args:
         results: list of parsed result dicts from unified_parser
         timeout_ms: timeout in milliseconds for PAR-2 filtering
+        bandwidth_source: 'measured' uses the Memory Profile byte counts,
+            'inferred' L1 misses x line size, 'auto' measured when present
 
     Returns:
         dict mapping test_case -> {propagations_per_sec, actual_bandwidth_GBs,
                                     operational_intensity, propagations, sim_time_ms,
-                                    l1_total_misses, mem_bytes}
+                                    l1_total_misses, mem_bytes, bandwidth_source}
     """
     metrics = {}
 
@@ -107,7 +112,12 @@ def compute_metrics(results, timeout_ms):
         if propagations <= 0 or sim_time_ms <= 0:
             continue
 
-        if l1_total_misses <= 0:
+        measured_bytes = r.get('mem_total_bytes', 0) or 0
+        use_measured = bandwidth_source == 'measured' or (bandwidth_source == 'auto' and measured_bytes > 0)
+        if use_measured and measured_bytes <= 0:
+            print(f"  Warning: Skipping {test_case} — no memory profile data")
+            continue
+        if not use_measured and l1_total_misses <= 0:
             print(f"  Warning: Skipping {test_case} — no L1 miss data")
             continue
 
@@ -116,12 +126,12 @@ def compute_metrics(results, timeout_ms):
             continue
 
         sim_time_s = sim_time_ms / 1000.0
-        mem_bytes = l1_total_misses * CACHE_LINE_SIZE
+        mem_bytes = measured_bytes if use_measured else l1_total_misses * CACHE_LINE_SIZE
         propagations_per_sec = propagations / sim_time_s
         actual_bandwidth_GBs = mem_bytes / sim_time_s / 1e9
         operational_intensity = propagations / mem_bytes
         l1_miss_rate = (l1_total_misses / l1_total_requests * 100.0) if l1_total_requests > 0 else 0.0
-        req_per_prop = l1_total_requests / propagations
+        req_per_prop = l1_total_requests / propagations if l1_total_requests > 0 else 0.0
 
         metrics[test_case] = {
             'propagations_per_sec': propagations_per_sec,
@@ -134,6 +144,7 @@ def compute_metrics(results, timeout_ms):
             'l1_miss_rate': l1_miss_rate,
             'req_per_prop': req_per_prop,
             'mem_bytes': mem_bytes,
+            'bandwidth_source': 'measured' if use_measured else 'inferred',
         }
 
     return metrics
@@ -477,6 +488,9 @@ Examples:
                         help='Timeout in seconds (default: 36)')
     parser.add_argument('--output-dir', default='results',
                         help='Output directory for plots (default: results/)')
+    parser.add_argument('--bandwidth-source', choices=['auto', 'measured', 'inferred'], default='auto',
+                        help='Bytes moved per run: measured by the memory profile (profile_mem), '
+                             'inferred from L1 misses, or measured when the log has it (default: auto)')
     args = parser.parse_args()
     timeout_ms = args.timeout * 1000.0
     fonts = get_font_sizes()
@@ -498,8 +512,9 @@ Examples:
             print(f"  Error: No valid data found in {folder_path}")
             sys.exit(1)
 
-        metrics = compute_metrics(results, timeout_ms)
-        print(f"  Tests with valid data: {len(metrics)}")
+        metrics = compute_metrics(results, timeout_ms, args.bandwidth_source)
+        measured = sum(1 for m in metrics.values() if m['bandwidth_source'] == 'measured')
+        print(f"  Tests with valid data: {len(metrics)} ({measured} with measured bandwidth)")
 
         folder_names.append(folder_name)
         all_metrics[folder_name] = metrics
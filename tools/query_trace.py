@@ -16,6 +16,20 @@ Examples:
 
     # Literal-level view (decisions + enqueues)
     tools/query_trace.py runs/trace_db/foo/seed0.trace.bin --view literal --format text
+
+    # Only cycles [1000000, 1100000); v1.1 traces seek there via the index
+    tools/query_trace.py runs/trace_db/foo/seed0.trace.bin --cycles 1000000:1100000
+
+    # Everything between conflict 500 and conflict 510
+    tools/query_trace.py runs/trace_db/foo/seed0.trace.bin --conflicts 500:510
+
+    # Print the block seek index
+    tools/query_trace.py runs/trace_db/foo/seed0.trace.bin --index
+
+    # Aggregations, run by the native reader (make -C src tracereader)
+    tools/query_trace.py runs/trace_db/foo/seed0.trace.bin --reuse phase
+    tools/query_trace.py runs/trace_db/foo/seed0.trace.bin --strides 8
+    tools/query_trace.py runs/trace_db/foo/seed0.trace.bin --footprint 100000
 """
 import argparse
 import json
@@ -24,7 +38,9 @@ import sys
 
 # Make sibling imports work when script is run directly.
 sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
-from trace_lib import iter_events, parse_header, summarize, VIEWS  # noqa: E402
+from trace_lib import (iter_events, parse_header, read_index, summarize,  # noqa: E402
+                       DS_NAMES, PHASE_NAMES, VIEWS)
+import trace_native  # noqa: E402
 
 
 def _iter_traces(path):
@@ -78,6 +94,19 @@ def cmd_header(path):
             print(f'  {k} = {v}')
 
 
+def cmd_index(path):
+    for trace in _iter_traces(path):
+        print(f'=== {trace} ===')
+        index = read_index(trace)
+        if index is None:
+            print('  no seek index (v1.0 trace, or not closed)')
+            continue
+        print(f'  {len(index)} blocks')
+        for b, e in enumerate(index):
+            print(f"  block {b:>6} @ {e['offset']:>12}  cycle={e['cycle']:<12} "
+                  f"conflicts={e['conflicts']:<10} events={e['events']}")
+
+
 def cmd_summary(path):
     total = {}
     any_trace = False
@@ -91,6 +120,8 @@ def cmd_summary(path):
         print(f"  total_mem_bytes={s['total_mem_bytes']}")
         print(f"  counts={s['counts']}")
         print(f"  ds_counts={s['ds_counts']}")
+        if not s.get('crc_ok', True):
+            print("  WARNING: FINISH crc32 does not match the event stream")
         finish = s['counts'].get('finish', 0)
         if finish != 1:
             print(f"  WARNING: expected exactly 1 FINISH record, got {finish}")
@@ -105,12 +136,77 @@ def cmd_summary(path):
         print(f'  {total}')
 
 
-def cmd_stream(path, view, fmt, head):
+def _native(trace, threads, cycles):
+    if not trace_native.available():
+        sys.exit('aggregations need the native reader: make -C src tracereader '
+                 '(or set SATSOLVER_TRACE_READER) and install numpy')
+    t = trace_native.NativeTrace(trace, threads=threads)
+    t.load(cycles)
+    return t
+
+
+def _reuse_label(b):
+    if b == 0:
+        return '0'
+    if b == trace_native.REUSE_COLD_BIN:
+        return 'cold'
+    return f'<{1 << b}'
+
+
+def cmd_reuse(path, by, line_bytes, threads, cycles):
+    names = {'ds': DS_NAMES, 'phase': PHASE_NAMES}.get(by)
+    for trace in _iter_traces(path):
+        print(f'=== {trace} ===')
+        with _native(trace, threads, cycles) as t:
+            hist = t.reuse_histogram(by=by, line_bytes=line_bytes)
+        used = [b for b in range(hist.shape[1]) if hist[:, b].any()]
+        print(f"  {by:<12} " + ' '.join(f'{_reuse_label(b):>9}' for b in used))
+        for g in range(hist.shape[0]):
+            if not hist[g].any():
+                continue
+            label = names[g] if names and g < len(names) else str(g)
+            print(f'  {label:<12} ' + ' '.join(f'{int(hist[g, b]):>9}' for b in used))
+
+
+def cmd_strides(path, max_stride, line_bytes, threads, cycles):
+    for trace in _iter_traces(path):
+        print(f'=== {trace} ===')
+        with _native(trace, threads, cycles) as t:
+            hist = t.stride_histogram(line_bytes=line_bytes, max_stride=max_stride)
+        labels = [f'<-{max_stride}'] + [str(s) for s in range(-max_stride, max_stride + 1)] \
+            + [f'>{max_stride}']
+        print(f"  {'ds':<12} " + ' '.join(f'{l:>7}' for l in labels))
+        for d in range(hist.shape[0]):
+            if hist[d].any():
+                print(f'  {DS_NAMES[d]:<12} ' + ' '.join(f'{int(v):>7}' for v in hist[d]))
+
+
+def cmd_footprint(path, window_cycles, line_bytes, threads, cycles):
+    for trace in _iter_traces(path):
+        print(f'=== {trace} ===')
+        with _native(trace, threads, cycles) as t:
+            starts, distinct, cumulative = t.footprint(window_cycles, line_bytes=line_bytes)
+        print(f"  {'cycle':>12} {'lines':>10} {'cumulative':>12}")
+        for s, d, c in zip(starts, distinct, cumulative):
+            print(f'  {int(s):>12} {int(d):>10} {int(c):>12}')
+
+
+def _window(spec):
+    """Parse 'LO:HI' (either side may be empty) into a (lo, hi) tuple."""
+    if spec is None:
+        return None
+    lo, sep, hi = spec.partition(':')
+    if not sep:
+        raise argparse.ArgumentTypeError(f'expected LO:HI, got {spec!r}')
+    return (int(lo) if lo else None, int(hi) if hi else None)
+
+
+def cmd_stream(path, view, fmt, head, cycles, conflicts):
     shown = 0
     for trace in _iter_traces(path):
         if os.path.isdir(path):
             print(f'=== {trace} ===')
-        for ev in iter_events(trace, view=view):
+        for ev in iter_events(trace, view=view, cycles=cycles, conflicts=conflicts):
             if fmt == 'jsonl':
                 print(json.dumps(ev))
             else:
@@ -133,6 +229,22 @@ def main():
                     help='print header only and exit')
     ap.add_argument('--summary', action='store_true',
                     help='print per-kind / per-DS counts and exit')
+    ap.add_argument('--index', action='store_true',
+                    help='print the seek index and exit')
+    ap.add_argument('--cycles', type=_window, default=None, metavar='LO:HI',
+                    help='only events in cycles [LO, HI)')
+    ap.add_argument('--conflicts', type=_window, default=None, metavar='LO:HI',
+                    help='only events from conflict LO up to conflict HI')
+    ap.add_argument('--reuse', choices=sorted(trace_native.GROUP_BY), default=None,
+                    help='print the reuse-distance histogram grouped by ds, phase or level')
+    ap.add_argument('--strides', type=int, default=None, metavar='MAX',
+                    help='print per-DS stride histograms up to +-MAX lines')
+    ap.add_argument('--footprint', type=int, default=None, metavar='CYCLES',
+                    help='print the distinct lines touched per window of CYCLES')
+    ap.add_argument('--line-bytes', type=int, default=64,
+                    help='line size of the aggregations (default: 64)')
+    ap.add_argument('--threads', type=int, default=None,
+                    help='decoder threads of the native reader (default: all cores)')
     args = ap.parse_args()
 
     if args.header:
@@ -141,7 +253,19 @@ def main():
     if args.summary:
         cmd_summary(args.path)
         return
-    cmd_stream(args.path, args.view, args.format, args.head)
+    if args.index:
+        cmd_index(args.path)
+        return
+    if args.reuse:
+        cmd_reuse(args.path, args.reuse, args.line_bytes, args.threads, args.cycles)
+        return
+    if args.strides is not None:
+        cmd_strides(args.path, args.strides, args.line_bytes, args.threads, args.cycles)
+        return
+    if args.footprint:
+        cmd_footprint(args.path, args.footprint, args.line_bytes, args.threads, args.cycles)
+        return
+    cmd_stream(args.path, args.view, args.format, args.head, args.cycles, args.conflicts)
 
 
 if __name__ == '__main__':
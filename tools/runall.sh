@@ -30,6 +30,7 @@ unsat_total=0
 SAT_DIR=~/michael_sat_solver/SAT_test_cases/sat
 UNSAT_DIR=~/michael_sat_solver/SAT_test_cases/unsat
 DECISION_DIR="" # Default to empty
+SAMPLE_INTERVAL=0 # Sampled simulation period in conflicts (0 = fully timed)
 
 # Default number of parallel jobs (use available CPU cores)
 MAX_JOBS=$(nproc 2>/dev/null || sysctl -n hw.ncpu 2>/dev/null || echo 4)
@@ -67,6 +68,15 @@ while [[ $# -gt 0 ]]; do
                 exit 1
             fi
             ;;
+        -s|--sample)
+            if [[ "$2" =~ ^[0-9]+$ ]]; then
+                SAMPLE_INTERVAL=$2
+                shift 2
+            else
+                echo "Error: -s/--sample requires a number argument"
+                exit 1
+            fi
+            ;;
         *)
             DECISION_DIR="$1"
             shift
@@ -79,6 +89,7 @@ echo "Logs will be saved to $LOGS_DIR"
 echo "Summary will be saved to $LOG_FILE"
 echo "Running with $MAX_JOBS parallel jobs"
 [[ -n "$DECISION_DIR" ]] && echo "Using decision files from $DECISION_DIR"
+(( SAMPLE_INTERVAL > 0 )) && echo "Sampled simulation every $SAMPLE_INTERVAL conflicts"
 
 # Function to log messages to both console and log file
 log_message() {
@@ -169,6 +180,10 @@ run_single_test() {
     
     # Build command with timeout and basic arguments
     local command="timeout 18000 sst ./tests/test_basic.py -- --cnf \"$file\" --stats-file \"$stats_file\""
+    # test_basic.py has no sampling knobs; sampled runs use the full config
+    if (( SAMPLE_INTERVAL > 0 )); then
+        command="timeout 18000 sst ./tests/test_two_level.py -- --cnf \"$file\" --stats-file \"$stats_file\" --sample-interval $SAMPLE_INTERVAL"
+    fi
     
     # Add decision file if directory specified and file exists
     if [[ -n "$DECISION_DIR" ]]; then
@@ -10,6 +10,10 @@ Typical usage:
     for ev in iter_events('/path/to/run.trace.bin', view='memory'):
         ...  # ev is a dict: {'kind', 'cycle', 'phase', 'level', ...}
 
+    # v1.1 traces carry a seek index: decode only cycles [1e6, 2e6)
+    for ev in iter_events(path, view='memory', cycles=(1000000, 2000000)):
+        ...
+
 Views:
     all      - every decoded event
     memory   - only MEM_READ / MEM_WRITE
@@ -41,6 +45,13 @@ TAG_DECIDE, TAG_ENQUEUE, TAG_CONFLICT, TAG_LEARN = 0x20, 0x21, 0x22, 0x23
 TAG_BACKTRACK, TAG_RESTART, TAG_REDUCE = 0x24, 0x25, 0x26
 TAG_FINISH = 0x7f
 
+# v1.1 block framing
+BLOCK_MARKER, INDEX_MARKER = 0xB1, 0x1D
+CODEC_NONE, CODEC_ZLIB = 0, 1
+INDEX_MAGIC = b'SSTIDX\x00\x00'
+_BLOCK_HEADER = struct.Struct('<BBII')   # marker, codec, raw_size, stored_size
+_INDEX_ENTRY = struct.Struct('<QQQQIB9Q')  # offset, cycle, conflicts, events, level, phase, last_addr[9]
+
 VIEWS = ('all', 'memory', 'algo', 'literal', 'clause', 'phase')
 
 ALGO_KINDS = frozenset(('decide', 'enqueue', 'conflict', 'learn',
@@ -89,158 +100,312 @@ def parse_header(path):
         return hdr
 
 
-def iter_events(path, view='all'):
+def _is_blocked(hdr):
+    """True for v1.1+ traces, whose body is a sequence of blocks."""
+    major, _, minor = hdr.get('version', '1.0').partition('.')
+    return (int(major), int(minor or 0)) >= (1, 1)
+
+
+def read_index(path):
+    """Return the seek index of a v1.1 trace as a list of dicts, one per
+    block, or None if the trace has no index (v1.0, or a run that did not
+    close its trace)."""
+    hdr = parse_header(path)
+    if not _is_blocked(hdr):
+        return None
+    with open(path, 'rb') as f:
+        f.seek(0, os.SEEK_END)
+        size = f.tell()
+        if size < hdr['body_offset'] + 16:
+            return None
+        f.seek(size - 16)
+        trailer = f.read(16)
+        if trailer[8:] != INDEX_MAGIC:
+            return None
+        index_offset = int.from_bytes(trailer[:8], 'little')
+        f.seek(index_offset)
+        head = f.read(5)
+        if len(head) < 5 or head[0] != INDEX_MARKER:
+            raise ValueError(f'{path}: bad index marker at offset {index_offset}')
+        count = int.from_bytes(head[1:5], 'little')
+        raw = f.read(count * _INDEX_ENTRY.size)
+    index = []
+    for k in range(count):
+        e = _INDEX_ENTRY.unpack_from(raw, k * _INDEX_ENTRY.size)
+        index.append({'offset': e[0], 'cycle': e[1], 'conflicts': e[2],
+                      'events': e[3], 'level': e[4], 'phase': e[5],
+                      'last_addr': list(e[6:15])})
+    return index
+
+
+def _iter_chunks(path, hdr, offset):
+    """Yield the decoded event stream in chunks, starting at file offset
+    `offset` (a block boundary for v1.1 traces)."""
+    with open(path, 'rb') as f:
+        f.seek(offset)
+        if not _is_blocked(hdr):
+            yield f.read()
+            return
+        while True:
+            head = f.read(_BLOCK_HEADER.size)
+            if len(head) < _BLOCK_HEADER.size or head[0] != BLOCK_MARKER:
+                return  # index, or a truncated trace
+            _, codec, raw_size, stored_size = _BLOCK_HEADER.unpack(head)
+            payload = f.read(stored_size)
+            if len(payload) < stored_size:
+                return
+            if codec == CODEC_ZLIB:
+                payload = zlib.decompress(payload)
+            elif codec != CODEC_NONE:
+                raise ValueError(f'{path}: unknown block codec {codec}')
+            if len(payload) != raw_size:
+                raise ValueError(f'{path}: block at {f.tell() - stored_size - _BLOCK_HEADER.size} '
+                                 f'decodes to {len(payload)} bytes, expected {raw_size}')
+            yield payload
+
+
+def _seek_entry(index, cycles, conflicts):
+    """Last index entry that starts strictly before the window. Events of a
+    block carry at most its successor's start values, so every earlier block
+    lies entirely before the window."""
+    best = None
+    for e in index:
+        if cycles is not None and (cycles[0] is None or e['cycle'] >= cycles[0]):
+            break
+        if conflicts is not None and (conflicts[0] is None or e['conflicts'] >= conflicts[0]):
+            break
+        best = e
+    return best
+
+
+def iter_events(path, view='all', cycles=None, conflicts=None):
     """Yield decoded events as dicts.
 
     Each dict has at minimum a `kind` key. Memory events also carry
     `cycle, phase, level, ds, ds_name, addr, size, is_write`. Algorithm
     events carry kind-specific payload plus the current `cycle/phase/level`.
+
+    `cycles` and `conflicts` restrict the output to a half-open window
+    (lo, hi); either bound may be None. An event's conflict number is the
+    count of CONFLICT records before it. With a seek index (v1.1) decoding
+    starts at the block holding the window instead of at the beginning.
+    In the 'all' view the FINISH record is yielded whenever decoding
+    reaches it.
     """
+    events = _decode(path, view, cycles, conflicts)
+    if cycles is None and conflicts is None:
+        for _, ev in events:
+            yield ev
+        return
+    c_lo, c_hi = cycles if cycles is not None else (None, None)
+    k_lo, k_hi = conflicts if conflicts is not None else (None, None)
+    for k, ev in events:
+        if ev['kind'] == 'finish':
+            yield ev
+            return
+        if (c_hi is not None and ev['cycle'] >= c_hi) or (k_hi is not None and k >= k_hi):
+            return
+        if (c_lo is not None and ev['cycle'] < c_lo) or (k_lo is not None and k < k_lo):
+            continue
+        yield ev
+
+
+def _decode(path, view, cycles=None, conflicts=None):
+    """Yield (conflict number, event) pairs."""
     if view not in VIEWS:
         raise ValueError(f'view must be one of {VIEWS}')
 
     hdr = parse_header(path)
-    with open(path, 'rb') as f:
-        f.seek(hdr['body_offset'])
-        buf = f.read()
-
-    i = 0
-    n = len(buf)
+    offset = hdr['body_offset']
     cur_cycle = 0
     cur_phase = 0
     cur_level = 0
+    cur_conflicts = 0
     last_addr = [0] * 9
 
-    SIZE_CLASSES = (1, 2, 4, 8, 16, 32, 64, None)
-
-    while i < n:
-        tag = buf[i]
-        i += 1
-
-        if tag == TAG_TICK:
-            delta, i = _uvarint(buf, i)
-            cur_cycle += delta
-            continue
-
-        if tag == TAG_PHASE:
-            cur_phase = buf[i]
-            i += 1
-            if view in ('all', 'phase'):
-                yield {'kind': 'phase', 'cycle': cur_cycle, 'phase': cur_phase,
-                       'phase_name': PHASE_NAMES[cur_phase] if cur_phase < len(PHASE_NAMES) else str(cur_phase),
-                       'level': cur_level}
-            continue
+    windowed = cycles is not None or conflicts is not None
+    if windowed:
+        index = read_index(path)
+        entry = _seek_entry(index, cycles, conflicts) if index else None
+        if entry is not None:
+            offset = entry['offset']
+            cur_cycle = entry['cycle']
+            cur_phase = entry['phase']
+            cur_level = entry['level']
+            cur_conflicts = entry['conflicts']
+            last_addr = list(entry['last_addr'])
 
-        if tag == TAG_LEVEL:
-            cur_level, i = _uvarint(buf, i)
-            continue
+    SIZE_CLASSES = (1, 2, 4, 8, 16, 32, 64, None)
 
-        if tag in (TAG_MEM_READ, TAG_MEM_WRITE):
-            packed = buf[i]
+    for buf in _iter_chunks(path, hdr, offset):
+        i = 0
+        n = len(buf)
+        while i < n:
+            tag = buf[i]
             i += 1
-            sc = (packed >> 4) & 0x7
-            ds = packed & 0xF
-            delta, i = _svarint(buf, i)
-            last_addr[ds] += delta
-            size = SIZE_CLASSES[sc]
-            if size is None:
-                size, i = _uvarint(buf, i)
-            # View filter
-            if view == 'memory' or view == 'all':
-                yield {
-                    'kind': 'mem_write' if tag == TAG_MEM_WRITE else 'mem_read',
-                    'cycle': cur_cycle, 'phase': cur_phase,
-                    'phase_name': PHASE_NAMES[cur_phase] if cur_phase < len(PHASE_NAMES) else str(cur_phase),
-                    'level': cur_level,
-                    'ds': ds, 'ds_name': DS_NAMES[ds] if ds < len(DS_NAMES) else str(ds),
-                    'addr': last_addr[ds], 'size': size,
-                    'is_write': tag == TAG_MEM_WRITE,
-                }
-            elif view == 'clause' and ds in CLAUSE_DS_IDS:
-                yield {
-                    'kind': 'mem_write' if tag == TAG_MEM_WRITE else 'mem_read',
-                    'cycle': cur_cycle, 'phase': cur_phase,
-                    'phase_name': PHASE_NAMES[cur_phase] if cur_phase < len(PHASE_NAMES) else str(cur_phase),
-                    'level': cur_level,
-                    'ds': ds, 'ds_name': DS_NAMES[ds],
-                    'addr': last_addr[ds], 'size': size,
-                    'is_write': tag == TAG_MEM_WRITE,
-                }
-            continue
-
-        if tag == TAG_DECIDE:
-            var, i = _uvarint(buf, i)
-            sign = buf[i]; i += 1
-            new_level, i = _uvarint(buf, i)
-            if view in ('all', 'algo', 'literal'):
-                yield {'kind': 'decide', 'cycle': cur_cycle, 'phase': cur_phase,
-                       'level': cur_level, 'var': var, 'sign': sign, 'new_level': new_level}
-            continue
-
-        if tag == TAG_ENQUEUE:
-            var, i = _uvarint(buf, i)
-            sign = buf[i]; i += 1
-            reason, i = _svarint(buf, i)
-            if view in ('all', 'algo', 'literal'):
-                yield {'kind': 'enqueue', 'cycle': cur_cycle, 'phase': cur_phase,
-                       'level': cur_level, 'var': var, 'sign': sign, 'reason_cref': reason}
-            continue
-
-        if tag == TAG_CONFLICT:
-            cref, i = _uvarint(buf, i)
-            if view in ('all', 'algo', 'clause'):
-                yield {'kind': 'conflict', 'cycle': cur_cycle, 'phase': cur_phase,
-                       'level': cur_level, 'cref': cref}
-            continue
-
-        if tag == TAG_LEARN:
-            lbd, i = _uvarint(buf, i)
-            clause_size, i = _uvarint(buf, i)
-            bt_level, i = _uvarint(buf, i)
-            new_cref, i = _uvarint(buf, i)
-            if view in ('all', 'algo', 'clause'):
-                yield {'kind': 'learn', 'cycle': cur_cycle, 'phase': cur_phase,
-                       'level': cur_level, 'lbd': lbd, 'clause_size': clause_size,
-                       'bt_level': bt_level, 'new_cref': new_cref}
-            continue
-
-        if tag == TAG_BACKTRACK:
-            frm, i = _uvarint(buf, i)
-            to, i = _uvarint(buf, i)
-            if view in ('all', 'algo'):
-                yield {'kind': 'backtrack', 'cycle': cur_cycle, 'phase': cur_phase,
-                       'level': cur_level, 'from_level': frm, 'to_level': to}
-            continue
 
-        if tag == TAG_RESTART:
-            idx, i = _uvarint(buf, i)
-            if view in ('all', 'algo'):
-                yield {'kind': 'restart', 'cycle': cur_cycle, 'phase': cur_phase,
-                       'level': cur_level, 'restart_idx': idx}
-            continue
-
-        if tag == TAG_REDUCE:
-            removed, i = _uvarint(buf, i)
-            kept, i = _uvarint(buf, i)
-            if view in ('all', 'algo', 'clause'):
-                yield {'kind': 'reduce', 'cycle': cur_cycle, 'phase': cur_phase,
-                       'level': cur_level, 'removed': removed, 'kept': kept}
-            continue
-
-        if tag == TAG_FINISH:
-            total_cycles = int.from_bytes(buf[i:i+8], 'little'); i += 8
-            events_written = int.from_bytes(buf[i:i+8], 'little'); i += 8
-            crc32 = int.from_bytes(buf[i:i+4], 'little'); i += 4
-            if view == 'all':
-                yield {'kind': 'finish', 'total_cycles': total_cycles,
-                       'events_written': events_written, 'crc32': crc32}
-            return
+            if tag == TAG_TICK:
+                delta, i = _uvarint(buf, i)
+                cur_cycle += delta
+                continue
+
+            if tag == TAG_PHASE:
+                cur_phase = buf[i]
+                i += 1
+                if view in ('all', 'phase'):
+                    yield cur_conflicts, {'kind': 'phase', 'cycle': cur_cycle, 'phase': cur_phase,
+                                          'phase_name': PHASE_NAMES[cur_phase] if cur_phase < len(PHASE_NAMES) else str(cur_phase),
+                                          'level': cur_level}
+                continue
+
+            if tag == TAG_LEVEL:
+                cur_level, i = _uvarint(buf, i)
+                continue
+
+            if tag in (TAG_MEM_READ, TAG_MEM_WRITE):
+                packed = buf[i]
+                i += 1
+                sc = (packed >> 4) & 0x7
+                ds = packed & 0xF
+                delta, i = _svarint(buf, i)
+                last_addr[ds] += delta
+                size = SIZE_CLASSES[sc]
+                if size is None:
+                    size, i = _uvarint(buf, i)
+                # View filter
+                if view == 'memory' or view == 'all':
+                    yield cur_conflicts, {
+                        'kind': 'mem_write' if tag == TAG_MEM_WRITE else 'mem_read',
+                        'cycle': cur_cycle, 'phase': cur_phase,
+                        'phase_name': PHASE_NAMES[cur_phase] if cur_phase < len(PHASE_NAMES) else str(cur_phase),
+                        'level': cur_level,
+                        'ds': ds, 'ds_name': DS_NAMES[ds] if ds < len(DS_NAMES) else str(ds),
+                        'addr': last_addr[ds], 'size': size,
+                        'is_write': tag == TAG_MEM_WRITE,
+                    }
+                elif view == 'clause' and ds in CLAUSE_DS_IDS:
+                    yield cur_conflicts, {
+                        'kind': 'mem_write' if tag == TAG_MEM_WRITE else 'mem_read',
+                        'cycle': cur_cycle, 'phase': cur_phase,
+                        'phase_name': PHASE_NAMES[cur_phase] if cur_phase < len(PHASE_NAMES) else str(cur_phase),
+                        'level': cur_level,
+                        'ds': ds, 'ds_name': DS_NAMES[ds],
+                        'addr': last_addr[ds], 'size': size,
+                        'is_write': tag == TAG_MEM_WRITE,
+                    }
+                continue
+
+            if tag == TAG_DECIDE:
+                var, i = _uvarint(buf, i)
+                sign = buf[i]; i += 1
+                new_level, i = _uvarint(buf, i)
+                if view in ('all', 'algo', 'literal'):
+                    yield cur_conflicts, {'kind': 'decide', 'cycle': cur_cycle, 'phase': cur_phase,
+                                          'level': cur_level, 'var': var, 'sign': sign, 'new_level': new_level}
+                continue
+
+            if tag == TAG_ENQUEUE:
+                var, i = _uvarint(buf, i)
+                sign = buf[i]; i += 1
+                reason, i = _svarint(buf, i)
+                if view in ('all', 'algo', 'literal'):
+                    yield cur_conflicts, {'kind': 'enqueue', 'cycle': cur_cycle, 'phase': cur_phase,
+                                          'level': cur_level, 'var': var, 'sign': sign, 'reason_cref': reason}
+                continue
+
+            if tag == TAG_CONFLICT:
+                cref, i = _uvarint(buf, i)
+                if view in ('all', 'algo', 'clause'):
+                    yield cur_conflicts, {'kind': 'conflict', 'cycle': cur_cycle, 'phase': cur_phase,
+                                          'level': cur_level, 'cref': cref}
+                cur_conflicts += 1
+                continue
+
+            if tag == TAG_LEARN:
+                lbd, i = _uvarint(buf, i)
+                clause_size, i = _uvarint(buf, i)
+                bt_level, i = _uvarint(buf, i)
+                new_cref, i = _uvarint(buf, i)
+                if view in ('all', 'algo', 'clause'):
+                    yield cur_conflicts, {'kind': 'learn', 'cycle': cur_cycle, 'phase': cur_phase,
+                                          'level': cur_level, 'lbd': lbd, 'clause_size': clause_size,
+                                          'bt_level': bt_level, 'new_cref': new_cref}
+                continue
+
+            if tag == TAG_BACKTRACK:
+                frm, i = _uvarint(buf, i)
+                to, i = _uvarint(buf, i)
+                if view in ('all', 'algo'):
+                    yield cur_conflicts, {'kind': 'backtrack', 'cycle': cur_cycle, 'phase': cur_phase,
+                                          'level': cur_level, 'from_level': frm, 'to_level': to}
+                continue
+
+            if tag == TAG_RESTART:
+                idx, i = _uvarint(buf, i)
+                if view in ('all', 'algo'):
+                    yield cur_conflicts, {'kind': 'restart', 'cycle': cur_cycle, 'phase': cur_phase,
+                                          'level': cur_level, 'restart_idx': idx}
+                continue
+
+            if tag == TAG_REDUCE:
+                removed, i = _uvarint(buf, i)
+                kept, i = _uvarint(buf, i)
+                if view in ('all', 'algo', 'clause'):
+                    yield cur_conflicts, {'kind': 'reduce', 'cycle': cur_cycle, 'phase': cur_phase,
+                                          'level': cur_level, 'removed': removed, 'kept': kept}
+                continue
+
+            if tag == TAG_FINISH:
+                total_cycles = int.from_bytes(buf[i:i+8], 'little'); i += 8
+                events_written = int.from_bytes(buf[i:i+8], 'little'); i += 8
+                crc32 = int.from_bytes(buf[i:i+4], 'little'); i += 4
+                if view == 'all':
+                    yield cur_conflicts, {'kind': 'finish', 'total_cycles': total_cycles,
+                                          'events_written': events_written, 'crc32': crc32}
+                return
+
+            raise ValueError(f'unknown tag 0x{tag:02x} at body offset {i-1}')
+
+
+# Tag -> event kind, for tags iter_events yields
+TAG_KINDS = {
+    TAG_PHASE: 'phase', TAG_MEM_READ: 'mem_read', TAG_MEM_WRITE: 'mem_write',
+    TAG_DECIDE: 'decide', TAG_ENQUEUE: 'enqueue', TAG_CONFLICT: 'conflict',
+    TAG_LEARN: 'learn', TAG_BACKTRACK: 'backtrack', TAG_RESTART: 'restart',
+    TAG_REDUCE: 'reduce', TAG_FINISH: 'finish',
+}
+
+
+def _summarize_native(path):
+    from trace_native import NativeTrace
+    hdr = parse_header(path)
+    with NativeTrace(path) as t:
+        s = t.summary()
+    counts = {TAG_KINDS[tag]: n for tag, n in s['tags'].items() if tag in TAG_KINDS}
+    ds_counts = {DS_NAMES[d]: n for d, n in enumerate(s['ds_events']) if n}
+    phase_counts = {(PHASE_NAMES[p] if p < len(PHASE_NAMES) else str(p)): n
+                    for p, n in s['phases'].items()}
+    return {
+        'header': hdr,
+        'counts': counts,
+        'ds_counts': ds_counts,
+        'phase_counts': phase_counts,
+        'total_mem_bytes': s['mem_bytes'],
+        'crc_ok': s['crc_ok'],
+    }
 
-        raise ValueError(f'unknown tag 0x{tag:02x} at body offset {i-1}')
 
+def summarize(path, native=None):
+    """Return a dict of per-kind counts + per-DS memory counts + header.
 
-def summarize(path):
-    """Return a dict of per-kind counts + per-DS memory counts + header."""
+    Uses the native reader (trace_native) when it is available, unless
+    native=False; the native summary also carries `crc_ok`, the FINISH
+    checksum verified over the decoded stream."""
+    if native is None:
+        from trace_native import available
+        native = available()
+    if native:
+        return _summarize_native(path)
     hdr = parse_header(path)
     counts = {}
     ds_counts = {}
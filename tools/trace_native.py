@@ -0,0 +1,228 @@
+"""NumPy front end for the native trace reader (src/trace_reader.h).
+
+Build the library once with
+
+    make -C src tracereader        # -> build/libtracereader.so
+
+or point SATSOLVER_TRACE_READER at a copy. The native reader decodes v1.1
+traces in parallel across seek-index blocks and runs the aggregations in
+C++; this module only moves the results into NumPy arrays.
+
+Typical usage:
+
+    from trace_native import NativeTrace
+
+    with NativeTrace('/path/to/run.trace.bin', threads=8) as t:
+        t.load(cycles=(0, 10_000_000))     # memory events of the window
+        cols = t.columns()                 # dict of NumPy arrays
+        hist = t.reuse_histogram(by='phase')
+        strides = t.stride_histogram(max_stride=16)
+        starts, distinct, cumulative = t.footprint(window_cycles=100_000)
+
+`available()` tells whether the library can be loaded; trace_lib falls back
+to the pure-Python decoder when it cannot.
+"""
+import ctypes as C
+import os
+
+_REPO = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+_DEFAULT_LIB = os.path.join(_REPO, 'build', 'libtracereader.so')
+
+DS_COUNT = 9
+GROUP_BY = {'ds': 0, 'phase': 1, 'level': 2}
+# Reuse histogram bins: 0, then [2^(b-1), 2^b) for b = 1..64, then cold
+REUSE_COLD_BIN = 65
+
+_lib = None
+
+
+class _Summary(C.Structure):
+    _fields_ = [
+        ('tags', C.c_uint64 * 256),
+        ('ds_events', C.c_uint64 * DS_COUNT),
+        ('phases', C.c_uint64 * 256),
+        ('mem_bytes', C.c_uint64),
+        ('total_cycles', C.c_uint64),
+        ('events_written', C.c_uint64),
+        ('crc32', C.c_uint32),
+        ('crc32_actual', C.c_uint32),
+        ('finished', C.c_int32),
+    ]
+
+
+def _load_lib():
+    global _lib
+    if _lib is not None:
+        return _lib
+    lib = C.CDLL(os.environ.get('SATSOLVER_TRACE_READER', _DEFAULT_LIB))
+    h, u8p, u32p, u64p = C.c_void_p, C.c_void_p, C.c_void_p, C.c_void_p
+    sigs = {
+        'tr_open':        (C.c_void_p, [C.c_char_p, C.c_int]),
+        'tr_close':       (None,       [h]),
+        'tr_error':       (C.c_char_p, [h]),
+        'tr_header':      (C.c_char_p, [h, C.c_char_p]),
+        'tr_blocks':      (C.c_int64,  [h]),
+        'tr_indexed':     (C.c_int32,  [h]),
+        'tr_summarize':   (C.c_int32,  [h, C.POINTER(_Summary)]),
+        'tr_load':        (C.c_int64,  [h, C.c_uint64, C.c_uint64]),
+        'tr_mem_columns': (C.c_int64,  [h, u64p, u64p, u64p, u32p, u32p, u8p, u8p, u8p]),
+        'tr_stride_bins': (C.c_int64,  [C.c_int32]),
+        'tr_stride_hist': (C.c_int64,  [h, C.c_uint32, C.c_int32, u64p]),
+        'tr_reuse_bins':  (C.c_int64,  []),
+        'tr_groups':      (C.c_int64,  [h, C.c_int32]),
+        'tr_reuse_hist':  (C.c_int64,  [h, C.c_uint32, C.c_int32, C.c_int64, u64p]),
+        'tr_footprint':   (C.c_int64,  [h, C.c_uint32, C.c_uint64, u64p, u64p, u64p]),
+    }
+    for name, (res, args) in sigs.items():
+        fn = getattr(lib, name)
+        fn.restype = res
+        fn.argtypes = args
+    _lib = lib
+    return lib
+
+
+def available():
+    """True if the native library and NumPy can be loaded."""
+    try:
+        import numpy  # noqa: F401
+        _load_lib()
+        return True
+    except (OSError, ImportError):
+        return False
+
+
+def _ptr(a):
+    return a.ctypes.data_as(C.c_void_p)
+
+
+class NativeTrace:
+    """One open trace. Aggregations work on the events of the last load()."""
+
+    def __init__(self, path, threads=None):
+        self._lib = _load_lib()
+        self.path = path
+        if threads is None:
+            threads = os.cpu_count() or 1
+        self._h = self._lib.tr_open(os.fsencode(path), threads)
+        if not self._h:
+            raise ValueError(self._lib.tr_error(None).decode())
+        self._loaded = None
+
+    def close(self):
+        if self._h:
+            self._lib.tr_close(self._h)
+            self._h = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    def __del__(self):
+        self.close()
+
+    def _check(self, rc):
+        if rc < 0:
+            raise ValueError(self._lib.tr_error(self._h).decode())
+        return rc
+
+    def header(self, key):
+        v = self._lib.tr_header(self._h, key.encode())
+        return None if v is None else v.decode()
+
+    def blocks(self):
+        return self._lib.tr_blocks(self._h)
+
+    def indexed(self):
+        return bool(self._lib.tr_indexed(self._h))
+
+    def summary(self):
+        """Record counts by tag, DS and phase, and the FINISH check."""
+        s = _Summary()
+        self._check(self._lib.tr_summarize(self._h, C.byref(s)))
+        return {
+            'tags': {t: s.tags[t] for t in range(256) if s.tags[t]},
+            'ds_events': list(s.ds_events),
+            'phases': {p: s.phases[p] for p in range(256) if s.phases[p]},
+            'mem_bytes': s.mem_bytes,
+            'finished': bool(s.finished),
+            'total_cycles': s.total_cycles,
+            'events_written': s.events_written,
+            'crc32': s.crc32,
+            'crc_ok': bool(s.finished) and s.crc32 == s.crc32_actual,
+        }
+
+    def load(self, cycles=None):
+        """Decode the memory events with cycle in [lo, hi); returns the count."""
+        lo, hi = cycles if cycles is not None else (None, None)
+        lo = 0 if lo is None else lo
+        hi = (1 << 64) - 1 if hi is None else hi
+        self._loaded = self._check(self._lib.tr_load(self._h, lo, hi))
+        return self._loaded
+
+    def _require_loaded(self):
+        if self._loaded is None:
+            self.load()
+        return self._loaded
+
+    def columns(self):
+        """Memory events as a dict of NumPy arrays, in stream order."""
+        import numpy as np
+        n = self._require_loaded()
+        cols = {
+            'cycle': np.empty(n, np.uint64),
+            'addr': np.empty(n, np.uint64),
+            'conflict': np.empty(n, np.uint64),
+            'size': np.empty(n, np.uint32),
+            'level': np.empty(n, np.uint32),
+            'ds': np.empty(n, np.uint8),
+            'phase': np.empty(n, np.uint8),
+            'is_write': np.empty(n, np.uint8),
+        }
+        self._check(self._lib.tr_mem_columns(
+            self._h, _ptr(cols['cycle']), _ptr(cols['addr']), _ptr(cols['conflict']),
+            _ptr(cols['size']), _ptr(cols['level']), _ptr(cols['ds']),
+            _ptr(cols['phase']), _ptr(cols['is_write'])))
+        cols['is_write'] = cols['is_write'].astype(bool)
+        return cols
+
+    def stride_histogram(self, line_bytes=64, max_stride=16):
+        """Array [DS_COUNT, 2*max_stride + 3]: column 0 counts strides below
+        -max_stride, column max_stride + 1 + s counts stride s (in lines),
+        the last column strides above max_stride."""
+        import numpy as np
+        self._require_loaded()
+        bins = self._check(self._lib.tr_stride_bins(max_stride))
+        out = np.zeros(DS_COUNT * bins, np.uint64)
+        self._check(self._lib.tr_stride_hist(self._h, line_bytes, max_stride, _ptr(out)))
+        return out.reshape(DS_COUNT, bins)
+
+    def reuse_histogram(self, by='ds', line_bytes=64, groups=None):
+        """Array [groups, 66] of LRU stack distances in distinct lines: bin 0
+        is distance 0, bin b in 1..64 is [2^(b-1), 2^b), bin 65 first touches.
+        Rows are DS ids, phase values or decision levels (by=); with groups
+        given, levels beyond it share the last row."""
+        import numpy as np
+        self._require_loaded()
+        code = GROUP_BY[by]
+        if groups is None:
+            groups = self._check(self._lib.tr_groups(self._h, code))
+        bins = self._lib.tr_reuse_bins()
+        out = np.zeros(groups * bins, np.uint64)
+        self._check(self._lib.tr_reuse_hist(self._h, line_bytes, code, groups, _ptr(out)))
+        return out.reshape(groups, bins)
+
+    def footprint(self, window_cycles, line_bytes=64):
+        """(window start cycles, distinct lines per window, cumulative
+        distinct lines), for the windows that saw any access."""
+        import numpy as np
+        self._require_loaded()
+        n = self._check(self._lib.tr_footprint(self._h, line_bytes, window_cycles,
+                                                None, None, None))
+        starts = np.empty(n, np.uint64)
+        distinct = np.empty(n, np.uint64)
+        cumulative = np.empty(n, np.uint64)
+        self._check(self._lib.tr_footprint(self._h, line_bytes, window_cycles,
+                                           _ptr(starts), _ptr(distinct), _ptr(cumulative)))
+        return starts, distinct, cumulative
@@ -10,6 +10,8 @@ This module provides a unified parser for SAT solver log files that extracts:
 - L1 Cache Profiler Statistics by component
 - Clauses Fragmentation statistics
 - Cycle Statistics
+- Memory Profile Statistics (per-structure latency, MLP and bandwidth)
+- Sampled Estimates (sampled simulation, sample_interval > 0)
 - Simulated time
 
 Usage:
@@ -368,6 +370,12 @@ def parse_solver_statistics(content):
             'db_reductions': r'DB_Reductions\s*:\s*(\d+)',
             'assigns': r'Assigns\s*:\s*(\d+)',
             'unassigns': r'UnAssigns\s*:\s*(\d+)',
+            'value_reads': r'Value Reads\s*:\s*(\d+)',
+            # blocks/watcher density = watch_chain_blocks / watch_chain_watchers
+            'watch_chain_blocks': r'Watch chains\s*:[^\n]*\((\d+) blocks read',
+            'watch_chain_watchers': r'Watch chains\s*:[^\n]*blocks read for (\d+) watchers',
+            'watch_compactions': r'Watch compact\s*:\s*(\d+)',
+            'watch_blocks_freed': r'Watch compact\s*:[^\n]*?(\d+) blocks freed',
             'minimized': r'Minimized\s*:\s*(\d+)',
             'restarts': r'Restarts\s*:\s*(\d+)',
             # Speculation stats
@@ -424,6 +432,36 @@ def parse_cache_statistics(content, level):
                 cache_stats[f'{prefix}_{comp_name}_hits'] = int(match.group(1))
                 cache_stats[f'{prefix}_{comp_name}_misses'] = int(match.group(2))
 
+        # Newer profilers split the heap, watch and clause regions into one
+        # row per data structure. Keep those as {prefix}_ds_<name>_* and fold
+        # them back into the five components above, which the plots expect.
+        per_ds = {}
+        for name, hits, misses, cold in re.findall(
+                r'(\w+)\s*:\s*(\d+) hits,\s*(\d+) misses,\s*\d+ total,\s*[\d.]+% miss rate,\s*(\d+) cold misses',
+                section_text):
+            if name == 'TOTAL':
+                cache_stats[f'{prefix}_total_cold_misses'] = int(cold)
+                continue
+            per_ds[name] = (int(hits), int(misses))
+            cache_stats[f'{prefix}_ds_{name.lower()}_hits'] = int(hits)
+            cache_stats[f'{prefix}_ds_{name.lower()}_misses'] = int(misses)
+            cache_stats[f'{prefix}_ds_{name.lower()}_cold_misses'] = int(cold)
+        groups = {
+            'heap': ['Heap', 'Indices'],
+            'watches': ['Watches', 'WatchNodes'],
+            'clauses': ['ClausesCmd', 'Clauses'],
+        }
+        for comp_name, names in groups.items():
+            if not per_ds:
+                break
+            hits = sum(per_ds.get(n, (0, 0))[0] for n in names)
+            misses = sum(per_ds.get(n, (0, 0))[1] for n in names)
+            total = hits + misses
+            cache_stats[f'{prefix}_{comp_name}_hits'] = hits
+            cache_stats[f'{prefix}_{comp_name}_misses'] = misses
+            cache_stats[f'{prefix}_{comp_name}_total'] = total
+            cache_stats[f'{prefix}_{comp_name}_miss_rate'] = (misses / total * 100.0) if total else 0.0
+
     return cache_stats
 
 
@@ -653,6 +691,165 @@ def parse_conflict_learning_statistics(content):
     return stats
 
 
+def parse_memory_profile_statistics(content):
+    """Parse Memory Profile Statistics section (solver run with profile_mem).
+
+    Keys are mem_{structure}_{field} for structure in variables, watches,
+    clauses, varactivity, plus mem_total_bytes over all of them.
+    """
+    stats = {}
+    section = re.search(
+        r'=+\[\s*Memory Profile Statistics\s*\]=+\n(.*?)\n=+',
+        content, re.DOTALL
+    )
+    if not section:
+        return stats
+
+    pattern = (r'(\w+)\s*:\s*(\d+) reads,\s*(\d+) B read,\s*(\d+) B written,'
+               r'\s*latency ([\d.]+) mean / (\d+) max,\s*MLP ([\d.]+) \(peak (\d+)\),'
+               r'\s*(\d+) busy cycles,\s*([\d.]+) B/cycle')
+    total_bytes = 0
+    for m in re.finditer(pattern, section.group(1)):
+        name = m.group(1).lower()
+        stats[f'mem_{name}_reads'] = int(m.group(2))
+        stats[f'mem_{name}_read_bytes'] = int(m.group(3))
+        stats[f'mem_{name}_write_bytes'] = int(m.group(4))
+        stats[f'mem_{name}_mean_latency'] = float(m.group(5))
+        stats[f'mem_{name}_max_latency'] = int(m.group(6))
+        stats[f'mem_{name}_mlp'] = float(m.group(7))
+        stats[f'mem_{name}_peak_outstanding'] = int(m.group(8))
+        stats[f'mem_{name}_busy_cycles'] = int(m.group(9))
+        stats[f'mem_{name}_bytes_per_cycle'] = float(m.group(10))
+        total_bytes += int(m.group(3)) + int(m.group(4))
+    if stats:
+        stats['mem_total_bytes'] = total_bytes
+    return stats
+
+
+def parse_clause_line_statistics(content):
+    """Parse Clause Line Statistics section: clause reads per size class.
+
+    Keys are clause_{class}_reads/lines/lines_per_read/min_lines_per_read for
+    class lits_2_5 .. lits_62_up, plus clause_lines_per_read and
+    clause_min_lines_per_read over all classes.
+    """
+    stats = {}
+    section = re.search(
+        r'=+\[\s*Clause Line Statistics\s*\]=+\n(.*?)\n=+',
+        content, re.DOTALL
+    )
+    if not section:
+        return stats
+
+    pattern = (r'(lits_\w+)\s*:\s*(\d+) reads,\s*(\d+) lines,\s*([\d.]+) lines/read,'
+               r'\s*([\d.]+) min lines/read')
+    reads = lines = min_lines = 0.0
+    for m in re.finditer(pattern, section.group(1)):
+        name = m.group(1)
+        n = int(m.group(2))
+        stats[f'clause_{name}_reads'] = n
+        stats[f'clause_{name}_lines'] = int(m.group(3))
+        stats[f'clause_{name}_lines_per_read'] = float(m.group(4))
+        stats[f'clause_{name}_min_lines_per_read'] = float(m.group(5))
+        reads += n
+        lines += int(m.group(3))
+        min_lines += n * float(m.group(5))
+    if reads > 0:
+        stats['clause_lines_per_read'] = lines / reads
+        stats['clause_min_lines_per_read'] = min_lines / reads
+    return stats
+
+
+def parse_sampled_estimates(content):
+    """Parse Sampled Estimates section (sample_interval > 0).
+
+    Keys are sampled_windows and sampled_conflicts, plus est_{counter}_cycles,
+    est_{counter}_ci (95% half-width) and est_{counter}_per_conflict for the
+    extrapolated total and the Cycle Statistics counters (propagate,
+    reduce_db, heap_insert, ...). The section is only there for sampled
+    runs, whose sim_time_ms covers the timed windows alone.
+    """
+    stats = {}
+    section = re.search(
+        r'=+\[\s*Sampled Estimates\s*\]=+\n(.*?)\n=+',
+        content, re.DOTALL
+    )
+    if not section:
+        return stats
+    text = section.group(1)
+
+    m = re.search(r'Windows\s*:\s*(\d+) measured,\s*(\d+) conflicts', text)
+    if m:
+        stats['sampled_windows'] = int(m.group(1))
+        stats['sampled_conflicts'] = int(m.group(2))
+    pattern = (r'^(\w[\w ]*?)\s*:\s*(\d+) cycles \+- (\d+) \(95%\),'
+               r'\s*([\d.]+) cycles/conflict')
+    for m in re.finditer(pattern, text, re.M):
+        key = 'est_' + m.group(1).lower().replace(' ', '_')
+        stats[f'{key}_cycles'] = int(m.group(2))
+        stats[f'{key}_ci'] = int(m.group(3))
+        stats[f'{key}_per_conflict'] = float(m.group(4))
+    return stats
+
+
+def parse_speculation_depth_statistics(content):
+    """Parse Speculation Depth Statistics section (enable_speculative).
+
+    Keys are spec_d{depth}_contexts/hits/dropped/hit_rate/lines/wasted_lines
+    per depth, plus spec_adopted and spec_rejected with spec_reuse.
+    """
+    stats = {}
+    section = re.search(
+        r'=+\[\s*Speculation Depth Statistics\s*\]=+\n(.*?)\n=+',
+        content, re.DOTALL
+    )
+    if not section:
+        return stats
+
+    pattern = (r'Depth (\d+)\s*:\s*(\d+) contexts,\s*(\d+) hits,\s*(\d+) dropped'
+               r' \(([\d.]+)% hit\),\s*(\d+) lines,\s*(\d+) wasted')
+    for m in re.finditer(pattern, section.group(1)):
+        d = m.group(1)
+        stats[f'spec_d{d}_contexts'] = int(m.group(2))
+        stats[f'spec_d{d}_hits'] = int(m.group(3))
+        stats[f'spec_d{d}_dropped'] = int(m.group(4))
+        stats[f'spec_d{d}_hit_rate'] = float(m.group(5)) / 100.0
+        stats[f'spec_d{d}_lines'] = int(m.group(6))
+        stats[f'spec_d{d}_wasted_lines'] = int(m.group(7))
+    m = re.search(r'Reused\s*:\s*(\d+) implications adopted,\s*(\d+) rejected', section.group(1))
+    if m:
+        stats['spec_adopted'] = int(m.group(1))
+        stats['spec_rejected'] = int(m.group(2))
+    return stats
+
+
+def parse_address_layout_statistics(content):
+    """Parse Address Layout Statistics section (layout_stripes > 1).
+
+    Keys are stripe{N}_reads/writes per stripe, layout_balance, and
+    watch_blocks_colocated with layout_colocate_watches.
+    """
+    stats = {}
+    section = re.search(
+        r'=+\[\s*Address Layout Statistics\s*\]=+\n(.*?)\n=+',
+        content, re.DOTALL
+    )
+    if not section:
+        return stats
+    text = section.group(1)
+
+    for m in re.finditer(r'Stripe (\d+)\s*:\s*(\d+) reads,\s*(\d+) writes', text):
+        stats[f'stripe{m.group(1)}_reads'] = int(m.group(2))
+        stats[f'stripe{m.group(1)}_writes'] = int(m.group(3))
+    m = re.search(r'Balance\s*:\s*busiest stripe ([\d.]+)x', text)
+    if m:
+        stats['layout_balance'] = float(m.group(1))
+    m = re.search(r'Colocated\s*:\s*(\d+) watcher blocks', text)
+    if m:
+        stats['watch_blocks_colocated'] = int(m.group(1))
+    return stats
+
+
 def parse_reduced_clause_access_statistics(content):
     """Parse Reduced Clause Access Statistics section if present."""
     stats = {}
@@ -925,6 +1122,11 @@ def parse_satsolver_log(log_file_path, content):
         result.update(parse_propagation_detail_statistics(content))
         result.update(parse_directed_prefetcher_statistics(content))
         result.update(parse_reduced_clause_access_statistics(content))
+        result.update(parse_memory_profile_statistics(content))
+        result.update(parse_clause_line_statistics(content))
+        result.update(parse_speculation_depth_statistics(content))
+        result.update(parse_sampled_estimates(content))
+        result.update(parse_address_layout_statistics(content))
         result.update(parse_conflict_learning_statistics(content))
         result.update(parse_coprocessor_raw_statistics(content))
 